@@ -0,0 +1,358 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include "Mat4.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include "Vec3.h"
+#include "Vec3SoA.h"
+#include "VertexStream.h"
+
+namespace lm
+{
+	/* -----
+	Axis-aligned box [mMin, mMax]. The default box is empty (mMin above mMax) so that merging
+	points or boxes into it starts from nothing; an empty box contains and intersects nothing.
+	----- */
+
+	template <typename T> class AABB
+	{
+	public:
+		Vec3<T> mMin;
+		Vec3<T> mMax;
+
+		constexpr AABB()
+			: mMin(std::numeric_limits<T>::max()), mMax(std::numeric_limits<T>::lowest())
+		{}
+
+		constexpr AABB(const Vec3<T>& pMin, const Vec3<T>& pMax)
+			: mMin(pMin), mMax(pMax)
+		{}
+
+		/* Rule of five */
+		AABB(const AABB<T>& pOther) = default;
+		AABB(AABB<T>&& pOther) noexcept = default;
+		AABB<T>& operator=(const AABB<T>& pOther) = default;
+		AABB<T>& operator=(AABB<T>&& pOther) noexcept = default;
+
+		/**/
+
+		static constexpr AABB<T> FromCenterExtents(const Vec3<T>& pCenter, const Vec3<T>& pExtents)
+		{
+			return AABB<T>(pCenter - pExtents, pCenter + pExtents);
+		}
+
+		/* -----
+		Bounds of pCount points, pStride bytes apart as in Strided (VertexStream.h). Tightly packed
+		floats are reduced four points (three Float4 loads) per step, strided floats one point per Float4.
+		----- */
+		static AABB<T> FromPoints(const Vec3<T>* pPoints, const std::size_t pCount,
+			const std::size_t pStride = sizeof(Vec3<T>))
+		{
+			AABB<T> result;
+			std::size_t i = 0;
+
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				using Simd::Float4;
+
+				if (pStride == sizeof(Vec3<T>) && pCount >= 4)
+				{
+					// flat index o of a 12 float block holds component o % 3
+					const float* flat = &pPoints[0][0];
+					Float4 min[3] = { Float4::Load(flat), Float4::Load(flat + 4), Float4::Load(flat + 8) };
+					Float4 max[3] = { min[0], min[1], min[2] };
+					for (i = 4; i + 4 <= pCount; i += 4)
+					{
+						for (int block = 0; block < 3; block++)
+						{
+							const Float4 values = Float4::Load(flat + 3 * i + 4 * block);
+							min[block] = Simd::Min(min[block], values);
+							max[block] = Simd::Max(max[block], values);
+						}
+					}
+
+					float mins[12], maxs[12];
+					for (int block = 0; block < 3; block++)
+					{
+						min[block].Store(mins + 4 * block);
+						max[block].Store(maxs + 4 * block);
+					}
+					for (int o = 0; o < 12; o++)
+					{
+						result.mMin[o % 3] = std::min(result.mMin[o % 3], mins[o]);
+						result.mMax[o % 3] = std::max(result.mMax[o % 3], maxs[o]);
+					}
+				}
+				else if (pStride >= sizeof(Float4) && pCount >= 2)
+				{
+					// the fourth lane reads the next bytes of the element and is dropped, the last point goes
+					// scalar. Two accumulators so that consecutive points do not wait on each other
+					Float4 min = Float4::Load(&Strided(pPoints, 0, pStride)[0]);
+					Float4 max = min;
+					Float4 otherMin = min;
+					Float4 otherMax = min;
+					for (i = 1; i + 2 < pCount; i += 2)
+					{
+						const Float4 values = Float4::Load(&Strided(pPoints, i, pStride)[0]);
+						const Float4 otherValues = Float4::Load(&Strided(pPoints, i + 1, pStride)[0]);
+						min = Simd::Min(min, values);
+						max = Simd::Max(max, values);
+						otherMin = Simd::Min(otherMin, otherValues);
+						otherMax = Simd::Max(otherMax, otherValues);
+					}
+					min = Simd::Min(min, otherMin);
+					max = Simd::Max(max, otherMax);
+
+					float mins[4], maxs[4];
+					min.Store(mins);
+					max.Store(maxs);
+					result = AABB<T>(Vec3<T>(mins[0], mins[1], mins[2]), Vec3<T>(maxs[0], maxs[1], maxs[2]));
+				}
+			}
+
+			for (; i < pCount; i++)
+				result.MergeSelf(Strided(pPoints, i, pStride));
+
+			return result;
+		}
+
+		static AABB<T> FromPoints(const Vec3SoA<T>& pPoints)
+		{
+			const T* lanes[3] = { pPoints.X(), pPoints.Y(), pPoints.Z() };
+			const std::size_t count = pPoints.Size();
+
+			AABB<T> result;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const T* lane = lanes[axis];
+				std::size_t i = 0;
+
+				if constexpr (Simd::IsAccelerated<T>)
+				{
+					using Simd::Float8;
+
+					if (count >= Float8::Width)
+					{
+						Float8 min = Float8::Load(lane);
+						Float8 max = min;
+						for (i = Float8::Width; i + Float8::Width <= count; i += Float8::Width)
+						{
+							const Float8 values = Float8::Load(lane + i);
+							min = Simd::Min(min, values);
+							max = Simd::Max(max, values);
+						}
+
+						float mins[Float8::Width], maxs[Float8::Width];
+						min.Store(mins);
+						max.Store(maxs);
+						result.mMin[axis] = *std::min_element(mins, mins + Float8::Width);
+						result.mMax[axis] = *std::max_element(maxs, maxs + Float8::Width);
+					}
+				}
+
+				for (; i < count; i++)
+				{
+					result.mMin[axis] = std::min(result.mMin[axis], lane[i]);
+					result.mMax[axis] = std::max(result.mMax[axis], lane[i]);
+				}
+			}
+
+			return result;
+		}
+
+		constexpr bool operator==(const AABB<T>& pOther) const
+		{
+			return this->mMin == pOther.mMin && this->mMax == pOther.mMax;
+		}
+
+		constexpr bool operator!=(const AABB<T>& pOther) const
+		{
+			return !(*this == pOther);
+		}
+
+		constexpr bool ApproxEqual(const AABB<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
+		{
+			return this->mMin.ApproxEqual(pOther.mMin, pAbsEps, pRelEps) && this->mMax.ApproxEqual(pOther.mMax, pAbsEps, pRelEps);
+		}
+
+		constexpr bool IsEmpty() const
+		{
+			return this->mMin.X() > this->mMax.X() || this->mMin.Y() > this->mMax.Y() || this->mMin.Z() > this->mMax.Z();
+		}
+
+		constexpr Vec3<T> GetCenter() const
+		{
+			return (this->mMin + this->mMax) * T(0.5);
+		}
+
+		// half size along each axis
+		constexpr Vec3<T> GetExtents() const
+		{
+			return (this->mMax - this->mMin) * T(0.5);
+		}
+
+		constexpr Vec3<T> GetSize() const
+		{
+			return this->mMax - this->mMin;
+		}
+
+		// 0 for an empty box, the SAH cost of a BVH node
+		constexpr T SurfaceArea() const
+		{
+			if (this->IsEmpty())
+				return 0;
+
+			const Vec3<T> size = this->GetSize();
+			return 2 * (size.X() * size.Y() + size.Y() * size.Z() + size.Z() * size.X());
+		}
+
+		constexpr T Volume() const
+		{
+			if (this->IsEmpty())
+				return 0;
+
+			const Vec3<T> size = this->GetSize();
+			return size.X() * size.Y() * size.Z();
+		}
+
+		constexpr bool Contains(const Vec3<T>& pPoint) const
+		{
+			return pPoint.X() >= this->mMin.X() && pPoint.X() <= this->mMax.X() &&
+				pPoint.Y() >= this->mMin.Y() && pPoint.Y() <= this->mMax.Y() &&
+				pPoint.Z() >= this->mMin.Z() && pPoint.Z() <= this->mMax.Z();
+		}
+
+		constexpr bool Contains(const AABB<T>& pOther) const
+		{
+			return !pOther.IsEmpty() && this->Contains(pOther.mMin) && this->Contains(pOther.mMax);
+		}
+
+		// 0 inside, a sphere overlaps the box when it is at most the squared radius
+		constexpr T SquaredDistance(const Vec3<T>& pPoint) const
+		{
+			T result = 0;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const T outside = std::max(std::max(this->mMin[axis] - pPoint[axis], pPoint[axis] - this->mMax[axis]), T(0));
+				result += outside * outside;
+			}
+			return result;
+		}
+
+		// touching boxes intersect
+		constexpr bool Intersects(const AABB<T>& pOther) const
+		{
+			return !this->Intersection(pOther).IsEmpty();
+		}
+
+		constexpr AABB<T> Merge(const Vec3<T>& pPoint) const
+		{
+			return AABB<T>(MinPerAxis(this->mMin, pPoint), MaxPerAxis(this->mMax, pPoint));
+		}
+
+		constexpr AABB<T> Merge(const AABB<T>& pOther) const
+		{
+			return AABB<T>(MinPerAxis(this->mMin, pOther.mMin), MaxPerAxis(this->mMax, pOther.mMax));
+		}
+
+		constexpr AABB<T>& MergeSelf(const Vec3<T>& pPoint)
+		{
+			return *this = this->Merge(pPoint);
+		}
+
+		constexpr AABB<T>& MergeSelf(const AABB<T>& pOther)
+		{
+			return *this = this->Merge(pOther);
+		}
+
+		// the overlap, empty when the boxes are apart
+		constexpr AABB<T> Intersection(const AABB<T>& pOther) const
+		{
+			return AABB<T>(MaxPerAxis(this->mMin, pOther.mMin), MinPerAxis(this->mMax, pOther.mMax));
+		}
+
+		/* -----
+		Bounds of the box transformed by an affine pMatrix (row-vector convention, translation in
+		row 3), Arvo's method: the center goes through the matrix and the extents through its
+		absolute value, no corner is transformed. The result is tight for the transformed box.
+		----- */
+		AABB<T> Transform(const Mat4<T>& pMatrix) const
+		{
+			if (this->IsEmpty())
+				return *this;
+
+			const Vec3<T> center = this->GetCenter();
+			const Vec3<T> extents = this->GetExtents();
+
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				using Simd::Float4;
+
+				Float4 newCenter = Float4::Load(&pMatrix[3][0]);
+				Float4 newExtents = Float4::Splat(0.f);
+				for (int row = 0; row < 3; row++)
+				{
+					const Float4 axis = Float4::Load(&pMatrix[row][0]);
+					newCenter = newCenter + axis * Float4::Splat(center[row]);
+					newExtents = newExtents + Simd::Abs(axis) * Float4::Splat(extents[row]);
+				}
+
+				float centers[4], extent[4];
+				newCenter.Store(centers);
+				newExtents.Store(extent);
+				return FromCenterExtents(Vec3<T>(centers[0], centers[1], centers[2]), Vec3<T>(extent[0], extent[1], extent[2]));
+			}
+			else
+			{
+				Vec3<T> newCenter(pMatrix[3][0], pMatrix[3][1], pMatrix[3][2]);
+				Vec3<T> newExtents;
+				for (int row = 0; row < 3; row++)
+					for (int column = 0; column < 3; column++)
+					{
+						newCenter[column] += pMatrix[row][column] * center[row];
+						newExtents[column] += std::abs(pMatrix[row][column]) * extents[row];
+					}
+
+				return FromCenterExtents(newCenter, newExtents);
+			}
+		}
+
+	private:
+		static constexpr Vec3<T> MinPerAxis(const Vec3<T>& pLeft, const Vec3<T>& pRight)
+		{
+			return Vec3<T>(std::min(pLeft.X(), pRight.X()), std::min(pLeft.Y(), pRight.Y()), std::min(pLeft.Z(), pRight.Z()));
+		}
+
+		static constexpr Vec3<T> MaxPerAxis(const Vec3<T>& pLeft, const Vec3<T>& pRight)
+		{
+			return Vec3<T>(std::max(pLeft.X(), pRight.X()), std::max(pLeft.Y(), pRight.Y()), std::max(pLeft.Z(), pRight.Z()));
+		}
+	};
+
+	typedef AABB<float> FAABB;
+	typedef AABB<double> DAABB;
+
+	static_assert(std::is_trivially_copyable_v<FAABB> && std::is_standard_layout_v<FAABB>,
+		"FAABB must be trivially copyable and standard layout");
+
+	/* -----
+	pResult[i] = pBoxes[i].Transform(pMatrices[i]): local mesh bounds to world bounds for a
+	whole scene, e.g. with Hierarchy::GetWorlds(). Threaded by box ranges as described in
+	Parallel.h.
+	----- */
+	template <typename T> void TransformBoxes(const AABB<T>* pBoxes, const Mat4<T>* pMatrices, const std::size_t pCount,
+		AABB<T>* pResult, const unsigned int pThreadCount = 0)
+	{
+		Parallel::ForRanges(pCount, Parallel::mMinElementsPerThread, pThreadCount,
+			[pBoxes, pMatrices, pResult](const std::size_t pBegin, const std::size_t pEnd)
+			{
+				for (std::size_t i = pBegin; i < pEnd; i++)
+					pResult[i] = pBoxes[i].Transform(pMatrices[i]);
+			});
+	}
+}
@@ -0,0 +1,742 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "AABB.h"
+#include "Parallel.h"
+#include "Ray.h"
+#include "Simd.h"
+#include "Vec3.h"
+#include "VertexStream.h"
+
+namespace lm
+{
+	/* -----
+	Binary bounding volume hierarchy over primitive bounds, built with the binned surface area
+	heuristic. Primitives are referenced by their index in the array given to Build, a leaf
+	covers GetIndices()[mLeftFirst, mLeftFirst + mCount). Queries report the primitives of the
+	leaves they reach; the exact primitive test is left to the callback.
+	----- */
+
+	template <typename T> class BVH
+	{
+	public:
+		// 32 bytes for floats, the children of an internal node are mLeftFirst and mLeftFirst + 1
+		struct Node
+		{
+			Vec3<T> mMin;
+			std::uint32_t mLeftFirst;	// first child, or first index of the leaf
+			Vec3<T> mMax;
+			std::uint32_t mCount;		// primitives in the leaf, 0 for an internal node
+
+			bool IsLeaf() const
+			{
+				return this->mCount != 0;
+			}
+
+			AABB<T> GetBounds() const
+			{
+				return AABB<T>(this->mMin, this->mMax);
+			}
+		};
+
+		static constexpr std::size_t mBinCount = 16;
+
+		// below half of it SAH splits are used, then object medians: a traversal stack never overflows
+		static constexpr std::size_t mMaxDepth = 64;
+
+		BVH() = default;
+
+		/* Rule of five */
+		BVH(const BVH<T>& pOther) = default;
+		BVH(BVH<T>&& pOther) noexcept = default;
+		BVH<T>& operator=(const BVH<T>& pOther) = default;
+		BVH<T>& operator=(BVH<T>&& pOther) noexcept = default;
+
+		/**/
+
+		/* -----
+		Builds over pCount primitive bounds, leaves hold at most pMaxLeafSize primitives. The top
+		of the tree is split on the calling thread until the ranges are small enough, these
+		subtrees are then built on separate threads (see Parallel.h) and appended. The splits do
+		not depend on the thread count, only the node order does.
+		----- */
+		void Build(const AABB<T>* pBounds, const std::size_t pCount, const std::size_t pMaxLeafSize = 4,
+			const unsigned int pThreadCount = 0)
+		{
+			assert(pCount < std::numeric_limits<std::uint32_t>::max() && "BVH primitive indices are 32 bits");
+
+			this->mNodes.clear();
+			this->mIndices.resize(pCount);
+			std::iota(this->mIndices.begin(), this->mIndices.end(), std::uint32_t(0));
+			if (pCount == 0)
+				return;
+
+			std::vector<Vec3<T>> centroids(pCount);
+			for (std::size_t i = 0; i < pCount; i++)
+				centroids[i] = pBounds[i].GetCenter();
+
+			const Builder builder{ pBounds, centroids.data(), this->mIndices.data(),
+				std::clamp<std::size_t>(pMaxLeafSize, 1, std::numeric_limits<std::uint16_t>::max()) };
+
+			const unsigned int threadCount = Parallel::ThreadCount(pThreadCount);
+			const std::size_t taskSize = threadCount > 1 && pCount >= 2 * Parallel::mMinElementsPerThread ?
+				std::max<std::size_t>(pCount / (4 * std::size_t(threadCount)), 1) : 0;
+
+			std::vector<Task> tasks;
+			this->mNodes.emplace_back();
+			builder.Split(this->mNodes, 0, 0, std::uint32_t(pCount), 0, taskSize, &tasks);
+			if (tasks.empty())
+				return;
+
+			// largest subtrees first, threads take the next task when they are done
+			std::sort(tasks.begin(), tasks.end(), [](const Task& pLeft, const Task& pRight)
+				{
+					return pLeft.mEnd - pLeft.mBegin > pRight.mEnd - pRight.mBegin;
+				});
+
+			std::vector<std::vector<Node>> subtrees(tasks.size());
+			std::atomic<std::size_t> next{ 0 };
+			Parallel::ForRanges(threadCount, 1, threadCount,
+				[&builder, &tasks, &subtrees, &next](const std::size_t, const std::size_t)
+				{
+					for (std::size_t task = next++; task < tasks.size(); task = next++)
+					{
+						subtrees[task].emplace_back();
+						builder.Split(subtrees[task], 0, tasks[task].mBegin, tasks[task].mEnd, tasks[task].mDepth, 0, nullptr);
+					}
+				});
+
+			// the subtree root replaces its placeholder, the other nodes are appended in order
+			for (std::size_t task = 0; task < tasks.size(); task++)
+			{
+				const std::uint32_t offset = std::uint32_t(this->mNodes.size() - 1);
+				for (std::size_t i = 0; i < subtrees[task].size(); i++)
+				{
+					Node node = subtrees[task][i];
+					if (!node.IsLeaf())
+						node.mLeftFirst += offset;
+
+					if (i == 0)
+						this->mNodes[tasks[task].mNode] = node;
+					else
+						this->mNodes.push_back(node);
+				}
+			}
+		}
+
+		std::size_t GetNodeCount() const
+		{
+			return this->mNodes.size();
+		}
+
+		// the root is node 0
+		const Node* GetNodes() const
+		{
+			return this->mNodes.data();
+		}
+
+		const std::uint32_t* GetIndices() const
+		{
+			return this->mIndices.data();
+		}
+
+		std::size_t GetPrimitiveCount() const
+		{
+			return this->mIndices.size();
+		}
+
+		AABB<T> GetBounds() const
+		{
+			return this->mNodes.empty() ? AABB<T>() : this->mNodes[0].GetBounds();
+		}
+
+		/* -----
+		Closest hit: pHit(primitive, pDistance) tests a primitive, shortens pDistance and returns
+		true when it hits closer. Nodes are visited nearest first and skipped once they start
+		beyond pDistance. Returns true when any primitive was hit, pDistance is then the closest.
+		----- */
+		template <typename Hit> bool Raycast(const Ray<T>& pRay, T& pDistance, Hit&& pHit) const
+		{
+			T entry;
+			if (this->mNodes.empty() || !pRay.IntersectBox(this->mNodes[0].GetBounds(), pDistance, entry))
+				return false;
+
+			struct Entry
+			{
+				std::uint32_t mNode;
+				T mDistance;
+			};
+
+			Entry stack[mMaxDepth + 1];
+			std::size_t size = 0;
+			stack[size++] = { 0, entry };
+
+			bool hit = false;
+			while (size != 0)
+			{
+				const Entry top = stack[--size];
+				if (top.mDistance > pDistance)
+					continue;
+
+				const Node* node = &this->mNodes[top.mNode];
+				while (node != nullptr && !node->IsLeaf())
+				{
+					T leftEntry, rightEntry;
+					const std::uint32_t left = node->mLeftFirst;
+					const bool leftHit = pRay.IntersectBox(this->mNodes[left].GetBounds(), pDistance, leftEntry);
+					const bool rightHit = pRay.IntersectBox(this->mNodes[left + 1].GetBounds(), pDistance, rightEntry);
+
+					if (leftHit && rightHit)
+					{
+						const bool leftFirst = leftEntry <= rightEntry;
+						stack[size++] = leftFirst ? Entry{ left + 1, rightEntry } : Entry{ left, leftEntry };
+						node = &this->mNodes[leftFirst ? left : left + 1];
+					}
+					else if (leftHit || rightHit)
+						node = &this->mNodes[leftHit ? left : left + 1];
+					else
+						node = nullptr;
+				}
+
+				if (node == nullptr)
+					continue;
+
+				for (std::uint32_t i = node->mLeftFirst; i < node->mLeftFirst + node->mCount; i++)
+					hit = pHit(this->mIndices[i], pDistance) || hit;
+			}
+
+			return hit;
+		}
+
+		// pVisit(primitive) for every primitive of the leaves touching the sphere
+		template <typename Visit> void QuerySphere(const Vec3<T>& pCenter, const T pRadius, Visit&& pVisit) const
+		{
+			const T squaredRadius = pRadius * pRadius;
+			this->Query([&pCenter, squaredRadius](const Node& pNode)
+				{
+					return pNode.GetBounds().SquaredDistance(pCenter) <= squaredRadius;
+				}, pVisit);
+		}
+
+		// pVisit(primitive) for every primitive of the leaves touching pBox
+		template <typename Visit> void QueryBox(const AABB<T>& pBox, Visit&& pVisit) const
+		{
+			this->Query([&pBox](const Node& pNode)
+				{
+					return pNode.GetBounds().Intersects(pBox);
+				}, pVisit);
+		}
+
+	private:
+		struct Task
+		{
+			std::uint32_t mNode;
+			std::uint32_t mBegin;
+			std::uint32_t mEnd;
+			std::size_t mDepth;
+		};
+
+		struct Builder
+		{
+			const AABB<T>* mBounds;
+			const Vec3<T>* mCentroids;
+			std::uint32_t* mIndices;
+			std::size_t mMaxLeafSize;
+
+			/* -----
+			Fills pNodes[pNode] with the primitives mIndices[pBegin, pEnd) and splits it. A range of
+			at most pTaskSize primitives is left to a Task when pTasks is given.
+			----- */
+			void Split(std::vector<Node>& pNodes, const std::uint32_t pNode, const std::uint32_t pBegin,
+				const std::uint32_t pEnd, const std::size_t pDepth, const std::size_t pTaskSize, std::vector<Task>* pTasks) const
+			{
+				AABB<T> bounds, centroidBounds;
+				for (std::uint32_t i = pBegin; i < pEnd; i++)
+				{
+					bounds.MergeSelf(this->mBounds[this->mIndices[i]]);
+					centroidBounds.MergeSelf(this->mCentroids[this->mIndices[i]]);
+				}
+				pNodes[pNode].mMin = bounds.mMin;
+				pNodes[pNode].mMax = bounds.mMax;
+
+				if (pTasks != nullptr && pEnd - pBegin <= pTaskSize)
+				{
+					pTasks->push_back({ pNode, pBegin, pEnd, pDepth });
+					return;
+				}
+
+				const std::uint32_t middle = this->Partition(pBegin, pEnd, pDepth, bounds, centroidBounds);
+				if (middle == pEnd)
+				{
+					pNodes[pNode].mLeftFirst = pBegin;
+					pNodes[pNode].mCount = pEnd - pBegin;
+					return;
+				}
+
+				// vector storage may move while the children recurse, only indices are kept
+				const std::uint32_t left = std::uint32_t(pNodes.size());
+				pNodes.emplace_back();
+				pNodes.emplace_back();
+				pNodes[pNode].mLeftFirst = left;
+				pNodes[pNode].mCount = 0;
+
+				this->Split(pNodes, left, pBegin, middle, pDepth + 1, pTaskSize, pTasks);
+				this->Split(pNodes, left + 1, middle, pEnd, pDepth + 1, pTaskSize, pTasks);
+			}
+
+			// the first index of the right child, pEnd for a leaf
+			std::uint32_t Partition(const std::uint32_t pBegin, const std::uint32_t pEnd, const std::size_t pDepth,
+				const AABB<T>& pBounds, const AABB<T>& pCentroidBounds) const
+			{
+				const std::uint32_t count = pEnd - pBegin;
+				if (count <= 1)
+					return pEnd;
+
+				const Vec3<T> extent = pCentroidBounds.GetSize();
+				const int longest = extent.X() >= extent.Y() && extent.X() >= extent.Z() ? 0 : extent.Y() >= extent.Z() ? 1 : 2;
+
+				// every centroid in one point: no plane separates them, halve large ranges anyway
+				if (extent[longest] <= 0)
+					return count <= this->mMaxLeafSize ? pEnd : pBegin + count / 2;
+
+				// deep in a degenerate tree: stop binning, halve the ranges still above the leaf size
+				if (pDepth >= mMaxDepth / 2)
+					return count <= this->mMaxLeafSize ? pEnd : this->MedianSplit(pBegin, pEnd, longest);
+
+				struct Bin
+				{
+					AABB<T> mBounds;
+					std::uint32_t mCount = 0;
+				};
+
+				Bin bins[3][mBinCount];
+				T scale[3];
+				for (int axis = 0; axis < 3; axis++)
+					scale[axis] = extent[axis] > 0 ? T(mBinCount) / extent[axis] : T(0);
+
+				const auto binOf = [&pCentroidBounds, &scale](const Vec3<T>& pCentroid, const int pAxis)
+				{
+					const std::size_t bin = std::size_t((pCentroid[pAxis] - pCentroidBounds.mMin[pAxis]) * scale[pAxis]);
+					return std::min(bin, mBinCount - 1);
+				};
+
+				for (std::uint32_t i = pBegin; i < pEnd; i++)
+				{
+					const std::uint32_t primitive = this->mIndices[i];
+					for (int axis = 0; axis < 3; axis++)
+					{
+						Bin& bin = bins[axis][binOf(this->mCentroids[primitive], axis)];
+						bin.mBounds.MergeSelf(this->mBounds[primitive]);
+						bin.mCount++;
+					}
+				}
+
+				// sweep from the left, then from the right evaluating each plane between two bins
+				T bestCost = std::numeric_limits<T>::max();
+				int bestAxis = -1;
+				std::size_t bestSplit = 0;
+				for (int axis = 0; axis < 3; axis++)
+				{
+					T leftCosts[mBinCount - 1];
+					std::uint32_t leftCounts[mBinCount - 1];
+					AABB<T> side;
+					std::uint32_t sideCount = 0;
+					for (std::size_t bin = 0; bin + 1 < mBinCount; bin++)
+					{
+						side.MergeSelf(bins[axis][bin].mBounds);
+						sideCount += bins[axis][bin].mCount;
+						leftCosts[bin] = side.SurfaceArea() * T(sideCount);
+						leftCounts[bin] = sideCount;
+					}
+
+					side = AABB<T>();
+					sideCount = 0;
+					for (std::size_t bin = mBinCount - 1; bin > 0; bin--)
+					{
+						side.MergeSelf(bins[axis][bin].mBounds);
+						sideCount += bins[axis][bin].mCount;
+
+						const T cost = leftCosts[bin - 1] + side.SurfaceArea() * T(sideCount);
+						if (leftCounts[bin - 1] != 0 && sideCount != 0 && cost < bestCost)
+						{
+							bestCost = cost;
+							bestAxis = axis;
+							bestSplit = bin;
+						}
+					}
+				}
+
+				// costs scaled by the node area: one traversal step against one primitive test each
+				const T area = pBounds.SurfaceArea();
+				const bool fits = count <= this->mMaxLeafSize;
+				if (bestAxis < 0)
+					return fits ? pEnd : this->MedianSplit(pBegin, pEnd, longest);
+				if (fits && T(count) * area <= area + bestCost)
+					return pEnd;
+
+				const std::uint32_t* middle = std::partition(this->mIndices + pBegin, this->mIndices + pEnd,
+					[this, &binOf, bestAxis, bestSplit](const std::uint32_t pPrimitive)
+					{
+						return binOf(this->mCentroids[pPrimitive], bestAxis) < bestSplit;
+					});
+				return std::uint32_t(middle - this->mIndices);
+			}
+
+			std::uint32_t MedianSplit(const std::uint32_t pBegin, const std::uint32_t pEnd, const int pAxis) const
+			{
+				const std::uint32_t middle = pBegin + (pEnd - pBegin) / 2;
+				std::nth_element(this->mIndices + pBegin, this->mIndices + middle, this->mIndices + pEnd,
+					[this, pAxis](const std::uint32_t pLeft, const std::uint32_t pRight)
+					{
+						return this->mCentroids[pLeft][pAxis] < this->mCentroids[pRight][pAxis];
+					});
+				return middle;
+			}
+		};
+
+		template <typename Overlaps, typename Visit> void Query(Overlaps&& pOverlaps, Visit&& pVisit) const
+		{
+			if (this->mNodes.empty() || !pOverlaps(this->mNodes[0]))
+				return;
+
+			std::uint32_t stack[mMaxDepth + 1];
+			std::size_t size = 0;
+			stack[size++] = 0;
+
+			while (size != 0)
+			{
+				const Node& node = this->mNodes[stack[--size]];
+				if (node.IsLeaf())
+				{
+					for (std::uint32_t i = node.mLeftFirst; i < node.mLeftFirst + node.mCount; i++)
+						pVisit(this->mIndices[i]);
+					continue;
+				}
+
+				for (const std::uint32_t child : { node.mLeftFirst, node.mLeftFirst + 1 })
+					if (pOverlaps(this->mNodes[child]))
+						stack[size++] = child;
+			}
+		}
+
+		std::vector<Node> mNodes;
+		std::vector<std::uint32_t> mIndices;
+	};
+
+	typedef BVH<float> FBVH;
+	typedef BVH<double> DBVH;
+
+	static_assert(sizeof(FBVH::Node) == 32, "FBVH nodes must stay 32 bytes, two per cache line");
+
+	/* -----
+	Float BVH collapsed to Width children per node (4 or 8) with the child boxes stored per
+	axis, so that a ray or a query box is tested against every child at once with Float4 or
+	Float8. Children are opened largest surface area first, leaves stay the source leaves.
+	----- */
+
+	template <std::size_t Width> class WideBVH
+	{
+		static_assert(Width == 4 || Width == 8, "WideBVH nodes have 4 or 8 children");
+
+		using Pack = std::conditional_t<Width == 8, Simd::Float8, Simd::Float4>;
+
+	public:
+		struct alignas(Width * sizeof(float)) Node
+		{
+			float mMinX[Width], mMinY[Width], mMinZ[Width];
+			float mMaxX[Width], mMaxY[Width], mMaxZ[Width];
+			std::uint32_t mChild[Width];	// node index, or first index of a leaf child
+			std::uint16_t mCount[Width];	// primitives of a leaf child, 0 for a node
+			std::uint32_t mChildCount;		// the children fill the first slots
+		};
+
+		WideBVH() = default;
+
+		explicit WideBVH(const FBVH& pSource)
+		{
+			this->Build(pSource);
+		}
+
+		/* Rule of five */
+		WideBVH(const WideBVH<Width>& pOther) = default;
+		WideBVH(WideBVH<Width>&& pOther) noexcept = default;
+		WideBVH<Width>& operator=(const WideBVH<Width>& pOther) = default;
+		WideBVH<Width>& operator=(WideBVH<Width>&& pOther) noexcept = default;
+
+		/**/
+
+		void Build(const FBVH& pSource)
+		{
+			this->mNodes.clear();
+			this->mIndices.clear();
+			if (pSource.GetNodeCount() == 0)
+				return;
+
+			this->mIndices.assign(pSource.GetIndices(), pSource.GetIndices() + pSource.GetPrimitiveCount());
+
+			this->mNodes.emplace_back();
+			this->Collapse(pSource, 0, 0);
+		}
+
+		std::size_t GetNodeCount() const
+		{
+			return this->mNodes.size();
+		}
+
+		const Node* GetNodes() const
+		{
+			return this->mNodes.data();
+		}
+
+		const std::uint32_t* GetIndices() const
+		{
+			return this->mIndices.data();
+		}
+
+		// same contract as BVH::Raycast
+		template <typename Hit> bool Raycast(const FRay& pRay, float& pDistance, Hit&& pHit) const
+		{
+			if (this->mNodes.empty())
+				return false;
+
+			const Pack originX = Pack::Splat(pRay.GetOrigin().X());
+			const Pack originY = Pack::Splat(pRay.GetOrigin().Y());
+			const Pack originZ = Pack::Splat(pRay.GetOrigin().Z());
+			const Pack inverseX = Pack::Splat(pRay.GetInverseDirection().X());
+			const Pack inverseY = Pack::Splat(pRay.GetInverseDirection().Y());
+			const Pack inverseZ = Pack::Splat(pRay.GetInverseDirection().Z());
+			const Pack zero = Pack::Splat(0.f);
+
+			Entry stack[mStackSize];
+			std::size_t size = 0;
+			stack[size++] = { 0, 0, 0.f };
+
+			bool hit = false;
+			while (size != 0)
+			{
+				const Entry top = stack[--size];
+				if (top.mDistance > pDistance)
+					continue;
+
+				if (top.mCount != 0)
+				{
+					for (std::uint32_t i = top.mChild; i < top.mChild + top.mCount; i++)
+						hit = pHit(this->mIndices[i], pDistance) || hit;
+					continue;
+				}
+
+				const Node& node = this->mNodes[top.mChild];
+				const Pack nearX = (Pack::Load(node.mMinX) - originX) * inverseX;
+				const Pack farX = (Pack::Load(node.mMaxX) - originX) * inverseX;
+				const Pack nearY = (Pack::Load(node.mMinY) - originY) * inverseY;
+				const Pack farY = (Pack::Load(node.mMaxY) - originY) * inverseY;
+				const Pack nearZ = (Pack::Load(node.mMinZ) - originZ) * inverseZ;
+				const Pack farZ = (Pack::Load(node.mMaxZ) - originZ) * inverseZ;
+
+				// NaN ordering as in RayPacket::IntersectBox
+				const Pack entry = Simd::Max(Simd::Min(farZ, nearZ),
+					Simd::Max(Simd::Min(farY, nearY), Simd::Max(Simd::Min(farX, nearX), zero)));
+				const Pack exit = Simd::Min(Simd::Max(nearZ, farZ),
+					Simd::Min(Simd::Max(nearY, farY), Simd::Min(Simd::Max(nearX, farX), Pack::Splat(pDistance))));
+
+				const int bits = (entry <= exit).Bits() & ((1 << node.mChildCount) - 1);
+				if (bits == 0)
+					continue;
+
+				float entries[Width];
+				entry.Store(entries);
+
+				// farthest pushed first so that the nearest child is popped next
+				Entry hits[Width];
+				std::size_t hitCount = 0;
+				for (std::size_t slot = 0; slot < Width; slot++)
+				{
+					if ((bits >> slot & 1) == 0)
+						continue;
+
+					std::size_t position = hitCount++;
+					for (; position > 0 && hits[position - 1].mDistance < entries[slot]; position--)
+						hits[position] = hits[position - 1];
+					hits[position] = { node.mChild[slot], node.mCount[slot], entries[slot] };
+				}
+				for (std::size_t i = 0; i < hitCount; i++)
+					stack[size++] = hits[i];
+			}
+
+			return hit;
+		}
+
+		// same contract as BVH::QuerySphere
+		template <typename Visit> void QuerySphere(const FVec3& pCenter, const float pRadius, Visit&& pVisit) const
+		{
+			const Pack centerX = Pack::Splat(pCenter.X());
+			const Pack centerY = Pack::Splat(pCenter.Y());
+			const Pack centerZ = Pack::Splat(pCenter.Z());
+			const Pack squaredRadius = Pack::Splat(pRadius * pRadius);
+			const Pack zero = Pack::Splat(0.f);
+
+			this->Query([&](const Node& pNode)
+				{
+					const Pack x = Simd::Max(Simd::Max(Pack::Load(pNode.mMinX) - centerX, centerX - Pack::Load(pNode.mMaxX)), zero);
+					const Pack y = Simd::Max(Simd::Max(Pack::Load(pNode.mMinY) - centerY, centerY - Pack::Load(pNode.mMaxY)), zero);
+					const Pack z = Simd::Max(Simd::Max(Pack::Load(pNode.mMinZ) - centerZ, centerZ - Pack::Load(pNode.mMaxZ)), zero);
+					return (x * x + y * y + z * z <= squaredRadius).Bits();
+				}, pVisit);
+		}
+
+		// same contract as BVH::QueryBox
+		template <typename Visit> void QueryBox(const FAABB& pBox, Visit&& pVisit) const
+		{
+			const Pack minX = Pack::Splat(pBox.mMin.X());
+			const Pack minY = Pack::Splat(pBox.mMin.Y());
+			const Pack minZ = Pack::Splat(pBox.mMin.Z());
+			const Pack maxX = Pack::Splat(pBox.mMax.X());
+			const Pack maxY = Pack::Splat(pBox.mMax.Y());
+			const Pack maxZ = Pack::Splat(pBox.mMax.Z());
+
+			this->Query([&](const Node& pNode)
+				{
+					return ((Pack::Load(pNode.mMinX) <= maxX) & (Pack::Load(pNode.mMaxX) >= minX) &
+						(Pack::Load(pNode.mMinY) <= maxY) & (Pack::Load(pNode.mMaxY) >= minY) &
+						(Pack::Load(pNode.mMinZ) <= maxZ) & (Pack::Load(pNode.mMaxZ) >= minZ)).Bits();
+				}, pVisit);
+		}
+
+	private:
+		struct Entry
+		{
+			std::uint32_t mChild;
+			std::uint32_t mCount;
+			float mDistance;
+		};
+
+		// every level of the source below the root may push Width - 1 siblings
+		static constexpr std::size_t mStackSize = FBVH::mMaxDepth * (Width - 1) + 1;
+
+		void Collapse(const FBVH& pSource, const std::uint32_t pSourceNode, const std::size_t pNode)
+		{
+			const FBVH::Node* nodes = pSource.GetNodes();
+
+			std::uint32_t children[Width];
+			std::size_t childCount = 0;
+			if (nodes[pSourceNode].IsLeaf())
+				children[childCount++] = pSourceNode;
+			else
+			{
+				children[childCount++] = nodes[pSourceNode].mLeftFirst;
+				children[childCount++] = nodes[pSourceNode].mLeftFirst + 1;
+			}
+
+			// open the largest internal child until the node is full
+			while (childCount < Width)
+			{
+				std::size_t largest = Width;
+				float largestArea = -1.f;
+				for (std::size_t i = 0; i < childCount; i++)
+				{
+					const float area = nodes[children[i]].GetBounds().SurfaceArea();
+					if (!nodes[children[i]].IsLeaf() && area > largestArea)
+					{
+						largest = i;
+						largestArea = area;
+					}
+				}
+
+				if (largest == Width)
+					break;
+
+				const std::uint32_t opened = children[largest];
+				children[largest] = nodes[opened].mLeftFirst;
+				children[childCount++] = nodes[opened].mLeftFirst + 1;
+			}
+
+			Node node{};
+			node.mChildCount = std::uint32_t(childCount);
+			for (std::size_t slot = 0; slot < Width; slot++)
+			{
+				// empty slots are masked by mChildCount, their boxes only need to be finite
+				if (slot >= childCount)
+					continue;
+
+				const FBVH::Node& child = nodes[children[slot]];
+				node.mMinX[slot] = child.mMin.X();
+				node.mMinY[slot] = child.mMin.Y();
+				node.mMinZ[slot] = child.mMin.Z();
+				node.mMaxX[slot] = child.mMax.X();
+				node.mMaxY[slot] = child.mMax.Y();
+				node.mMaxZ[slot] = child.mMax.Z();
+
+				if (child.IsLeaf())
+				{
+					node.mChild[slot] = child.mLeftFirst;
+					node.mCount[slot] = std::uint16_t(child.mCount);
+				}
+				else
+				{
+					node.mChild[slot] = std::uint32_t(this->mNodes.size());
+					this->mNodes.emplace_back();
+				}
+			}
+			this->mNodes[pNode] = node;
+
+			for (std::size_t slot = 0; slot < childCount; slot++)
+				if (!nodes[children[slot]].IsLeaf())
+					this->Collapse(pSource, children[slot], node.mChild[slot]);
+		}
+
+		template <typename Overlaps, typename Visit> void Query(Overlaps&& pOverlaps, Visit&& pVisit) const
+		{
+			if (this->mNodes.empty())
+				return;
+
+			std::uint32_t stack[mStackSize];
+			std::size_t size = 0;
+			stack[size++] = 0;
+
+			while (size != 0)
+			{
+				const Node& node = this->mNodes[stack[--size]];
+				const int bits = pOverlaps(node) & ((1 << node.mChildCount) - 1);
+				for (std::size_t slot = 0; slot < Width; slot++)
+				{
+					if ((bits >> slot & 1) == 0)
+						continue;
+
+					if (node.mCount[slot] == 0)
+						stack[size++] = node.mChild[slot];
+					else
+						for (std::uint32_t i = node.mChild[slot]; i < node.mChild[slot] + node.mCount[slot]; i++)
+							pVisit(this->mIndices[i]);
+				}
+			}
+		}
+
+		std::vector<Node> mNodes;
+		std::vector<std::uint32_t> mIndices;
+	};
+
+	typedef WideBVH<4> FBVH4;
+	typedef WideBVH<8> FBVH8;
+
+	/* -----
+	Bounds of pTriangleCount indexed triangles, the BVH input for a mesh. Positions are
+	pStride bytes apart as in Strided (VertexStream.h).
+	----- */
+	template <typename T> void TriangleBounds(const Vec3<T>* pPositions, const std::uint32_t* pIndices,
+		const std::size_t pTriangleCount, AABB<T>* pBounds, const std::size_t pStride = sizeof(Vec3<T>))
+	{
+		for (std::size_t i = 0; i < pTriangleCount; i++)
+		{
+			const Vec3<T>& a = Strided(pPositions, pIndices[3 * i], pStride);
+			pBounds[i] = AABB<T>(a, a).Merge(Strided(pPositions, pIndices[3 * i + 1], pStride)).
+				Merge(Strided(pPositions, pIndices[3 * i + 2], pStride));
+		}
+	}
+}
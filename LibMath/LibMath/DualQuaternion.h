@@ -0,0 +1,217 @@
+#pragma once
+#include <type_traits>
+#include <cmath>
+#include <cstddef>
+#include "Quaternion.h"
+
+namespace lm
+{
+	/* -----
+	Rigid transform as a dual quaternion: mReal is the rotation, mDual is
+	0.5 * translation * rotation. Like Quaternion, a * b applies b first then a.
+	Conjugate() is the inverse of a unit dual quaternion.
+	----- */
+
+	template <typename T> class DualQuaternion
+	{
+	public:
+		Quaternion<T> mReal;
+		Quaternion<T> mDual;
+
+		static const DualQuaternion<T> mIdentity;
+
+		constexpr DualQuaternion()
+			: mReal(), mDual()
+		{}
+
+		constexpr DualQuaternion(const Quaternion<T>& pReal, const Quaternion<T>& pDual)
+			: mReal(pReal), mDual(pDual)
+		{}
+
+		// rotates then translates, pRotation must be unit
+		constexpr DualQuaternion(const Quaternion<T>& pRotation, const Vec3<T>& pTranslation)
+			: mReal(pRotation),
+			mDual(Quaternion<T>(pTranslation.X() * T(0.5), pTranslation.Y() * T(0.5), pTranslation.Z() * T(0.5), 0) * pRotation)
+		{}
+
+		/* Rule of five */
+		DualQuaternion(const DualQuaternion<T>& pOther) = default;
+		DualQuaternion(DualQuaternion<T>&& pOther) noexcept = default;
+		DualQuaternion<T>& operator=(const DualQuaternion<T>& pOther) = default;
+		DualQuaternion<T>& operator=(DualQuaternion<T>&& pOther) noexcept = default;
+
+		/**/
+
+		constexpr DualQuaternion<T> operator+(const DualQuaternion<T>& pOther) const
+		{
+			return DualQuaternion<T>(this->mReal + pOther.mReal, this->mDual + pOther.mDual);
+		}
+
+		constexpr DualQuaternion<T> operator*(const T pScale) const
+		{
+			return DualQuaternion<T>(this->mReal * pScale, this->mDual * pScale);
+		}
+
+		constexpr DualQuaternion<T> operator*(const DualQuaternion<T>& pOther) const
+		{
+			return DualQuaternion<T>(this->mReal * pOther.mReal,
+				this->mReal * pOther.mDual + this->mDual * pOther.mReal);
+		}
+
+		constexpr void operator*=(const DualQuaternion<T>& pOther)
+		{
+			*this = *this * pOther;
+		}
+
+		// exact, component-wise: q and -q are the same transform but compare different
+		constexpr bool operator==(const DualQuaternion<T>& pOther) const
+		{
+			return this->mReal == pOther.mReal && this->mDual == pOther.mDual;
+		}
+
+		constexpr bool operator!=(const DualQuaternion<T>& pOther) const
+		{
+			return !(*this == pOther);
+		}
+
+		constexpr bool ApproxEqual(const DualQuaternion<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
+		{
+			return this->mReal.ApproxEqual(pOther.mReal, pAbsEps, pRelEps) &&
+				this->mDual.ApproxEqual(pOther.mDual, pAbsEps, pRelEps);
+		}
+
+		constexpr DualQuaternion<T> Conjugate() const
+		{
+			return DualQuaternion<T>(this->mReal.Conjugate(), this->mDual.Conjugate());
+		}
+
+		// unit real part, dual part made orthogonal to it so the result is a rigid transform
+		DualQuaternion<T> Normalize() const
+		{
+			const T invLength = T(1) / this->mReal.Length();
+			const Quaternion<T> real = this->mReal * invLength;
+			const Quaternion<T> dual = this->mDual * invLength;
+
+			return DualQuaternion<T>(real, dual - real * real.DotProduct(dual));
+		}
+
+		void NormalizeSelf()
+		{
+			*this = this->Normalize();
+		}
+
+		constexpr Quaternion<T> GetRotation() const
+		{
+			return this->mReal;
+		}
+
+		// 2 * dual * conjugate(real), vector part
+		constexpr Vec3<T> GetTranslation() const
+		{
+			const Vec3<T> real(this->mReal.mX, this->mReal.mY, this->mReal.mZ);
+			const Vec3<T> dual(this->mDual.mX, this->mDual.mY, this->mDual.mZ);
+
+			return (dual * this->mReal.mW - real * this->mDual.mW + real.CrossProduct(dual)) * T(2);
+		}
+
+		constexpr Vec3<T> TransformDirection(const Vec3<T>& pDirection) const
+		{
+			const Vec3<T> real(this->mReal.mX, this->mReal.mY, this->mReal.mZ);
+
+			return pDirection + real.CrossProduct(real.CrossProduct(pDirection) + pDirection * this->mReal.mW) * T(2);
+		}
+
+		constexpr Vec3<T> TransformPoint(const Vec3<T>& pPoint) const
+		{
+			return this->TransformDirection(pPoint) + this->GetTranslation();
+		}
+
+		Mat4<T> ToMat4() const
+		{
+			Mat4<T> result = this->mReal.ToMat4();
+
+			const Vec3<T> translation = this->GetTranslation();
+			result[3][0] = translation.X();
+			result[3][1] = translation.Y();
+			result[3][2] = translation.Z();
+			return result;
+		}
+
+		/* -----
+		Screw linear interpolation: constant speed rotation around and translation along the
+		screw axis between two unit dual quaternions, takes the shortest path.
+		----- */
+		static DualQuaternion<T> Sclerp(const DualQuaternion<T>& pStart, const DualQuaternion<T>& pEnd, const T pAlpha)
+		{
+			DualQuaternion<T> difference = pStart.Conjugate() * pEnd;
+			if (difference.mReal.mW < 0)
+				difference = difference * T(-1);
+
+			const Vec3<T> real(difference.mReal.mX, difference.mReal.mY, difference.mReal.mZ);
+			const Vec3<T> dual(difference.mDual.mX, difference.mDual.mY, difference.mDual.mZ);
+
+			const T sinHalf = std::sqrt(real.Length2());
+			if (sinHalf < T(1e-6))
+			{
+				// pure translation, the screw axis is undefined
+				return pStart * DualQuaternion<T>(Quaternion<T>(0, 0, 0, 1),
+					Quaternion<T>(dual.X() * pAlpha, dual.Y() * pAlpha, dual.Z() * pAlpha, 0));
+			}
+
+			// screw parameters: angle, pitch, direction and moment of the axis
+			const T angle = 2 * std::atan2(sinHalf, difference.mReal.mW);
+			const T pitch = -2 * difference.mDual.mW / sinHalf;
+			const Vec3<T> direction = real * (T(1) / sinHalf);
+			const Vec3<T> moment = (dual - direction * (pitch * T(0.5) * difference.mReal.mW)) * (T(1) / sinHalf);
+
+			const T halfAngle = angle * pAlpha * T(0.5);
+			const T halfPitch = pitch * pAlpha * T(0.5);
+			const T sinAlpha = std::sin(halfAngle);
+			const T cosAlpha = std::cos(halfAngle);
+
+			const Vec3<T> realAlpha = direction * sinAlpha;
+			const Vec3<T> dualAlpha = moment * sinAlpha + direction * (halfPitch * cosAlpha);
+
+			return pStart * DualQuaternion<T>(Quaternion<T>(realAlpha.X(), realAlpha.Y(), realAlpha.Z(), cosAlpha),
+				Quaternion<T>(dualAlpha.X(), dualAlpha.Y(), dualAlpha.Z(), -halfPitch * sinAlpha));
+		}
+
+		/* -----
+		Dual quaternion linear blending (Kavan et al.): weighted sum with every input flipped
+		into the hemisphere of the first one with a non zero weight, then normalized. No
+		candy-wrapper collapse when two bones twist in opposite directions. All weights 0 give
+		the identity rather than dividing by a zero length.
+		----- */
+		static DualQuaternion<T> Blend(const DualQuaternion<T>* pDualQuats, const T* pWeights, const std::size_t pCount)
+		{
+			std::size_t pivot = 0;
+			while (pivot + 1 < pCount && pWeights[pivot] == 0)
+				pivot++;
+
+			DualQuaternion<T> result;
+			for (std::size_t i = 0; i < pCount; i++)
+			{
+				const T sign = pDualQuats[pivot].mReal.DotProduct(pDualQuats[i].mReal) < 0 ? T(-1) : T(1);
+				result = result + pDualQuats[i] * (pWeights[i] * sign);
+			}
+
+			if (result.mReal.DotProduct(result.mReal) == 0)
+				return mIdentity;
+
+			return result.Normalize();
+		}
+	};
+
+	template<class T> constexpr DualQuaternion<T> DualQuaternion<T>::mIdentity =
+		DualQuaternion<T>(Quaternion<T>(0, 0, 0, 1), Quaternion<T>(0, 0, 0, 0));
+
+	typedef DualQuaternion<float> FDualQuat;
+	typedef DualQuaternion<double> DDualQuat;
+
+	static_assert(sizeof(FDualQuat) == 8 * sizeof(float), "FDualQuat must map onto eight packed floats");
+	static_assert(std::is_trivially_copyable_v<FDualQuat> && std::is_standard_layout_v<FDualQuat>,
+		"FDualQuat must be trivially copyable and standard layout");
+	static_assert(std::is_trivially_copyable_v<DDualQuat> && std::is_standard_layout_v<DDualQuat>,
+		"DDualQuat must be trivially copyable and standard layout");
+}
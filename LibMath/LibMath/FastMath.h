@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "Simd.h"
+#include "Utilities.h"
+
+namespace lm
+{
+	namespace Utilities
+	{
+		/* -----
+		Fast math, scalar and Float4/Float8 forms share the same polynomials and bounds.
+		SinCos		|error| <= 1e-7 for |angle| <= 8192 rad, quadrant reduction with a 3 part pi/2
+		FastRsqrt	relative error <= 5e-7, estimate refined by Newton steps
+		FastAcos	|error| <= 7e-5 rad on [-1, 1], input is clamped
+		FastAtan2	|error| <= 2e-6 rad, FastAtan2(0, 0) is 0
+
+		The rotation builders and Normalize() take FastMath as an extra argument to use them.
+		----- */
+
+		struct FastMathTag {};
+		inline constexpr FastMathTag FastMath{};
+
+		namespace Detail
+		{
+			// Cody-Waite split of pi/2, the first two parts have few enough bits to multiply exactly
+			constexpr float mHalfPi0 = 1.5703125f;
+			constexpr float mHalfPi1 = 4.837512969970703125e-4f;
+			constexpr float mHalfPi2 = 7.54978995489188216e-8f;
+			constexpr float mTwoOverPi = 0.636619772367581343f;
+
+			// minimax on [-pi/4, pi/4]
+			template <typename T> T SinPoly(const T& pX, const T& pX2)
+			{
+				return ((T(-1.9515295891e-4f) * pX2 + T(8.3321608736e-3f)) * pX2 + T(-1.6666654611e-1f)) * pX2 * pX + pX;
+			}
+
+			template <typename T> T CosPoly(const T& pX2)
+			{
+				return ((T(2.443315711809948e-5f) * pX2 + T(-1.388731625493765e-3f)) * pX2 + T(4.166664568298827e-2f)) * pX2 * pX2
+					- T(0.5f) * pX2 + T(1.f);
+			}
+
+			// atan on [0, 1]
+			template <typename T> T AtanPoly(const T& pX)
+			{
+				const T x2 = pX * pX;
+				T poly = T(-0.0117212f);
+				poly = poly * x2 + T(0.05265332f);
+				poly = poly * x2 + T(-0.11643287f);
+				poly = poly * x2 + T(0.19354346f);
+				poly = poly * x2 + T(-0.33262347f);
+				poly = poly * x2 + T(0.99997726f);
+				return poly * pX;
+			}
+
+			// wraps Splat so the polynomials above read the same for packs and floats
+			template <typename P> struct Splatted : P
+			{
+				Splatted(const P& pValue) : P(pValue) {}
+				Splatted(const float pValue) : P(P::Splat(pValue)) {}
+			};
+
+			template <typename P> void SinCos(const P& pAngle, P& pSin, P& pCos)
+			{
+				using S = Splatted<P>;
+
+				// round to nearest: adding 1.5 * 2^23 drops the fraction, exact below 2^22,
+				// -ffast-math or /fp:fast may fold it away
+				const P round = P::Splat(12582912.f);
+				const P quadrant = (pAngle * P::Splat(mTwoOverPi) + round) - round;
+
+				P x = pAngle - quadrant * P::Splat(mHalfPi0);
+				x = x - quadrant * P::Splat(mHalfPi1);
+				x = x - quadrant * P::Splat(mHalfPi2);
+
+				const S sx = x;
+				const S x2 = x * x;
+				const P sin = SinPoly<S>(sx, x2);
+				const P cos = CosPoly<S>(x2);
+
+				// quadrant modulo 4, the rounded values are never halfway
+				const P quarter = (quadrant * P::Splat(0.25f) - P::Splat(0.375f) + round) - round;
+				const P mod = quadrant - quarter * P::Splat(4.f);
+
+				const auto odd = (mod == P::Splat(1.f)) | (mod == P::Splat(3.f));
+				const auto sinNegative = P::Splat(1.5f) < mod;
+				const auto cosNegative = (mod == P::Splat(1.f)) | (mod == P::Splat(2.f));
+
+				pSin = Simd::Select(odd, cos, sin);
+				pCos = Simd::Select(odd, sin, cos);
+				pSin = Simd::Select(sinNegative, -pSin, pSin);
+				pCos = Simd::Select(cosNegative, -pCos, pCos);
+			}
+
+			template <typename P> P FastRsqrt(const P& pValue)
+			{
+				const P estimate = Simd::RsqrtEstimate(pValue);
+				return estimate * (P::Splat(1.5f) - P::Splat(0.5f) * pValue * estimate * estimate);
+			}
+
+			template <typename P> P FastAcos(const P& pValue)
+			{
+				const P x = Simd::Min(Simd::Abs(pValue), P::Splat(1.f));
+				const P result = Simd::AcosUnitFast(x);
+				return Simd::Select(pValue < P::Splat(0.f), P::Splat(float(M_PI)) - result, result);
+			}
+
+			template <typename P> P FastAtan2(const P& pY, const P& pX)
+			{
+				const P absX = Simd::Abs(pX);
+				const P absY = Simd::Abs(pY);
+				const P upper = Simd::Max(absX, absY);
+				const P lower = Simd::Min(absX, absY);
+
+				const P zero = P::Splat(0.f);
+				const P ratio = lower / Simd::Select(upper == zero, P::Splat(1.f), upper);
+
+				P result = AtanPoly<Splatted<P>>(ratio);
+				result = Simd::Select(absX < absY, P::Splat(float(M_PI / 2)) - result, result);
+				result = Simd::Select(pX < zero, P::Splat(float(M_PI)) - result, result);
+				return Simd::Select(pY < zero, -result, result);
+			}
+		}
+
+		/* ----- Scalar ----- */
+
+		inline void SinCos(const float pAngle, float& pSin, float& pCos)
+		{
+			const float scaled = pAngle * Detail::mTwoOverPi;
+			const int quadrant = int(scaled + (scaled < 0.f ? -0.5f : 0.5f));
+			const float q = float(quadrant);
+
+			float x = pAngle - q * Detail::mHalfPi0;
+			x = x - q * Detail::mHalfPi1;
+			x = x - q * Detail::mHalfPi2;
+
+			const float x2 = x * x;
+			const float sin = Detail::SinPoly(x, x2);
+			const float cos = Detail::CosPoly(x2);
+
+			// quadrant & 3 picks the octant swap and the signs, also right for negative quadrants
+			const bool swap = (quadrant & 1) != 0;
+			const float swappedSin = swap ? cos : sin;
+			const float swappedCos = swap ? sin : cos;
+			pSin = (quadrant & 2) ? -swappedSin : swappedSin;
+			pCos = ((quadrant + 1) & 2) ? -swappedCos : swappedCos;
+		}
+
+		inline void SinCos(const double pAngle, double& pSin, double& pCos)
+		{
+			pSin = std::sin(pAngle);
+			pCos = std::cos(pAngle);
+		}
+
+		inline float FastRsqrt(const float pValue)
+		{
+#if defined(LIBMATH_SSE)
+			const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(pValue)));
+			return estimate * (1.5f - 0.5f * pValue * estimate * estimate);
+#else
+			// bit level estimate, ~3.4% off, three steps to reach the SSE bound
+			std::uint32_t bits;
+			std::memcpy(&bits, &pValue, sizeof(bits));
+			bits = 0x5F375A86u - (bits >> 1);
+
+			float estimate;
+			std::memcpy(&estimate, &bits, sizeof(estimate));
+			for (int i = 0; i < 3; i++)
+				estimate = estimate * (1.5f - 0.5f * pValue * estimate * estimate);
+			return estimate;
+#endif
+		}
+
+		inline double FastRsqrt(const double pValue)
+		{
+			return 1.0 / std::sqrt(pValue);
+		}
+
+		inline float FastAcos(const float pValue)
+		{
+			const float x = std::min(Abs(pValue), 1.f);
+
+			float poly = -0.0187293f;
+			poly = poly * x + 0.0742610f;
+			poly = poly * x - 0.2121144f;
+			poly = poly * x + 1.5707288f;
+
+			const float result = std::sqrt(1.f - x) * poly;
+			return pValue < 0.f ? float(M_PI) - result : result;
+		}
+
+		inline float FastAtan2(const float pY, const float pX)
+		{
+			const float absX = Abs(pX);
+			const float absY = Abs(pY);
+			const float upper = std::max(absX, absY);
+			if (upper == 0.f)
+				return 0.f;
+
+			float result = Detail::AtanPoly(std::min(absX, absY) / upper);
+			if (absX < absY)
+				result = float(M_PI / 2) - result;
+			if (pX < 0.f)
+				result = float(M_PI) - result;
+			return pY < 0.f ? -result : result;
+		}
+
+		/* ----- Float4 / Float8 ----- */
+
+		inline void SinCos(const Simd::Float4& pAngle, Simd::Float4& pSin, Simd::Float4& pCos)
+		{
+			Detail::SinCos(pAngle, pSin, pCos);
+		}
+
+		inline void SinCos(const Simd::Float8& pAngle, Simd::Float8& pSin, Simd::Float8& pCos)
+		{
+			Detail::SinCos(pAngle, pSin, pCos);
+		}
+
+		inline Simd::Float4 FastRsqrt(const Simd::Float4& pValue)
+		{
+			return Detail::FastRsqrt(pValue);
+		}
+
+		inline Simd::Float8 FastRsqrt(const Simd::Float8& pValue)
+		{
+			return Detail::FastRsqrt(pValue);
+		}
+
+		inline Simd::Float4 FastAcos(const Simd::Float4& pValue)
+		{
+			return Detail::FastAcos(pValue);
+		}
+
+		inline Simd::Float8 FastAcos(const Simd::Float8& pValue)
+		{
+			return Detail::FastAcos(pValue);
+		}
+
+		inline Simd::Float4 FastAtan2(const Simd::Float4& pY, const Simd::Float4& pX)
+		{
+			return Detail::FastAtan2(pY, pX);
+		}
+
+		inline Simd::Float8 FastAtan2(const Simd::Float8& pY, const Simd::Float8& pX)
+		{
+			return Detail::FastAtan2(pY, pX);
+		}
+	}
+}
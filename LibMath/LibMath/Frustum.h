@@ -0,0 +1,222 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "Mat4.h"
+#include "Plane.h"
+#include "Simd.h"
+#include "Vec3SoA.h"
+
+namespace lm
+{
+	// depth range of the clip space: CreateFrustum is MinusOneToOne, CreateFrustumDirect ZeroToOne
+	enum class ClipDepth
+	{
+		MinusOneToOne, ZeroToOne
+	};
+
+	/* -----
+	Six inward facing, normalized planes. Bounds touching the frustum count as visible, so a
+	bound may be kept while lying outside near a corner (conservative, never a false cull).
+	----- */
+
+	template <typename T> class Frustum
+	{
+	public:
+		enum Side
+		{
+			Left, Right, Bottom, Top, Near, Far, SideCount
+		};
+
+		Plane<T> mPlanes[SideCount];
+
+		constexpr Frustum() = default;
+
+		/* -----
+		Gribb-Hartmann extraction: with row vectors clip = v * M, so each plane is the sum or
+		difference of the fourth column and another column of M. A projection alone gives
+		view-space planes, view * projection world-space ones.
+		----- */
+		explicit Frustum(const Mat4<T>& pViewProjection, const ClipDepth pDepth = ClipDepth::MinusOneToOne)
+		{
+			const auto column = [&pViewProjection](const int pColumn)
+			{
+				return Plane<T>(Vec3<T>(pViewProjection[0][pColumn], pViewProjection[1][pColumn], pViewProjection[2][pColumn]),
+					pViewProjection[3][pColumn]);
+			};
+			const auto add = [](const Plane<T>& pA, const Plane<T>& pB)
+			{
+				return Plane<T>(pA.mNormal + pB.mNormal, pA.mDistance + pB.mDistance);
+			};
+			const auto subtract = [](const Plane<T>& pA, const Plane<T>& pB)
+			{
+				return Plane<T>(pA.mNormal - pB.mNormal, pA.mDistance - pB.mDistance);
+			};
+
+			const Plane<T> w = column(3);
+			this->mPlanes[Left] = add(w, column(0));
+			this->mPlanes[Right] = subtract(w, column(0));
+			this->mPlanes[Bottom] = add(w, column(1));
+			this->mPlanes[Top] = subtract(w, column(1));
+			this->mPlanes[Near] = pDepth == ClipDepth::ZeroToOne ? column(2) : add(w, column(2));
+			this->mPlanes[Far] = subtract(w, column(2));
+
+			for (Plane<T>& plane : this->mPlanes)
+				plane.NormalizeSelf();
+		}
+
+		bool ContainsPoint(const Vec3<T>& pPoint) const
+		{
+			for (const Plane<T>& plane : this->mPlanes)
+				if (plane.SignedDistance(pPoint) < 0)
+					return false;
+
+			return true;
+		}
+
+		bool IntersectsSphere(const Vec3<T>& pCenter, const T pRadius) const
+		{
+			for (const Plane<T>& plane : this->mPlanes)
+				if (plane.SignedDistance(pCenter) < -pRadius)
+					return false;
+
+			return true;
+		}
+
+		// box given by its center and half extents, projected on each plane normal
+		bool IntersectsBox(const Vec3<T>& pCenter, const Vec3<T>& pExtents) const
+		{
+			for (const Plane<T>& plane : this->mPlanes)
+			{
+				const T radius = std::abs(plane.mNormal.X()) * pExtents.X() + std::abs(plane.mNormal.Y()) * pExtents.Y() +
+					std::abs(plane.mNormal.Z()) * pExtents.Z();
+				if (plane.SignedDistance(pCenter) < -radius)
+					return false;
+			}
+
+			return true;
+		}
+
+		/* -----
+		Batched tests: bit i % 64 of pVisible[i / 64] is set when bound i is visible, pVisible
+		must hold (count + 63) / 64 words and the unused bits of the last word are cleared.
+		Floats run 8 bounds per step against the six planes without branching.
+		----- */
+
+		void CullSpheres(const Vec3SoA<T>& pCenters, const T* pRadii, std::uint64_t* pVisible) const
+		{
+			const T* x = pCenters.X();
+			const T* y = pCenters.Y();
+			const T* z = pCenters.Z();
+
+			this->CullWords(pCenters.Size(), pVisible,
+				[&](const auto& pPlanes, const std::size_t i)
+				{
+					using P = std::decay_t<decltype(pPlanes[0].mX)>;
+					const P cx = P::Load(x + i);
+					const P cy = P::Load(y + i);
+					const P cz = P::Load(z + i);
+					const P negRadius = P::Splat(0) - P::Load(pRadii + i);
+
+					auto visible = pPlanes[0].Distance(cx, cy, cz) >= negRadius;
+					for (int side = 1; side < SideCount; side++)
+						visible = visible & (pPlanes[side].Distance(cx, cy, cz) >= negRadius);
+					return visible.Bits();
+				},
+				[&](const std::size_t i)
+				{
+					return this->IntersectsSphere(Vec3<T>(x[i], y[i], z[i]), pRadii[i]);
+				});
+		}
+
+		void CullBoxes(const Vec3SoA<T>& pCenters, const Vec3SoA<T>& pExtents, std::uint64_t* pVisible) const
+		{
+			const T* x = pCenters.X();
+			const T* y = pCenters.Y();
+			const T* z = pCenters.Z();
+			const T* ex = pExtents.X();
+			const T* ey = pExtents.Y();
+			const T* ez = pExtents.Z();
+
+			this->CullWords(pCenters.Size(), pVisible,
+				[&](const auto& pPlanes, const std::size_t i)
+				{
+					using P = std::decay_t<decltype(pPlanes[0].mX)>;
+					const P cx = P::Load(x + i);
+					const P cy = P::Load(y + i);
+					const P cz = P::Load(z + i);
+					const P extentX = P::Load(ex + i);
+					const P extentY = P::Load(ey + i);
+					const P extentZ = P::Load(ez + i);
+
+					auto visible = pPlanes[0].Distance(cx, cy, cz) >= P::Splat(0) - pPlanes[0].Radius(extentX, extentY, extentZ);
+					for (int side = 1; side < SideCount; side++)
+						visible = visible &
+							(pPlanes[side].Distance(cx, cy, cz) >= P::Splat(0) - pPlanes[side].Radius(extentX, extentY, extentZ));
+					return visible.Bits();
+				},
+				[&](const std::size_t i)
+				{
+					return this->IntersectsBox(Vec3<T>(x[i], y[i], z[i]), Vec3<T>(ex[i], ey[i], ez[i]));
+				});
+		}
+
+	private:
+		// one plane splatted over a pack, with the absolute normal for the box radius
+		template <typename P> struct PackedPlane
+		{
+			P mX, mY, mZ, mDistance;
+			P mAbsX, mAbsY, mAbsZ;
+
+			P Distance(const P& pX, const P& pY, const P& pZ) const
+			{
+				return this->mX * pX + this->mY * pY + this->mZ * pZ + this->mDistance;
+			}
+
+			P Radius(const P& pX, const P& pY, const P& pZ) const
+			{
+				return this->mAbsX * pX + this->mAbsY * pY + this->mAbsZ * pZ;
+			}
+		};
+
+		template <typename PackTest, typename ScalarTest>
+		void CullWords(const std::size_t pCount, std::uint64_t* pVisible, PackTest&& pPackTest, ScalarTest&& pScalarTest) const
+		{
+			using Simd::Float8;
+
+			PackedPlane<Float8> planes[SideCount];
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				for (int side = 0; side < SideCount; side++)
+				{
+					const Plane<T>& plane = this->mPlanes[side];
+					planes[side] = { Float8::Splat(plane.mNormal.X()), Float8::Splat(plane.mNormal.Y()),
+						Float8::Splat(plane.mNormal.Z()), Float8::Splat(plane.mDistance),
+						Float8::Splat(std::abs(plane.mNormal.X())), Float8::Splat(std::abs(plane.mNormal.Y())),
+						Float8::Splat(std::abs(plane.mNormal.Z())) };
+				}
+			}
+
+			for (std::size_t begin = 0; begin < pCount; begin += 64)
+			{
+				const std::size_t end = std::min<std::size_t>(begin + 64, pCount);
+
+				std::uint64_t bits = 0;
+				std::size_t i = begin;
+				if constexpr (Simd::IsAccelerated<T>)
+				{
+					for (; i + Float8::Width <= end; i += Float8::Width)
+						bits |= std::uint64_t(pPackTest(planes, i)) << (i - begin);
+				}
+				for (; i < end; i++)
+					bits |= std::uint64_t(pScalarTest(i) ? 1 : 0) << (i - begin);
+
+				pVisible[begin / 64] = bits;
+			}
+		}
+	};
+
+	typedef Frustum<float> FFrustum;
+	typedef Frustum<double> DFrustum;
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Mat4.h"
+#include "Parallel.h"
+#include "Transform.h"
+
+namespace lm
+{
+	/* -----
+	Flat transform hierarchy stored in depth-first order: a node is added after its parent and
+	every node of a subtree is contiguous, [pNode, GetSubtreeEnd(pNode)). Update walks the
+	arrays once, a world matrix is recomputed only when its local transform or an ancestor
+	changed, and a subtree without any change is skipped in a single jump. Worlds are
+	local.ToMat4() * parent world (row-vector convention), so non-uniform scales stay exact.
+	----- */
+
+	template <typename T> class Hierarchy
+	{
+	public:
+		static constexpr std::size_t mNoParent = std::numeric_limits<std::size_t>::max();
+
+		Hierarchy() = default;
+
+		/* Rule of five */
+		Hierarchy(const Hierarchy<T>& pOther) = default;
+		Hierarchy(Hierarchy<T>&& pOther) noexcept = default;
+		Hierarchy<T>& operator=(const Hierarchy<T>& pOther) = default;
+		Hierarchy<T>& operator=(Hierarchy<T>&& pOther) noexcept = default;
+
+		/**/
+
+		/* -----
+		Appends a node and returns its index. pParent is mNoParent or an ancestor-or-self of the
+		last added node, which keeps the depth-first order (asserted in debug builds).
+		----- */
+		std::size_t AddNode(const Transform<T>& pLocal, const std::size_t pParent = mNoParent)
+		{
+			const std::size_t node = this->mParents.size();
+			assert((pParent == mNoParent || (pParent < node && this->mSubtreeEnds[pParent] == node)) &&
+				"Hierarchy nodes must be added in depth-first order");
+
+			this->mParents.push_back(pParent);
+			this->mSubtreeEnds.push_back(node + 1);
+			this->mLocals.push_back(pLocal);
+			this->mWorlds.push_back(Mat4<T>::mIdentity);
+			this->mDirty.push_back(1);
+			this->mDirtyBelow.push_back(0);
+			this->mWorldVersions.push_back(0);
+
+			for (std::size_t ancestor = pParent; ancestor != mNoParent; ancestor = this->mParents[ancestor])
+			{
+				this->mSubtreeEnds[ancestor] = node + 1;
+				this->mDirtyBelow[ancestor] = 1;
+			}
+
+			return node;
+		}
+
+		void Reserve(const std::size_t pCount)
+		{
+			this->mParents.reserve(pCount);
+			this->mSubtreeEnds.reserve(pCount);
+			this->mLocals.reserve(pCount);
+			this->mWorlds.reserve(pCount);
+			this->mDirty.reserve(pCount);
+			this->mDirtyBelow.reserve(pCount);
+			this->mWorldVersions.reserve(pCount);
+		}
+
+		void SetLocal(const std::size_t pNode, const Transform<T>& pLocal)
+		{
+			this->mLocals[pNode] = pLocal;
+			this->mDirty[pNode] = 1;
+
+			// stops at the first ancestor already flagged, its own ancestors are flagged too
+			for (std::size_t ancestor = this->mParents[pNode]; ancestor != mNoParent && this->mDirtyBelow[ancestor] == 0;
+				ancestor = this->mParents[ancestor])
+				this->mDirtyBelow[ancestor] = 1;
+		}
+
+		std::size_t Size() const
+		{
+			return this->mParents.size();
+		}
+
+		std::size_t GetParent(const std::size_t pNode) const
+		{
+			return this->mParents[pNode];
+		}
+
+		std::size_t GetSubtreeEnd(const std::size_t pNode) const
+		{
+			return this->mSubtreeEnds[pNode];
+		}
+
+		const Transform<T>& GetLocal(const std::size_t pNode) const
+		{
+			return this->mLocals[pNode];
+		}
+
+		const Mat4<T>& GetWorld(const std::size_t pNode) const
+		{
+			return this->mWorlds[pNode];
+		}
+
+		// every world matrix in node order, ready for upload
+		const Mat4<T>* GetWorlds() const
+		{
+			return this->mWorlds.data();
+		}
+
+		// true when the last Update recomputed the world matrix of pNode
+		bool WorldChanged(const std::size_t pNode) const
+		{
+			return this->mWorldVersions[pNode] == this->mVersion;
+		}
+
+		/* -----
+		Brings every world matrix up to date. Sibling subtrees are independent: the nodes above
+		them are updated here, then the subtrees are grouped into contiguous ranges of about the
+		same size and run on separate threads, as described in Parallel.h.
+		----- */
+		void Update(const unsigned int pThreadCount = 0)
+		{
+			this->mVersion++;
+
+			const std::size_t count = this->Size();
+			const unsigned int threadCount = Parallel::ThreadCount(pThreadCount);
+			if (threadCount == 1 || count < 2 * Parallel::mMinElementsPerThread)
+			{
+				this->UpdateRange(0, count);
+				return;
+			}
+
+			std::vector<std::size_t> subtrees;
+			for (std::size_t node = 0; node < count; node = this->mSubtreeEnds[node])
+				subtrees.push_back(node);
+
+			// a lone root above everything is updated here and its children split instead
+			while (subtrees.size() == 1)
+			{
+				const std::size_t root = subtrees.front();
+				if (!this->UpdateNode(root) && this->mDirtyBelow[root] == 0)
+					return;
+
+				this->mDirtyBelow[root] = 0;
+				subtrees.clear();
+				for (std::size_t node = root + 1; node < this->mSubtreeEnds[root]; node = this->mSubtreeEnds[node])
+					subtrees.push_back(node);
+			}
+
+			if (subtrees.empty())
+				return;
+
+			const std::size_t begin = subtrees.front();
+			const std::size_t end = this->mSubtreeEnds[subtrees.back()];
+			const std::size_t target = std::max((end - begin) / threadCount, Parallel::mMinElementsPerThread);
+
+			// consecutive sibling subtrees are consecutive nodes, a group is one node range
+			std::vector<std::pair<std::size_t, std::size_t>> groups;
+			for (const std::size_t subtree : subtrees)
+			{
+				if (groups.empty() || groups.back().second - groups.back().first >= target)
+					groups.emplace_back(subtree, subtree);
+				groups.back().second = this->mSubtreeEnds[subtree];
+			}
+
+			Parallel::ForRanges(groups.size(), 1, threadCount,
+				[this, &groups](const std::size_t pBegin, const std::size_t pEnd)
+				{
+					for (std::size_t group = pBegin; group < pEnd; group++)
+						this->UpdateRange(groups[group].first, groups[group].second);
+				});
+		}
+
+	private:
+		// recomputes the world of pNode if it or an ancestor changed, the parent is already up to date
+		bool UpdateNode(const std::size_t pNode)
+		{
+			const std::size_t parent = this->mParents[pNode];
+			const bool parentChanged = parent != mNoParent && this->mWorldVersions[parent] == this->mVersion;
+			if (this->mDirty[pNode] == 0 && !parentChanged)
+				return false;
+
+			this->mWorlds[pNode] = parent == mNoParent ? this->mLocals[pNode].ToMat4() :
+				this->mLocals[pNode].ToMat4() * this->mWorlds[parent];
+			this->mDirty[pNode] = 0;
+			this->mWorldVersions[pNode] = this->mVersion;
+			return true;
+		}
+
+		// [pBegin, pEnd) holds whole subtrees whose ancestors are up to date
+		void UpdateRange(const std::size_t pBegin, const std::size_t pEnd)
+		{
+			for (std::size_t node = pBegin; node < pEnd;)
+			{
+				if (this->UpdateNode(node) || this->mDirtyBelow[node] != 0)
+				{
+					this->mDirtyBelow[node] = 0;
+					node++;
+				}
+				else
+					node = this->mSubtreeEnds[node];
+			}
+		}
+
+		std::vector<std::size_t> mParents;
+		std::vector<std::size_t> mSubtreeEnds;
+		std::vector<Transform<T>> mLocals;
+		std::vector<Mat4<T>> mWorlds;
+
+		// bytes rather than vector<bool>: threads write flags of neighbouring nodes
+		std::vector<std::uint8_t> mDirty;
+		std::vector<std::uint8_t> mDirtyBelow;
+		// a node is added at version 0, below the first Update, so nothing reports a change before it
+		std::vector<std::uint32_t> mWorldVersions;
+		std::uint32_t mVersion = 1;
+	};
+
+	typedef Hierarchy<float> FHierarchy;
+	typedef Hierarchy<double> DHierarchy;
+}
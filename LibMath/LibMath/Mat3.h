@@ -1,4 +1,5 @@
 #pragma once
+#include <type_traits>
 
 #include "Vec3.h"
 
@@ -12,93 +13,43 @@ namespace lm
 	public:
 		static const Mat3<T> mIdentity;
 
-		Mat3()
-		{
-			this->mMatrix[0] = Vec3<T>(0, 0, 0);
-			this->mMatrix[1] = Vec3<T>(0, 0, 0);
-			this->mMatrix[2] = Vec3<T>(0, 0, 0);
-		}
+		constexpr Mat3()
+			: mMatrix{ Vec3<T>(0, 0, 0), Vec3<T>(0, 0, 0), Vec3<T>(0, 0, 0) }
+		{}
 
-		Mat3(const T pInit)
-		{
-			this->mMatrix[0] = Vec3<T>(pInit, 0, 0);
-			this->mMatrix[1] = Vec3<T>(0, pInit, 0);
-			this->mMatrix[2] = Vec3<T>(0, 0, pInit);
-		}
+		constexpr Mat3(const T pInit)
+			: mMatrix{ Vec3<T>(pInit, 0, 0), Vec3<T>(0, pInit, 0), Vec3<T>(0, 0, pInit) }
+		{}
 
-		Mat3(const Vec3<T>& pVec1, const Vec3<T>& pVec2, const Vec3<T>& pVec3)
-		{
-			this->mMatrix[0] = pVec1;
-			this->mMatrix[1] = pVec2;
-			this->mMatrix[2] = pVec3;
-		}
+		constexpr Mat3(const Vec3<T>& pVec1, const Vec3<T>& pVec2, const Vec3<T>& pVec3)
+			: mMatrix{ pVec1, pVec2, pVec3 }
+		{}
 
-		Mat3(const T& p00, const T& p01, const T& p02,
+		constexpr Mat3(const T& p00, const T& p01, const T& p02,
 			const T& p10, const T& p11, const T& p12,
 			const T& p20, const T& p21, const T& p22)
-		{
-			mMatrix[0][0] = p00;
-			mMatrix[0][1] = p01;
-			mMatrix[0][2] = p02;
-			mMatrix[1][0] = p10;
-			mMatrix[1][1] = p11;
-			mMatrix[1][2] = p12;
-			mMatrix[2][0] = p20;
-			mMatrix[2][1] = p21;
-			mMatrix[2][2] = p22;
-		}
+			: mMatrix{ Vec3<T>(p00, p01, p02), Vec3<T>(p10, p11, p12), Vec3<T>(p20, p21, p22) }
+		{}
 
-		Mat3(const Mat3<T>& pOther)
-		{
-			for (unsigned int i = 0; i < 3; i++)
-				this->mMatrix[i] = pOther.mMatrix[i];
-		}
+		Mat3(const Mat3<T>& pOther) = default;
+		Mat3(Mat3<T>&& pOther) noexcept = default;
+		Mat3<T>& operator=(const Mat3<T>& pOther) = default;
+		Mat3<T>& operator=(Mat3<T>&& pOther) noexcept = default;
 
-		Mat3(Mat3<T>&& pOther) noexcept
+		// unchecked in release builds, asserts the row when NDEBUG is not defined
+		constexpr const Vec3<T>& operator[](const int pIdx) const
 		{
-			for (unsigned int i = 0; i < 3; i++)
-				this->mMatrix[i] = std::move(pOther.mMatrix[i]);
+			assert(pIdx >= 0 && pIdx < 3 && "Mat3 row out of range");
+			return this->mMatrix[pIdx];
 		}
 
-		Mat3<T>& operator=(const Mat3<T>& pOther)
+		constexpr Vec3<T>& operator[](const int pIdx)
 		{
-			if (this == &pOther)
-				return *this;
-
-			for (unsigned int i = 0; i < 3; i++)
-				this->mMatrix[i] = pOther.mMatrix[i];
-
-			return *this;
+			assert(pIdx >= 0 && pIdx < 3 && "Mat3 row out of range");
+			return this->mMatrix[pIdx];
 		}
 
-		Mat3<T>& operator=(Mat3<T>&& pOther) noexcept
-		{
-			if (this == &pOther)
-				return *this;
-
-			for (unsigned int i = 0; i < 3; i++)
-				this->mMatrix[i] = std::move(pOther.mMatrix[i]);
-
-			return *this;
-		}
-
-		const Vec3<T> operator[](int pIdx) const
-		{
-			if (pIdx >= 0 && pIdx < 3)
-				return mMatrix[pIdx];
-
-			return mMatrix[0];
-		}
-
-		Vec3<T>& operator[](int pIdx)
-		{
-			if (pIdx >= 0 && pIdx < 3)
-				return mMatrix[pIdx];
-
-			return mMatrix[0];
-		}
-
-		Mat3<T> Scale(const float pScale) const
+		constexpr Mat3<T> Scale(const float pScale) const
 		{
 			Mat3<T> mat3(*this);
 			mat3[0] *= pScale;
@@ -108,14 +59,14 @@ namespace lm
 			return mat3;
 		}
 
-		void ScaleSelf(const float pScale)
+		constexpr void ScaleSelf(const float pScale)
 		{
 			mMatrix[0] *= pScale;
 			mMatrix[1] *= pScale;
 			mMatrix[2] *= pScale;
 		}
 
-		Mat3<T> DotProduct(const Mat3<T>& pOther) const
+		constexpr Mat3<T> DotProduct(const Mat3<T>& pOther) const
 		{
 			Mat3<T> newMat3;
 
@@ -134,14 +85,14 @@ namespace lm
 			return newMat3;
 		}
 
-		Mat3<T> Transpose() const
+		constexpr Mat3<T> Transpose() const
 		{
 			return Mat3<T>(Vec3<T>(this->mMatrix[0].X(), this->mMatrix[1].X(), this->mMatrix[2].X()),
 				Vec3<T>(this->mMatrix[0].Y(), this->mMatrix[1].Y(), this->mMatrix[2].Y()),
 				Vec3<T>(this->mMatrix[0].Z(), this->mMatrix[1].Z(), this->mMatrix[2].Z()));
 		}
 
-		const T Determinant() const
+		constexpr const T Determinant() const
 		{
 			return ((this->mMatrix[0].X() * ((this->mMatrix[1].Y() * this->mMatrix[2].Z()) -
 				(this->mMatrix[1].Z() * this->mMatrix[2].Y()))) -
@@ -151,7 +102,7 @@ namespace lm
 					(this->mMatrix[1].Y() * this->mMatrix[2].X())));
 		}
 
-		Mat3<T> Minor() const
+		constexpr Mat3<T> Minor() const
 		{
 			Mat3<T> newMat3;
 			newMat3.mMatrix[0].X() = ((this->mMatrix[1].Y() * this->mMatrix[2].Z()) -
@@ -178,7 +129,7 @@ namespace lm
 			return newMat3;
 		}
 
-		Mat3<T> Cofactor() const
+		constexpr Mat3<T> Cofactor() const
 		{
 			Mat3<T> min = this->Minor();
 			min.mMatrix[0].Y() *= -1;
@@ -188,14 +139,14 @@ namespace lm
 			return min;
 		}
 
-		Mat3<T> Adjugate() const
+		constexpr Mat3<T> Adjugate() const
 		{
 			Mat3<T> cof = this->Cofactor();
 			cof = cof.Transpose();
 			return cof;
 		}
 
-		Mat3<T> Inverse() const
+		constexpr Mat3<T> Inverse() const
 		{
 			const T determinant = this->Determinant();
 			const T div = 1.0f / determinant;
@@ -206,32 +157,32 @@ namespace lm
 				Vec3<T>(mat3.mMatrix[2].X() * div, mat3.mMatrix[2].Y() * div, mat3.mMatrix[2].Z() * div));
 		}
 
-		bool IsIdentity() const
+		constexpr bool IsIdentity() const
 		{
 			return *this == mIdentity;
 		}
 
-		Mat3<T> operator*(const float pScale) const
+		constexpr Mat3<T> operator*(const float pScale) const
 		{
 			return this->Scale(pScale);
 		}
 
-		void operator*=(const float pScale)
+		constexpr void operator*=(const float pScale)
 		{
 			this->ScaleSelf(pScale);
 		}
 
-		Mat3<T> operator*(const Mat3<T>& pOther) const
+		constexpr Mat3<T> operator*(const Mat3<T>& pOther) const
 		{
 			return this->DotProduct(pOther);
 		}
 
-		void operator*=(const Mat3<T>& pOther)
+		constexpr void operator*=(const Mat3<T>& pOther)
 		{
 			*this = this->DotProduct(pOther);
 		}
 
-		Vec3<T> operator*(const Vec3<T>& pVec3)
+		constexpr Vec3<T> operator*(const Vec3<T>& pVec3)
 		{
 			Vec3<T> newVec3;
 			newVec3.X() = (this->mMatrix[0].X() * pVec3.X()) + (this->mMatrix[1].X() * pVec3.Y()) +
@@ -243,11 +194,9 @@ namespace lm
 			return newVec3;
 		}
 
-		const bool operator==(const Mat3<T>& pOther) const
+		// exact, component-wise
+		constexpr bool operator==(const Mat3<T>& pOther) const
 		{
-			if (this == &pOther)
-				return true;
-
 			for (unsigned int i = 0; i < 3; i++)
 				if (this->mMatrix[i] != pOther.mMatrix[i])
 					return false;
@@ -255,14 +204,39 @@ namespace lm
 			return true;
 		}
 
-		const bool operator!=(const Mat3<T>& pOther) const
+		constexpr bool operator!=(const Mat3<T>& pOther) const
 		{
 			return !(*this == pOther);
 		}
+
+		constexpr bool ApproxEqual(const Mat3<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
+		{
+			for (unsigned int i = 0; i < 3; i++)
+				if (!this->mMatrix[i].ApproxEqual(pOther.mMatrix[i], pAbsEps, pRelEps))
+					return false;
+
+			return true;
+		}
+
+		bool UlpEqual(const Mat3<T>& pOther, const unsigned int pMaxUlps = 4) const
+		{
+			for (unsigned int i = 0; i < 3; i++)
+				if (!this->mMatrix[i].UlpEqual(pOther.mMatrix[i], pMaxUlps))
+					return false;
+
+			return true;
+		}
 	};
 
-	template<class T> const Mat3<T> Mat3<T>::mIdentity = Mat3<T>(1);
+	template<class T> constexpr Mat3<T> Mat3<T>::mIdentity = Mat3<T>(1);
 
 	typedef Mat3<float> FMat3;
 	typedef Mat3<double> DMat3;
+
+	static_assert(sizeof(FMat3) == 9 * sizeof(float), "FMat3 rows must be contiguous");
+	static_assert(std::is_trivially_copyable_v<FMat3> && std::is_standard_layout_v<FMat3>,
+		"FMat3 must be trivially copyable and standard layout");
+	static_assert(std::is_trivially_copyable_v<DMat3> && std::is_standard_layout_v<DMat3>,
+		"DMat3 must be trivially copyable and standard layout");
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <type_traits>
 //#include <Windows.h>
 #include "Vec4.h"
 #include "Mat3.h"
@@ -18,105 +19,57 @@ namespace lm
 		Vec4<T>& GetRaw2() { return mMatrix[2]; }
 		Vec4<T>& GetRaw3() { return mMatrix[3]; }
 
-		Mat4()
-		{
-			this->mMatrix[0] = Vec4<T>(0, 0, 0, 0);
-			this->mMatrix[1] = Vec4<T>(0, 0, 0, 0);
-			this->mMatrix[2] = Vec4<T>(0, 0, 0, 0);
-			this->mMatrix[3] = Vec4<T>(0, 0, 0, 0);
-		}
+		constexpr Mat4()
+			: mMatrix{ Vec4<T>(0, 0, 0, 0), Vec4<T>(0, 0, 0, 0), Vec4<T>(0, 0, 0, 0), Vec4<T>(0, 0, 0, 0) }
+		{}
 
-		Mat4(const T pInit)
-		{
-			this->mMatrix[0] = Vec4<T>(pInit, 0, 0, 0);
-			this->mMatrix[1] = Vec4<T>(0, pInit, 0, 0);
-			this->mMatrix[2] = Vec4<T>(0, 0, pInit, 0);
-			this->mMatrix[3] = Vec4<T>(0, 0, 0, pInit);
-		}
+		constexpr Mat4(const T pInit)
+			: mMatrix{ Vec4<T>(pInit, 0, 0, 0), Vec4<T>(0, pInit, 0, 0), Vec4<T>(0, 0, pInit, 0), Vec4<T>(0, 0, 0, pInit) }
+		{}
 
-		Mat4(const Vec4<T>& pVec1, const Vec4<T>& pVec2, const Vec4<T>& pVec3, const Vec4<T>& pVec4)
-		{
-			this->mMatrix[0] = pVec1;
-			this->mMatrix[1] = pVec2;
-			this->mMatrix[2] = pVec3;
-			this->mMatrix[3] = pVec4;
-		}
+		constexpr Mat4(const Vec4<T>& pVec1, const Vec4<T>& pVec2, const Vec4<T>& pVec3, const Vec4<T>& pVec4)
+			: mMatrix{ pVec1, pVec2, pVec3, pVec4 }
+		{}
 
-		Mat4(const T& p00, const T& p01, const T& p02, const T& p03,
+		constexpr Mat4(const T& p00, const T& p01, const T& p02, const T& p03,
 			const T& p10, const T& p11, const T& p12, const T& p13,
 			const T& p20, const T& p21, const T& p22, const T& p23,
 			const T& p30, const T& p31, const T& p32, const T& p33)
-		{
-			this->mMatrix[0][0] = p00;
-			this->mMatrix[0][1] = p01;
-			this->mMatrix[0][2] = p02;
-			this->mMatrix[0][3] = p03;
-			this->mMatrix[1][0] = p10;
-			this->mMatrix[1][1] = p11;
-			this->mMatrix[1][2] = p12;
-			this->mMatrix[1][3] = p13;
-			this->mMatrix[2][0] = p20;
-			this->mMatrix[2][1] = p21;
-			this->mMatrix[2][2] = p22;
-			this->mMatrix[2][3] = p23;
-			this->mMatrix[3][0] = p30;
-			this->mMatrix[3][1] = p31;
-			this->mMatrix[3][2] = p32;
-			this->mMatrix[3][3] = p33;
-		}
-
-		Mat4(const Mat4<T>& pOther)
-		{
-			for (unsigned int i = 0; i < 4; i++)
-				this->mMatrix[i] = pOther.mMatrix[i];
-		}
-
-		Mat4(Mat4<T>&& pOther) noexcept
-		{
-			for (unsigned int i = 0; i < 4; i++)
-				this->mMatrix[i] = std::move(pOther.mMatrix[i]);
-		}
-
-		Mat4<T>& operator=(const Mat4<T>& pOther)
-		{
-			if (this == &pOther)
-				return *this;
+			: mMatrix{ Vec4<T>(p00, p01, p02, p03), Vec4<T>(p10, p11, p12, p13),
+				Vec4<T>(p20, p21, p22, p23), Vec4<T>(p30, p31, p32, p33) }
+		{}
 
-			for (unsigned int i = 0; i < 4; i++)
-				this->mMatrix[i] = pOther.mMatrix[i];
-
-			return *this;
-		}
-
-		Mat4<T>& operator=(Mat4<T>&& pOther) noexcept
-		{
-			if (this == &pOther)
-				return *this;
-
-			for (unsigned int i = 0; i < 4; i++)
-				this->mMatrix[i] = std::move(pOther.mMatrix[i]);
-
-			return *this;
-		}
+		Mat4(const Mat4<T>& pOther) = default;
+		Mat4(Mat4<T>&& pOther) noexcept = default;
+		Mat4<T>& operator=(const Mat4<T>& pOther) = default;
+		Mat4<T>& operator=(Mat4<T>&& pOther) noexcept = default;
 
-		const Vec4<T> operator[](int pIdx) const
+		// unchecked in release builds, asserts the row when NDEBUG is not defined
+		constexpr const Vec4<T>& operator[](const int pIdx) const
 		{
-			if (pIdx >= 0 && pIdx < 4)
-				return this->mMatrix[pIdx];
-			return this->mMatrix[0];
+			assert(pIdx >= 0 && pIdx < 4 && "Mat4 row out of range");
+			return this->mMatrix[pIdx];
 		}
 
-		Vec4<T>& operator[](int pIdx)
+		constexpr Vec4<T>& operator[](const int pIdx)
 		{
-			if (pIdx >= 0 && pIdx < 4)
-				return this->mMatrix[pIdx];
-			return this->mMatrix[0];
+			assert(pIdx >= 0 && pIdx < 4 && "Mat4 row out of range");
+			return this->mMatrix[pIdx];
 		}
 
-		Mat4<T> DotProduct(const Mat4<T>& pOther) const
+		constexpr Mat4<T> DotProduct(const Mat4<T>& pOther) const
 		{
 			Mat4<T> newMat4;
 
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Simd::Mat4Multiply(this->mMatrix[0].Data(), pOther.mMatrix[0].Data(), newMat4.mMatrix[0].Data());
+					return newMat4;
+				}
+			}
+
 			for (unsigned int i = 0; i < 4; i++)
 			{
 				Vec4<T> vec4;
@@ -222,7 +175,7 @@ namespace lm
 			return Result;
 		}
 
-		const T Determinant() const
+		constexpr const T Determinant() const
 		{
 			Mat3<T> cofactor0{
 				mMatrix[1][1], mMatrix[1][2], mMatrix[1][3],
@@ -250,7 +203,7 @@ namespace lm
 				mMatrix[3][0] * cofactor3.Determinant();
 		}
 
-		Mat4<T> Adjugate() const
+		constexpr Mat4<T> Adjugate() const
 		{
 			Mat3<T> sub00{
 				mMatrix[1][1], mMatrix[1][2], mMatrix[1][3],
@@ -340,16 +293,70 @@ namespace lm
 			}.Transpose();
 		}
 
-		Mat4<T> Inverse() const
+		constexpr Mat4<T> Inverse() const
 		{
-			const T det = this->Determinant();
-			const T div = 1.f / det;
+			// the kernels index the four rows as one array, which constant evaluation rejects
+			if (Simd::IsConstantEvaluated())
+				return this->Adjugate() * (1 / this->Determinant());
 
-			return this->Adjugate() * div;
+			Mat4<T> inverse;
+			Simd::Mat4Inverse(this->mMatrix[0].Data(), inverse.mMatrix[0].Data());
+			return inverse;
 		}
 
-		Mat4<T> Transpose() const
+		/* -----
+		Inverse of a matrix whose last column is (0, 0, 0, 1): the 3x3 part is inverted
+		from the cross products of its rows and the translation row is brought back through it.
+		----- */
+
+		constexpr Mat4<T> InverseAffine() const
 		{
+			const Vec3<T> row0(mMatrix[0][0], mMatrix[0][1], mMatrix[0][2]);
+			const Vec3<T> row1(mMatrix[1][0], mMatrix[1][1], mMatrix[1][2]);
+			const Vec3<T> row2(mMatrix[2][0], mMatrix[2][1], mMatrix[2][2]);
+			const Vec3<T> translation(mMatrix[3][0], mMatrix[3][1], mMatrix[3][2]);
+
+			const Vec3<T> column0 = row1.CrossProduct(row2);
+			const Vec3<T> column1 = row2.CrossProduct(row0);
+			const Vec3<T> column2 = row0.CrossProduct(row1);
+			const T inverseDet = 1 / row0.DotProduct(column0);
+
+			return Mat4<T>{
+				column0.X() * inverseDet, column1.X() * inverseDet, column2.X() * inverseDet, 0,
+				column0.Y() * inverseDet, column1.Y() * inverseDet, column2.Y() * inverseDet, 0,
+				column0.Z() * inverseDet, column1.Z() * inverseDet, column2.Z() * inverseDet, 0,
+				-translation.DotProduct(column0) * inverseDet,
+				-translation.DotProduct(column1) * inverseDet,
+				-translation.DotProduct(column2) * inverseDet, 1 };
+		}
+
+		// inverse of a rotation + translation matrix (orthonormal 3x3 part)
+		constexpr Mat4<T> InverseRigid() const
+		{
+			const Vec3<T> row0(mMatrix[0][0], mMatrix[0][1], mMatrix[0][2]);
+			const Vec3<T> row1(mMatrix[1][0], mMatrix[1][1], mMatrix[1][2]);
+			const Vec3<T> row2(mMatrix[2][0], mMatrix[2][1], mMatrix[2][2]);
+			const Vec3<T> translation(mMatrix[3][0], mMatrix[3][1], mMatrix[3][2]);
+
+			return Mat4<T>{
+				row0.X(), row1.X(), row2.X(), 0,
+				row0.Y(), row1.Y(), row2.Y(), 0,
+				row0.Z(), row1.Z(), row2.Z(), 0,
+				-translation.DotProduct(row0), -translation.DotProduct(row1), -translation.DotProduct(row2), 1 };
+		}
+
+		constexpr Mat4<T> Transpose() const
+		{
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Mat4<T> transpose;
+					Simd::Mat4Transpose(this->mMatrix[0].Data(), transpose.mMatrix[0].Data());
+					return transpose;
+				}
+			}
+
 			return Mat4<T>{
 				mMatrix[0][0], mMatrix[1][0], mMatrix[2][0], mMatrix[3][0],
 				mMatrix[0][1], mMatrix[1][1], mMatrix[2][1], mMatrix[3][1],
@@ -357,9 +364,9 @@ namespace lm
 				mMatrix[0][3], mMatrix[1][3], mMatrix[2][3], mMatrix[3][3]};
 		}
 
-		static Mat4<T> Translation(const Vec3<T>& pTranslation)
+		static constexpr Mat4<T> Translation(const Vec3<T>& pTranslation)
 		{
-			Mat4<T> translate;
+			Mat4<T> translate(1);
 			translate[3][0] = pTranslation.X();
 			translate[3][1] = pTranslation.Y();
 			translate[3][2] = pTranslation.Z();
@@ -371,7 +378,7 @@ namespace lm
 			this *= Translation(pTranslate);
 		}
 
-		Mat4<T> Scale(const T& pScale) const
+		constexpr Mat4<T> Scale(const T& pScale) const
 		{
 			Mat4<T> matrixScale = *this;
 			matrixScale[0] *= pScale;
@@ -381,7 +388,7 @@ namespace lm
 			return matrixScale;
 		}
 
-		void ScaleSelf(const T& pScale)
+		constexpr void ScaleSelf(const T& pScale)
 		{
 			this->mMatrix[0] *= pScale;
 			this->mMatrix[1] *= pScale;
@@ -392,43 +399,40 @@ namespace lm
 		static Mat4<T> xRotation(float pAngle)
 		{
 			float rad = float(Utilities::DegreesToRadians(double(pAngle)));
+			return xRotationSinCos(std::sin(rad), std::cos(rad));
+		}
 
-			Mat4<T> matrixScale = mIdentity;
-			matrixScale[1][1] = std::cosf(rad);
-			matrixScale[1][2] = std::sinf(rad);
-
-			matrixScale[2][1] = -std::sinf(rad);
-			matrixScale[2][2] = std::cosf(rad);
-
-			return matrixScale;
+		static Mat4<T> xRotation(float pAngle, Utilities::FastMathTag)
+		{
+			float sinAngle, cosAngle;
+			Utilities::SinCos(float(Utilities::DegreesToRadians(double(pAngle))), sinAngle, cosAngle);
+			return xRotationSinCos(sinAngle, cosAngle);
 		}
 
 		static Mat4<T> yRotation(float pAngle)
 		{
 			float rad = float(Utilities::DegreesToRadians(double(pAngle)));
+			return yRotationSinCos(std::sin(rad), std::cos(rad));
+		}
 
-			Mat4<T> matrixRotation = mIdentity;
-			matrixRotation[0][0] = std::cosf(rad);
-			matrixRotation[0][2] = -std::sinf(rad);
-
-			matrixRotation[2][0] = std::sinf(rad);
-			matrixRotation[2][2] = std::cosf(rad);
-
-			return matrixRotation;
+		static Mat4<T> yRotation(float pAngle, Utilities::FastMathTag)
+		{
+			float sinAngle, cosAngle;
+			Utilities::SinCos(float(Utilities::DegreesToRadians(double(pAngle))), sinAngle, cosAngle);
+			return yRotationSinCos(sinAngle, cosAngle);
 		}
 
 		static Mat4<T> zRotation(float pAngle)
 		{
 			float rad = float(Utilities::DegreesToRadians(double(pAngle)));
+			return zRotationSinCos(std::sin(rad), std::cos(rad));
+		}
 
-			Mat4<T> matrixScale = mIdentity;
-			matrixScale[0][0] = std::cosf(rad);
-			matrixScale[0][1] = std::sinf(rad);
-
-			matrixScale[1][0] = -std::sinf(rad);
-			matrixScale[1][1] = std::cosf(rad);
-
-			return matrixScale;
+		static Mat4<T> zRotation(float pAngle, Utilities::FastMathTag)
+		{
+			float sinAngle, cosAngle;
+			Utilities::SinCos(float(Utilities::DegreesToRadians(double(pAngle))), sinAngle, cosAngle);
+			return zRotationSinCos(sinAngle, cosAngle);
 		}
 
 		static Mat4<T> PerspectiveRH(const float pFov, const float pAspect, const float pNear, const float pFar)
@@ -440,7 +444,7 @@ namespace lm
 			return CreateFrustum(-width, width, -height, height, pNear, pFar);
 		}
 
-		static Mat4<T> CreateFrustum(const float pLeft, const float pRight, const float pBottom,
+		static constexpr Mat4<T> CreateFrustum(const float pLeft, const float pRight, const float pBottom,
 			const float pTop, const float pNear, const float pFar)
 		{
 			const float maxView = 2.0f * pNear;
@@ -470,7 +474,7 @@ namespace lm
 			return CreateFrustumDirect(-width, width, -height, height, pNear, pFar);
 		}
 
-		static Mat4<T> CreateFrustumDirect(const float pLeft, const float pRight, const float pBottom,
+		static constexpr Mat4<T> CreateFrustumDirect(const float pLeft, const float pRight, const float pBottom,
 			const float pTop, const float pNear, const float pFar)
 		{
 			const float maxView = 2.0f * pNear;
@@ -491,7 +495,7 @@ namespace lm
 			return Frustum;
 		}
 
-		bool IsIdentity() const
+		constexpr bool IsIdentity() const
 		{
 			return *this == mIdentity;
 		}
@@ -569,29 +573,39 @@ namespace lm
 			return rotateVector;
 		}
 
-		Mat4<T> operator*(const float pScale) const
+		constexpr Mat4<T> operator*(const float pScale) const
 		{
 			return this->Scale(pScale);
 		}
 
-		void operator*=(const float pScale)
+		constexpr void operator*=(const float pScale)
 		{
 			this->ScaleSelf(pScale);
 		}
 
-		Mat4<T> operator*(const Mat4<T>& pOther) const
+		constexpr Mat4<T> operator*(const Mat4<T>& pOther) const
 		{
 			return this->DotProduct(pOther);
 		}
 
-		void operator*=(const Mat4<T>& pOther)
+		constexpr void operator*=(const Mat4<T>& pOther)
 		{
 			*this = this->DotProduct(pOther);
 		}
 
-		Vec4<T> operator*(const Vec4<T>& pVec4) const
+		constexpr Vec4<T> operator*(const Vec4<T>& pVec4) const
 		{
 			Vec4<T> newVec4;
+
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Simd::Mat4Transform(this->mMatrix[0].Data(), pVec4.Data(), newVec4.Data());
+					return newVec4;
+				}
+			}
+
 			newVec4.X() = (this->mMatrix[0][0] * pVec4.X()) + (this->mMatrix[1].X() * pVec4.Y()) +
 				(this->mMatrix[2].X() * pVec4.Z()) + (this->mMatrix[3].X() * pVec4.W());
 			newVec4.Y() = (this->mMatrix[0][1] * pVec4.X()) + (this->mMatrix[1].Y() * pVec4.Y()) +
@@ -603,11 +617,37 @@ namespace lm
 			return newVec4;
 		}
 
-		const bool operator==(const Mat4<T>& pOther) const
+		/* -----
+		Batch versions of operator*(Vec4), pIn and pOut may be the same array.
+		Points are transformed with an implicit w of 1, directions with a w of 0,
+		only xyz of the result is kept (no perspective divide).
+		----- */
+
+		void TransformPoints(const Vec3<T>* pIn, Vec3<T>* pOut, const std::size_t pCount) const
+		{
+			this->TransformVec3s(pIn, pOut, pCount, 1);
+		}
+
+		void TransformDirections(const Vec3<T>* pIn, Vec3<T>* pOut, const std::size_t pCount) const
+		{
+			this->TransformVec3s(pIn, pOut, pCount, 0);
+		}
+
+		void TransformVec4(const Vec4<T>* pIn, Vec4<T>* pOut, const std::size_t pCount) const
 		{
-			if (this == &pOther)
-				return true;
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				Simd::Mat4TransformVec4s(this->mMatrix[0].Data(), pIn[0].Data(), pOut[0].Data(), pCount);
+				return;
+			}
+
+			for (std::size_t i = 0; i < pCount; i++)
+				pOut[i] = *this * pIn[i];
+		}
 
+		// exact, component-wise
+		constexpr bool operator==(const Mat4<T>& pOther) const
+		{
 			for (unsigned int i = 0; i < 4; i++)
 				if (this->mMatrix[i] != pOther.mMatrix[i])
 					return false;
@@ -615,14 +655,93 @@ namespace lm
 			return true;
 		}
 
-		const bool operator!=(const Mat4<T>& pOther) const
+		constexpr bool operator!=(const Mat4<T>& pOther) const
 		{
 			return !(*this == pOther);
 		}
+
+		constexpr bool ApproxEqual(const Mat4<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
+		{
+			for (unsigned int i = 0; i < 4; i++)
+				if (!this->mMatrix[i].ApproxEqual(pOther.mMatrix[i], pAbsEps, pRelEps))
+					return false;
+
+			return true;
+		}
+
+		bool UlpEqual(const Mat4<T>& pOther, const unsigned int pMaxUlps = 4) const
+		{
+			for (unsigned int i = 0; i < 4; i++)
+				if (!this->mMatrix[i].UlpEqual(pOther.mMatrix[i], pMaxUlps))
+					return false;
+
+			return true;
+		}
+
+	private:
+		static Mat4<T> xRotationSinCos(const float pSin, const float pCos)
+		{
+			Mat4<T> matrixRotation = mIdentity;
+			matrixRotation[1][1] = pCos;
+			matrixRotation[1][2] = pSin;
+
+			matrixRotation[2][1] = -pSin;
+			matrixRotation[2][2] = pCos;
+
+			return matrixRotation;
+		}
+
+		static Mat4<T> yRotationSinCos(const float pSin, const float pCos)
+		{
+			Mat4<T> matrixRotation = mIdentity;
+			matrixRotation[0][0] = pCos;
+			matrixRotation[0][2] = -pSin;
+
+			matrixRotation[2][0] = pSin;
+			matrixRotation[2][2] = pCos;
+
+			return matrixRotation;
+		}
+
+		static Mat4<T> zRotationSinCos(const float pSin, const float pCos)
+		{
+			Mat4<T> matrixRotation = mIdentity;
+			matrixRotation[0][0] = pCos;
+			matrixRotation[0][1] = pSin;
+
+			matrixRotation[1][0] = -pSin;
+			matrixRotation[1][1] = pCos;
+
+			return matrixRotation;
+		}
+
+		void TransformVec3s(const Vec3<T>* pIn, Vec3<T>* pOut, const std::size_t pCount, const T pW) const
+		{
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				Simd::Mat4TransformVec3s(this->mMatrix[0].Data(), reinterpret_cast<const T*>(pIn),
+					reinterpret_cast<T*>(pOut), pCount, pW);
+				return;
+			}
+
+			for (std::size_t i = 0; i < pCount; i++)
+			{
+				const Vec4<T> result = *this * Vec4<T>(pIn[i], pW);
+				pOut[i] = Vec3<T>(result.X(), result.Y(), result.Z());
+			}
+		}
 	};
 
-	template<class T> const Mat4<T> Mat4<T>::mIdentity = Mat4<T>(1);
+	template<class T> constexpr Mat4<T> Mat4<T>::mIdentity = Mat4<T>(1);
 
 	typedef Mat4<float> FMat4;
 	typedef Mat4<double> DMat4;
+
+	static_assert(sizeof(FMat4) == 16 * sizeof(float), "FMat4 rows must be contiguous");
+	static_assert(alignof(FMat4) == alignof(FVec4), "FMat4 rows must stay SIMD aligned");
+	static_assert(std::is_trivially_copyable_v<FMat4> && std::is_standard_layout_v<FMat4>,
+		"FMat4 must be trivially copyable and standard layout");
+	static_assert(std::is_trivially_copyable_v<DMat4> && std::is_standard_layout_v<DMat4>,
+		"DMat4 must be trivially copyable and standard layout");
 }
\ No newline at end of file
@@ -0,0 +1,274 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "Parallel.h"
+#include "Vec4.h"
+#include "Vertex.h"
+#include "VertexStream.h"
+
+namespace lm
+{
+	// how the faces around a vertex weigh in its smooth normal
+	enum class NormalWeighting
+	{
+		Area, Angle
+	};
+
+	namespace Meshes
+	{
+		/* -----
+		Atomic-free accumulation of per-triangle values onto vertices: pEvaluate(triangle) computes
+		the value of a triangle once, pAccumulate(value, corner, sums) adds it to the sums of the
+		vertex at corner 0, 1 or 2 and pResolve(vertex, sums) receives the total.
+		One thread scatters blocks of triangles into a single buffer of sums. With more, the
+		vertices are cut into power of two buckets, about 8 per thread, and the work runs in two
+		parallel passes, a vertex to corner adjacency at bucket granularity:
+		- each triangle range evaluates its triangles and counting sorts its corners by bucket
+		- each thread takes a range of buckets, walks them in every triangle range, in triangle
+		  order, and gathers into the sums of its own vertices only
+		Work is O(triangles + vertices + threads^2) and memory one value per triangle, 4 bytes per
+		corner and one set of sums per vertex, whatever the thread count. The triangles of a
+		vertex are always added in index order so the sums do not depend on the thread count.
+		----- */
+
+		template <std::size_t Count, typename Evaluate, typename Accumulate, typename Resolve>
+		void GatherTriangles(const std::uint32_t* pIndices, const std::size_t pTriangleCount, const std::size_t pVertexCount,
+			const unsigned int pThreadCount, Evaluate&& pEvaluate, Accumulate&& pAccumulate, Resolve&& pResolve)
+		{
+			using Sums = std::array<FVec3, Count>;
+			using Value = std::decay_t<decltype(pEvaluate(std::size_t(0)))>;
+
+			for (std::size_t i = 0; i < 3 * pTriangleCount; i++)
+				assert(pIndices[i] < pVertexCount && "GatherTriangles index outside the vertices");
+
+			const std::size_t rangeCount = std::clamp<std::size_t>(pVertexCount / Parallel::mMinElementsPerThread, 1,
+				Parallel::ThreadCount(pThreadCount));
+			if (rangeCount == 1)
+			{
+				// evaluated by blocks, as the threads store their values first, so that no multiply
+				// of pEvaluate fuses into the sums and the rounding matches on FMA targets
+				std::vector<Sums> sums(pVertexCount);
+				std::array<Value, 256> values;
+				for (std::size_t block = 0; block < pTriangleCount; block += values.size())
+				{
+					const std::size_t count = std::min(values.size(), pTriangleCount - block);
+					for (std::size_t i = 0; i < count; i++)
+						values[i] = pEvaluate(block + i);
+
+					for (std::size_t i = 0; i < count; i++)
+						for (std::uint32_t corner = 0; corner < 3; corner++)
+							pAccumulate(values[i], corner, sums[pIndices[3 * (block + i) + corner]]);
+				}
+
+				for (std::size_t vertex = 0; vertex < pVertexCount; vertex++)
+					pResolve(vertex, sums[vertex]);
+				return;
+			}
+
+			// a shift instead of a division per corner
+			std::size_t shift = 0;
+			while ((std::size_t(2) << shift) <= pVertexCount / (8 * rangeCount))
+				shift++;
+
+			const std::size_t bucketCount = ((pVertexCount - 1) >> shift) + 1;
+			const std::size_t triangleRange = (pTriangleCount + rangeCount - 1) / rangeCount;
+			assert(3 * triangleRange <= std::numeric_limits<std::uint32_t>::max() && "GatherTriangles corner overflows 32 bits");
+
+			// per triangle range: the values, and the corners relative to the range sorted by bucket
+			struct Bucketed
+			{
+				std::vector<Value> mValues;
+				std::vector<std::uint32_t> mCorners;
+				std::vector<std::size_t> mStarts;
+			};
+
+			std::vector<Bucketed> bucketed(rangeCount);
+			Parallel::ForRanges(rangeCount, 1, unsigned(rangeCount),
+				[&](const std::size_t pBegin, const std::size_t pEnd)
+				{
+					for (std::size_t range = pBegin; range < pEnd; range++)
+					{
+						Bucketed& buckets = bucketed[range];
+						const std::size_t first = std::min(range * triangleRange, pTriangleCount);
+						const std::size_t last = std::min(first + triangleRange, pTriangleCount);
+
+						buckets.mValues.reserve(last - first);
+						buckets.mStarts.assign(bucketCount + 1, 0);
+						for (std::size_t triangle = first; triangle < last; triangle++)
+						{
+							buckets.mValues.push_back(pEvaluate(triangle));
+							for (std::size_t corner = 3 * triangle; corner < 3 * triangle + 3; corner++)
+								buckets.mStarts[(pIndices[corner] >> shift) + 1]++;
+						}
+
+						for (std::size_t bucket = 1; bucket <= bucketCount; bucket++)
+							buckets.mStarts[bucket] += buckets.mStarts[bucket - 1];
+
+						std::vector<std::size_t> cursors(buckets.mStarts.begin(), buckets.mStarts.end() - 1);
+						buckets.mCorners.resize(3 * (last - first));
+						for (std::size_t corner = 3 * first; corner < 3 * last; corner++)
+							buckets.mCorners[cursors[pIndices[corner] >> shift]++] = std::uint32_t(corner - 3 * first);
+					}
+				});
+
+			Parallel::ForRanges(rangeCount, 1, unsigned(rangeCount),
+				[&](const std::size_t pBegin, const std::size_t pEnd)
+				{
+					for (std::size_t range = pBegin; range < pEnd; range++)
+					{
+						const std::size_t firstBucket = range * bucketCount / rangeCount;
+						const std::size_t lastBucket = (range + 1) * bucketCount / rangeCount;
+						const std::size_t first = firstBucket << shift;
+						const std::size_t last = std::min(lastBucket << shift, pVertexCount);
+
+						std::vector<Sums> sums(last - first);
+						for (std::size_t source = 0; source < rangeCount; source++)
+						{
+							const Bucketed& buckets = bucketed[source];
+							const std::uint32_t* indices = pIndices + 3 * std::min(source * triangleRange, pTriangleCount);
+							for (std::size_t i = buckets.mStarts[firstBucket]; i < buckets.mStarts[lastBucket]; i++)
+							{
+								const std::uint32_t corner = buckets.mCorners[i];
+								pAccumulate(buckets.mValues[corner / 3], corner % 3, sums[indices[corner] - first]);
+							}
+						}
+
+						for (std::size_t vertex = first; vertex < last; vertex++)
+							pResolve(vertex, sums[vertex - first]);
+					}
+				});
+		}
+	}
+
+	/* -----
+	Smooth normals of an indexed triangle list, one per element of pNormals. Area weighting
+	adds the unnormalized face normal (twice the area) to the three corners, Angle weighting
+	the unit face normal times the corner angle, which does not depend on how a flat region
+	is triangulated. Vertices used by no triangle, or only by degenerate ones, get a zero
+	normal. Threaded by Meshes::GatherTriangles as described in Parallel.h.
+	----- */
+
+	inline void ComputeNormals(const VertexStream<const FVec3>& pPositions, const std::uint32_t* pIndices,
+		const std::size_t pIndexCount, const VertexStream<FVec3>& pNormals,
+		const NormalWeighting pWeighting = NormalWeighting::Area, const unsigned int pThreadCount = 0)
+	{
+		const auto resolve = [&](const std::size_t pVertex, const std::array<FVec3, 1>& pSums)
+		{
+			pNormals[pVertex] = Meshes::NormalizeOrZero(pSums[0]);
+		};
+
+		if (pWeighting == NormalWeighting::Area)
+		{
+			Meshes::GatherTriangles<1>(pIndices, pIndexCount / 3, pNormals.Size(), pThreadCount,
+				[&](const std::size_t pTriangle)
+				{
+					const std::uint32_t a = pIndices[3 * pTriangle], b = pIndices[3 * pTriangle + 1], c = pIndices[3 * pTriangle + 2];
+					return (pPositions[b] - pPositions[a]).CrossProduct(pPositions[c] - pPositions[a]);
+				},
+				[](const FVec3& pNormal, const std::uint32_t, std::array<FVec3, 1>& pSums) { pSums[0] += pNormal; },
+				resolve);
+			return;
+		}
+
+		// the unit normal of the triangle and its three corner angles
+		Meshes::GatherTriangles<1>(pIndices, pIndexCount / 3, pNormals.Size(), pThreadCount,
+			[&](const std::size_t pTriangle)
+			{
+				const std::uint32_t a = pIndices[3 * pTriangle], b = pIndices[3 * pTriangle + 1], c = pIndices[3 * pTriangle + 2];
+				const FVec3 ab = pPositions[b] - pPositions[a];
+				const FVec3 ac = pPositions[c] - pPositions[a];
+				const FVec3 normal = ab.CrossProduct(ac);
+
+				// |normal| is |u x v| for the two edges of any corner, atan2 stays accurate near 0 and pi
+				const float length = normal.Length();
+				if (length == 0.f)
+					return std::array<FVec3, 2>{};
+
+				const FVec3 bc = pPositions[c] - pPositions[b];
+				return std::array<FVec3, 2>{ normal * (1.f / length), FVec3(std::atan2(length, ab.DotProduct(ac)),
+					std::atan2(length, -ab.DotProduct(bc)), std::atan2(length, ac.DotProduct(bc))) };
+			},
+			[](const std::array<FVec3, 2>& pFace, const std::uint32_t pCorner, std::array<FVec3, 1>& pSums)
+			{
+				pSums[0] += pFace[0] * pFace[1][int(pCorner)];
+			},
+			resolve);
+	}
+
+	inline void ComputeNormals(Vertex* pVertices, const std::size_t pVertexCount, const std::uint32_t* pIndices,
+		const std::size_t pIndexCount, const NormalWeighting pWeighting = NormalWeighting::Area, const unsigned int pThreadCount = 0)
+	{
+		if (pVertexCount == 0)
+			return;
+
+		ComputeNormals(VertexStream<const FVec3>(&pVertices[0].GetPosition(), pVertexCount, sizeof(Vertex)), pIndices, pIndexCount,
+			VertexStream<FVec3>(&pVertices[0].GetNormal(), pVertexCount, sizeof(Vertex)), pWeighting, pThreadCount);
+	}
+
+	/* -----
+	Tangent frames from the texture coordinates (Lengyel's method, threaded as ComputeNormals):
+	each triangle adds the directions of increasing u and v to its corners, the u sum is then
+	made perpendicular to the unit normal of the vertex. xyz of pTangents is the unit tangent,
+	w the handedness (+1 or -1) so that bitangent = w * normal x tangent, as in MikkTSpace and
+	glTF. Vertices without usable coordinates get any tangent perpendicular to their normal.
+	----- */
+
+	inline void ComputeTangents(const VertexStream<const FVec3>& pPositions, const VertexStream<const FVec3>& pNormals,
+		const VertexStream<const FVec2>& pTextCoords, const std::uint32_t* pIndices, const std::size_t pIndexCount,
+		const VertexStream<FVec4>& pTangents, const unsigned int pThreadCount = 0)
+	{
+		Meshes::GatherTriangles<2>(pIndices, pIndexCount / 3, pTangents.Size(), pThreadCount,
+			[&](const std::size_t pTriangle)
+			{
+				const std::uint32_t a = pIndices[3 * pTriangle], b = pIndices[3 * pTriangle + 1], c = pIndices[3 * pTriangle + 2];
+				const FVec3 edge1 = pPositions[b] - pPositions[a];
+				const FVec3 edge2 = pPositions[c] - pPositions[a];
+				const FVec2 uv1 = pTextCoords[b] - pTextCoords[a];
+				const FVec2 uv2 = pTextCoords[c] - pTextCoords[a];
+
+				const float determinant = uv1.X() * uv2.Y() - uv2.X() * uv1.Y();
+				if (determinant == 0.f)
+					return std::array<FVec3, 2>{};
+
+				const float inverse = 1.f / determinant;
+				return std::array<FVec3, 2>{ (edge1 * uv2.Y() - edge2 * uv1.Y()) * inverse, (edge2 * uv1.X() - edge1 * uv2.X()) * inverse };
+			},
+			[](const std::array<FVec3, 2>& pFace, const std::uint32_t, std::array<FVec3, 2>& pSums)
+			{
+				pSums[0] += pFace[0];
+				pSums[1] += pFace[1];
+			},
+			[&](const std::size_t pVertex, const std::array<FVec3, 2>& pSums)
+			{
+				const FVec3& normal = pNormals[pVertex];
+				FVec3 tangent = Meshes::NormalizeOrZero(pSums[0] - normal * normal.DotProduct(pSums[0]));
+				if (tangent == FVec3(0.f))
+				{
+					const FVec3 axis = std::abs(normal.X()) < .9f ? FVec3(1.f, 0.f, 0.f) : FVec3(0.f, 1.f, 0.f);
+					tangent = Meshes::NormalizeOrZero(axis - normal * normal.DotProduct(axis));
+				}
+
+				const float handedness = normal.CrossProduct(tangent).DotProduct(pSums[1]) < 0.f ? -1.f : 1.f;
+				pTangents[pVertex] = FVec4(tangent, handedness);
+			});
+	}
+
+	inline void ComputeTangents(const Vertex* pVertices, const std::size_t pVertexCount, const std::uint32_t* pIndices,
+		const std::size_t pIndexCount, FVec4* pTangents, const unsigned int pThreadCount = 0)
+	{
+		if (pVertexCount == 0)
+			return;
+
+		ComputeTangents(VertexStream<const FVec3>(&pVertices[0].GetPosition(), pVertexCount, sizeof(Vertex)),
+			VertexStream<const FVec3>(&pVertices[0].GetNormal(), pVertexCount, sizeof(Vertex)),
+			VertexStream<const FVec2>(&pVertices[0].GetTextCoords(), pVertexCount, sizeof(Vertex)), pIndices, pIndexCount,
+			VertexStream<FVec4>(pTangents, pVertexCount), pThreadCount);
+	}
+}
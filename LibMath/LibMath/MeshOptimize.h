@@ -0,0 +1,386 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "Vertex.h"
+#include "VertexStream.h"
+
+namespace lm
+{
+	// the post-transform cache cost of an index buffer, see AnalyzeVertexCache
+	struct VertexCacheStatistics
+	{
+		std::size_t mTransformed = 0;
+		float mAcmr = 0.f;
+		float mAtvr = 0.f;
+	};
+
+	namespace Meshes
+	{
+		// entries of the LRU cache modelled by the Forsyth scores
+		constexpr std::size_t mScoredCacheSize = 32;
+
+		/* -----
+		Forsyth's vertex score: the 3 vertices of the last triangle get a fixed 0.75 so their
+		neighbours do not always win, older cache entries decay with (1 - age)^1.5, and vertices
+		with few triangles left get a boost of 2 / sqrt(count) to be finished early.
+		-1 for vertices without triangles left so no triangle is drawn towards them.
+		----- */
+
+		inline float VertexCacheScore(const int pCachePosition, const std::uint32_t pLiveTriangles)
+		{
+			static const std::array<float, mScoredCacheSize> positionScores = []()
+			{
+				std::array<float, mScoredCacheSize> scores{};
+				for (std::size_t i = 0; i < mScoredCacheSize; i++)
+					scores[i] = i < 3 ? .75f : std::pow(1.f - float(i - 3) / float(mScoredCacheSize - 3), 1.5f);
+				return scores;
+			}();
+
+			static const std::array<float, 64> valenceScores = []()
+			{
+				std::array<float, 64> scores{};
+				for (std::size_t i = 1; i < scores.size(); i++)
+					scores[i] = 2.f / std::sqrt(float(i));
+				return scores;
+			}();
+
+			if (pLiveTriangles == 0)
+				return -1.f;
+
+			const float valence = pLiveTriangles < valenceScores.size() ? valenceScores[pLiveTriangles] :
+				2.f / std::sqrt(float(pLiveTriangles));
+			return pCachePosition < 0 ? valence : valence + positionScores[pCachePosition];
+		}
+
+		template <typename Index> constexpr bool IsIndex()
+		{
+			return std::is_same_v<Index, std::uint32_t> || std::is_same_v<Index, std::uint16_t>;
+		}
+	}
+
+	/* -----
+	Reorders the triangles of an indexed list for the post-transform vertex cache (Forsyth's
+	linear-speed algorithm): the next triangle is the best scored one around the vertices of a
+	simulated LRU cache, the first one left in input order when none is. pOut may alias
+	pIndices, the winding of every triangle is kept.
+	----- */
+
+	template <typename Index> void OptimizeVertexCache(const Index* pIndices, const std::size_t pIndexCount,
+		const std::size_t pVertexCount, Index* pOut)
+	{
+		static_assert(Meshes::IsIndex<Index>(), "OptimizeVertexCache works on 16 or 32 bits indices");
+
+		const std::size_t triangleCount = pIndexCount / 3;
+		const std::vector<Index> indices(pIndices, pIndices + 3 * triangleCount);
+
+		// triangles of every vertex, the live ones first in its slice
+		std::vector<std::uint32_t> live(pVertexCount, 0);
+		for (const Index index : indices)
+		{
+			assert(index < pVertexCount && "OptimizeVertexCache index outside the vertices");
+			live[index]++;
+		}
+
+		std::vector<std::uint32_t> offsets(pVertexCount + 1, 0);
+		for (std::size_t vertex = 0; vertex < pVertexCount; vertex++)
+			offsets[vertex + 1] = offsets[vertex] + live[vertex];
+
+		std::vector<std::uint32_t> adjacency(indices.size());
+		{
+			std::vector<std::uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+			for (std::size_t i = 0; i < indices.size(); i++)
+				adjacency[cursors[indices[i]]++] = std::uint32_t(i / 3);
+		}
+
+		std::vector<int> cachePositions(pVertexCount, -1);
+		std::vector<float> vertexScores(pVertexCount);
+		for (std::size_t vertex = 0; vertex < pVertexCount; vertex++)
+			vertexScores[vertex] = Meshes::VertexCacheScore(-1, live[vertex]);
+
+		std::vector<float> triangleScores(triangleCount);
+		std::vector<bool> emitted(triangleCount, false);
+		for (std::size_t triangle = 0; triangle < triangleCount; triangle++)
+			triangleScores[triangle] = vertexScores[indices[3 * triangle]] + vertexScores[indices[3 * triangle + 1]] +
+				vertexScores[indices[3 * triangle + 2]];
+
+		// the 3 vertices of the new triangle in front, the previous entries pushed back behind them
+		std::array<std::uint32_t, Meshes::mScoredCacheSize + 3> cache{}, nextCache{};
+		std::size_t cacheSize = 0;
+
+		constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+		std::size_t best = triangleCount != 0 ? std::size_t(std::max_element(triangleScores.begin(), triangleScores.end()) -
+			triangleScores.begin()) : none;
+		std::size_t cursor = 0;
+
+		for (std::size_t output = 0; output < triangleCount; output++)
+		{
+			if (best == none)
+			{
+				while (emitted[cursor])
+					cursor++;
+				best = cursor;
+			}
+
+			emitted[best] = true;
+			const std::uint32_t corners[3] = { indices[3 * best], indices[3 * best + 1], indices[3 * best + 2] };
+			for (int k = 0; k < 3; k++)
+			{
+				pOut[3 * output + k] = Index(corners[k]);
+
+				// swap the triangle out of the live slice of its vertex
+				const std::uint32_t vertex = corners[k];
+				std::uint32_t* begin = adjacency.data() + offsets[vertex];
+				std::uint32_t* end = begin + live[vertex];
+				std::iter_swap(std::find(begin, end, std::uint32_t(best)), end - 1);
+				live[vertex]--;
+			}
+
+			std::size_t nextSize = 0;
+			for (const std::uint32_t vertex : corners)
+				if (std::find(nextCache.begin(), nextCache.begin() + nextSize, vertex) == nextCache.begin() + nextSize)
+					nextCache[nextSize++] = vertex;
+			for (std::size_t i = 0; i < cacheSize; i++)
+				if (cache[i] != corners[0] && cache[i] != corners[1] && cache[i] != corners[2])
+					nextCache[nextSize++] = cache[i];
+
+			// the entries pushed out of the cache are rescored too, then dropped
+			for (std::size_t i = 0; i < nextSize; i++)
+			{
+				const std::uint32_t vertex = nextCache[i];
+				cachePositions[vertex] = i < Meshes::mScoredCacheSize ? int(i) : -1;
+				vertexScores[vertex] = Meshes::VertexCacheScore(cachePositions[vertex], live[vertex]);
+			}
+
+			best = none;
+			float bestScore = -std::numeric_limits<float>::max();
+			for (std::size_t i = 0; i < nextSize; i++)
+			{
+				const std::uint32_t vertex = nextCache[i];
+				for (std::uint32_t j = offsets[vertex]; j < offsets[vertex] + live[vertex]; j++)
+				{
+					const std::uint32_t triangle = adjacency[j];
+					const float score = vertexScores[indices[3 * triangle]] + vertexScores[indices[3 * triangle + 1]] +
+						vertexScores[indices[3 * triangle + 2]];
+					triangleScores[triangle] = score;
+
+					if (i < Meshes::mScoredCacheSize && score > bestScore)
+					{
+						best = triangle;
+						bestScore = score;
+					}
+				}
+			}
+
+			cacheSize = std::min(nextSize, Meshes::mScoredCacheSize);
+			std::swap(cache, nextCache);
+		}
+	}
+
+	/* -----
+	Simulates a FIFO post-transform cache of pCacheSize entries over the triangles. ACMR is the
+	count of vertex shader runs per triangle (0.5 at best on a regular grid, 3 without reuse),
+	ATVR the runs per distinct vertex referenced (1 at best).
+	----- */
+
+	template <typename Index> VertexCacheStatistics AnalyzeVertexCache(const Index* pIndices, const std::size_t pIndexCount,
+		const std::size_t pVertexCount, const std::size_t pCacheSize = 16)
+	{
+		static_assert(Meshes::IsIndex<Index>(), "AnalyzeVertexCache works on 16 or 32 bits indices");
+
+		// a vertex is in the cache while less than pCacheSize misses happened since its own
+		std::vector<std::size_t> timestamps(pVertexCount, 0);
+		std::size_t time = pCacheSize + 1;
+		std::size_t referenced = 0;
+
+		VertexCacheStatistics statistics;
+		const std::size_t indexCount = pIndexCount - pIndexCount % 3;
+		for (std::size_t i = 0; i < indexCount; i++)
+		{
+			const Index vertex = pIndices[i];
+			assert(vertex < pVertexCount && "AnalyzeVertexCache index outside the vertices");
+
+			referenced += timestamps[vertex] == 0;
+			if (time - timestamps[vertex] > pCacheSize)
+			{
+				timestamps[vertex] = time++;
+				statistics.mTransformed++;
+			}
+		}
+
+		if (indexCount != 0)
+		{
+			statistics.mAcmr = float(statistics.mTransformed) / float(indexCount / 3);
+			statistics.mAtvr = float(statistics.mTransformed) / float(referenced);
+		}
+		return statistics;
+	}
+
+	/* -----
+	Sorts the triangles of a cache optimized list so that the outer surfaces are drawn first
+	and hide the ones behind them (Sander et al.). The list is cut into clusters where the FIFO
+	cache misses on all 3 vertices and again wherever the ACMR of the cluster so far drops
+	under pThreshold times that of the whole cut, then the clusters are sorted by how far their
+	area-weighted centroid lies out of the mesh along their normal. A higher pThreshold gives
+	more clusters, so less overdraw for more cache misses. pOut may alias pIndices.
+	----- */
+
+	template <typename Index> void OptimizeOverdraw(const Index* pIndices, const std::size_t pIndexCount,
+		const VertexStream<const FVec3>& pPositions, Index* pOut, const float pThreshold = 1.05f,
+		const std::size_t pCacheSize = 16)
+	{
+		static_assert(Meshes::IsIndex<Index>(), "OptimizeOverdraw works on 16 or 32 bits indices");
+
+		const std::size_t triangleCount = pIndexCount / 3;
+		const std::vector<Index> indices(pIndices, pIndices + 3 * triangleCount);
+
+		// FIFO misses of a triangle, the cache restarting empty on pReset
+		std::vector<std::size_t> timestamps(pPositions.Size(), 0);
+		std::size_t time = pCacheSize + 1;
+		const auto misses = [&](const std::size_t pTriangle, const bool pReset)
+		{
+			if (pReset)
+				time += pCacheSize + 1;
+
+			int count = 0;
+			for (int k = 0; k < 3; k++)
+			{
+				const Index vertex = indices[3 * pTriangle + k];
+				if (time - timestamps[vertex] > pCacheSize)
+				{
+					timestamps[vertex] = time++;
+					count++;
+				}
+			}
+			return count;
+		};
+
+		std::vector<std::size_t> hardCuts;
+		for (std::size_t triangle = 0; triangle < triangleCount; triangle++)
+			if (misses(triangle, triangle == 0) == 3)
+				hardCuts.push_back(triangle);
+		hardCuts.push_back(triangleCount);
+
+		std::vector<std::size_t> clusters;
+		for (std::size_t cut = 0; cut + 1 < hardCuts.size(); cut++)
+		{
+			const std::size_t begin = hardCuts[cut], end = hardCuts[cut + 1];
+
+			std::size_t total = 0;
+			for (std::size_t triangle = begin; triangle < end; triangle++)
+				total += misses(triangle, triangle == begin);
+			const float threshold = pThreshold * float(total) / float(end - begin);
+
+			clusters.push_back(begin);
+			std::size_t start = begin, count = 0;
+			for (std::size_t triangle = begin; triangle < end; triangle++)
+			{
+				count += misses(triangle, triangle == start);
+				if (triangle + 1 < end && float(count) <= threshold * float(triangle - start + 1))
+				{
+					start = triangle + 1;
+					count = 0;
+					clusters.push_back(start);
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+
+		// area-weighted centroid and normal of every cluster, then of the mesh
+		const std::size_t clusterCount = clusters.size() - 1;
+		std::vector<FVec3> centroids(clusterCount), normals(clusterCount);
+		FVec3 meshCentroid(0.f);
+		float meshArea = 0.f;
+		for (std::size_t cluster = 0; cluster < clusterCount; cluster++)
+		{
+			FVec3 centroid(0.f), normal(0.f);
+			float area = 0.f;
+			for (std::size_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; triangle++)
+			{
+				const FVec3& a = pPositions[indices[3 * triangle]];
+				const FVec3& b = pPositions[indices[3 * triangle + 1]];
+				const FVec3& c = pPositions[indices[3 * triangle + 2]];
+				const FVec3 cross = (b - a).CrossProduct(c - a);
+				const float weight = cross.Length();
+
+				centroid += (a + b + c) * (weight / 3.f);
+				normal += cross;
+				area += weight;
+			}
+
+			meshCentroid += centroid;
+			meshArea += area;
+			centroids[cluster] = area > 0.f ? centroid * (1.f / area) : centroid;
+			normals[cluster] = Meshes::NormalizeOrZero(normal);
+		}
+		if (meshArea > 0.f)
+			meshCentroid = meshCentroid * (1.f / meshArea);
+
+		std::vector<float> keys(clusterCount);
+		std::vector<std::size_t> order(clusterCount);
+		for (std::size_t cluster = 0; cluster < clusterCount; cluster++)
+		{
+			keys[cluster] = (centroids[cluster] - meshCentroid).DotProduct(normals[cluster]);
+			order[cluster] = cluster;
+		}
+		std::stable_sort(order.begin(), order.end(),
+			[&keys](const std::size_t pLeft, const std::size_t pRight) { return keys[pLeft] > keys[pRight]; });
+
+		Index* out = pOut;
+		for (const std::size_t cluster : order)
+			out = std::copy(indices.begin() + 3 * clusters[cluster], indices.begin() + 3 * clusters[cluster + 1], out);
+	}
+
+	/* -----
+	Numbers the vertices in the order the indices first use them, so drawing, and batch kernels
+	walking the list, read the vertex data forward. pRemap[vertex] receives the new position;
+	the vertices no triangle uses follow in their original order. Returns the used count.
+	----- */
+
+	template <typename Index> std::size_t GenerateFetchRemap(const Index* pIndices, const std::size_t pIndexCount,
+		const std::size_t pVertexCount, std::uint32_t* pRemap)
+	{
+		static_assert(Meshes::IsIndex<Index>(), "GenerateFetchRemap works on 16 or 32 bits indices");
+
+		constexpr std::uint32_t unused = std::numeric_limits<std::uint32_t>::max();
+		std::fill(pRemap, pRemap + pVertexCount, unused);
+
+		std::uint32_t next = 0;
+		for (std::size_t i = 0; i < pIndexCount; i++)
+		{
+			assert(pIndices[i] < pVertexCount && "GenerateFetchRemap index outside the vertices");
+			if (pRemap[pIndices[i]] == unused)
+				pRemap[pIndices[i]] = next++;
+		}
+
+		const std::size_t used = next;
+		for (std::size_t vertex = 0; vertex < pVertexCount; vertex++)
+			if (pRemap[vertex] == unused)
+				pRemap[vertex] = next++;
+
+		return used;
+	}
+
+	// reorders pVertices and rewrites pIndices in place by GenerateFetchRemap, returns the used count
+	template <typename Index> std::size_t OptimizeVertexFetch(Vertex* pVertices, const std::size_t pVertexCount, Index* pIndices,
+		const std::size_t pIndexCount)
+	{
+		std::vector<std::uint32_t> remap(pVertexCount);
+		const std::size_t used = GenerateFetchRemap(pIndices, pIndexCount, pVertexCount, remap.data());
+
+		const std::vector<Vertex> vertices(pVertices, pVertices + pVertexCount);
+		for (std::size_t vertex = 0; vertex < pVertexCount; vertex++)
+			pVertices[remap[vertex]] = vertices[vertex];
+
+		for (std::size_t i = 0; i < pIndexCount; i++)
+			pIndices[i] = Index(remap[pIndices[i]]);
+
+		return used;
+	}
+}
@@ -0,0 +1,310 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "Parallel.h"
+#include "Vertex.h"
+#include "VertexStream.h"
+
+namespace lm
+{
+	/* -----
+	Per-attribute distance under which WeldVertices merges two vertices: a vertex joins the
+	first unique vertex before it whose components are all within the tolerance of its own. 0
+	merges bit-identical attributes only (with -0 equal to +0).
+	----- */
+
+	class WeldTolerance
+	{
+	public:
+		constexpr WeldTolerance(const float pAll = 0.f)
+			: mPosition(pAll), mNormal(pAll), mTextCoords(pAll), mColor(pAll)
+		{}
+
+		constexpr WeldTolerance(const float pPosition, const float pNormal, const float pTextCoords, const float pColor)
+			: mPosition(pPosition), mNormal(pNormal), mTextCoords(pTextCoords), mColor(pColor)
+		{}
+
+		float mPosition;
+		float mNormal;
+		float mTextCoords;
+		float mColor;
+	};
+
+	namespace Meshes
+	{
+		// the 11 floats of a Vertex once quantized, compared as a whole
+		using WeldKey = std::array<std::uint32_t, 11>;
+
+		// bits of pValue, or index of the nearest cell when pInverseStep is not 0
+		inline std::uint32_t QuantizeAttribute(const float pValue, const float pInverseStep)
+		{
+			if (pInverseStep == 0.f)
+			{
+				const float value = pValue == 0.f ? 0.f : pValue;
+				std::uint32_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+				return bits;
+			}
+
+			// out of range and NaN cells saturate instead of overflowing the conversion
+			const float cell = std::floor(pValue * pInverseStep + .5f);
+			if (!(cell > -2147483648.f))
+				return std::uint32_t(std::numeric_limits<std::int32_t>::min());
+			if (!(cell < 2147483648.f))
+				return std::uint32_t(std::numeric_limits<std::int32_t>::max());
+			return std::uint32_t(std::int32_t(cell));
+		}
+
+		// word-wise multiply-xor of the words after the position, which HashWeldCell folds last
+		inline std::uint64_t HashWeldAttributes(const WeldKey& pKey)
+		{
+			std::uint64_t hash = 0xCBF29CE484222325ull;
+			for (std::size_t word = 3; word < pKey.size(); word++)
+				hash = (hash ^ pKey[word]) * 0x100000001B3ull;
+			return hash;
+		}
+
+		// the position words, then the murmur3 finalizer so that every bit mixes in
+		inline std::uint64_t HashWeldCell(const std::uint64_t pAttributes, const std::uint32_t pX, const std::uint32_t pY,
+			const std::uint32_t pZ)
+		{
+			std::uint64_t hash = pAttributes;
+			for (const std::uint32_t word : { pX, pY, pZ })
+				hash = (hash ^ word) * 0x100000001B3ull;
+
+			hash ^= hash >> 33;
+			hash *= 0xFF51AFD7ED558CCDull;
+			hash ^= hash >> 33;
+			hash *= 0xC4CEB9FE1A85EC53ull;
+			return hash ^ (hash >> 33);
+		}
+
+		inline std::uint64_t HashWeldKey(const WeldKey& pKey)
+		{
+			return Meshes::HashWeldCell(Meshes::HashWeldAttributes(pKey), pKey[0], pKey[1], pKey[2]);
+		}
+
+		inline float InverseStep(const float pStep)
+		{
+			return pStep > 0.f ? 1.f / pStep : 0.f;
+		}
+
+		// every component of pLeft and pRight at most pTolerance apart, always true for 0 as the key compares them
+		template <typename Vector> bool WithinTolerance(const Vector& pLeft, const Vector& pRight, const float pTolerance)
+		{
+			if (pTolerance <= 0.f)
+				return true;
+
+			for (int axis = 0; axis < int(sizeof(Vector) / sizeof(float)); axis++)
+				if (!(std::abs(pLeft[axis] - pRight[axis]) <= pTolerance))
+					return false;
+			return true;
+		}
+	}
+
+	/* -----
+	Finds the duplicate vertices of the four attribute streams: pRemap[i] receives the new index
+	of vertex i, the unique vertices being numbered in the order of their first occurrence, and
+	the unique count is returned. The exact attributes, and the positions rounded to cells of
+	their tolerance, are hashed into open addressing tables with linear probing. A vertex looks
+	for unique vertices in its cell, and with a position tolerance in the 26 cells around it,
+	then compares the attributes within their tolerances. The vertices are counting sorted once
+	into one table per thread by the hash of their exact attributes and each table walks its
+	own in vertex order, so the result does not depend on the thread count; with a tolerance on
+	every attribute they all share one table. Threaded as described in Parallel.h.
+	----- */
+
+	inline std::size_t GenerateVertexRemap(const VertexStream<const FVec3>& pPositions, const VertexStream<const FVec3>& pNormals,
+		const VertexStream<const FVec2>& pTextCoords, const VertexStream<const FVec3>& pColors, std::uint32_t* pRemap,
+		const WeldTolerance& pTolerance = WeldTolerance(), const unsigned int pThreadCount = 0)
+	{
+		const std::size_t count = pPositions.Size();
+		assert(count < std::numeric_limits<std::uint32_t>::max() && "GenerateVertexRemap indices are 32 bits");
+
+		const float positionStep = Meshes::InverseStep(pTolerance.mPosition);
+		const float normalStep = Meshes::InverseStep(pTolerance.mNormal);
+		const float textCoordStep = Meshes::InverseStep(pTolerance.mTextCoords);
+		const float colorStep = Meshes::InverseStep(pTolerance.mColor);
+		const bool snap = positionStep != 0.f;
+
+		// the high bits of the hash pick the table, the low bits the slot inside it
+		const std::size_t tableCount = std::clamp<std::size_t>(count / Parallel::mMinElementsPerThread, 1,
+			Parallel::ThreadCount(pThreadCount));
+		const auto tableOf = [tableCount](const std::uint64_t pHash)
+		{
+			return std::uint32_t(((pHash >> 32) * tableCount) >> 32);
+		};
+
+		// positions keep their bits or nearest cell, the other attributes with a tolerance leave 0 and are compared on a match
+		std::vector<Meshes::WeldKey> keys(count);
+		std::vector<std::uint64_t> attributes(count);
+		std::vector<std::uint64_t> hashes(count);
+		std::vector<std::uint32_t> tables(count);
+		Parallel::ForRanges(count, Parallel::mMinElementsPerThread, pThreadCount,
+			[&](const std::size_t pBegin, const std::size_t pEnd)
+			{
+				for (std::size_t i = pBegin; i < pEnd; i++)
+				{
+					Meshes::WeldKey& key = keys[i];
+					for (int axis = 0; axis < 3; axis++)
+					{
+						key[axis] = Meshes::QuantizeAttribute(pPositions[i][axis], positionStep);
+						key[3 + axis] = normalStep == 0.f ? Meshes::QuantizeAttribute(pNormals[i][axis], 0.f) : 0;
+						key[8 + axis] = colorStep == 0.f ? Meshes::QuantizeAttribute(pColors[i][axis], 0.f) : 0;
+					}
+					key[6] = textCoordStep == 0.f ? Meshes::QuantizeAttribute(pTextCoords[i].X(), 0.f) : 0;
+					key[7] = textCoordStep == 0.f ? Meshes::QuantizeAttribute(pTextCoords[i].Y(), 0.f) : 0;
+					attributes[i] = Meshes::HashWeldAttributes(key);
+					hashes[i] = Meshes::HashWeldCell(attributes[i], key[0], key[1], key[2]);
+
+					// the neighbour cells of a snapped position must land in the same table
+					tables[i] = tableOf(snap ? Meshes::HashWeldCell(attributes[i], 0, 0, 0) : hashes[i]);
+				}
+			});
+
+		std::vector<std::size_t> tableStarts(tableCount + 1, 0);
+		for (std::size_t i = 0; i < count; i++)
+			tableStarts[tables[i] + 1]++;
+
+		for (std::size_t table = 1; table <= tableCount; table++)
+			tableStarts[table] += tableStarts[table - 1];
+
+		std::vector<std::uint32_t> members(count);
+		{
+			std::vector<std::size_t> cursors(tableStarts.begin(), tableStarts.end() - 1);
+			for (std::size_t i = 0; i < count; i++)
+				members[cursors[tables[i]]++] = std::uint32_t(i);
+		}
+
+		// the snapped position words may differ by a cell, the distances decide
+		const std::size_t firstCompared = snap ? 3 : 0;
+		const auto matches = [&](const std::uint32_t pOther, const std::size_t pVertex)
+		{
+			return std::equal(keys[pOther].begin() + firstCompared, keys[pOther].end(), keys[pVertex].begin() + firstCompared) &&
+				Meshes::WithinTolerance(pPositions[pOther], pPositions[pVertex], pTolerance.mPosition) &&
+				Meshes::WithinTolerance(pNormals[pOther], pNormals[pVertex], pTolerance.mNormal) &&
+				Meshes::WithinTolerance(pTextCoords[pOther], pTextCoords[pVertex], pTolerance.mTextCoords) &&
+				Meshes::WithinTolerance(pColors[pOther], pColors[pVertex], pTolerance.mColor);
+		};
+
+		// each table walks its vertices in order, the first of a kind becomes its representative
+		constexpr std::uint32_t empty = std::numeric_limits<std::uint32_t>::max();
+		const int reach = snap ? 1 : 0;
+		Parallel::ForRanges(tableCount, 1, unsigned(tableCount),
+			[&](const std::size_t pBegin, const std::size_t pEnd)
+			{
+				for (std::size_t table = pBegin; table < pEnd; table++)
+				{
+					const std::size_t memberCount = tableStarts[table + 1] - tableStarts[table];
+
+					// at most half full so the probe sequences stay short
+					std::size_t capacity = 16;
+					while (capacity < 2 * memberCount)
+						capacity *= 2;
+
+					const std::size_t mask = capacity - 1;
+					std::vector<std::uint32_t> slots(capacity, empty);
+					for (std::size_t member = tableStarts[table]; member < tableStarts[table + 1]; member++)
+					{
+						const std::uint32_t i = members[member];
+
+						// the earliest representative within tolerance, in any of the probed cells
+						const Meshes::WeldKey& key = keys[i];
+						std::uint32_t match = empty;
+						for (int dz = -reach; dz <= reach; dz++)
+							for (int dy = -reach; dy <= reach; dy++)
+								for (int dx = -reach; dx <= reach; dx++)
+								{
+									const std::uint64_t hash = snap ? Meshes::HashWeldCell(attributes[i], key[0] + std::uint32_t(dx),
+										key[1] + std::uint32_t(dy), key[2] + std::uint32_t(dz)) : hashes[i];
+									for (std::size_t slot = hash & mask; slots[slot] != empty; slot = (slot + 1) & mask)
+									{
+										const std::uint32_t other = slots[slot];
+										if (other < match && hashes[other] == hash && matches(other, i))
+											match = other;
+									}
+								}
+
+						if (match != empty)
+						{
+							pRemap[i] = match;
+							continue;
+						}
+
+						std::size_t slot = hashes[i] & mask;
+						while (slots[slot] != empty)
+							slot = (slot + 1) & mask;
+
+						slots[slot] = i;
+						pRemap[i] = i;
+					}
+				}
+			});
+
+		// a representative always comes before its duplicates, which then read its new index
+		std::uint32_t unique = 0;
+		for (std::size_t i = 0; i < count; i++)
+			pRemap[i] = pRemap[i] == i ? unique++ : pRemap[pRemap[i]];
+
+		return unique;
+	}
+
+	inline std::size_t GenerateVertexRemap(const Vertex* pVertices, const std::size_t pVertexCount, std::uint32_t* pRemap,
+		const WeldTolerance& pTolerance = WeldTolerance(), const unsigned int pThreadCount = 0)
+	{
+		if (pVertexCount == 0)
+			return 0;
+
+		return GenerateVertexRemap(VertexStream<const FVec3>(&pVertices[0].GetPosition(), pVertexCount, sizeof(Vertex)),
+			VertexStream<const FVec3>(&pVertices[0].GetNormal(), pVertexCount, sizeof(Vertex)),
+			VertexStream<const FVec2>(&pVertices[0].GetTextCoords(), pVertexCount, sizeof(Vertex)),
+			VertexStream<const FVec3>(&pVertices[0].GetColor(), pVertexCount, sizeof(Vertex)), pRemap, pTolerance, pThreadCount);
+	}
+
+	/* -----
+	Builds an indexed mesh from a triangle soup, pVertices holding one vertex per corner:
+	pUnique receives the first vertex of each group of duplicates (see GenerateVertexRemap),
+	pIndices one index per input vertex. Index is std::uint32_t or std::uint16_t, false is
+	returned with both outputs empty when the unique vertices do not fit it.
+	----- */
+
+	template <typename Index> bool WeldVertices(const Vertex* pVertices, const std::size_t pVertexCount,
+		std::vector<Vertex>& pUnique, std::vector<Index>& pIndices, const WeldTolerance& pTolerance = WeldTolerance(),
+		const unsigned int pThreadCount = 0)
+	{
+		static_assert(std::is_same_v<Index, std::uint32_t> || std::is_same_v<Index, std::uint16_t>,
+			"WeldVertices writes 16 or 32 bits indices");
+
+		std::vector<std::uint32_t> remap(pVertexCount);
+		const std::size_t unique = GenerateVertexRemap(pVertices, pVertexCount, remap.data(), pTolerance, pThreadCount);
+
+		pUnique.clear();
+		pIndices.clear();
+		if (unique > std::size_t(std::numeric_limits<Index>::max()) + 1)
+			return false;
+
+		// the representatives are the vertices whose index is seen for the first time
+		pUnique.reserve(unique);
+		for (std::size_t i = 0; i < pVertexCount; i++)
+			if (remap[i] == pUnique.size())
+				pUnique.push_back(pVertices[i]);
+
+		pIndices.resize(pVertexCount);
+		Parallel::ForRanges(pVertexCount, Parallel::mMinElementsPerThread, pThreadCount,
+			[&](const std::size_t pBegin, const std::size_t pEnd)
+			{
+				for (std::size_t i = pBegin; i < pEnd; i++)
+					pIndices[i] = Index(remap[i]);
+			});
+
+		return true;
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace lm
+{
+	namespace Parallel
+	{
+		/* -----
+		Threading contract of the library functions taking a pThreadCount: their work is split in
+		ranges of at least mMinElementsPerThread elements, one per thread, and pThreadCount = 0
+		uses every hardware thread. Starting and joining a thread costs tens of microseconds,
+		about the time a light kernel (a box transform, a skinned vertex, a weld hash) spends on
+		4096 elements, so shorter ranges stay on the calling thread.
+		----- */
+
+		constexpr std::size_t mMinElementsPerThread = 4096;
+
+		/* -----
+		Splits [0, pCount) into contiguous ranges and calls pFunction(begin, end) once per range,
+		the calling thread runs the last one. A range never holds less than pMinRange elements so
+		small inputs stay on the calling thread. pThreadCount = 0 uses every hardware thread.
+		pFunction must be safe to run concurrently on disjoint ranges.
+		----- */
+
+		inline unsigned int ThreadCount(const unsigned int pRequested)
+		{
+			if (pRequested != 0)
+				return pRequested;
+
+			return std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		template <typename Function> void ForRanges(const std::size_t pCount, const std::size_t pMinRange,
+			const unsigned int pThreadCount, Function&& pFunction)
+		{
+			const std::size_t byRange = pCount / std::max<std::size_t>(pMinRange, 1);
+			const std::size_t rangeCount = std::max<std::size_t>(1, std::min<std::size_t>(ThreadCount(pThreadCount), byRange));
+
+			if (rangeCount == 1)
+			{
+				if (pCount != 0)
+					pFunction(std::size_t(0), pCount);
+				return;
+			}
+
+			std::vector<std::thread> workers;
+			workers.reserve(rangeCount - 1);
+
+			const std::size_t rangeSize = (pCount + rangeCount - 1) / rangeCount;
+			for (std::size_t i = 0; i + 1 < rangeCount; i++)
+			{
+				const std::size_t begin = std::min(i * rangeSize, pCount);
+				const std::size_t end = std::min(begin + rangeSize, pCount);
+				workers.emplace_back([&pFunction, begin, end]() { pFunction(begin, end); });
+			}
+
+			pFunction(std::min((rangeCount - 1) * rangeSize, pCount), pCount);
+
+			for (std::thread& worker : workers)
+				worker.join();
+		}
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <type_traits>
+#include <cmath>
+#include <limits>
+#include "Vec3.h"
+
+namespace lm
+{
+	/* -----
+	Plane dot(mNormal, p) + mDistance = 0, the normal points to the positive half-space.
+	SignedDistance is metric only once the plane is normalized.
+	----- */
+
+	template <typename T> class Plane
+	{
+	public:
+		Vec3<T> mNormal;
+		T mDistance;
+
+		constexpr Plane()
+			: mNormal(), mDistance(0)
+		{}
+
+		constexpr Plane(const Vec3<T>& pNormal, const T pDistance)
+			: mNormal(pNormal), mDistance(pDistance)
+		{}
+
+		/* Rule of five */
+		Plane(const Plane<T>& pOther) = default;
+		Plane(Plane<T>&& pOther) noexcept = default;
+		Plane<T>& operator=(const Plane<T>& pOther) = default;
+		Plane<T>& operator=(Plane<T>&& pOther) noexcept = default;
+
+		/**/
+
+		static constexpr Plane<T> FromPointNormal(const Vec3<T>& pPoint, const Vec3<T>& pNormal)
+		{
+			return Plane<T>(pNormal, -pNormal.DotProduct(pPoint));
+		}
+
+		// counter-clockwise a, b, c seen from the positive side
+		static Plane<T> FromPoints(const Vec3<T>& pA, const Vec3<T>& pB, const Vec3<T>& pC)
+		{
+			return FromPointNormal(pA, (pB - pA).CrossProduct(pC - pA).Normalize());
+		}
+
+		constexpr bool operator==(const Plane<T>& pOther) const
+		{
+			return this->mNormal == pOther.mNormal && this->mDistance == pOther.mDistance;
+		}
+
+		constexpr bool operator!=(const Plane<T>& pOther) const
+		{
+			return !(*this == pOther);
+		}
+
+		constexpr bool ApproxEqual(const Plane<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
+		{
+			return this->mNormal.ApproxEqual(pOther.mNormal, pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mDistance, pOther.mDistance, pAbsEps, pRelEps);
+		}
+
+		constexpr T SignedDistance(const Vec3<T>& pPoint) const
+		{
+			return this->mNormal.DotProduct(pPoint) + this->mDistance;
+		}
+
+		// unit normal, the distance scaled with it
+		Plane<T> Normalize() const
+		{
+			const T invLength = T(1) / std::sqrt(this->mNormal.DotProduct(this->mNormal));
+			return Plane<T>(this->mNormal * invLength, this->mDistance * invLength);
+		}
+
+		void NormalizeSelf()
+		{
+			*this = this->Normalize();
+		}
+	};
+
+	typedef Plane<float> FPlane;
+	typedef Plane<double> DPlane;
+
+	static_assert(std::is_trivially_copyable_v<FPlane> && std::is_standard_layout_v<FPlane>,
+		"FPlane must be trivially copyable and standard layout");
+}
@@ -0,0 +1,346 @@
+#pragma once
+
+#include "Quaternion.h"
+#include "Vec3Packet.h"
+
+namespace lm
+{
+	/* -----
+	Accuracy tiers of the packet and batch Slerp, errors are the max angle between the
+	result and a double precision Slerp, measured by the Quaternion benchmark.
+	----- */
+
+	enum class SlerpAccuracy
+	{
+		Fast,		// 4 term acos and 7th order sin, ~2e-5 rad
+		Precise,	// 8 term acos and 11th order sin, ~1e-6 rad, the float rounding of Exact
+		Exact		// std::acos / std::sin per lane
+	};
+
+	/* -----
+	QuaternionPacket<P> holds P::Width independent Quaternion<float>, see Vec3Packet.h
+	----- */
+
+	template <typename P> class QuaternionPacket
+	{
+	public:
+		using Pack = P;
+		using Mask = typename P::Mask;
+
+		static constexpr std::size_t Width = P::Width;
+
+		P mW, mX, mY, mZ;
+
+		QuaternionPacket()
+			: mW(P::Splat(0)), mX(P::Splat(0)), mY(P::Splat(0)), mZ(P::Splat(0))
+		{}
+
+		// same quaternion in every lane
+		QuaternionPacket(const Quaternion<float>& pValue)
+			: mW(P::Splat(pValue.mW)), mX(P::Splat(pValue.mX)), mY(P::Splat(pValue.mY)), mZ(P::Splat(pValue.mZ))
+		{}
+
+		QuaternionPacket(const P& pX, const P& pY, const P& pZ, const P& pW)
+			: mW(pW), mX(pX), mY(pY), mZ(pZ)
+		{}
+
+		// reads Width quaternions from pSource
+		static QuaternionPacket<P> Load(const Quaternion<float>* pSource)
+		{
+			float x[Width], y[Width], z[Width], w[Width];
+			for (std::size_t i = 0; i < Width; i++)
+			{
+				x[i] = pSource[i].mX;
+				y[i] = pSource[i].mY;
+				z[i] = pSource[i].mZ;
+				w[i] = pSource[i].mW;
+			}
+
+			return QuaternionPacket<P>(P::Load(x), P::Load(y), P::Load(z), P::Load(w));
+		}
+
+		// writes Width quaternions to pDestination
+		void Store(Quaternion<float>* pDestination) const
+		{
+			float x[Width], y[Width], z[Width], w[Width];
+			this->mX.Store(x);
+			this->mY.Store(y);
+			this->mZ.Store(z);
+			this->mW.Store(w);
+
+			for (std::size_t i = 0; i < Width; i++)
+				pDestination[i] = Quaternion<float>(x[i], y[i], z[i], w[i]);
+		}
+
+		Quaternion<float> Get(const std::size_t pLane) const
+		{
+			Quaternion<float> lanes[Width];
+			this->Store(lanes);
+			return lanes[pLane];
+		}
+
+		QuaternionPacket<P> operator+(const QuaternionPacket<P>& pOther) const
+		{
+			return QuaternionPacket<P>(this->mX + pOther.mX, this->mY + pOther.mY, this->mZ + pOther.mZ,
+				this->mW + pOther.mW);
+		}
+
+		QuaternionPacket<P> operator-(const QuaternionPacket<P>& pOther) const
+		{
+			return QuaternionPacket<P>(this->mX - pOther.mX, this->mY - pOther.mY, this->mZ - pOther.mZ,
+				this->mW - pOther.mW);
+		}
+
+		QuaternionPacket<P> operator-() const
+		{
+			return QuaternionPacket<P>(-this->mX, -this->mY, -this->mZ, -this->mW);
+		}
+
+		QuaternionPacket<P> operator*(const P& pScalaire) const
+		{
+			return QuaternionPacket<P>(this->mX * pScalaire, this->mY * pScalaire, this->mZ * pScalaire,
+				this->mW * pScalaire);
+		}
+
+		QuaternionPacket<P> operator*(const QuaternionPacket<P>& pOther) const
+		{
+			const P finalW = (this->mW * pOther.mW) - (this->mX * pOther.mX) - (this->mY * pOther.mY) - (this->mZ * pOther.mZ);
+			const P finalX = (this->mW * pOther.mX) + (this->mX * pOther.mW) + (this->mY * pOther.mZ) - (this->mZ * pOther.mY);
+			const P finalY = (this->mW * pOther.mY) - (this->mX * pOther.mZ) + (this->mY * pOther.mW) + (this->mZ * pOther.mX);
+			const P finalZ = (this->mW * pOther.mZ) + (this->mX * pOther.mY) - (this->mY * pOther.mX) + (this->mZ * pOther.mW);
+
+			return QuaternionPacket<P>(finalX, finalY, finalZ, finalW);
+		}
+
+		// rotates every lane of pOther, same as Quaternion<T>::operator*(Vec3<T>)
+		Vec3Packet<P> operator*(const Vec3Packet<P>& pOther) const
+		{
+			const P zero = P::Splat(0);
+			const QuaternionPacket<P> rotated = *this * QuaternionPacket<P>(pOther.X(), pOther.Y(), pOther.Z(), zero) *
+				this->Conjugate();
+
+			return Vec3Packet<P>(rotated.mX, rotated.mY, rotated.mZ);
+		}
+
+		Mask operator==(const QuaternionPacket<P>& pOther) const
+		{
+			return (this->mW == pOther.mW) & (this->mX == pOther.mX) & (this->mY == pOther.mY) &
+				(this->mZ == pOther.mZ);
+		}
+
+		Mask operator!=(const QuaternionPacket<P>& pOther) const
+		{
+			return !(*this == pOther);
+		}
+
+		QuaternionPacket<P> Conjugate() const
+		{
+			return QuaternionPacket<P>(-this->mX, -this->mY, -this->mZ, this->mW);
+		}
+
+		P DotProduct(const QuaternionPacket<P>& pOther) const
+		{
+			return (this->mX * pOther.mX) + (this->mY * pOther.mY) + (this->mZ * pOther.mZ) + (this->mW * pOther.mW);
+		}
+
+		P Length() const
+		{
+			return Simd::Sqrt(this->DotProduct(*this));
+		}
+
+		QuaternionPacket<P> Normalize() const
+		{
+			const P length = this->Length();
+			return QuaternionPacket<P>(this->mX / length, this->mY / length, this->mZ / length, this->mW / length);
+		}
+
+		void NormalizeSelf()
+		{
+			*this = this->Normalize();
+		}
+
+		static QuaternionPacket<P> Select(const Mask& pMask, const QuaternionPacket<P>& pIfTrue,
+			const QuaternionPacket<P>& pIfFalse)
+		{
+			return QuaternionPacket<P>(Simd::Select(pMask, pIfTrue.mX, pIfFalse.mX),
+				Simd::Select(pMask, pIfTrue.mY, pIfFalse.mY),
+				Simd::Select(pMask, pIfTrue.mZ, pIfFalse.mZ),
+				Simd::Select(pMask, pIfTrue.mW, pIfFalse.mW));
+		}
+
+		static QuaternionPacket<P> Lerp(const QuaternionPacket<P>& pStart, const QuaternionPacket<P>& pEnd,
+			const float pAlpha)
+		{
+			const P t = P::Splat(Utilities::FClamp(pAlpha, 0.f, 1.f));
+			return pStart + ((pEnd - pStart) * t);
+		}
+
+		// lane-wise Quaternion<T>::Nlerp
+		static QuaternionPacket<P> Nlerp(const QuaternionPacket<P>& pStart, const QuaternionPacket<P>& pEnd,
+			const P& pAlpha)
+		{
+			const P t = Simd::Min(Simd::Max(pAlpha, P::Splat(0)), P::Splat(1));
+			const QuaternionPacket<P> to = Select(pStart.DotProduct(pEnd) < P::Splat(0), -pEnd, pEnd);
+
+			return (pStart + ((to - pStart) * t)).Normalize();
+		}
+
+		/* -----
+		Renormalized Slerp for blending: both the spherical and the near-parallel Nlerp
+		weights are computed and blended per lane, so lanes never diverge.
+		Exact uses std::acos/std::sin per lane and matches Quaternion<T>::Slerp on unit
+		quaternions, the other tiers use the Simd polynomials. Since every tier renormalizes its result, the
+		1 / sin(angle) factor of the textbook formula cancels out and is never computed.
+		----- */
+
+		static QuaternionPacket<P> Slerp(const QuaternionPacket<P>& pStart, const QuaternionPacket<P>& pEnd,
+			const P& pAlpha, const SlerpAccuracy pAccuracy)
+		{
+			const P zero = P::Splat(0);
+			const P one = P::Splat(1);
+			const P t = Simd::Min(Simd::Max(pAlpha, zero), one);
+
+			const P dot = pStart.DotProduct(pEnd);
+			const QuaternionPacket<P> to = Select(dot < zero, -pEnd, pEnd);
+			const P cosAngle = Simd::Min(Simd::Abs(dot), one);
+
+			P ratioA, ratioB;
+			if (pAccuracy == SlerpAccuracy::Exact)
+			{
+				float cosLanes[Width], tLanes[Width], ratioALanes[Width], ratioBLanes[Width];
+				cosAngle.Store(cosLanes);
+				t.Store(tLanes);
+				for (std::size_t i = 0; i < Width; i++)
+				{
+					const float angle = std::acos(cosLanes[i]);
+					ratioALanes[i] = std::sin((1 - tLanes[i]) * angle);
+					ratioBLanes[i] = std::sin(tLanes[i] * angle);
+				}
+
+				ratioA = P::Load(ratioALanes);
+				ratioB = P::Load(ratioBLanes);
+			}
+			else if (pAccuracy == SlerpAccuracy::Precise)
+			{
+				const P angle = Simd::AcosUnitPrecise(cosAngle);
+				ratioA = Simd::SinHalfPiPrecise((one - t) * angle);
+				ratioB = Simd::SinHalfPiPrecise(t * angle);
+			}
+			else
+			{
+				const P angle = Simd::AcosUnitFast(cosAngle);
+				ratioA = Simd::SinHalfPiFast((one - t) * angle);
+				ratioB = Simd::SinHalfPiFast(t * angle);
+			}
+
+			const typename P::Mask spherical = cosAngle < P::Splat(Quaternion<float>::mSlerpThreshold);
+			ratioA = Simd::Select(spherical, ratioA, one - t);
+			ratioB = Simd::Select(spherical, ratioB, t);
+
+			return ((pStart * ratioA) + (to * ratioB)).Normalize();
+		}
+
+		// lane-wise Quaternion<T>::Slerp, including its unnormalized Lerp for near-parallel lanes
+		static QuaternionPacket<P> Slerp(const QuaternionPacket<P>& pStart, const QuaternionPacket<P>& pEnd,
+			const float pAlpha)
+		{
+			const float t = Utilities::FClamp(pAlpha, 0.f, 1.f);
+			const P zero = P::Splat(0);
+
+			P cosAngle = pStart.DotProduct(pEnd);
+			const Mask flip = cosAngle < zero;
+			cosAngle = Simd::Select(flip, -cosAngle, cosAngle);
+			const QuaternionPacket<P> to = Select(flip, -pEnd, pEnd);
+
+			float cosLanes[Width], ratioALanes[Width], ratioBLanes[Width];
+			cosAngle.Store(cosLanes);
+			for (std::size_t i = 0; i < Width; i++)
+			{
+				const float angle = std::acos(std::min(cosLanes[i], 1.f));
+				const float invSinAngle = 1.f / std::sin(angle);
+
+				ratioALanes[i] = std::sin((1 - t) * angle) * invSinAngle;
+				ratioBLanes[i] = std::sin(t * angle) * invSinAngle;
+			}
+
+			const Mask spherical = cosAngle < P::Splat(Quaternion<float>::mSlerpThreshold);
+			const P ratioA = Simd::Select(spherical, P::Load(ratioALanes), P::Splat(1 - t));
+			const P ratioB = Simd::Select(spherical, P::Load(ratioBLanes), P::Splat(t));
+
+			return (pStart * ratioA) + (to * ratioB);
+		}
+	};
+
+	typedef QuaternionPacket<Simd::Float4>	Quatx4;
+	typedef QuaternionPacket<Simd::Float8>	Quatx8;
+
+	/* -----
+	Batch blends over arrays of FQuat, e.g. blending two animation poses bone by bone.
+	pOut[i] = Slerp(pStart[i], pEnd[i], alpha) where alpha is either shared or read from pAlpha[i].
+	pOut may alias pStart or pEnd. Eight quaternions are blended per step, the tail is padded
+	so every element goes through the same code and gets the same accuracy.
+	----- */
+
+	namespace Detail
+	{
+		template <typename Function> void ForEachQuatx8(const FQuat* pStart, const FQuat* pEnd,
+			const float* pAlpha, const float pSharedAlpha, FQuat* pOut, const std::size_t pCount, Function&& pBlend)
+		{
+			constexpr std::size_t width = Quatx8::Width;
+
+			std::size_t i = 0;
+			for (; i + width <= pCount; i += width)
+			{
+				const Simd::Float8 alpha = pAlpha ? Simd::Float8::Load(pAlpha + i) : Simd::Float8::Splat(pSharedAlpha);
+				pBlend(Quatx8::Load(pStart + i), Quatx8::Load(pEnd + i), alpha).Store(pOut + i);
+			}
+
+			if (i == pCount)
+				return;
+
+			FQuat start[width], end[width], out[width];
+			float alpha[width];
+			for (std::size_t lane = 0; lane < width; lane++)
+			{
+				const std::size_t source = i + lane < pCount ? i + lane : i;
+				start[lane] = pStart[source];
+				end[lane] = pEnd[source];
+				alpha[lane] = pAlpha ? pAlpha[source] : pSharedAlpha;
+			}
+
+			pBlend(Quatx8::Load(start), Quatx8::Load(end), Simd::Float8::Load(alpha)).Store(out);
+			for (std::size_t lane = 0; i + lane < pCount; lane++)
+				pOut[i + lane] = out[lane];
+		}
+	}
+
+	inline void BatchSlerp(const FQuat* pStart, const FQuat* pEnd, const float pAlpha, FQuat* pOut,
+		const std::size_t pCount, const SlerpAccuracy pAccuracy = SlerpAccuracy::Precise)
+	{
+		Detail::ForEachQuatx8(pStart, pEnd, nullptr, pAlpha, pOut, pCount,
+			[pAccuracy](const Quatx8& pA, const Quatx8& pB, const Simd::Float8& pT)
+			{ return Quatx8::Slerp(pA, pB, pT, pAccuracy); });
+	}
+
+	inline void BatchSlerp(const FQuat* pStart, const FQuat* pEnd, const float* pAlpha, FQuat* pOut,
+		const std::size_t pCount, const SlerpAccuracy pAccuracy = SlerpAccuracy::Precise)
+	{
+		Detail::ForEachQuatx8(pStart, pEnd, pAlpha, 0.f, pOut, pCount,
+			[pAccuracy](const Quatx8& pA, const Quatx8& pB, const Simd::Float8& pT)
+			{ return Quatx8::Slerp(pA, pB, pT, pAccuracy); });
+	}
+
+	inline void BatchNlerp(const FQuat* pStart, const FQuat* pEnd, const float pAlpha, FQuat* pOut,
+		const std::size_t pCount)
+	{
+		Detail::ForEachQuatx8(pStart, pEnd, nullptr, pAlpha, pOut, pCount,
+			[](const Quatx8& pA, const Quatx8& pB, const Simd::Float8& pT) { return Quatx8::Nlerp(pA, pB, pT); });
+	}
+
+	inline void BatchNlerp(const FQuat* pStart, const FQuat* pEnd, const float* pAlpha, FQuat* pOut,
+		const std::size_t pCount)
+	{
+		Detail::ForEachQuatx8(pStart, pEnd, pAlpha, 0.f, pOut, pCount,
+			[](const Quatx8& pA, const Quatx8& pB, const Simd::Float8& pT) { return Quatx8::Nlerp(pA, pB, pT); });
+	}
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <type_traits>
 #include <cmath>
 #include <algorithm>
 #include "Mat3.h"
@@ -15,105 +16,64 @@
 		static const Quaternion<T> mZero;
 		static const Quaternion<T> mOne;
 
-		Quaternion()
-		{
-			mW = 0;
-			mX = 0;
-			mY = 0;
-			mZ = 0;
-		}
+		constexpr Quaternion()
+			:mW(0), mX(0), mY(0), mZ(0)
+		{}
 
-		Quaternion(const T pValue)
+		constexpr Quaternion(const T pValue)
 			:mW(pValue), mX(pValue), mY(pValue), mZ(pValue)
 		{}
 
-		Quaternion(const T pX, const T pY, const T pZ, const T pW)
+		constexpr Quaternion(const T pX, const T pY, const T pZ, const T pW)
 			:mW(pW), mX(pX), mY(pY), mZ(pZ)
 		{}
 
 
 		/* Rule of five */
-		Quaternion(const Quaternion<T>& pOther)
-		{
-			this->mX = pOther.mX;
-			this->mY = pOther.mY;
-			this->mZ = pOther.mZ;
-			this->mW = pOther.mW;
-		}
-
-		Quaternion<T>& operator=(const Quaternion& pOther)
-		{
-			if (this == &pOther)
-				return *this;
-
-			this->mX = pOther.mX;
-			this->mY = pOther.mY;
-			this->mZ = pOther.mZ;
-			this->mW = pOther.mW;
-
-			return *this;
-		}
-
-		Quaternion(Quaternion<T>&& pOther) noexcept
-		{
-			this->mX = std::move(pOther.mX);
-			this->mY = std::move(pOther.mY);
-			this->mZ = std::move(pOther.mZ);
-			this->mW = std::move(pOther.mW);
-		}
-
-		Quaternion<T>& operator=(Quaternion<T>&& pOther) noexcept
-		{
-			if (this == &pOther)
-				return *this;
-
-			this->mX = std::move(pOther.mX);
-			this->mY = std::move(pOther.mY);
-			this->mZ = std::move(pOther.mZ);
-			this->mW = std::move(pOther.mW);
-
-			return *this;
-		}
+		Quaternion(const Quaternion<T>& pOther) = default;
+		Quaternion(Quaternion<T>&& pOther) noexcept = default;
+		Quaternion<T>& operator=(const Quaternion<T>& pOther) = default;
+		Quaternion<T>& operator=(Quaternion<T>&& pOther) noexcept = default;
 
 		/**/
 
-		Quaternion<T> operator+(const Quaternion<T>& pOther) const
+		constexpr Quaternion<T> operator+(const Quaternion<T>& pOther) const
 		{
 			return Quaternion<T>(this->mX + pOther.mX, this->mY + pOther.mY, this->mZ + pOther.mZ,
 				this->mW + pOther.mW);
 		}
-		void operator+=(const Quaternion<T>& pOther) /*const*/
+		constexpr void operator+=(const Quaternion<T>& pOther) /*const*/
 		{
 			this->mW += pOther.mW;
 			this->mX += pOther.mX;
 			this->mY += pOther.mY;
 			this->mZ += pOther.mZ;
 		}
-		Quaternion<T> operator-(const Quaternion<T>& pOther) const
+		constexpr Quaternion<T> operator-(const Quaternion<T>& pOther) const
 		{
 			return Quaternion<T>(this->mX - pOther.mX, this->mY - pOther.mY, this->mZ - pOther.mZ,
 				this->mW - pOther.mW);
 		}
-		void operator-=(const Quaternion<T>& pOther)
+		constexpr void operator-=(const Quaternion<T>& pOther)
 		{
 			this->mW -= pOther.mW;
 			this->mX -= pOther.mX;
 			this->mY -= pOther.mY;
 			this->mZ -= pOther.mZ;
 		}
-		Quaternion<T> operator*(const T& pScalaire) const
+		constexpr Quaternion<T> operator*(const T& pScalaire) const
 		{
 			return Quaternion<T>(this->mX * pScalaire, this->mY * pScalaire, this->mZ * pScalaire,
 				this->mW * pScalaire);
 		}
-		void operator*=(const T& pScalaire)
+		constexpr void operator*=(const T& pScalaire)
 		{
 			this->mW *= pScalaire;
 			this->mX *= pScalaire;
 			this->mY *= pScalaire;
 			this->mZ *= pScalaire;
 		}
-		Quaternion<T> operator*(const Quaternion<T>& pOther) const
+		constexpr Quaternion<T> operator*(const Quaternion<T>& pOther) const
 		{
 			T FinalW = (this->mW * pOther.mW) - (this->mX * pOther.mX) - (this->mY * pOther.mY) - (this->mZ * pOther.mZ);
 			T FinalX = (this->mW * pOther.mX) + (this->mX * pOther.mW) + (this->mY * pOther.mZ) - (this->mZ * pOther.mY);
@@ -123,7 +83,7 @@
 			return Quaternion<T>(FinalX, FinalY, FinalZ, FinalW);
 		}
 
-		void operator*=(const Quaternion<T>& pOther)
+		constexpr void operator*=(const Quaternion<T>& pOther)
 		{
 			T FinalW = (this->mW * pOther.mW) - (this->mX * pOther.mX) - (this->mY * pOther.mY) - (this->mZ * pOther.mZ);
 			T FinalX = (this->mW * pOther.mX) + (this->mX * pOther.mW) + (this->mY * pOther.mZ) - (this->mZ * pOther.mY);
@@ -136,7 +96,7 @@
 			this->mZ = FinalZ;
 		}
 
-		lm::Vec3<T> operator*(const lm::Vec3<T> pOther)
+		constexpr lm::Vec3<T> operator*(const lm::Vec3<T> pOther)
 		{
 			Quaternion<T> inverseQuat = this->Conjugate();
 			Quaternion<T> VecToQuat = Quaternion<T>(pOther.X(), pOther.Y(), pOther.Z(), 0);
@@ -145,23 +105,36 @@
 			return lm::Vec3<T>(newQuat.mX, newQuat.mY, newQuat.mZ);
 		}
 
-		const bool operator==(const Quaternion<T>& pOther) const
+		// exact, component-wise: q and -q are the same rotation but compare different
+		constexpr bool operator==(const Quaternion<T>& pOther) const
 		{
-			if (this == &pOther)
-				return true;
+			return this->mW == pOther.mW && this->mX == pOther.mX && this->mY == pOther.mY &&
+				this->mZ == pOther.mZ;
+		}
 
-			if (this->mW == pOther.mW && this->mX == pOther.mX && this->mY == pOther.mY &&
-				this->mZ == pOther.mZ)
-				return true;
+		constexpr bool operator!=(const Quaternion<T>& pOther) const
+		{
+			return !(*this == pOther);
+		}
 
-			return false;
+		constexpr bool ApproxEqual(const Quaternion<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
+		{
+			return Utilities::ApproxEqual(this->mW, pOther.mW, pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mX, pOther.mX, pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mY, pOther.mY, pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mZ, pOther.mZ, pAbsEps, pRelEps);
 		}
-		const bool operator!=(const Quaternion<T>& pOther) const
+
+		bool UlpEqual(const Quaternion<T>& pOther, const unsigned int pMaxUlps = 4) const
 		{
-			return !(*this == pOther);
+			return Utilities::UlpEqual(this->mW, pOther.mW, pMaxUlps) &&
+				Utilities::UlpEqual(this->mX, pOther.mX, pMaxUlps) &&
+				Utilities::UlpEqual(this->mY, pOther.mY, pMaxUlps) &&
+				Utilities::UlpEqual(this->mZ, pOther.mZ, pMaxUlps);
 		}
 
-		Quaternion<T> Conjugate() const
+		constexpr Quaternion<T> Conjugate() const
 		{
 			return Quaternion<T>(this->mX * -1, this->mY * -1, this->mZ * -1, this->mW);
 		}
@@ -184,6 +157,18 @@
 				this->mW / length);
 		}
 
+		// FastRsqrt instead of sqrt and divide, relative error <= 5e-7 for floats
+		Quaternion<T> Normalize(Utilities::FastMathTag) const
+		{
+			const T invLength = Utilities::FastRsqrt(this->mW * this->mW + this->mX * this->mX +
+				this->mY * this->mY + this->mZ * this->mZ);
+
+			return Quaternion<T>(this->mX * invLength,
+				this->mY * invLength,
+				this->mZ * invLength,
+				this->mW * invLength);
+		}
+
 		void NormalizeSelf()
 		{
 			auto length = this->Length();
@@ -251,7 +236,7 @@
 			return result.Conjugate().Normalize();
 		}
 
-		Mat3<T> GetRotationMatrix() const
+		constexpr Mat3<T> GetRotationMatrix() const
 		{
 			Quaternion<T> base = *this;
 
@@ -317,12 +302,23 @@
 			Vec3<T> UnitVector = pDirection.Normalize();
 
 			//step 2 & 3
-			Quaternion<T> g = Quaternion<T>(sin(pAngle / 2) * UnitVector.X(),
-				sin(pAngle / 2) * UnitVector.Y(),
-				sin(pAngle / 2) * UnitVector.Z(),
-				cos(pAngle / 2));
+			const T sinHalf = T(std::sin(pAngle / 2));
+			return Quaternion<T>(sinHalf * UnitVector.X(),
+				sinHalf * UnitVector.Y(),
+				sinHalf * UnitVector.Z(),
+				T(std::cos(pAngle / 2)));
+		}
+
+		static Quaternion<T> RotationAxis(float pAngle, Vec3<T> pDirection, Utilities::FastMathTag)
+		{
+			Vec3<T> UnitVector = pDirection.Normalize(Utilities::FastMath);
 
-			return g;
+			float sinHalf, cosHalf;
+			Utilities::SinCos(pAngle / 2, sinHalf, cosHalf);
+			return Quaternion<T>(T(sinHalf) * UnitVector.X(),
+				T(sinHalf) * UnitVector.Y(),
+				T(sinHalf) * UnitVector.Z(),
+				T(cosHalf));
 		}
 
 		enum class axis_order
@@ -412,7 +408,7 @@
 			pYaw = std::atan2(siny_cosp, cosy_cosp);
 		}
 
-		const T DotProduct(const Quaternion<T>& pOther) const
+		constexpr const T DotProduct(const Quaternion<T>& pOther) const
 		{
 			return (this->mX * pOther.mX) +
 				(this->mY * pOther.mY) +
@@ -420,7 +416,7 @@
 				(this->mW * pOther.mW);
 		}
 
-		static Quaternion<T> Lerp(const Quaternion<T>& pStart, const Quaternion<T>& pEnd, float pAlpha)
+		static constexpr Quaternion<T> Lerp(const Quaternion<T>& pStart, const Quaternion<T>& pEnd, float pAlpha)
 		{
 			float t = Utilities::FClamp(pAlpha, 0.f, 1.f);
 			Quaternion<T> q = (pEnd - pStart);
@@ -430,6 +426,18 @@
 			return q;
 		}
 
+		// normalized Lerp along the shortest path, exact at 0 and 1, drifts from Slerp in between
+		static Quaternion<T> Nlerp(const Quaternion<T>& pStart, const Quaternion<T>& pEnd, float pAlpha)
+		{
+			const T t = T(Utilities::FClamp(pAlpha, 0.f, 1.f));
+			const T sign = pStart.DotProduct(pEnd) < 0 ? T(-1) : T(1);
+
+			return Quaternion<T>(pStart.mX + ((pEnd.mX * sign) - pStart.mX) * t,
+				pStart.mY + ((pEnd.mY * sign) - pStart.mY) * t,
+				pStart.mZ + ((pEnd.mZ * sign) - pStart.mZ) * t,
+				pStart.mW + ((pEnd.mW * sign) - pStart.mW) * t).Normalize();
+		}
+
 		static Quaternion<T> Slerp(const Quaternion<T>& pStart, 
 			const Quaternion<T>& pEnd,
 			float pAlpha)
@@ -438,7 +446,6 @@
 			Quaternion<T> to = pEnd;
 
 			float t = Utilities::FClamp(pAlpha, 0.f, 1.f);
-			Quaternion<T> q;
 			float cosAngle = from.DotProduct(to);
 
 			if (cosAngle < 0.f)
@@ -447,7 +454,8 @@
 				to = Quaternion<T>(-to.mX, -to.mY, -to.mZ, -to.mW);
 			}
 
-			if (cosAngle < 0.95f)
+			// below ~3.6 degrees sin(angle) loses precision and Lerp is indistinguishable
+			if (cosAngle < mSlerpThreshold)
 			{
 				float angle = std::acos(cosAngle);
 				float sinAngle = std::sin(angle);
@@ -463,15 +471,28 @@
 			}
 			else
 			{
-				return Quaternion::Lerp(pStart, pEnd, pAlpha);
+				// like DirectX, not renormalized: see Nlerp or BatchSlerp for a unit result
+				return Quaternion<T>(from.mX + (to.mX - from.mX) * t,
+					from.mY + (to.mY - from.mY) * t,
+					from.mZ + (to.mZ - from.mZ) * t,
+					from.mW + (to.mW - from.mW) * t);
 			}
 		}
+
+		// cos of the angle between two quaternions above which Slerp switches to Lerp
+		static constexpr float mSlerpThreshold = 0.9995f;
 	};
 
-	template<class T> const Quaternion<T> Quaternion<T>::mZero = Quaternion();
-	template<class T> const Quaternion<T> Quaternion<T>::mOne = Quaternion(1);
-	template<class T> const T Quaternion<T>::mUnitVal = 1;
+	template<class T> constexpr Quaternion<T> Quaternion<T>::mZero = Quaternion();
+	template<class T> constexpr Quaternion<T> Quaternion<T>::mOne = Quaternion(1);
+	template<class T> constexpr T Quaternion<T>::mUnitVal = 1;
 
 	typedef Quaternion<float> FQuat;
 	typedef Quaternion<double> DQuat;
+
+	static_assert(sizeof(FQuat) == 4 * sizeof(float), "FQuat must map onto four packed floats");
+	static_assert(std::is_trivially_copyable_v<FQuat> && std::is_standard_layout_v<FQuat>,
+		"FQuat must be trivially copyable and standard layout");
+	static_assert(std::is_trivially_copyable_v<DQuat> && std::is_standard_layout_v<DQuat>,
+		"DQuat must be trivially copyable and standard layout");
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "AABB.h"
+#include "Vec3.h"
+
+namespace lm
+{
+	/* -----
+	Closest hit so far: the triangle tests only accept a hit before mDistance and then write
+	its distance and barycentrics, the hit point is a + mU * (b - a) + mV * (c - a).
+	----- */
+
+	template <typename T> struct RayHit
+	{
+		T mDistance = std::numeric_limits<T>::max();
+		T mU = 0;
+		T mV = 0;
+		std::uint32_t mPrimitive = std::numeric_limits<std::uint32_t>::max();
+	};
+
+	typedef RayHit<float> FRayHit;
+	typedef RayHit<double> DRayHit;
+
+	/* -----
+	Half line mOrigin + t * mDirection, t >= 0. The direction is not normalized, distances are
+	in units of its length. The inverse direction is kept for the slab tests, a zero component
+	gives an infinite inverse which the slab tests handle, and the shear of the watertight
+	triangle test is computed once per ray.
+	----- */
+
+	template <typename T> class Ray
+	{
+	public:
+		constexpr Ray() = default;
+
+		Ray(const Vec3<T>& pOrigin, const Vec3<T>& pDirection)
+			: mOrigin(pOrigin), mDirection(pDirection),
+			mInverseDirection(T(1) / pDirection.X(), T(1) / pDirection.Y(), T(1) / pDirection.Z())
+		{
+			// z is the dominant axis, x and y swap when it points backwards to keep the winding
+			const Vec3<T> absolute(std::abs(pDirection.X()), std::abs(pDirection.Y()), std::abs(pDirection.Z()));
+			const int z = absolute.X() >= absolute.Y() && absolute.X() >= absolute.Z() ? 0 : absolute.Y() >= absolute.Z() ? 1 : 2;
+			int x = (z + 1) % 3;
+			int y = (x + 1) % 3;
+			if (pDirection[z] < 0)
+				std::swap(x, y);
+
+			this->mAxes[0] = std::uint8_t(x);
+			this->mAxes[1] = std::uint8_t(y);
+			this->mAxes[2] = std::uint8_t(z);
+			this->mShear = Vec3<T>(pDirection[x] / pDirection[z], pDirection[y] / pDirection[z], T(1) / pDirection[z]);
+		}
+
+		/* Rule of five */
+		Ray(const Ray<T>& pOther) = default;
+		Ray(Ray<T>&& pOther) noexcept = default;
+		Ray<T>& operator=(const Ray<T>& pOther) = default;
+		Ray<T>& operator=(Ray<T>&& pOther) noexcept = default;
+
+		/**/
+
+		const Vec3<T>& GetOrigin() const { return mOrigin; }
+		const Vec3<T>& GetDirection() const { return mDirection; }
+		const Vec3<T>& GetInverseDirection() const { return mInverseDirection; }
+
+		constexpr Vec3<T> GetPoint(const T pDistance) const
+		{
+			return this->mOrigin + this->mDirection * pDistance;
+		}
+
+		/* -----
+		Slab test: true when the ray enters pBox before pMaxDistance, pEntry receives the entry
+		distance (0 when the origin is inside). An origin on a slab plane with a zero direction
+		component gives a NaN, which the operand order of min/max (NaN returns the first)
+		keeps out of the running entry and exit: the ray grazing a face hits the box.
+		----- */
+		bool IntersectBox(const AABB<T>& pBox, const T pMaxDistance, T& pEntry) const
+		{
+			T entry = 0;
+			T exit = pMaxDistance;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const T near = (pBox.mMin[axis] - this->mOrigin[axis]) * this->mInverseDirection[axis];
+				const T far = (pBox.mMax[axis] - this->mOrigin[axis]) * this->mInverseDirection[axis];
+				entry = std::max(entry, std::min(near, far));
+				exit = std::min(exit, std::max(far, near));
+			}
+
+			pEntry = entry;
+			return entry <= exit;
+		}
+
+		/* -----
+		Moller-Trumbore, both faces: true when the ray hits the triangle before pHit.mDistance,
+		pHit then holds the new distance and barycentrics (mPrimitive is left to the caller).
+		Rays through a shared edge may miss both triangles, see IntersectTriangleWatertight.
+		----- */
+		bool IntersectTriangle(const Vec3<T>& pA, const Vec3<T>& pB, const Vec3<T>& pC, RayHit<T>& pHit) const
+		{
+			const Vec3<T> edge1 = pB - pA;
+			const Vec3<T> edge2 = pC - pA;
+			const Vec3<T> p = this->mDirection.CrossProduct(edge2);
+			const T determinant = edge1.DotProduct(p);
+			if (determinant == 0)
+				return false;
+
+			const T inverse = T(1) / determinant;
+			const Vec3<T> s = this->mOrigin - pA;
+			const T u = s.DotProduct(p) * inverse;
+			const Vec3<T> q = s.CrossProduct(edge1);
+			const T v = this->mDirection.DotProduct(q) * inverse;
+			const T distance = edge2.DotProduct(q) * inverse;
+			if (!(u >= 0 && v >= 0 && u + v <= 1 && distance >= 0 && distance < pHit.mDistance))
+				return false;
+
+			pHit.mDistance = distance;
+			pHit.mU = u;
+			pHit.mV = v;
+			return true;
+		}
+
+		/* -----
+		Woop, Benthin and Wald's watertight test: the triangle is sheared into ray space and the
+		edge functions decide, so a ray through an edge or a vertex shared by two triangles hits
+		at least one of them. Float edge functions are evaluated in double (the paper only does it
+		for their zero case), where they are exact.
+		----- */
+		bool IntersectTriangleWatertight(const Vec3<T>& pA, const Vec3<T>& pB, const Vec3<T>& pC, RayHit<T>& pHit) const
+		{
+			const int x = this->mAxes[0], y = this->mAxes[1], z = this->mAxes[2];
+			const Vec3<T> a = pA - this->mOrigin;
+			const Vec3<T> b = pB - this->mOrigin;
+			const Vec3<T> c = pC - this->mOrigin;
+
+			const T ax = a[x] - this->mShear.X() * a[z];
+			const T ay = a[y] - this->mShear.Y() * a[z];
+			const T bx = b[x] - this->mShear.X() * b[z];
+			const T by = b[y] - this->mShear.Y() * b[z];
+			const T cx = c[x] - this->mShear.X() * c[z];
+			const T cy = c[y] - this->mShear.Y() * c[z];
+
+			// float products are exact in double, so the signs stay consistent with FMA contraction
+			using Wide = std::conditional_t<std::is_same_v<T, float>, double, T>;
+			const Wide u = Wide(cx) * Wide(by) - Wide(cy) * Wide(bx);
+			const Wide v = Wide(ax) * Wide(cy) - Wide(ay) * Wide(cx);
+			const Wide w = Wide(bx) * Wide(ay) - Wide(by) * Wide(ax);
+			if ((u < 0 || v < 0 || w < 0) && (u > 0 || v > 0 || w > 0))
+				return false;
+
+			const Wide determinant = u + v + w;
+			if (determinant == 0)
+				return false;
+
+			const T distance = T(Wide(this->mShear.Z()) * (u * Wide(a[z]) + v * Wide(b[z]) + w * Wide(c[z])) / determinant);
+			if (!(distance >= 0 && distance < pHit.mDistance))
+				return false;
+
+			pHit.mDistance = distance;
+			pHit.mU = T(v / determinant);
+			pHit.mV = T(w / determinant);
+			return true;
+		}
+
+	private:
+		Vec3<T> mOrigin;
+		Vec3<T> mDirection;
+		Vec3<T> mInverseDirection;
+		Vec3<T> mShear;
+		std::uint8_t mAxes[3] = { 0, 1, 2 };
+	};
+
+	typedef Ray<float> FRay;
+	typedef Ray<double> DRay;
+
+	static_assert(std::is_trivially_copyable_v<FRay>, "FRay must stay memcpy-able for ray batches");
+}
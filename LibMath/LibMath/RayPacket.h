@@ -0,0 +1,180 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "AABB.h"
+#include "Ray.h"
+#include "Simd.h"
+#include "Vec3Packet.h"
+#include "VertexStream.h"
+
+namespace lm
+{
+	/* -----
+	RayPacket<P> holds P::Width rays in SoA registers: Width rays against one box, or one ray
+	copied in every lane against Width triangles. Lane i of a triangle packet is tested
+	against lane i of the rays, the result masks give the lanes that hit.
+	----- */
+
+	template <typename P> class RayPacket
+	{
+	public:
+		using Pack = P;
+		using Mask = typename P::Mask;
+
+		static constexpr std::size_t Width = P::Width;
+
+		// same ray in every lane
+		RayPacket(const Ray<float>& pRay)
+			: mOrigin(pRay.GetOrigin()), mDirection(pRay.GetDirection()), mInverseDirection(pRay.GetInverseDirection())
+		{}
+
+		// reads Width rays from pSource
+		static RayPacket<P> Load(const Ray<float>* pSource)
+		{
+			Vec3<float> origins[Width], directions[Width], inverses[Width];
+			for (std::size_t i = 0; i < Width; i++)
+			{
+				origins[i] = pSource[i].GetOrigin();
+				directions[i] = pSource[i].GetDirection();
+				inverses[i] = pSource[i].GetInverseDirection();
+			}
+
+			return RayPacket<P>(Vec3Packet<P>::Load(origins), Vec3Packet<P>::Load(directions), Vec3Packet<P>::Load(inverses));
+		}
+
+		/* -----
+		Gathers triangles pFirst to pFirst + Width of an indexed mesh, positions pStride bytes
+		apart as in Strided (VertexStream.h).
+		----- */
+		static void GatherTriangles(const Vec3<float>* pPositions, const std::uint32_t* pIndices, const std::size_t pFirst,
+			Vec3Packet<P>& pA, Vec3Packet<P>& pB, Vec3Packet<P>& pC, const std::size_t pStride = sizeof(Vec3<float>))
+		{
+			const std::uint32_t* indices = pIndices + 3 * pFirst;
+
+			float corners[3][3][Width];
+			for (std::size_t i = 0; i < Width; i++)
+				for (std::size_t corner = 0; corner < 3; corner++)
+				{
+					const Vec3<float>& position = Strided(pPositions, indices[3 * i + corner], pStride);
+					corners[corner][0][i] = position.X();
+					corners[corner][1][i] = position.Y();
+					corners[corner][2][i] = position.Z();
+				}
+
+			pA = Vec3Packet<P>(P::Load(corners[0][0]), P::Load(corners[0][1]), P::Load(corners[0][2]));
+			pB = Vec3Packet<P>(P::Load(corners[1][0]), P::Load(corners[1][1]), P::Load(corners[1][2]));
+			pC = Vec3Packet<P>(P::Load(corners[2][0]), P::Load(corners[2][1]), P::Load(corners[2][2]));
+		}
+
+		const Vec3Packet<P>& GetOrigin() const { return mOrigin; }
+		const Vec3Packet<P>& GetDirection() const { return mDirection; }
+
+		// the slab test of Ray::IntersectBox in every lane, pEntry receives the entry distances
+		Mask IntersectBox(const AABB<float>& pBox, const P& pMaxDistance, P& pEntry) const
+		{
+			// Simd::Min and Max return their second operand on NaN, see Ray::IntersectBox
+			const P nearX = (P::Splat(pBox.mMin.X()) - this->mOrigin.X()) * this->mInverseDirection.X();
+			const P farX = (P::Splat(pBox.mMax.X()) - this->mOrigin.X()) * this->mInverseDirection.X();
+			const P nearY = (P::Splat(pBox.mMin.Y()) - this->mOrigin.Y()) * this->mInverseDirection.Y();
+			const P farY = (P::Splat(pBox.mMax.Y()) - this->mOrigin.Y()) * this->mInverseDirection.Y();
+			const P nearZ = (P::Splat(pBox.mMin.Z()) - this->mOrigin.Z()) * this->mInverseDirection.Z();
+			const P farZ = (P::Splat(pBox.mMax.Z()) - this->mOrigin.Z()) * this->mInverseDirection.Z();
+
+			pEntry = Simd::Max(Simd::Min(farZ, nearZ),
+				Simd::Max(Simd::Min(farY, nearY), Simd::Max(Simd::Min(farX, nearX), P::Splat(0))));
+			const P exit = Simd::Min(Simd::Max(nearZ, farZ),
+				Simd::Min(Simd::Max(nearY, farY), Simd::Min(Simd::Max(nearX, farX), pMaxDistance)));
+			return pEntry <= exit;
+		}
+
+		/* -----
+		Moller-Trumbore in every lane: a lane hits when its triangle is hit before pDistance, its
+		pDistance, pU and pV are then replaced and the other lanes are kept.
+		----- */
+		Mask IntersectTriangles(const Vec3Packet<P>& pA, const Vec3Packet<P>& pB, const Vec3Packet<P>& pC,
+			P& pDistance, P& pU, P& pV) const
+		{
+			const Vec3Packet<P> edge1 = pB - pA;
+			const Vec3Packet<P> edge2 = pC - pA;
+			const Vec3Packet<P> p = this->mDirection.CrossProduct(edge2);
+			const P determinant = edge1.DotProduct(p);
+			const P inverse = P::Splat(1) / determinant;
+
+			const Vec3Packet<P> s = this->mOrigin - pA;
+			const P u = s.DotProduct(p) * inverse;
+			const Vec3Packet<P> q = s.CrossProduct(edge1);
+			const P v = this->mDirection.DotProduct(q) * inverse;
+			const P distance = edge2.DotProduct(q) * inverse;
+
+			const P zero = P::Splat(0);
+			const Mask hit = (determinant != zero) & (u >= zero) & (v >= zero) & (u + v <= P::Splat(1)) &
+				(distance >= zero) & (distance < pDistance);
+
+			pDistance = Simd::Select(hit, distance, pDistance);
+			pU = Simd::Select(hit, u, pU);
+			pV = Simd::Select(hit, v, pV);
+			return hit;
+		}
+
+	private:
+		RayPacket(const Vec3Packet<P>& pOrigin, const Vec3Packet<P>& pDirection, const Vec3Packet<P>& pInverseDirection)
+			: mOrigin(pOrigin), mDirection(pDirection), mInverseDirection(pInverseDirection)
+		{}
+
+		Vec3Packet<P> mOrigin;
+		Vec3Packet<P> mDirection;
+		Vec3Packet<P> mInverseDirection;
+	};
+
+	typedef RayPacket<Simd::Float4>	Rayx4;
+	typedef RayPacket<Simd::Float8>	Rayx8;
+
+	/* -----
+	Closest hit of pRay among pTriangleCount indexed triangles, one ray against 8 triangles per
+	step then the scalar Moller-Trumbore for the rest. Only hits before pHit.mDistance count,
+	pHit.mPrimitive receives the triangle index. Positions are read as in GatherTriangles.
+	----- */
+	inline bool RaycastTriangles(const Ray<float>& pRay, const Vec3<float>* pPositions, const std::uint32_t* pIndices,
+		const std::size_t pTriangleCount, RayHit<float>& pHit, const std::size_t pStride = sizeof(Vec3<float>))
+	{
+		using Simd::Float8;
+
+		const Rayx8 packet(pRay);
+		bool hit = false;
+
+		std::size_t i = 0;
+		for (; i + Float8::Width <= pTriangleCount; i += Float8::Width)
+		{
+			Vec3x8 a, b, c;
+			Rayx8::GatherTriangles(pPositions, pIndices, i, a, b, c, pStride);
+
+			Float8 distance = Float8::Splat(pHit.mDistance);
+			Float8 u = Float8::Splat(0.f);
+			Float8 v = Float8::Splat(0.f);
+			const int lanes = packet.IntersectTriangles(a, b, c, distance, u, v).Bits();
+			if (lanes == 0)
+				continue;
+
+			float distances[Float8::Width], us[Float8::Width], vs[Float8::Width];
+			distance.Store(distances);
+			u.Store(us);
+			v.Store(vs);
+			for (std::size_t lane = 0; lane < Float8::Width; lane++)
+				if ((lanes >> lane & 1) != 0 && distances[lane] < pHit.mDistance)
+					pHit = { distances[lane], us[lane], vs[lane], std::uint32_t(i + lane) };
+			hit = true;
+		}
+
+		for (; i < pTriangleCount; i++)
+		{
+			if (pRay.IntersectTriangle(Strided(pPositions, pIndices[3 * i], pStride), Strided(pPositions, pIndices[3 * i + 1], pStride),
+				Strided(pPositions, pIndices[3 * i + 2], pStride), pHit))
+			{
+				pHit.mPrimitive = std::uint32_t(i);
+				hit = true;
+			}
+		}
+
+		return hit;
+	}
+}
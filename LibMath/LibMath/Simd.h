@@ -0,0 +1,1309 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/* -----
+Instruction set is selected at compile time from the compiler flags
+(/arch:AVX, -mavx, -msse2, x64 targets...).
+Define LIBMATH_NO_SIMD before including any LibMath header to force the scalar path.
+----- */
+
+#if !defined(LIBMATH_NO_SIMD)
+	#if defined(__AVX__)
+		#define LIBMATH_AVX
+	#endif
+
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define LIBMATH_SSE
+	#endif
+#endif
+
+#if defined(LIBMATH_AVX)
+#include <immintrin.h>
+#elif defined(LIBMATH_SSE)
+#include <emmintrin.h>
+#endif
+
+namespace lm
+{
+	namespace Simd
+	{
+		template <typename T> struct VectorAlignment
+		{
+			static constexpr std::size_t value = alignof(T);
+		};
+
+		template <> struct VectorAlignment<float>
+		{
+			static constexpr std::size_t value = 16;
+		};
+
+		// true when Vec4<T>/Mat4<T> route their arithmetic through the kernels below
+		template <typename T> constexpr bool IsAccelerated = std::is_same<T, float>::value;
+
+		/* -----
+		Intrinsics cannot run in constant expressions: constexpr functions check this before
+		taking an accelerated path so they fall back to their scalar code at compile time.
+		Without compiler support this returns false and accelerated types are runtime only.
+		----- */
+		constexpr bool IsConstantEvaluated() noexcept
+		{
+#if defined(__cpp_lib_is_constant_evaluated)
+			return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+			return __builtin_is_constant_evaluated();
+#else
+			return false;
+#endif
+		}
+
+		inline void Add4(const float* pLeft, const float* pRight, float* pResult)
+		{
+#if defined(LIBMATH_SSE)
+			_mm_storeu_ps(pResult, _mm_add_ps(_mm_loadu_ps(pLeft), _mm_loadu_ps(pRight)));
+#else
+			for (unsigned int i = 0; i < 4; i++)
+				pResult[i] = pLeft[i] + pRight[i];
+#endif
+		}
+
+		inline void Sub4(const float* pLeft, const float* pRight, float* pResult)
+		{
+#if defined(LIBMATH_SSE)
+			_mm_storeu_ps(pResult, _mm_sub_ps(_mm_loadu_ps(pLeft), _mm_loadu_ps(pRight)));
+#else
+			for (unsigned int i = 0; i < 4; i++)
+				pResult[i] = pLeft[i] - pRight[i];
+#endif
+		}
+
+		inline void Mul4(const float* pLeft, const float* pRight, float* pResult)
+		{
+#if defined(LIBMATH_SSE)
+			_mm_storeu_ps(pResult, _mm_mul_ps(_mm_loadu_ps(pLeft), _mm_loadu_ps(pRight)));
+#else
+			for (unsigned int i = 0; i < 4; i++)
+				pResult[i] = pLeft[i] * pRight[i];
+#endif
+		}
+
+		inline void Scale4(const float* pVec, const float pScale, float* pResult)
+		{
+#if defined(LIBMATH_SSE)
+			_mm_storeu_ps(pResult, _mm_mul_ps(_mm_loadu_ps(pVec), _mm_set1_ps(pScale)));
+#else
+			for (unsigned int i = 0; i < 4; i++)
+				pResult[i] = pVec[i] * pScale;
+#endif
+		}
+
+		inline float Dot4(const float* pLeft, const float* pRight)
+		{
+#if defined(LIBMATH_SSE)
+			const __m128 product = _mm_mul_ps(_mm_loadu_ps(pLeft), _mm_loadu_ps(pRight));
+			const __m128 pairs = _mm_add_ps(product, _mm_movehl_ps(product, product));
+			const __m128 sum = _mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 0x55));
+			return _mm_cvtss_f32(sum);
+#else
+			return (pLeft[0] * pRight[0]) + (pLeft[1] * pRight[1]) +
+				(pLeft[2] * pRight[2]) + (pLeft[3] * pRight[3]);
+#endif
+		}
+
+		// pResult[i] = pVec[pIi], pResult may alias pVec
+		template <int pI0, int pI1, int pI2, int pI3> inline void Shuffle4(const float* pVec, float* pResult)
+		{
+#if defined(LIBMATH_SSE)
+			const __m128 vec = _mm_loadu_ps(pVec);
+			_mm_storeu_ps(pResult, _mm_shuffle_ps(vec, vec, (pI3 << 6) | (pI2 << 4) | (pI1 << 2) | pI0));
+#else
+			const float x = pVec[pI0], y = pVec[pI1], z = pVec[pI2], w = pVec[pI3];
+			pResult[0] = x;
+			pResult[1] = y;
+			pResult[2] = z;
+			pResult[3] = w;
+#endif
+		}
+
+		/* -----
+		Matrices are 16 floats, row major, as laid out by Mat4<float>.
+		pResult may alias either operand.
+		----- */
+
+		inline void Mat4Multiply(const float* pLeft, const float* pRight, float* pResult)
+		{
+#if defined(LIBMATH_AVX)
+			const __m128 right0 = _mm_loadu_ps(pRight);
+			const __m128 right1 = _mm_loadu_ps(pRight + 4);
+			const __m128 right2 = _mm_loadu_ps(pRight + 8);
+			const __m128 right3 = _mm_loadu_ps(pRight + 12);
+
+			const __m256 wide0 = _mm256_broadcast_ps(&right0);
+			const __m256 wide1 = _mm256_broadcast_ps(&right1);
+			const __m256 wide2 = _mm256_broadcast_ps(&right2);
+			const __m256 wide3 = _mm256_broadcast_ps(&right3);
+
+			// two rows of the left matrix per iteration, one in each 128 bits lane
+			for (unsigned int i = 0; i < 16; i += 8)
+			{
+				const __m256 rows = _mm256_loadu_ps(pLeft + i);
+
+				__m256 result = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x00), wide0);
+				result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0x55), wide1));
+				result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xAA), wide2));
+				result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, 0xFF), wide3));
+
+				_mm256_storeu_ps(pResult + i, result);
+			}
+#elif defined(LIBMATH_SSE)
+			const __m128 right0 = _mm_loadu_ps(pRight);
+			const __m128 right1 = _mm_loadu_ps(pRight + 4);
+			const __m128 right2 = _mm_loadu_ps(pRight + 8);
+			const __m128 right3 = _mm_loadu_ps(pRight + 12);
+
+			for (unsigned int i = 0; i < 16; i += 4)
+			{
+				const __m128 row = _mm_loadu_ps(pLeft + i);
+
+				__m128 result = _mm_mul_ps(_mm_shuffle_ps(row, row, 0x00), right0);
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, 0x55), right1));
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xAA), right2));
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(row, row, 0xFF), right3));
+
+				_mm_storeu_ps(pResult + i, result);
+			}
+#else
+			float result[16];
+			for (unsigned int i = 0; i < 4; i++)
+				for (unsigned int j = 0; j < 4; j++)
+					result[i * 4 + j] = pLeft[i * 4] * pRight[j]
+						+ pLeft[i * 4 + 1] * pRight[4 + j]
+						+ pLeft[i * 4 + 2] * pRight[8 + j]
+						+ pLeft[i * 4 + 3] * pRight[12 + j];
+
+			for (unsigned int i = 0; i < 16; i++)
+				pResult[i] = result[i];
+#endif
+		}
+
+		// pResult = pVec.x * row0 + pVec.y * row1 + pVec.z * row2 + pVec.w * row3
+		inline void Mat4Transform(const float* pMatrix, const float* pVec, float* pResult)
+		{
+#if defined(LIBMATH_SSE)
+			const __m128 vec = _mm_loadu_ps(pVec);
+
+			__m128 result = _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0x00), _mm_loadu_ps(pMatrix));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0x55), _mm_loadu_ps(pMatrix + 4)));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0xAA), _mm_loadu_ps(pMatrix + 8)));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0xFF), _mm_loadu_ps(pMatrix + 12)));
+
+			_mm_storeu_ps(pResult, result);
+#else
+			float result[4];
+			for (unsigned int j = 0; j < 4; j++)
+				result[j] = (pMatrix[j] * pVec[0]) + (pMatrix[4 + j] * pVec[1]) +
+					(pMatrix[8 + j] * pVec[2]) + (pMatrix[12 + j] * pVec[3]);
+
+			for (unsigned int j = 0; j < 4; j++)
+				pResult[j] = result[j];
+#endif
+		}
+
+		/* -----
+		Stream versions of Mat4Transform. pIn and pOut may be the same array.
+		Vec3 streams are processed four at a time: the 12 floats are deinterleaved
+		into x/y/z registers, transformed, then interleaved back.
+		pW is the implicit fourth component (1 for points, 0 for directions).
+		----- */
+
+		inline void Mat4TransformVec3s(const float* pMatrix, const float* pIn, float* pOut,
+			const std::size_t pCount, const float pW)
+		{
+			std::size_t i = 0;
+
+#if defined(LIBMATH_SSE)
+			const __m128 m00 = _mm_set1_ps(pMatrix[0]), m01 = _mm_set1_ps(pMatrix[1]), m02 = _mm_set1_ps(pMatrix[2]);
+			const __m128 m10 = _mm_set1_ps(pMatrix[4]), m11 = _mm_set1_ps(pMatrix[5]), m12 = _mm_set1_ps(pMatrix[6]);
+			const __m128 m20 = _mm_set1_ps(pMatrix[8]), m21 = _mm_set1_ps(pMatrix[9]), m22 = _mm_set1_ps(pMatrix[10]);
+			const __m128 m30 = _mm_set1_ps(pMatrix[12] * pW);
+			const __m128 m31 = _mm_set1_ps(pMatrix[13] * pW);
+			const __m128 m32 = _mm_set1_ps(pMatrix[14] * pW);
+
+			for (; i + 4 <= pCount; i += 4)
+			{
+				const float* in = pIn + i * 3;
+				float* out = pOut + i * 3;
+
+				// a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+				const __m128 a = _mm_loadu_ps(in);
+				const __m128 b = _mm_loadu_ps(in + 4);
+				const __m128 c = _mm_loadu_ps(in + 8);
+
+				const __m128 ab = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+				const __m128 bc = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+				const __m128 x = _mm_shuffle_ps(a, bc, _MM_SHUFFLE(2, 0, 3, 0));
+				const __m128 y = _mm_shuffle_ps(ab, bc, _MM_SHUFFLE(3, 1, 2, 0));
+				const __m128 z = _mm_shuffle_ps(ab, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+				__m128 resultX = _mm_add_ps(_mm_mul_ps(x, m00), m30);
+				resultX = _mm_add_ps(resultX, _mm_mul_ps(y, m10));
+				resultX = _mm_add_ps(resultX, _mm_mul_ps(z, m20));
+
+				__m128 resultY = _mm_add_ps(_mm_mul_ps(x, m01), m31);
+				resultY = _mm_add_ps(resultY, _mm_mul_ps(y, m11));
+				resultY = _mm_add_ps(resultY, _mm_mul_ps(z, m21));
+
+				__m128 resultZ = _mm_add_ps(_mm_mul_ps(x, m02), m32);
+				resultZ = _mm_add_ps(resultZ, _mm_mul_ps(y, m12));
+				resultZ = _mm_add_ps(resultZ, _mm_mul_ps(z, m22));
+
+				const __m128 xyLow = _mm_unpacklo_ps(resultX, resultY);
+				const __m128 xyHigh = _mm_unpackhi_ps(resultX, resultY);
+
+				const __m128 zx = _mm_shuffle_ps(resultZ, xyLow, _MM_SHUFFLE(2, 2, 0, 0));
+				const __m128 yz = _mm_shuffle_ps(xyLow, resultZ, _MM_SHUFFLE(1, 1, 3, 3));
+				const __m128 zx2 = _mm_shuffle_ps(resultZ, xyHigh, _MM_SHUFFLE(2, 2, 2, 2));
+				const __m128 yz2 = _mm_shuffle_ps(xyHigh, resultZ, _MM_SHUFFLE(3, 3, 3, 3));
+
+				_mm_storeu_ps(out, _mm_shuffle_ps(xyLow, zx, _MM_SHUFFLE(2, 0, 1, 0)));
+				_mm_storeu_ps(out + 4, _mm_shuffle_ps(yz, xyHigh, _MM_SHUFFLE(1, 0, 2, 0)));
+				_mm_storeu_ps(out + 8, _mm_shuffle_ps(zx2, yz2, _MM_SHUFFLE(2, 0, 2, 0)));
+			}
+#endif
+
+			for (; i < pCount; i++)
+			{
+				const float x = pIn[i * 3];
+				const float y = pIn[i * 3 + 1];
+				const float z = pIn[i * 3 + 2];
+
+				pOut[i * 3] = (pMatrix[0] * x) + (pMatrix[4] * y) + (pMatrix[8] * z) + (pMatrix[12] * pW);
+				pOut[i * 3 + 1] = (pMatrix[1] * x) + (pMatrix[5] * y) + (pMatrix[9] * z) + (pMatrix[13] * pW);
+				pOut[i * 3 + 2] = (pMatrix[2] * x) + (pMatrix[6] * y) + (pMatrix[10] * z) + (pMatrix[14] * pW);
+			}
+		}
+
+		inline void Mat4TransformVec4s(const float* pMatrix, const float* pIn, float* pOut, const std::size_t pCount)
+		{
+#if defined(LIBMATH_SSE)
+			const __m128 row0 = _mm_loadu_ps(pMatrix);
+			const __m128 row1 = _mm_loadu_ps(pMatrix + 4);
+			const __m128 row2 = _mm_loadu_ps(pMatrix + 8);
+			const __m128 row3 = _mm_loadu_ps(pMatrix + 12);
+
+			for (std::size_t i = 0; i < pCount; i++)
+			{
+				const __m128 vec = _mm_loadu_ps(pIn + i * 4);
+
+				__m128 result = _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0x00), row0);
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0x55), row1));
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0xAA), row2));
+				result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(vec, vec, 0xFF), row3));
+
+				_mm_storeu_ps(pOut + i * 4, result);
+			}
+#else
+			for (std::size_t i = 0; i < pCount; i++)
+				Mat4Transform(pMatrix, pIn + i * 4, pOut + i * 4);
+#endif
+		}
+
+		inline void Mat4Transpose(const float* pMatrix, float* pResult)
+		{
+#if defined(LIBMATH_SSE)
+			__m128 row0 = _mm_loadu_ps(pMatrix);
+			__m128 row1 = _mm_loadu_ps(pMatrix + 4);
+			__m128 row2 = _mm_loadu_ps(pMatrix + 8);
+			__m128 row3 = _mm_loadu_ps(pMatrix + 12);
+
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+			_mm_storeu_ps(pResult, row0);
+			_mm_storeu_ps(pResult + 4, row1);
+			_mm_storeu_ps(pResult + 8, row2);
+			_mm_storeu_ps(pResult + 12, row3);
+#else
+			float result[16];
+			for (unsigned int i = 0; i < 4; i++)
+				for (unsigned int j = 0; j < 4; j++)
+					result[j * 4 + i] = pMatrix[i * 4 + j];
+
+			for (unsigned int i = 0; i < 16; i++)
+				pResult[i] = result[i];
+#endif
+		}
+
+		/* -----
+		General 4x4 inverse by Cramer's rule. The twelve 2x2 sub-determinants of the top
+		and bottom row pairs are computed once and shared by every cofactor, instead of
+		building sixteen 3x3 minors. Returns the determinant, the result is undefined when it is 0.
+		----- */
+
+		template <typename T> T Mat4Inverse(const T* pMatrix, T* pResult)
+		{
+			const T* m = pMatrix;
+
+			const T s0 = m[0] * m[5] - m[4] * m[1];
+			const T s1 = m[0] * m[6] - m[4] * m[2];
+			const T s2 = m[0] * m[7] - m[4] * m[3];
+			const T s3 = m[1] * m[6] - m[5] * m[2];
+			const T s4 = m[1] * m[7] - m[5] * m[3];
+			const T s5 = m[2] * m[7] - m[6] * m[3];
+
+			const T c5 = m[10] * m[15] - m[14] * m[11];
+			const T c4 = m[9] * m[15] - m[13] * m[11];
+			const T c3 = m[9] * m[14] - m[13] * m[10];
+			const T c2 = m[8] * m[15] - m[12] * m[11];
+			const T c1 = m[8] * m[14] - m[12] * m[10];
+			const T c0 = m[8] * m[13] - m[12] * m[9];
+
+			const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+			const T inv = T(1) / det;
+
+			T result[16];
+			result[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * inv;
+			result[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * inv;
+			result[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * inv;
+			result[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * inv;
+
+			result[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * inv;
+			result[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * inv;
+			result[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * inv;
+			result[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * inv;
+
+			result[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * inv;
+			result[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * inv;
+			result[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * inv;
+			result[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * inv;
+
+			result[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * inv;
+			result[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * inv;
+			result[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * inv;
+			result[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * inv;
+
+			for (unsigned int i = 0; i < 16; i++)
+				pResult[i] = result[i];
+
+			return det;
+		}
+
+#if defined(LIBMATH_SSE)
+		// lane selectors for _mm_shuffle_ps written in memory order (lane 0 first)
+		#define LIBMATH_SHUFFLE(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+
+		// 2x2 matrices packed as (m00, m01, m10, m11): pLeft * pRight
+		inline __m128 Mat2Multiply(const __m128 pLeft, const __m128 pRight)
+		{
+			return _mm_add_ps(_mm_mul_ps(pLeft, _mm_shuffle_ps(pRight, pRight, LIBMATH_SHUFFLE(0, 3, 0, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(pLeft, pLeft, LIBMATH_SHUFFLE(1, 0, 3, 2)),
+					_mm_shuffle_ps(pRight, pRight, LIBMATH_SHUFFLE(2, 1, 2, 1))));
+		}
+
+		// adjugate(pLeft) * pRight
+		inline __m128 Mat2AdjugateMultiply(const __m128 pLeft, const __m128 pRight)
+		{
+			return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(pLeft, pLeft, LIBMATH_SHUFFLE(3, 3, 0, 0)), pRight),
+				_mm_mul_ps(_mm_shuffle_ps(pLeft, pLeft, LIBMATH_SHUFFLE(1, 1, 2, 2)),
+					_mm_shuffle_ps(pRight, pRight, LIBMATH_SHUFFLE(2, 3, 0, 1))));
+		}
+
+		// pLeft * adjugate(pRight)
+		inline __m128 Mat2MultiplyAdjugate(const __m128 pLeft, const __m128 pRight)
+		{
+			return _mm_sub_ps(_mm_mul_ps(pLeft, _mm_shuffle_ps(pRight, pRight, LIBMATH_SHUFFLE(3, 0, 3, 0))),
+				_mm_mul_ps(_mm_shuffle_ps(pLeft, pLeft, LIBMATH_SHUFFLE(1, 0, 3, 2)),
+					_mm_shuffle_ps(pRight, pRight, LIBMATH_SHUFFLE(2, 1, 2, 1))));
+		}
+#endif
+
+		/* -----
+		SSE version works on the four 2x2 blocks | A B | C D | of the matrix, every block
+		determinant and adjugate product is shared between the four blocks of the inverse.
+		----- */
+
+		inline float Mat4Inverse(const float* pMatrix, float* pResult)
+		{
+#if defined(LIBMATH_SSE)
+			const __m128 row0 = _mm_loadu_ps(pMatrix);
+			const __m128 row1 = _mm_loadu_ps(pMatrix + 4);
+			const __m128 row2 = _mm_loadu_ps(pMatrix + 8);
+			const __m128 row3 = _mm_loadu_ps(pMatrix + 12);
+
+			const __m128 a = _mm_movelh_ps(row0, row1);
+			const __m128 b = _mm_movehl_ps(row1, row0);
+			const __m128 c = _mm_movelh_ps(row2, row3);
+			const __m128 d = _mm_movehl_ps(row3, row2);
+
+			// (|A|, |B|, |C|, |D|)
+			const __m128 detSub = _mm_sub_ps(
+				_mm_mul_ps(_mm_shuffle_ps(row0, row2, LIBMATH_SHUFFLE(0, 2, 0, 2)),
+					_mm_shuffle_ps(row1, row3, LIBMATH_SHUFFLE(1, 3, 1, 3))),
+				_mm_mul_ps(_mm_shuffle_ps(row0, row2, LIBMATH_SHUFFLE(1, 3, 1, 3)),
+					_mm_shuffle_ps(row1, row3, LIBMATH_SHUFFLE(0, 2, 0, 2))));
+
+			const __m128 detA = _mm_shuffle_ps(detSub, detSub, LIBMATH_SHUFFLE(0, 0, 0, 0));
+			const __m128 detB = _mm_shuffle_ps(detSub, detSub, LIBMATH_SHUFFLE(1, 1, 1, 1));
+			const __m128 detC = _mm_shuffle_ps(detSub, detSub, LIBMATH_SHUFFLE(2, 2, 2, 2));
+			const __m128 detD = _mm_shuffle_ps(detSub, detSub, LIBMATH_SHUFFLE(3, 3, 3, 3));
+
+			const __m128 adjDC = Mat2AdjugateMultiply(d, c);
+			const __m128 adjAB = Mat2AdjugateMultiply(a, b);
+
+			__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Multiply(b, adjDC));
+			__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Multiply(c, adjAB));
+			__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MultiplyAdjugate(d, adjAB));
+			__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MultiplyAdjugate(a, adjDC));
+
+			// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+			__m128 trace = _mm_mul_ps(adjAB, _mm_shuffle_ps(adjDC, adjDC, LIBMATH_SHUFFLE(0, 2, 1, 3)));
+			trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, LIBMATH_SHUFFLE(1, 0, 3, 2)));
+			trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, LIBMATH_SHUFFLE(2, 3, 0, 1)));
+
+			const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+			const __m128 inverseDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+			x = _mm_mul_ps(x, inverseDet);
+			y = _mm_mul_ps(y, inverseDet);
+			z = _mm_mul_ps(z, inverseDet);
+			w = _mm_mul_ps(w, inverseDet);
+
+			// adjugate shuffle of each block folded into the store
+			_mm_storeu_ps(pResult, _mm_shuffle_ps(x, y, LIBMATH_SHUFFLE(3, 1, 3, 1)));
+			_mm_storeu_ps(pResult + 4, _mm_shuffle_ps(x, y, LIBMATH_SHUFFLE(2, 0, 2, 0)));
+			_mm_storeu_ps(pResult + 8, _mm_shuffle_ps(z, w, LIBMATH_SHUFFLE(3, 1, 3, 1)));
+			_mm_storeu_ps(pResult + 12, _mm_shuffle_ps(z, w, LIBMATH_SHUFFLE(2, 0, 2, 0)));
+
+			return _mm_cvtss_f32(det);
+#else
+			return Mat4Inverse<float>(pMatrix, pResult);
+#endif
+		}
+
+#undef LIBMATH_SHUFFLE
+
+		/* -----
+		Allocator for std::vector lanes, 32 bytes is enough for AVX loads.
+		----- */
+
+		template <typename T, std::size_t Alignment = 32> struct AlignedAllocator
+		{
+			using value_type = T;
+
+			template <typename U> struct rebind
+			{
+				using other = AlignedAllocator<U, Alignment>;
+			};
+
+			AlignedAllocator() = default;
+
+			template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+			{}
+
+			T* allocate(const std::size_t pCount)
+			{
+				return static_cast<T*>(::operator new(pCount * sizeof(T), std::align_val_t(Alignment)));
+			}
+
+			void deallocate(T* pPointer, const std::size_t) noexcept
+			{
+				::operator delete(pPointer, std::align_val_t(Alignment));
+			}
+
+			template <typename U> bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+			{
+				return true;
+			}
+
+			template <typename U> bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept
+			{
+				return false;
+			}
+		};
+
+		/* -----
+		Lane packs. Float4 holds four floats in one SSE register (a plain array without SIMD),
+		Scalar<T> is the single lane version used for other types and for loop remainders.
+		Both expose the same interface so stream kernels are written once for any width.
+		----- */
+
+		template <typename T> struct Scalar
+		{
+			static constexpr std::size_t Width = 1;
+
+			T mValue;
+
+			static Scalar Load(const T* pSource)
+			{
+				return Scalar{ *pSource };
+			}
+
+			static Scalar Splat(const T pValue)
+			{
+				return Scalar{ pValue };
+			}
+
+			void Store(T* pDestination) const
+			{
+				*pDestination = this->mValue;
+			}
+
+			Scalar operator+(const Scalar& pOther) const
+			{
+				return Scalar{ this->mValue + pOther.mValue };
+			}
+
+			Scalar operator-(const Scalar& pOther) const
+			{
+				return Scalar{ this->mValue - pOther.mValue };
+			}
+
+			Scalar operator*(const Scalar& pOther) const
+			{
+				return Scalar{ this->mValue * pOther.mValue };
+			}
+
+			Scalar operator/(const Scalar& pOther) const
+			{
+				return Scalar{ this->mValue / pOther.mValue };
+			}
+		};
+
+		template <typename T> Scalar<T> Sqrt(const Scalar<T>& pValue)
+		{
+			return Scalar<T>{ std::sqrt(pValue.mValue) };
+		}
+
+		// Min and Max of every pack return pRight when a lane is NaN, as minps and maxps do
+		template <typename T> Scalar<T> Min(const Scalar<T>& pLeft, const Scalar<T>& pRight)
+		{
+			return Scalar<T>{ pLeft.mValue < pRight.mValue ? pLeft.mValue : pRight.mValue };
+		}
+
+		template <typename T> Scalar<T> Max(const Scalar<T>& pLeft, const Scalar<T>& pRight)
+		{
+			return Scalar<T>{ pLeft.mValue > pRight.mValue ? pLeft.mValue : pRight.mValue };
+		}
+
+		/* -----
+		Lane masks returned by pack comparisons, a set lane is all ones so it can be used
+		directly as a blend mask by Select.
+		----- */
+
+		struct Mask4
+		{
+			static constexpr std::size_t Width = 4;
+
+#if defined(LIBMATH_SSE)
+			__m128 mValue;
+
+			Mask4 operator&(const Mask4& pOther) const
+			{
+				return Mask4{ _mm_and_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask4 operator|(const Mask4& pOther) const
+			{
+				return Mask4{ _mm_or_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask4 operator^(const Mask4& pOther) const
+			{
+				return Mask4{ _mm_xor_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask4 operator!() const
+			{
+				return Mask4{ _mm_xor_ps(this->mValue, _mm_castsi128_ps(_mm_set1_epi32(-1))) };
+			}
+
+			// one bit per lane, lane 0 in bit 0
+			int Bits() const
+			{
+				return _mm_movemask_ps(this->mValue);
+			}
+#else
+			bool mValue[4];
+
+			Mask4 operator&(const Mask4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] && pOther.mValue[i];
+				return result;
+			}
+
+			Mask4 operator|(const Mask4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] || pOther.mValue[i];
+				return result;
+			}
+
+			Mask4 operator^(const Mask4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] != pOther.mValue[i];
+				return result;
+			}
+
+			Mask4 operator!() const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = !this->mValue[i];
+				return result;
+			}
+
+			int Bits() const
+			{
+				int bits = 0;
+				for (unsigned int i = 0; i < 4; i++)
+					bits |= int(this->mValue[i]) << i;
+				return bits;
+			}
+#endif
+
+			bool Any() const
+			{
+				return this->Bits() != 0;
+			}
+
+			bool All() const
+			{
+				return this->Bits() == 0xF;
+			}
+
+			bool None() const
+			{
+				return this->Bits() == 0;
+			}
+		};
+
+		struct Float4
+		{
+			using Mask = Mask4;
+
+			static constexpr std::size_t Width = 4;
+
+#if defined(LIBMATH_SSE)
+			__m128 mValue;
+
+			static Float4 Load(const float* pSource)
+			{
+				return Float4{ _mm_loadu_ps(pSource) };
+			}
+
+			static Float4 Splat(const float pValue)
+			{
+				return Float4{ _mm_set1_ps(pValue) };
+			}
+
+			void Store(float* pDestination) const
+			{
+				_mm_storeu_ps(pDestination, this->mValue);
+			}
+
+			Float4 operator+(const Float4& pOther) const
+			{
+				return Float4{ _mm_add_ps(this->mValue, pOther.mValue) };
+			}
+
+			Float4 operator-(const Float4& pOther) const
+			{
+				return Float4{ _mm_sub_ps(this->mValue, pOther.mValue) };
+			}
+
+			Float4 operator*(const Float4& pOther) const
+			{
+				return Float4{ _mm_mul_ps(this->mValue, pOther.mValue) };
+			}
+
+			Float4 operator/(const Float4& pOther) const
+			{
+				return Float4{ _mm_div_ps(this->mValue, pOther.mValue) };
+			}
+
+			Float4 operator-() const
+			{
+				return Float4{ _mm_xor_ps(this->mValue, _mm_set1_ps(-0.f)) };
+			}
+
+			Mask4 operator<(const Float4& pOther) const
+			{
+				return Mask4{ _mm_cmplt_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask4 operator<=(const Float4& pOther) const
+			{
+				return Mask4{ _mm_cmple_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask4 operator>(const Float4& pOther) const
+			{
+				return Mask4{ _mm_cmpgt_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask4 operator>=(const Float4& pOther) const
+			{
+				return Mask4{ _mm_cmpge_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask4 operator==(const Float4& pOther) const
+			{
+				return Mask4{ _mm_cmpeq_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask4 operator!=(const Float4& pOther) const
+			{
+				return Mask4{ _mm_cmpneq_ps(this->mValue, pOther.mValue) };
+			}
+#else
+			float mValue[4];
+
+			static Float4 Load(const float* pSource)
+			{
+				return Float4{ { pSource[0], pSource[1], pSource[2], pSource[3] } };
+			}
+
+			static Float4 Splat(const float pValue)
+			{
+				return Float4{ { pValue, pValue, pValue, pValue } };
+			}
+
+			void Store(float* pDestination) const
+			{
+				for (unsigned int i = 0; i < 4; i++)
+					pDestination[i] = this->mValue[i];
+			}
+
+			Float4 operator+(const Float4& pOther) const
+			{
+				Float4 result;
+				Add4(this->mValue, pOther.mValue, result.mValue);
+				return result;
+			}
+
+			Float4 operator-(const Float4& pOther) const
+			{
+				Float4 result;
+				Sub4(this->mValue, pOther.mValue, result.mValue);
+				return result;
+			}
+
+			Float4 operator*(const Float4& pOther) const
+			{
+				Float4 result;
+				Mul4(this->mValue, pOther.mValue, result.mValue);
+				return result;
+			}
+
+			Float4 operator/(const Float4& pOther) const
+			{
+				Float4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] / pOther.mValue[i];
+				return result;
+			}
+
+			Float4 operator-() const
+			{
+				return Float4{ { -this->mValue[0], -this->mValue[1], -this->mValue[2], -this->mValue[3] } };
+			}
+
+			Mask4 operator<(const Float4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] < pOther.mValue[i];
+				return result;
+			}
+
+			Mask4 operator<=(const Float4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] <= pOther.mValue[i];
+				return result;
+			}
+
+			Mask4 operator>(const Float4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] > pOther.mValue[i];
+				return result;
+			}
+
+			Mask4 operator>=(const Float4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] >= pOther.mValue[i];
+				return result;
+			}
+
+			Mask4 operator==(const Float4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] == pOther.mValue[i];
+				return result;
+			}
+
+			Mask4 operator!=(const Float4& pOther) const
+			{
+				Mask4 result;
+				for (unsigned int i = 0; i < 4; i++)
+					result.mValue[i] = this->mValue[i] != pOther.mValue[i];
+				return result;
+			}
+#endif
+		};
+
+		inline Float4 Sqrt(const Float4& pValue)
+		{
+#if defined(LIBMATH_SSE)
+			return Float4{ _mm_sqrt_ps(pValue.mValue) };
+#else
+			Float4 result;
+			for (unsigned int i = 0; i < 4; i++)
+				result.mValue[i] = std::sqrt(pValue.mValue[i]);
+			return result;
+#endif
+		}
+
+		// ~12 bits on SSE, refine with a Newton step
+		inline Float4 RsqrtEstimate(const Float4& pValue)
+		{
+#if defined(LIBMATH_SSE)
+			return Float4{ _mm_rsqrt_ps(pValue.mValue) };
+#else
+			return Float4::Splat(1.f) / Sqrt(pValue);
+#endif
+		}
+
+		inline Float4 Min(const Float4& pLeft, const Float4& pRight)
+		{
+#if defined(LIBMATH_SSE)
+			return Float4{ _mm_min_ps(pLeft.mValue, pRight.mValue) };
+#else
+			Float4 result;
+			for (unsigned int i = 0; i < 4; i++)
+				result.mValue[i] = pLeft.mValue[i] < pRight.mValue[i] ? pLeft.mValue[i] : pRight.mValue[i];
+			return result;
+#endif
+		}
+
+		inline Float4 Max(const Float4& pLeft, const Float4& pRight)
+		{
+#if defined(LIBMATH_SSE)
+			return Float4{ _mm_max_ps(pLeft.mValue, pRight.mValue) };
+#else
+			Float4 result;
+			for (unsigned int i = 0; i < 4; i++)
+				result.mValue[i] = pLeft.mValue[i] > pRight.mValue[i] ? pLeft.mValue[i] : pRight.mValue[i];
+			return result;
+#endif
+		}
+
+		inline Float4 Abs(const Float4& pValue)
+		{
+#if defined(LIBMATH_SSE)
+			return Float4{ _mm_andnot_ps(_mm_set1_ps(-0.f), pValue.mValue) };
+#else
+			Float4 result;
+			for (unsigned int i = 0; i < 4; i++)
+				result.mValue[i] = std::abs(pValue.mValue[i]);
+			return result;
+#endif
+		}
+
+		// lane-wise pMask ? pIfTrue : pIfFalse
+		inline Float4 Select(const Mask4& pMask, const Float4& pIfTrue, const Float4& pIfFalse)
+		{
+#if defined(LIBMATH_SSE)
+			return Float4{ _mm_or_ps(_mm_and_ps(pMask.mValue, pIfTrue.mValue),
+				_mm_andnot_ps(pMask.mValue, pIfFalse.mValue)) };
+#else
+			Float4 result;
+			for (unsigned int i = 0; i < 4; i++)
+				result.mValue[i] = pMask.mValue[i] ? pIfTrue.mValue[i] : pIfFalse.mValue[i];
+			return result;
+#endif
+		}
+
+		/* -----
+		Eight lane pack and mask: one AVX register, or two four lane halves otherwise.
+		----- */
+
+		struct Mask8
+		{
+			static constexpr std::size_t Width = 8;
+
+#if defined(LIBMATH_AVX)
+			__m256 mValue;
+
+			Mask8 operator&(const Mask8& pOther) const
+			{
+				return Mask8{ _mm256_and_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask8 operator|(const Mask8& pOther) const
+			{
+				return Mask8{ _mm256_or_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask8 operator^(const Mask8& pOther) const
+			{
+				return Mask8{ _mm256_xor_ps(this->mValue, pOther.mValue) };
+			}
+
+			Mask8 operator!() const
+			{
+				return Mask8{ _mm256_xor_ps(this->mValue, _mm256_castsi256_ps(_mm256_set1_epi32(-1))) };
+			}
+
+			int Bits() const
+			{
+				return _mm256_movemask_ps(this->mValue);
+			}
+#else
+			Mask4 mValue[2];
+
+			Mask8 operator&(const Mask8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] & pOther.mValue[0], this->mValue[1] & pOther.mValue[1] } };
+			}
+
+			Mask8 operator|(const Mask8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] | pOther.mValue[0], this->mValue[1] | pOther.mValue[1] } };
+			}
+
+			Mask8 operator^(const Mask8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] ^ pOther.mValue[0], this->mValue[1] ^ pOther.mValue[1] } };
+			}
+
+			Mask8 operator!() const
+			{
+				return Mask8{ { !this->mValue[0], !this->mValue[1] } };
+			}
+
+			int Bits() const
+			{
+				return this->mValue[0].Bits() | (this->mValue[1].Bits() << 4);
+			}
+#endif
+
+			bool Any() const
+			{
+				return this->Bits() != 0;
+			}
+
+			bool All() const
+			{
+				return this->Bits() == 0xFF;
+			}
+
+			bool None() const
+			{
+				return this->Bits() == 0;
+			}
+		};
+
+		struct Float8
+		{
+			using Mask = Mask8;
+
+			static constexpr std::size_t Width = 8;
+
+#if defined(LIBMATH_AVX)
+			__m256 mValue;
+
+			static Float8 Load(const float* pSource)
+			{
+				return Float8{ _mm256_loadu_ps(pSource) };
+			}
+
+			static Float8 Splat(const float pValue)
+			{
+				return Float8{ _mm256_set1_ps(pValue) };
+			}
+
+			void Store(float* pDestination) const
+			{
+				_mm256_storeu_ps(pDestination, this->mValue);
+			}
+
+			Float8 operator+(const Float8& pOther) const
+			{
+				return Float8{ _mm256_add_ps(this->mValue, pOther.mValue) };
+			}
+
+			Float8 operator-(const Float8& pOther) const
+			{
+				return Float8{ _mm256_sub_ps(this->mValue, pOther.mValue) };
+			}
+
+			Float8 operator*(const Float8& pOther) const
+			{
+				return Float8{ _mm256_mul_ps(this->mValue, pOther.mValue) };
+			}
+
+			Float8 operator/(const Float8& pOther) const
+			{
+				return Float8{ _mm256_div_ps(this->mValue, pOther.mValue) };
+			}
+
+			Float8 operator-() const
+			{
+				return Float8{ _mm256_xor_ps(this->mValue, _mm256_set1_ps(-0.f)) };
+			}
+
+			Mask8 operator<(const Float8& pOther) const
+			{
+				return Mask8{ _mm256_cmp_ps(this->mValue, pOther.mValue, _CMP_LT_OQ) };
+			}
+
+			Mask8 operator<=(const Float8& pOther) const
+			{
+				return Mask8{ _mm256_cmp_ps(this->mValue, pOther.mValue, _CMP_LE_OQ) };
+			}
+
+			Mask8 operator>(const Float8& pOther) const
+			{
+				return Mask8{ _mm256_cmp_ps(this->mValue, pOther.mValue, _CMP_GT_OQ) };
+			}
+
+			Mask8 operator>=(const Float8& pOther) const
+			{
+				return Mask8{ _mm256_cmp_ps(this->mValue, pOther.mValue, _CMP_GE_OQ) };
+			}
+
+			Mask8 operator==(const Float8& pOther) const
+			{
+				return Mask8{ _mm256_cmp_ps(this->mValue, pOther.mValue, _CMP_EQ_OQ) };
+			}
+
+			Mask8 operator!=(const Float8& pOther) const
+			{
+				return Mask8{ _mm256_cmp_ps(this->mValue, pOther.mValue, _CMP_NEQ_UQ) };
+			}
+#else
+			Float4 mValue[2];
+
+			static Float8 Load(const float* pSource)
+			{
+				return Float8{ { Float4::Load(pSource), Float4::Load(pSource + 4) } };
+			}
+
+			static Float8 Splat(const float pValue)
+			{
+				return Float8{ { Float4::Splat(pValue), Float4::Splat(pValue) } };
+			}
+
+			void Store(float* pDestination) const
+			{
+				this->mValue[0].Store(pDestination);
+				this->mValue[1].Store(pDestination + 4);
+			}
+
+			Float8 operator+(const Float8& pOther) const
+			{
+				return Float8{ { this->mValue[0] + pOther.mValue[0], this->mValue[1] + pOther.mValue[1] } };
+			}
+
+			Float8 operator-(const Float8& pOther) const
+			{
+				return Float8{ { this->mValue[0] - pOther.mValue[0], this->mValue[1] - pOther.mValue[1] } };
+			}
+
+			Float8 operator*(const Float8& pOther) const
+			{
+				return Float8{ { this->mValue[0] * pOther.mValue[0], this->mValue[1] * pOther.mValue[1] } };
+			}
+
+			Float8 operator/(const Float8& pOther) const
+			{
+				return Float8{ { this->mValue[0] / pOther.mValue[0], this->mValue[1] / pOther.mValue[1] } };
+			}
+
+			Float8 operator-() const
+			{
+				return Float8{ { -this->mValue[0], -this->mValue[1] } };
+			}
+
+			Mask8 operator<(const Float8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] < pOther.mValue[0], this->mValue[1] < pOther.mValue[1] } };
+			}
+
+			Mask8 operator<=(const Float8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] <= pOther.mValue[0], this->mValue[1] <= pOther.mValue[1] } };
+			}
+
+			Mask8 operator>(const Float8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] > pOther.mValue[0], this->mValue[1] > pOther.mValue[1] } };
+			}
+
+			Mask8 operator>=(const Float8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] >= pOther.mValue[0], this->mValue[1] >= pOther.mValue[1] } };
+			}
+
+			Mask8 operator==(const Float8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] == pOther.mValue[0], this->mValue[1] == pOther.mValue[1] } };
+			}
+
+			Mask8 operator!=(const Float8& pOther) const
+			{
+				return Mask8{ { this->mValue[0] != pOther.mValue[0], this->mValue[1] != pOther.mValue[1] } };
+			}
+#endif
+		};
+
+		inline Float8 Sqrt(const Float8& pValue)
+		{
+#if defined(LIBMATH_AVX)
+			return Float8{ _mm256_sqrt_ps(pValue.mValue) };
+#else
+			return Float8{ { Sqrt(pValue.mValue[0]), Sqrt(pValue.mValue[1]) } };
+#endif
+		}
+
+		inline Float8 RsqrtEstimate(const Float8& pValue)
+		{
+#if defined(LIBMATH_AVX)
+			return Float8{ _mm256_rsqrt_ps(pValue.mValue) };
+#else
+			return Float8{ { RsqrtEstimate(pValue.mValue[0]), RsqrtEstimate(pValue.mValue[1]) } };
+#endif
+		}
+
+		inline Float8 Abs(const Float8& pValue)
+		{
+#if defined(LIBMATH_AVX)
+			return Float8{ _mm256_andnot_ps(_mm256_set1_ps(-0.f), pValue.mValue) };
+#else
+			return Float8{ { Abs(pValue.mValue[0]), Abs(pValue.mValue[1]) } };
+#endif
+		}
+
+		inline Float8 Min(const Float8& pLeft, const Float8& pRight)
+		{
+#if defined(LIBMATH_AVX)
+			return Float8{ _mm256_min_ps(pLeft.mValue, pRight.mValue) };
+#else
+			return Float8{ { Min(pLeft.mValue[0], pRight.mValue[0]), Min(pLeft.mValue[1], pRight.mValue[1]) } };
+#endif
+		}
+
+		inline Float8 Max(const Float8& pLeft, const Float8& pRight)
+		{
+#if defined(LIBMATH_AVX)
+			return Float8{ _mm256_max_ps(pLeft.mValue, pRight.mValue) };
+#else
+			return Float8{ { Max(pLeft.mValue[0], pRight.mValue[0]), Max(pLeft.mValue[1], pRight.mValue[1]) } };
+#endif
+		}
+
+		inline Float8 Select(const Mask8& pMask, const Float8& pIfTrue, const Float8& pIfFalse)
+		{
+#if defined(LIBMATH_AVX)
+			return Float8{ _mm256_blendv_ps(pIfFalse.mValue, pIfTrue.mValue, pMask.mValue) };
+#else
+			return Float8{ { Select(pMask.mValue[0], pIfTrue.mValue[0], pIfFalse.mValue[0]),
+				Select(pMask.mValue[1], pIfTrue.mValue[1], pIfFalse.mValue[1]) } };
+#endif
+		}
+
+		/* -----
+		Polynomial approximations for Float4/Float8, valid on the ranges the quaternion blends use.
+		AcosUnit* take x in [0, 1]: acos(x) = sqrt(1 - x) * poly(x), Abramowitz & Stegun 4.4.45
+		(|error| <= 6.7e-5 rad) and 4.4.46 (|error| <= 2e-8 rad, so float rounding dominates).
+		SinHalfPi* take x in [-pi/2, pi/2]: odd Taylor series to x^7 (|error| <= 1.6e-4 at pi/2)
+		and to x^11 (|error| <= 6e-8).
+		----- */
+
+		template <typename P> P AcosUnitFast(const P& pValue)
+		{
+			P poly = P::Splat(-0.0187293f);
+			poly = poly * pValue + P::Splat(0.0742610f);
+			poly = poly * pValue + P::Splat(-0.2121144f);
+			poly = poly * pValue + P::Splat(1.5707288f);
+			return Sqrt(P::Splat(1.f) - pValue) * poly;
+		}
+
+		template <typename P> P AcosUnitPrecise(const P& pValue)
+		{
+			P poly = P::Splat(-0.0012624911f);
+			poly = poly * pValue + P::Splat(0.0066700901f);
+			poly = poly * pValue + P::Splat(-0.0170881256f);
+			poly = poly * pValue + P::Splat(0.0308918810f);
+			poly = poly * pValue + P::Splat(-0.0501743046f);
+			poly = poly * pValue + P::Splat(0.0889789874f);
+			poly = poly * pValue + P::Splat(-0.2145988016f);
+			poly = poly * pValue + P::Splat(1.5707963050f);
+			return Sqrt(P::Splat(1.f) - pValue) * poly;
+		}
+
+		template <typename P> P SinHalfPiFast(const P& pValue)
+		{
+			const P x2 = pValue * pValue;
+			P poly = P::Splat(-1.f / 5040.f);
+			poly = poly * x2 + P::Splat(1.f / 120.f);
+			poly = poly * x2 + P::Splat(-1.f / 6.f);
+			poly = poly * x2 + P::Splat(1.f);
+			return poly * pValue;
+		}
+
+		template <typename P> P SinHalfPiPrecise(const P& pValue)
+		{
+			const P x2 = pValue * pValue;
+			P poly = P::Splat(-1.f / 39916800.f);
+			poly = poly * x2 + P::Splat(1.f / 362880.f);
+			poly = poly * x2 + P::Splat(-1.f / 5040.f);
+			poly = poly * x2 + P::Splat(1.f / 120.f);
+			poly = poly * x2 + P::Splat(-1.f / 6.f);
+			poly = poly * x2 + P::Splat(1.f);
+			return poly * pValue;
+		}
+
+		// widest pack available for T
+		template <typename T> struct Pack
+		{
+			using Type = Scalar<T>;
+		};
+
+		template <> struct Pack<float>
+		{
+			using Type = Float4;
+		};
+
+		/* -----
+		Calls pFunction(pack, index) over [0, pCount) with the widest pack for T,
+		then once per remaining element with Scalar<T>.
+		----- */
+
+		template <typename T, typename Function> void ForEachPack(const std::size_t pCount, Function&& pFunction)
+		{
+			using Wide = typename Pack<T>::Type;
+
+			std::size_t i = 0;
+			for (; i + Wide::Width <= pCount; i += Wide::Width)
+				pFunction(Wide{}, i);
+
+			for (; i < pCount; i++)
+				pFunction(Scalar<T>{}, i);
+		}
+	}
+}
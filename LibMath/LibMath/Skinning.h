@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include "DualQuaternion.h"
+#include "Mat4.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include "Vertex.h"
+
+namespace lm
+{
+	namespace Skinning
+	{
+		/* -----
+		Skins [pBegin, pEnd): the palette matrices of a vertex are blended row by row with its
+		weights, one Float4 per row, then the position is transformed as a point and the normal
+		as a direction.
+		----- */
+
+		inline void SkinRange(const SkinnedVertex* pVertices, const std::size_t pBegin, const std::size_t pEnd,
+			const FMat4* pPalette, const std::size_t pPaletteSize, FVec3* pPositions, FVec3* pNormals)
+		{
+			using Simd::Float4;
+
+			for (std::size_t i = pBegin; i < pEnd; i++)
+			{
+				const SkinnedVertex& vertex = pVertices[i];
+
+				Float4 rows[4] = { Float4::Splat(0.f), Float4::Splat(0.f), Float4::Splat(0.f), Float4::Splat(0.f) };
+				for (std::size_t k = 0; k < SkinnedVertex::mMaxInfluences; k++)
+				{
+					const float weight = vertex.GetBoneWeight(k);
+					if (weight == 0.f)
+						continue;
+
+					assert(vertex.GetBoneIndex(k) < pPaletteSize && "SkinnedVertex bone outside the palette");
+					(void)pPaletteSize;
+
+					const float* bone = pPalette[vertex.GetBoneIndex(k)][0].Data();
+					const Float4 splat = Float4::Splat(weight);
+					for (int row = 0; row < 4; row++)
+						rows[row] = rows[row] + splat * Float4::Load(bone + 4 * row);
+				}
+
+				alignas(16) float result[4];
+
+				const FVec3& position = vertex.GetPosition();
+				(Float4::Splat(position.X()) * rows[0] + Float4::Splat(position.Y()) * rows[1] +
+					Float4::Splat(position.Z()) * rows[2] + rows[3]).Store(result);
+				pPositions[i] = FVec3(result[0], result[1], result[2]);
+
+				if (pNormals == nullptr)
+					continue;
+
+				const FVec3& normal = vertex.GetNormal();
+				(Float4::Splat(normal.X()) * rows[0] + Float4::Splat(normal.Y()) * rows[1] +
+					Float4::Splat(normal.Z()) * rows[2]).Store(result);
+
+				const float length2 = result[0] * result[0] + result[1] * result[1] + result[2] * result[2];
+				const float invLength = length2 > 0.f ? 1.f / std::sqrt(length2) : 0.f;
+				pNormals[i] = FVec3(result[0] * invLength, result[1] * invLength, result[2] * invLength);
+			}
+		}
+
+		/* -----
+		Dual quaternion variant, four vertices at a time: the bones of a vertex are blended as a
+		real and a dual Float4, flipped into the hemisphere of its first weighted bone. The four blends
+		are transposed so each lane holds one vertex, then the normalization and the rigid
+		transform of position and normal run lane-wise. No matrix is built and the normal stays
+		unit.
+		----- */
+
+		inline void SkinRange(const SkinnedVertex* pVertices, const std::size_t pBegin, const std::size_t pEnd,
+			const FDualQuat* pPalette, const std::size_t pPaletteSize, FVec3* pPositions, FVec3* pNormals)
+		{
+			using Simd::Float4;
+			constexpr std::size_t lanes = Float4::Width;
+
+			for (std::size_t i = pBegin; i < pEnd; i += lanes)
+			{
+				// one row per vertex in the w x y z order of FQuat, a short tail repeats the last vertex
+				alignas(16) float real[4 * lanes];
+				alignas(16) float dual[4 * lanes];
+				alignas(16) float position[3][lanes];
+				alignas(16) float normal[3][lanes];
+
+				for (std::size_t lane = 0; lane < lanes; lane++)
+				{
+					const SkinnedVertex& vertex = pVertices[std::min(i + lane, pEnd - 1)];
+
+					// an unused slot may name any bone, the pivot is the first one with a weight
+					std::size_t first = 0;
+					while (first + 1 < SkinnedVertex::mMaxInfluences && vertex.GetBoneWeight(first) == 0.f)
+						first++;
+
+					assert(vertex.GetBoneIndex(first) < pPaletteSize && "SkinnedVertex bone outside the palette");
+					const float* pivot = reinterpret_cast<const float*>(&pPalette[vertex.GetBoneIndex(first)].mReal);
+
+					Float4 blendReal = Float4::Splat(0.f);
+					Float4 blendDual = Float4::Splat(0.f);
+					for (std::size_t k = 0; k < SkinnedVertex::mMaxInfluences; k++)
+					{
+						const float weight = vertex.GetBoneWeight(k);
+						if (weight == 0.f)
+							continue;
+
+						assert(vertex.GetBoneIndex(k) < pPaletteSize && "SkinnedVertex bone outside the palette");
+						(void)pPaletteSize;
+
+						// branchless: the hemisphere of a bone is data dependent and would mispredict
+						const float* bone = reinterpret_cast<const float*>(&pPalette[vertex.GetBoneIndex(k)]);
+						const Float4 signedWeight = Float4::Splat(std::copysign(weight, Simd::Dot4(pivot, bone)));
+						blendReal = blendReal + signedWeight * Float4::Load(bone);
+						blendDual = blendDual + signedWeight * Float4::Load(bone + 4);
+					}
+
+					blendReal.Store(real + 4 * lane);
+					blendDual.Store(dual + 4 * lane);
+					for (int axis = 0; axis < 3; axis++)
+					{
+						position[axis][lane] = vertex.GetPosition()[axis];
+						normal[axis][lane] = vertex.GetNormal()[axis];
+					}
+				}
+
+				Simd::Mat4Transpose(real, real);
+				Simd::Mat4Transpose(dual, dual);
+
+				const Float4 realW = Float4::Load(real);
+				const Float4 realX = Float4::Load(real + lanes);
+				const Float4 realY = Float4::Load(real + 2 * lanes);
+				const Float4 realZ = Float4::Load(real + 3 * lanes);
+				const Float4 length2 = realW * realW + realX * realX + realY * realY + realZ * realZ;
+				const Float4 invLength = Float4::Splat(1.f) / Simd::Sqrt(length2);
+
+				// a vertex without weights blends to 0: its lanes are written as 0, as the matrix kernel does
+				const Float4 zero = Float4::Splat(0.f);
+				const Simd::Mask4 weighted = length2 > zero;
+
+				const Float4 w = realW * invLength;
+				const Float4 x = realX * invLength;
+				const Float4 y = realY * invLength;
+				const Float4 z = realZ * invLength;
+				const Float4 dualW = Float4::Load(dual) * invLength;
+				const Float4 dualX = Float4::Load(dual + lanes) * invLength;
+				const Float4 dualY = Float4::Load(dual + 2 * lanes) * invLength;
+				const Float4 dualZ = Float4::Load(dual + 3 * lanes) * invLength;
+				const Float4 two = Float4::Splat(2.f);
+
+				// v + 2 r x (r x v + w v), as DualQuaternion::TransformDirection
+				const auto rotate = [&](const float (&pVector)[3][lanes], Float4 (&pResult)[3])
+				{
+					const Float4 vx = Float4::Load(pVector[0]);
+					const Float4 vy = Float4::Load(pVector[1]);
+					const Float4 vz = Float4::Load(pVector[2]);
+
+					const Float4 cx = y * vz - z * vy + w * vx;
+					const Float4 cy = z * vx - x * vz + w * vy;
+					const Float4 cz = x * vy - y * vx + w * vz;
+
+					pResult[0] = vx + two * (y * cz - z * cy);
+					pResult[1] = vy + two * (z * cx - x * cz);
+					pResult[2] = vz + two * (x * cy - y * cx);
+				};
+
+				Float4 skinned[3];
+				alignas(16) float result[3][lanes];
+				const std::size_t count = std::min(lanes, pEnd - i);
+
+				// translation 2 (w d - dw r + r x d), as DualQuaternion::GetTranslation
+				rotate(position, skinned);
+				Simd::Select(weighted, skinned[0] + two * (dualX * w - x * dualW + y * dualZ - z * dualY), zero).Store(result[0]);
+				Simd::Select(weighted, skinned[1] + two * (dualY * w - y * dualW + z * dualX - x * dualZ), zero).Store(result[1]);
+				Simd::Select(weighted, skinned[2] + two * (dualZ * w - z * dualW + x * dualY - y * dualX), zero).Store(result[2]);
+				for (std::size_t lane = 0; lane < count; lane++)
+					pPositions[i + lane] = FVec3(result[0][lane], result[1][lane], result[2][lane]);
+
+				if (pNormals == nullptr)
+					continue;
+
+				rotate(normal, skinned);
+				for (int axis = 0; axis < 3; axis++)
+					Simd::Select(weighted, skinned[axis], zero).Store(result[axis]);
+				for (std::size_t lane = 0; lane < count; lane++)
+					pNormals[i + lane] = FVec3(result[0][lane], result[1][lane], result[2][lane]);
+			}
+		}
+	}
+
+	/* -----
+	Linear blend skinning of a whole mesh against a bone palette (row-vector convention, the
+	palette holds bind-inverse * bone world matrices). Weights are expected to sum to 1.
+	Normals go through the blended matrix and are renormalized, which is exact for rotations and
+	uniform scales; pNormals may be null to skip them. Threaded by vertex ranges as described
+	in Parallel.h. The outputs must not alias the input vertices.
+	----- */
+
+	inline void SkinVertices(const SkinnedVertex* pVertices, const std::size_t pCount, const FMat4* pPalette,
+		const std::size_t pPaletteSize, FVec3* pPositions, FVec3* pNormals = nullptr, const unsigned int pThreadCount = 0)
+	{
+		Parallel::ForRanges(pCount, Parallel::mMinElementsPerThread, pThreadCount,
+			[=](const std::size_t pBegin, const std::size_t pEnd)
+			{
+				Skinning::SkinRange(pVertices, pBegin, pEnd, pPalette, pPaletteSize, pPositions, pNormals);
+			});
+	}
+
+	/* -----
+	Dual quaternion skinning with the same threading and outputs, the palette holds unit
+	world * bind-inverse transforms (a * b applies b first). Rigid bones only, scaled bones
+	need the matrix palette. A bone is half the size of a matrix and blended joints keep their
+	volume, at the price of a costlier transform per vertex than the blended matrix kernel.
+	A vertex whose weights are all 0 is skinned to 0 like with the matrix palette.
+	----- */
+
+	inline void SkinVertices(const SkinnedVertex* pVertices, const std::size_t pCount, const FDualQuat* pPalette,
+		const std::size_t pPaletteSize, FVec3* pPositions, FVec3* pNormals = nullptr, const unsigned int pThreadCount = 0)
+	{
+		Parallel::ForRanges(pCount, Parallel::mMinElementsPerThread, pThreadCount,
+			[=](const std::size_t pBegin, const std::size_t pEnd)
+			{
+				Skinning::SkinRange(pVertices, pBegin, pEnd, pPalette, pPaletteSize, pPositions, pNormals);
+			});
+	}
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <type_traits>
+#include <cmath>
+#include "Quaternion.h"
+
+namespace lm
+{
+	/* -----
+	Translation, rotation and scale kept apart: a point is scaled, rotated then translated.
+	Composing and inverting cost a few quaternion and vector products instead of 4x4 matrix
+	products, the matrix is only built by ToMat4. Like Quaternion, a * b applies b first then a.
+	mRotation must stay unit.
+	----- */
+
+	template <typename T> class Transform
+	{
+	public:
+		Vec3<T> mTranslation;
+		Quaternion<T> mRotation;
+		Vec3<T> mScale;
+
+		static const Transform<T> mIdentity;
+
+		constexpr Transform()
+			: mTranslation(), mRotation(0, 0, 0, 1), mScale(1, 1, 1)
+		{}
+
+		constexpr Transform(const Vec3<T>& pTranslation, const Quaternion<T>& pRotation = Quaternion<T>(0, 0, 0, 1),
+			const Vec3<T>& pScale = Vec3<T>(1, 1, 1))
+			: mTranslation(pTranslation), mRotation(pRotation), mScale(pScale)
+		{}
+
+		/* Rule of five */
+		Transform(const Transform<T>& pOther) = default;
+		Transform(Transform<T>&& pOther) noexcept = default;
+		Transform<T>& operator=(const Transform<T>& pOther) = default;
+		Transform<T>& operator=(Transform<T>&& pOther) noexcept = default;
+
+		/**/
+
+		/* -----
+		Exact when this transform has a uniform scale. A non-uniform parent scale under a
+		rotated child is a shear, which TRS cannot hold: the scales are multiplied component-wise.
+		----- */
+		constexpr Transform<T> operator*(const Transform<T>& pOther) const
+		{
+			return Transform<T>(this->TransformPoint(pOther.mTranslation), this->mRotation * pOther.mRotation,
+				this->mScale * pOther.mScale);
+		}
+
+		constexpr void operator*=(const Transform<T>& pOther)
+		{
+			*this = *this * pOther;
+		}
+
+		constexpr bool operator==(const Transform<T>& pOther) const
+		{
+			return this->mTranslation == pOther.mTranslation && this->mRotation == pOther.mRotation &&
+				this->mScale == pOther.mScale;
+		}
+
+		constexpr bool operator!=(const Transform<T>& pOther) const
+		{
+			return !(*this == pOther);
+		}
+
+		constexpr bool ApproxEqual(const Transform<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
+		{
+			return this->mTranslation.ApproxEqual(pOther.mTranslation, pAbsEps, pRelEps) &&
+				this->mRotation.ApproxEqual(pOther.mRotation, pAbsEps, pRelEps) &&
+				this->mScale.ApproxEqual(pOther.mScale, pAbsEps, pRelEps);
+		}
+
+		// exact for a uniform scale, see InverseTransformPoint otherwise
+		constexpr Transform<T> Inverse() const
+		{
+			const Vec3<T> invScale(T(1) / this->mScale.X(), T(1) / this->mScale.Y(), T(1) / this->mScale.Z());
+			const Quaternion<T> invRotation = this->mRotation.Conjugate();
+
+			return Transform<T>(-(invScale * Rotate(invRotation, this->mTranslation)), invRotation, invScale);
+		}
+
+		constexpr Vec3<T> TransformPoint(const Vec3<T>& pPoint) const
+		{
+			return Rotate(this->mRotation, this->mScale * pPoint) + this->mTranslation;
+		}
+
+		// scaled and rotated, not translated: the w = 0 case of ToMat4
+		constexpr Vec3<T> TransformDirection(const Vec3<T>& pDirection) const
+		{
+			return Rotate(this->mRotation, this->mScale * pDirection);
+		}
+
+		constexpr Vec3<T> InverseTransformPoint(const Vec3<T>& pPoint) const
+		{
+			const Vec3<T> local = Rotate(this->mRotation.Conjugate(), pPoint - this->mTranslation);
+			return Vec3<T>(local.X() / this->mScale.X(), local.Y() / this->mScale.Y(), local.Z() / this->mScale.Z());
+		}
+
+		// rows of the rotation scaled by mScale, translation in row 3 (row-vector convention)
+		constexpr Mat4<T> ToMat4() const
+		{
+			const T x = this->mRotation.mX;
+			const T y = this->mRotation.mY;
+			const T z = this->mRotation.mZ;
+			const T w = this->mRotation.mW;
+			const T sx = this->mScale.X();
+			const T sy = this->mScale.Y();
+			const T sz = this->mScale.Z();
+
+			return Mat4<T>(
+				Vec4<T>((1 - 2 * (y * y + z * z)) * sx, 2 * (x * y + w * z) * sx, 2 * (x * z - w * y) * sx, 0),
+				Vec4<T>(2 * (x * y - w * z) * sy, (1 - 2 * (x * x + z * z)) * sy, 2 * (y * z + w * x) * sy, 0),
+				Vec4<T>(2 * (x * z + w * y) * sz, 2 * (y * z - w * x) * sz, (1 - 2 * (x * x + y * y)) * sz, 0),
+				Vec4<T>(this->mTranslation.X(), this->mTranslation.Y(), this->mTranslation.Z(), 1));
+		}
+
+		// component-wise lerp, Nlerp of the rotation
+		static Transform<T> Lerp(const Transform<T>& pStart, const Transform<T>& pEnd, const float pAlpha)
+		{
+			return Transform<T>(pStart.mTranslation + (pEnd.mTranslation - pStart.mTranslation) * T(pAlpha),
+				Quaternion<T>::Nlerp(pStart.mRotation, pEnd.mRotation, pAlpha),
+				pStart.mScale + (pEnd.mScale - pStart.mScale) * T(pAlpha));
+		}
+
+		// component-wise lerp, Slerp of the rotation
+		static Transform<T> Slerp(const Transform<T>& pStart, const Transform<T>& pEnd, const float pAlpha)
+		{
+			return Transform<T>(pStart.mTranslation + (pEnd.mTranslation - pStart.mTranslation) * T(pAlpha),
+				Quaternion<T>::Slerp(pStart.mRotation, pEnd.mRotation, pAlpha),
+				pStart.mScale + (pEnd.mScale - pStart.mScale) * T(pAlpha));
+		}
+
+	private:
+		// q v q* for a unit q, as v + 2 r x (r x v + w v)
+		static constexpr Vec3<T> Rotate(const Quaternion<T>& pRotation, const Vec3<T>& pVector)
+		{
+			const Vec3<T> real(pRotation.mX, pRotation.mY, pRotation.mZ);
+			return pVector + real.CrossProduct(real.CrossProduct(pVector) + pVector * pRotation.mW) * T(2);
+		}
+	};
+
+	template<class T> constexpr Transform<T> Transform<T>::mIdentity = Transform<T>();
+
+	typedef Transform<float> FTransform;
+	typedef Transform<double> DTransform;
+
+	static_assert(std::is_trivially_copyable_v<FTransform> && std::is_standard_layout_v<FTransform>,
+		"FTransform must be trivially copyable and standard layout");
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -23,35 +27,92 @@ namespace lm
 {
 	namespace Utilities
 	{
-		inline const double RadiansToDegrees(const double pRad)
+		constexpr double RadiansToDegrees(const double pRad)
 		{
 			return pRad * (HALF_CIRCLE / M_PI);
 		}
 
-		inline const double DegreesToRadians(const double pDeg)
+		constexpr double DegreesToRadians(const double pDeg)
 		{
 			return pDeg * (M_PI / HALF_CIRCLE);
 		}
 
-		inline float FClamp(const float pValue, const float pLower, const float pUpper)
+		constexpr float FClamp(const float pValue, const float pLower, const float pUpper)
 		{
 			return std::max(pLower, std::min(pValue, pUpper));
 		}
 
-		inline float FLerp(const float pMin, const float pMax, const float pValue)
+		constexpr float FLerp(const float pMin, const float pMax, const float pValue)
 		{
 			return pMin + pValue * (pMax - pMin);
 		}
 
-		inline float FUnLerp(const float pMin, const float pMax, const float pValue)
+		constexpr float FUnLerp(const float pMin, const float pMax, const float pValue)
 		{
 			return (pValue - pMin) / (pMax - pMin);
 		}
 
-		inline float MapInRange(const float pValue, const float pInMin, const float pInMax,
+		constexpr float MapInRange(const float pValue, const float pInMin, const float pInMax,
 			const float pOutMin, const float pOutMax)
 		{
 			return (pValue - pInMin) / (pInMax - pInMin) * (pOutMax - pOutMin) + pOutMin;
 		}
+
+		/* -----
+		Scalar comparisons shared by the vector, matrix and quaternion types.
+		ApproxEqual passes when the difference is within pAbsEps (needed around zero)
+		or within pRelEps of the larger magnitude.
+		UlpDistance counts the representable values between two floats: 0 means equal
+		(+0 and -0 included), 1 means neighbours. UlpEqual never matches NaN.
+		----- */
+
+		template <typename T> constexpr T Abs(const T pValue)
+		{
+			return pValue < T(0) ? -pValue : pValue;
+		}
+
+		template <typename T> constexpr bool ApproxEqual(const T pA, const T pB,
+			const T pAbsEps = std::numeric_limits<T>::epsilon(), const T pRelEps = std::numeric_limits<T>::epsilon())
+		{
+			const T diff = Abs(pA - pB);
+			if (diff <= pAbsEps)
+				return true;
+
+			return diff <= pRelEps * std::max(Abs(pA), Abs(pB));
+		}
+
+		// maps the sign-magnitude bit pattern onto a monotonic unsigned range
+		inline std::uint32_t OrderedBits(const float pValue)
+		{
+			std::uint32_t bits;
+			std::memcpy(&bits, &pValue, sizeof(bits));
+			return (bits & 0x80000000u) ? 0x80000000u - (bits & 0x7FFFFFFFu) : 0x80000000u + bits;
+		}
+
+		inline std::uint64_t OrderedBits(const double pValue)
+		{
+			constexpr std::uint64_t sign = 0x8000000000000000ull;
+
+			std::uint64_t bits;
+			std::memcpy(&bits, &pValue, sizeof(bits));
+			return (bits & sign) ? sign - (bits & ~sign) : sign + bits;
+		}
+
+		template <typename T> auto UlpDistance(const T pA, const T pB)
+		{
+			static_assert(std::is_floating_point_v<T>, "UlpDistance needs a float or a double");
+
+			const auto a = OrderedBits(pA);
+			const auto b = OrderedBits(pB);
+			return a > b ? a - b : b - a;
+		}
+
+		template <typename T> bool UlpEqual(const T pA, const T pB, const unsigned int pMaxUlps = 4)
+		{
+			if (pA != pA || pB != pB)
+				return false;
+
+			return UlpDistance(pA, pB) <= pMaxUlps;
+		}
 	};
 }
\ No newline at end of file
@@ -1,8 +1,12 @@
 #pragma once
+#include <type_traits>
 
 #define _USE_MATH_DEFINES_
 #include <cmath>
-#include "Utilities.h"
+#include "FastMath.h"
+#include <cassert>
+#include <cstddef>
+#include <utility>
 
 #include <iostream>
 #include <string>
@@ -16,8 +20,7 @@ namespace lm
 	template <typename T> class Vec2
 	{
 	private:
-		T mX;
-		T mY;
+		T mData[2];
 
 	public:
 		static const T mUnitVal;
@@ -28,102 +31,67 @@ namespace lm
 		static const Vec2<T> mLeft;
 		static const Vec2<T> mRight;
 
-		Vec2()
-		{
-			this->mX = 0;
-			this->mY = 0;
-		}
-
-		Vec2(const T init)
-		{
-			this->mX = init;
-			this->mY = init;
-		}
-
-		Vec2(const T pX, const T pY)
-		{
-			this->mX = pX;
-			this->mY = pY;
-		}
-
-		Vec2(const Vec2<T>& pOther)
-		{
-			this->mX = pOther.mX;
-			this->mY = pOther.mY;
-		}
-
-		Vec2(Vec2<T>&& pOther) noexcept
-		{
-			this->mX = std::move(pOther.mX);
-			this->mY = std::move(pOther.mY);
-		}
+		constexpr Vec2()
+			: mData{ 0, 0 }
+		{}
 
-		Vec2<T>& operator=(const Vec2<T>& pOther)
-		{
-			if (this == &pOther)
-				return *this;
+		constexpr Vec2(const T init)
+			: mData{ init, init }
+		{}
 
-			this->mX = pOther.mX;
-			this->mY = pOther.mY;
+		constexpr Vec2(const T pX, const T pY)
+			: mData{ pX, pY }
+		{}
 
-			return *this;
-		}
+		Vec2(const Vec2<T>& pOther) = default;
+		Vec2(Vec2<T>&& pOther) noexcept = default;
+		Vec2<T>& operator=(const Vec2<T>& pOther) = default;
+		Vec2<T>& operator=(Vec2<T>&& pOther) noexcept = default;
 
-		Vec2<T>& operator=(Vec2<T>&& pOther) noexcept
+		constexpr T& X()
 		{
-			if (this == &pOther)
-				return *this;
-
-			this->mX = std::move(pOther.mX);
-			this->mY = std::move(pOther.mY);
-
-			return *this;
+			return this->mData[0];
 		}
 
-		T& X()
+		constexpr T& Y()
 		{
-			return this->mX;
+			return this->mData[1];
 		}
 
-		T& Y()
+		constexpr T X() const
 		{
-			return this->mY;
+			return this->mData[0];
 		}
 
-		T X() const
+		constexpr T Y() const
 		{
-			return this->mX;
-		}
-
-		T Y() const
-		{
-			return this->mY;
+			return this->mData[1];
 		}
 
 		const T Length() const
 		{
-			return sqrt((this->mX * this->mX) + (this->mY * this->mY));
+			return sqrt((this->mData[0] * this->mData[0]) + (this->mData[1] * this->mData[1]));
 		}
 
-		const T Length2() const
+		constexpr const T Length2() const
 		{
-			return (this->mX * this->mX) + (this->mY * this->mY);
+			return (this->mData[0] * this->mData[0]) + (this->mData[1] * this->mData[1]);
 		}
 
-		bool IsLongerThan(Vec2<T> const& pOther) const	// return true if this vector Length2 is greater than the other
+		constexpr bool IsLongerThan(Vec2<T> const& pOther) const	// return true if this vector Length2 is greater than the other
 		{
-			return this->Length() > pOther.Length();
+			return this->Length2() > pOther.Length2();
 		}
 
-		bool IsShorterThan(Vec2<T> const& pOther) const	// return true if this vector Length2 is less than the other
+		constexpr bool IsShorterThan(Vec2<T> const& pOther) const	// return true if this vector Length2 is less than the other
 		{
-			return this->Length() < pOther.Length();
+			return this->Length2() < pOther.Length2();
 		}
 
 		const T DistanceFrom(Vec2<T> const& pOther) const // return distance between 2 points
 		{
-			return sqrt((pOther.mX - this.mX) * (pOther.mX - this.mX) +
-				(pOther.mY - this.mY) * (pOther.mY - this.mY));
+			return sqrt((pOther.mData[0] - this->mData[0]) * (pOther.mData[0] - this->mData[0]) +
+				(pOther.mData[1] - this->mData[1]) * (pOther.mData[1] - this->mData[1]));
 		}
 
 		const bool IsUnit() const
@@ -133,14 +101,14 @@ namespace lm
 				std::max(std::abs(this->Length()), std::abs(Vec2<T>::mUnitVal));
 		}
 
-		const T DotProduct(const Vec2<T>& pOther) const
+		constexpr const T DotProduct(const Vec2<T>& pOther) const
 		{
-			return (this->mX * pOther.mX) + (this->mY * pOther.mY);
+			return (this->mData[0] * pOther.mData[0]) + (this->mData[1] * pOther.mData[1]);
 		}
 
-		const T CrossProduct(const Vec2<T>& pOther) const
+		constexpr const T CrossProduct(const Vec2<T>& pOther) const
 		{
-			return (this->mX* pOther.mY) - (this->mY * pOther.mX);
+			return (this->mData[0]* pOther.mData[1]) - (this->mData[1] * pOther.mData[0]);
 		}
 
 		const T RadAngle(const Vec2<T>& pOther) const
@@ -161,13 +129,13 @@ namespace lm
 			return(const T)Utilities::RadiansToDegrees(this->RadAngle(pOther));
 		}
 
-		Vec2<T> ProjectOnTo(const Vec2<T>& pOther) const
+		constexpr Vec2<T> ProjectOnTo(const Vec2<T>& pOther) const
 		{
 			const T product = this->DotProduct(pOther);
 			const T length = pOther.Length2();
 			const T division = product / length;
 
-			return Vec2<T>(division * pOther.mX, division * pOther.mY);
+			return Vec2<T>(division * pOther.mData[0], division * pOther.mData[1]);
 		}
 
 		Vec2<T> Reflexion(const Vec2<T>& pOther) const
@@ -176,225 +144,272 @@ namespace lm
 			{
 				Vec2<T> proj = this->ProjectOnTo(pOther);
 				proj *= 2;
-				return Vec2<T>(this->mX - proj.mX, this->mY - proj.mY);
+				return Vec2<T>(this->mData[0] - proj.mData[0], this->mData[1] - proj.mData[1]);
 			}
 
 			const T product = this->DotProduct(pOther);
 			const T doubledProduct = 2 * product;
 			const Vec2<T> vecProduct = doubledProduct * pOther;
 
-			return Vec2<T>(this->mX - vecProduct.mX, this->mY - vecProduct.mY);
+			return Vec2<T>(this->mData[0] - vecProduct.mData[0], this->mData[1] - vecProduct.mData[1]);
 		}
 
-		Vec2<T> Perpendicular(const Vec2<T>& pOther) const
+		constexpr Vec2<T> Perpendicular(const Vec2<T>& pOther) const
 		{
 			const Vec2<T> proj = this->ProjectOnTo(pOther);
-			return Vec2<T>(this->mX - proj.mX, this->mY - proj.mY);
+			return Vec2<T>(this->mData[0] - proj.mData[0], this->mData[1] - proj.mData[1]);
 		}
 
-		Vec2<T> Add(const Vec2<T>& pOther) const
+		constexpr Vec2<T> Add(const Vec2<T>& pOther) const
 		{
-			return Vec2<T>(this->mX + pOther.mX, this->mY + pOther.mY);
+			return Vec2<T>(this->mData[0] + pOther.mData[0], this->mData[1] + pOther.mData[1]);
 		}
 
-		Vec2<T>& AddSelf(const Vec2<T>& pOther)
+		constexpr Vec2<T>& AddSelf(const Vec2<T>& pOther)
 		{
-			this->mX += pOther.mX;
-			this->mY += pOther.mY;
+			this->mData[0] += pOther.mData[0];
+			this->mData[1] += pOther.mData[1];
 			return *this;
 		}
 
-		Vec2<T> Scale(const T pScale) const
+		constexpr Vec2<T> Scale(const T pScale) const
 		{
-			return Vec2<T>(this->mX * pScale, this->mY * pScale);
+			return Vec2<T>(this->mData[0] * pScale, this->mData[1] * pScale);
 		}
 
-		Vec2<T>& ScaleSelf(const T pScale)
+		constexpr Vec2<T>& ScaleSelf(const T pScale)
 		{
-			this->mX *= pScale;
-			this->mY *= pScale;
+			this->mData[0] *= pScale;
+			this->mData[1] *= pScale;
 			return *this;
 		}
 
 		Vec2<T> Normalize() const
 		{
-			return Vec2<T>(this->mX / this->Length(), this->mY / this->Length());
+			return Vec2<T>(this->mData[0] / this->Length(), this->mData[1] / this->Length());
+		}
+
+		// FastRsqrt instead of sqrt and divide, relative error <= 5e-7 for floats
+		Vec2<T> Normalize(Utilities::FastMathTag) const
+		{
+			const T invLength = Utilities::FastRsqrt(this->Length2());
+			return Vec2<T>(this->mData[0] * invLength, this->mData[1] * invLength);
 		}
 
 		void NormalizeSelf()
 		{
 			T length = this->Length();
-			this->mX /= length;
-			this->mY /= length;
+			this->mData[0] /= length;
+			this->mData[1] /= length;
 		}
 
-		T& operator[](const int pIdx)
+		// unchecked in release builds, asserts the index when NDEBUG is not defined
+		constexpr T& operator[](const int pIdx)
 		{
-			switch (pIdx)
-			{
-			case 0:		return mX;
-			case 1:		return mY;
+			assert(pIdx >= 0 && pIdx < 2 && "Vec2 index out of range");
+			return this->mData[pIdx];
+		}
 
-			case 'x':	return mX;
-			case 'y':	return mY;
+		constexpr const T& operator[](const int pIdx) const
+		{
+			assert(pIdx >= 0 && pIdx < 2 && "Vec2 index out of range");
+			return this->mData[pIdx];
+		}
+
+		// by axis name as the const char* overload, a char must not convert to an index
+		template <typename Char, std::enable_if_t<std::is_same_v<Char, char>, int> = 0>
+		constexpr T& operator[](const Char pAxis)
+		{
+			switch (pAxis)
+			{
+			case 'x': return this->mData[0];
+			case 'y': return this->mData[1];
 
-			default:	return mX;
+			default: return this->mData[0];
 			}
 		}
 
-		T operator[](const int pIdx) const
+		template <typename Char, std::enable_if_t<std::is_same_v<Char, char>, int> = 0>
+		constexpr const T& operator[](const Char pAxis) const
 		{
-			switch (pIdx)
+			switch (pAxis)
 			{
-			case 0:		return mX;
-			case 1:		return mY;
+			case 'x': return this->mData[0];
+			case 'y': return this->mData[1];
 
-			case 'x':	return mX;
-			case 'y':	return mY;
-
-			default:	return mX;
+			default: return this->mData[0];
 			}
 		}
 
-		T& operator[](const char* pIdx)
+		template <std::size_t pIdx> constexpr T& get()
+		{
+			static_assert(pIdx < 2, "Vec2 index out of range");
+			return this->mData[pIdx];
+		}
+
+		template <std::size_t pIdx> constexpr const T& get() const
+		{
+			static_assert(pIdx < 2, "Vec2 index out of range");
+			return this->mData[pIdx];
+		}
+
+		// Swizzle<1, 0>() == (y, x)
+		template <int pI0, int pI1> constexpr Vec2<T> Swizzle() const
+		{
+			static_assert(pI0 >= 0 && pI0 < 2 && pI1 >= 0 && pI1 < 2, "Vec2 swizzle index out of range");
+			return Vec2<T>(this->mData[pI0], this->mData[pI1]);
+		}
+
+		constexpr T& operator[](const char* pIdx)
 		{
 			switch (pIdx[0])
 			{
-			case 'x': return mX;
-			case 'y': return mY;
+			case 'x': return mData[0];
+			case 'y': return mData[1];
 
-			default: return mX;
+			default: return mData[0];
 			}
 		}
 
-		const T operator[](const char* pIdx) const
+		constexpr const T operator[](const char* pIdx) const
 		{
 			switch (pIdx[0])
 			{
-			case 'x': return mX;
-			case 'y': return mY;
+			case 'x': return mData[0];
+			case 'y': return mData[1];
 
-			default: return mX;
+			default: return mData[0];
 			}
 		}
 
-		const bool operator==(const Vec2<T>& pOther) const
+		// exact, component-wise
+		constexpr bool operator==(const Vec2<T>& pOther) const
 		{
-			if (this == &pOther)
-				return true;
-
-			return std::abs(this->Length() - pOther.Length()) <= std::numeric_limits<T>::epsilon() ||
-				std::abs(this->Length() - pOther.Length()) <= std::numeric_limits<T>::epsilon() *
-				std::max(std::abs(this->Length()), std::abs(pOther.Length()));
+			return this->mData[0] == pOther.mData[0] && this->mData[1] == pOther.mData[1];
 		}
 
-		const bool operator!=(const Vec2<T>& pOther) const
+		constexpr bool operator!=(const Vec2<T>& pOther) const
 		{
 			return !(*this == pOther);
 		}
 
-		const bool operator<(const Vec2<T>& pOther) const
+		// pAbsEps covers components near zero, pRelEps scales with the larger magnitude
+		constexpr bool ApproxEqual(const Vec2<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
 		{
-			return this->Length() < pOther.Length();
+			return Utilities::ApproxEqual(this->mData[0], pOther.mData[0], pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mData[1], pOther.mData[1], pAbsEps, pRelEps);
 		}
 
-		const bool operator<=(const Vec2<T>& pOther) const
+		bool UlpEqual(const Vec2<T>& pOther, const unsigned int pMaxUlps = 4) const
 		{
-			return this->Length() < pOther.Length() || (*this == pOther);
+			return Utilities::UlpEqual(this->mData[0], pOther.mData[0], pMaxUlps) &&
+				Utilities::UlpEqual(this->mData[1], pOther.mData[1], pMaxUlps);
 		}
 
-		const bool operator>(const Vec2<T>& pOther) const
+		// ordered by magnitude
+		constexpr bool operator<(const Vec2<T>& pOther) const
 		{
-			return !(*this < pOther);
+			return this->Length2() < pOther.Length2();
 		}
 
-		const bool operator>=(const Vec2<T>& pOther) const
+		constexpr bool operator<=(const Vec2<T>& pOther) const
 		{
-			return !(*this <= pOther);
+			return this->Length2() <= pOther.Length2();
 		}
 
-		Vec2<T> operator+(const Vec2<T>& pOther) const
+		constexpr bool operator>(const Vec2<T>& pOther) const
 		{
-			return Vec2(this->mX + pOther.mX, this->mY + pOther.mY);
+			return this->Length2() > pOther.Length2();
 		}
 
-		void operator+=(const Vec2<T>& pOther)
+		constexpr bool operator>=(const Vec2<T>& pOther) const
 		{
-			this->mX += pOther.mX;
-			this->mY += pOther.mY;
+			return this->Length2() >= pOther.Length2();
 		}
 
-		Vec2<T> operator-(const Vec2<T>& pOther) const
+		constexpr Vec2<T> operator+(const Vec2<T>& pOther) const
 		{
-			return Vec2(this->mX - pOther.mX, this->mY - pOther.mY);
+			return Vec2(this->mData[0] + pOther.mData[0], this->mData[1] + pOther.mData[1]);
 		}
 
-		void operator-=(const Vec2<T>& pOther)
+		constexpr void operator+=(const Vec2<T>& pOther)
 		{
-			this->mX -= pOther.mX;
-			this->mY -= pOther.mY;
+			this->mData[0] += pOther.mData[0];
+			this->mData[1] += pOther.mData[1];
 		}
 
-		Vec2<T> operator-() const
+		constexpr Vec2<T> operator-(const Vec2<T>& pOther) const
 		{
-			return Vec2(-this->mX, -this->mY);
+			return Vec2(this->mData[0] - pOther.mData[0], this->mData[1] - pOther.mData[1]);
 		}
 
-		Vec2<T> operator*(const T pValue) const
+		constexpr void operator-=(const Vec2<T>& pOther)
+		{
+			this->mData[0] -= pOther.mData[0];
+			this->mData[1] -= pOther.mData[1];
+		}
+
+		constexpr Vec2<T> operator-() const
+		{
+			return Vec2(-this->mData[0], -this->mData[1]);
+		}
+
+		constexpr Vec2<T> operator*(const T pValue) const
 		{
 			return this->Scale(pValue);
 		}
 
-		void operator*=(const T pValue)
+		constexpr void operator*=(const T pValue)
 		{
 			*this = this->Scale(pValue);
 		}
 
-		Vec2<T> operator*(const Vec2<T>& pOther) const
+		constexpr Vec2<T> operator*(const Vec2<T>& pOther) const
 		{
-			return Vec2<T>(this->mX * pOther.mX, this->mY * pOther.mY);
+			return Vec2<T>(this->mData[0] * pOther.mData[0], this->mData[1] * pOther.mData[1]);
 		}
 
-		void operator*=(const Vec2<T>& pOther)
+		constexpr void operator*=(const Vec2<T>& pOther)
 		{
-			this->mX *= pOther.mX;
-			this->mY *= pOther.mY;
+			this->mData[0] *= pOther.mData[0];
+			this->mData[1] *= pOther.mData[1];
 		}
 
-		Vec2<T> operator/(const T pValue) const
+		constexpr Vec2<T> operator/(const T pValue) const
 		{
-			return Vec2(this->mX / pValue, this->mY / pValue);
+			return Vec2(this->mData[0] / pValue, this->mData[1] / pValue);
 		}
 
-		void operator/=(const T pValue)
+		constexpr void operator/=(const T pValue)
 		{
-			this->mX /= pValue;
-			this->mY /= pValue;
+			this->mData[0] /= pValue;
+			this->mData[1] /= pValue;
 		}
 
-		Vec2<T> operator/(const Vec2<T>& pOther) const
+		constexpr Vec2<T> operator/(const Vec2<T>& pOther) const
 		{
-			return Vec2<T>(this->mX / pOther.mX, this->mY / pOther.mY);
+			return Vec2<T>(this->mData[0] / pOther.mData[0], this->mData[1] / pOther.mData[1]);
 		}
 
-		void operator/=(const Vec2<T>& pOther)
+		constexpr void operator/=(const Vec2<T>& pOther)
 		{
-			this->mX /= pOther.mX;
-			this->mY /= pOther.mY;
+			this->mData[0] /= pOther.mData[0];
+			this->mData[1] /= pOther.mData[1];
 		}
 
 		void operator++(int)
 		{
 			T length = this->Length();
-			this->mX *= (length + 1) / length;
-			this->mY *= (length + 1) / length;
+			this->mData[0] *= (length + 1) / length;
+			this->mData[1] *= (length + 1) / length;
 		}
 
 		void operator--(int)
 		{
 			T length = this->Length();
-			this->mX *= (length - 1) / length;
-			this->mY *= (length - 1) / length;
+			this->mData[0] *= (length - 1) / length;
+			this->mData[1] *= (length - 1) / length;
 		}
 	};
 
@@ -441,29 +456,44 @@ namespace lm
 		pStr += "x:" + std::to_string(pOther.X()) + ", y : " + std::to_string(pOther.Y());
 	}
 
-	template<class T> Vec2<T> operator*(const double pValue, const Vec2<T>& pOther)
+	template<class T> constexpr Vec2<T> operator*(const double pValue, const Vec2<T>& pOther)
 	{
 		return pOther * T(pValue);
 	}
 
-	template<class T> Vec2<T> operator/(const double pValue, const Vec2<T>& pOther)
+	template<class T> constexpr Vec2<T> operator/(const double pValue, const Vec2<T>& pOther)
 	{
 		return Vec2<T>(T(pValue / pOther.X()), T(pValue / pOther.Y()));
 	}
 
-	template<class T> const T operator,(const Vec2<T>& pOther1, const Vec2<T>& pOther2)
+	template<class T> constexpr const T operator,(const Vec2<T>& pOther1, const Vec2<T>& pOther2)
 	{
 		return pOther1.DotProduct(pOther2);
 	}
 
-	template<class T> const Vec2<T> Vec2<T>::mZero = Vec2();
-	template<class T> const Vec2<T> Vec2<T>::mOne = Vec2(1);
-	template<class T> const Vec2<T> Vec2<T>::mUp(0, 1);
-	template<class T> const Vec2<T> Vec2<T>::mDown(0, -1);
-	template<class T> const Vec2<T> Vec2<T>::mLeft(-1, 0);
-	template<class T> const Vec2<T> Vec2<T>::mRight(1, 0);
-	template<class T> const T Vec2<T>::mUnitVal = 1;
+	template<class T> constexpr Vec2<T> Vec2<T>::mZero = Vec2();
+	template<class T> constexpr Vec2<T> Vec2<T>::mOne = Vec2(1);
+	template<class T> constexpr Vec2<T> Vec2<T>::mUp(0, 1);
+	template<class T> constexpr Vec2<T> Vec2<T>::mDown(0, -1);
+	template<class T> constexpr Vec2<T> Vec2<T>::mLeft(-1, 0);
+	template<class T> constexpr Vec2<T> Vec2<T>::mRight(1, 0);
+	template<class T> constexpr T Vec2<T>::mUnitVal = 1;
 
 	typedef Vec2<float> FVec2;
 	typedef Vec2<double> DVec2;
-}
\ No newline at end of file
+
+	static_assert(sizeof(FVec2) == 2 * sizeof(float), "FVec2 arrays must be tightly packed");
+	static_assert(std::is_trivially_copyable_v<FVec2> && std::is_standard_layout_v<FVec2>,
+		"FVec2 must be trivially copyable and standard layout");
+	static_assert(std::is_trivially_copyable_v<DVec2> && std::is_standard_layout_v<DVec2>,
+		"DVec2 must be trivially copyable and standard layout");
+}
+
+/* -----
+Structured bindings: auto [x, y] = v2;
+----- */
+namespace std
+{
+	template <typename T> struct tuple_size<lm::Vec2<T>> : integral_constant<size_t, 2> {};
+	template <size_t pIdx, typename T> struct tuple_element<pIdx, lm::Vec2<T>> { using type = T; };
+}
@@ -1,5 +1,6 @@
 #pragma once
 #define _USE_MATH_DEFINES
+#include <type_traits>
 #include <math.h>
 #include <cmath>
 
@@ -17,9 +18,7 @@ namespace lm
 	template <typename T> class Vec3
 	{
 	private:
-		T mX;
-		T mY;
-		T mZ;
+		T mData[3];
 
 	public:
 		static const T mUnitVal;
@@ -32,120 +31,78 @@ namespace lm
 		static const Vec3<T> mForward;
 		static const Vec3<T> mBackward;
 
-		Vec3()
-		{
-			this->mX = 0;
-			this->mY = 0;
-			this->mZ = 0;
-		}
+		constexpr Vec3()
+			: mData{ 0, 0, 0 }
+		{}
 
-		Vec3(const T pInit)
-		{
-			this->mX = pInit;
-			this->mY = pInit;
-			this->mZ = pInit;
-		}
+		constexpr Vec3(const T pInit)
+			: mData{ pInit, pInit, pInit }
+		{}
 
-		Vec3(const T pX, const T pY, const T pZ)
-		{
-			this->mX = pX;
-			this->mY = pY;
-			this->mZ = pZ;
-		}
+		constexpr Vec3(const T pX, const T pY, const T pZ)
+			: mData{ pX, pY, pZ }
+		{}
 
-		Vec3(const Vec3<T>& pOther)
-		{
-			this->mX = pOther.mX;
-			this->mY = pOther.mY;
-			this->mZ = pOther.mZ;
-		}
+		Vec3(const Vec3<T>& pOther) = default;
+		Vec3(Vec3<T>&& pOther) noexcept = default;
+		Vec3<T>& operator=(const Vec3<T>& pOther) = default;
+		Vec3<T>& operator=(Vec3<T>&& pOther) noexcept = default;
 
-		Vec3(Vec3<T>&& pOther) noexcept
+		constexpr T& X()
 		{
-			this->mX = std::move(pOther.mX);
-			this->mY = std::move(pOther.mY);
-			this->mZ = std::move(pOther.mZ);
+			return this->mData[0];
 		}
 
-		Vec3& operator=(const Vec3<T>& pOther)
+		constexpr T& Y()
 		{
-			if (this == &pOther)
-				return *this;
-
-			this->mX = pOther.mX;
-			this->mY = pOther.mY;
-			this->mZ = pOther.mZ;
-
-			return *this;
+			return this->mData[1];
 		}
 
-		Vec3& operator=(Vec3<T>&& pOther) noexcept
+		constexpr T& Z()
 		{
-			if (this == &pOther)
-				return *this;
-
-			this->mX = std::move(pOther.mX);
-			this->mY = std::move(pOther.mY);
-			this->mZ = std::move(pOther.mZ);
-
-			return *this;
+			return this->mData[2];
 		}
 
-		T& X()
+		constexpr const T X() const
 		{
-			return this->mX;
+			return this->mData[0];
 		}
 
-		T& Y()
+		constexpr const T Y() const
 		{
-			return this->mY;
+			return this->mData[1];
 		}
 
-		T& Z()
+		constexpr const T Z() const
 		{
-			return this->mZ;
-		}
-
-		const T X() const
-		{
-			return this->mX;
-		}
-
-		const T Y() const
-		{
-			return this->mY;
-		}
-
-		const T Z() const
-		{
-			return this->mZ;
+			return this->mData[2];
 		}
 
 		const T Length() const
 		{
-			return sqrt((this->mX * this->mX) + (this->mY * this->mY) + (this->mZ * this->mZ));
+			return sqrt((this->mData[0] * this->mData[0]) + (this->mData[1] * this->mData[1]) + (this->mData[2] * this->mData[2]));
 		}
 
-		const T Length2() const
+		constexpr const T Length2() const
 		{
-			return (this->mX * this->mX) + (this->mY * this->mY) + (this->mZ * this->mZ);
+			return (this->mData[0] * this->mData[0]) + (this->mData[1] * this->mData[1]) + (this->mData[2] * this->mData[2]);
 		}
 
-		bool IsLongerThan(Vec3<T> const& pOther) const	// return true if this vector Length2 is greater than the other
+		constexpr bool IsLongerThan(Vec3<T> const& pOther) const	// return true if this vector Length2 is greater than the other
 		{
-			return this->Length() > pOther.Length();
+			return this->Length2() > pOther.Length2();
 		}
 
-		bool IsShorterThan(Vec3<T> const& pOther) const	// return true if this vector Length2 is less than the other
+		constexpr bool IsShorterThan(Vec3<T> const& pOther) const	// return true if this vector Length2 is less than the other
 		{
-			return this->Length() < pOther.Length();
+			return this->Length2() < pOther.Length2();
 		}
 
 		const T DistanceFrom(Vec3<T> const& pOther) const // return distance between 2 points
 		{
-			return sqrt((pOther.mX - this.mX) * (pOther.mX - this.mX) +
-				(pOther.mY - this.mY) * (pOther.mY - this.mY) +
-				(pOther.mZ - this.mZ) * (pOther.mZ - this.mZ));
+			return sqrt((pOther.mData[0] - this->mData[0]) * (pOther.mData[0] - this->mData[0]) +
+				(pOther.mData[1] - this->mData[1]) * (pOther.mData[1] - this->mData[1]) +
+				(pOther.mData[2] - this->mData[2]) * (pOther.mData[2] - this->mData[2]));
 		}
 
 		const bool IsUnit() const
@@ -155,16 +112,16 @@ namespace lm
 				std::max(std::abs(this->Length()), std::abs(Vec3<T>::mUnitVal));
 		}
 
-		const T DotProduct(const Vec3<T>& pOther) const
+		constexpr const T DotProduct(const Vec3<T>& pOther) const
 		{
-			return (this->mX * pOther.mX) + (this->mY * pOther.mY) + (this->mZ * pOther.mZ);
+			return (this->mData[0] * pOther.mData[0]) + (this->mData[1] * pOther.mData[1]) + (this->mData[2] * pOther.mData[2]);
 		}
 
-		const Vec3<T> CrossProduct(const Vec3<T>& pOther) const
+		constexpr const Vec3<T> CrossProduct(const Vec3<T>& pOther) const
 		{
-			return Vec3<T>((this->mY * pOther.mZ) - (this->mZ * pOther.mY),
-				(this->mZ * pOther.mX) - (this->mX * pOther.mZ),
-				(this->mX * pOther.mY) - (this->mY * pOther.mX));
+			return Vec3<T>((this->mData[1] * pOther.mData[2]) - (this->mData[2] * pOther.mData[1]),
+				(this->mData[2] * pOther.mData[0]) - (this->mData[0] * pOther.mData[2]),
+				(this->mData[0] * pOther.mData[1]) - (this->mData[1] * pOther.mData[0]));
 		}
 
 		const T RadAngle(const Vec3<T>& pOther) const
@@ -185,13 +142,13 @@ namespace lm
 			return Utilities::RadiansToDegrees(this->RadAngle(pOther));
 		}
 
-		Vec3<T> ProjectOnTo(const Vec3<T>& pOther) const
+		constexpr Vec3<T> ProjectOnTo(const Vec3<T>& pOther) const
 		{
 			const T product = this->DotProduct(pOther);
 			const T length = pOther.Length2();
 			const T division = product / length;
 
-			return Vec3<T>(division * pOther.mX, division * pOther.mY, division * pOther.mZ);
+			return Vec3<T>(division * pOther.mData[0], division * pOther.mData[1], division * pOther.mData[2]);
 		}
 
 		Vec3<T> Reflexion(const Vec3<T>& pOther) const
@@ -200,308 +157,376 @@ namespace lm
 			{
 				Vec3<T> proj = this->ProjectOnTo(pOther);
 				proj *= 2;
-				return Vec3<T>(this->mX - proj.mX, this->mY - proj.mY, this->mZ - proj.mZ);
+				return Vec3<T>(this->mData[0] - proj.mData[0], this->mData[1] - proj.mData[1], this->mData[2] - proj.mData[2]);
 			}
 
 			const T product = this->DotProduct(pOther);
 			const T doubledProduct = 2 * product;
 			const Vec3<T> vecProduct = doubledProduct * pOther;
 
-			return Vec3<T>(this->mX - vecProduct.mX, this->mY - vecProduct.mY,
-				this->mZ - vecProduct.mZ);
+			return Vec3<T>(this->mData[0] - vecProduct.mData[0], this->mData[1] - vecProduct.mData[1],
+				this->mData[2] - vecProduct.mData[2]);
 		}
 
-		Vec3<T> Perpendicular(const Vec3<T>& pOther) const
+		constexpr Vec3<T> Perpendicular(const Vec3<T>& pOther) const
 		{
 			const Vec3<T> proj = this->ProjectOnTo(pOther);
-			return Vec3<T>(this->mX - proj.mX, this->mY - proj.mY, this->mZ - proj.mZ);
+			return Vec3<T>(this->mData[0] - proj.mData[0], this->mData[1] - proj.mData[1], this->mData[2] - proj.mData[2]);
 		}
 
-		Vec3<T> Add(const Vec3<T>& pOther) const
+		constexpr Vec3<T> Add(const Vec3<T>& pOther) const
 		{
-			return Vec3<T>(this->mX + pOther.mX, this->mY + pOther.mY, this->mZ + pOther.mZ);
+			return Vec3<T>(this->mData[0] + pOther.mData[0], this->mData[1] + pOther.mData[1], this->mData[2] + pOther.mData[2]);
 		}
 
-		Vec3<T>& AddSelf(const Vec3<T>& pOther)
+		constexpr Vec3<T>& AddSelf(const Vec3<T>& pOther)
 		{
-			this->mX += pOther.mX;
-			this->mY += pOther.mY;
-			this->mZ += pOther.mZ;
+			this->mData[0] += pOther.mData[0];
+			this->mData[1] += pOther.mData[1];
+			this->mData[2] += pOther.mData[2];
 			return *this;
 		}
 
-		Vec3<T> ScaleUniform(const T& pScale) const
+		constexpr Vec3<T> ScaleUniform(const T& pScale) const
 		{
-			return Vec3<T>(this->mX * pScale, this->mY * pScale, this->mZ * pScale);
+			return Vec3<T>(this->mData[0] * pScale, this->mData[1] * pScale, this->mData[2] * pScale);
 		}
 
-		Vec3<T> Scale(const Vec3<T>& pOther)
+		constexpr Vec3<T> Scale(const Vec3<T>& pOther)
 		{
-			return lm::Vec3<T>(this->mX * pOther.mX, this->mY * pOther.mY, this->mZ * pOther.mZ);
+			return lm::Vec3<T>(this->mData[0] * pOther.mData[0], this->mData[1] * pOther.mData[1], this->mData[2] * pOther.mData[2]);
 		}
 
-		Vec3<T>& ScaleSelf(const T pScale)
+		constexpr Vec3<T>& ScaleSelf(const T pScale)
 		{
-			this->mX *= pScale;
-			this->mY *= pScale;
-			this->mZ *= pScale;
+			this->mData[0] *= pScale;
+			this->mData[1] *= pScale;
+			this->mData[2] *= pScale;
 			return *this;
 		}
 
-		Vec3<T>& ScaleSelf(const Vec3<T>& pScale)
+		constexpr Vec3<T>& ScaleSelf(const Vec3<T>& pScale)
 		{
-			this->mX *= pScale.X();
-			this->mY *= pScale.Y();
-			this->mZ *= pScale.Z();
+			this->mData[0] *= pScale.X();
+			this->mData[1] *= pScale.Y();
+			this->mData[2] *= pScale.Z();
 			return *this;
 		}
 
 		Vec3<T> Normalize() const
 		{
 			T length = this->Length();
-			return Vec3<T>(this->mX / length, this->mY / length, this->mZ / length);
+			return Vec3<T>(this->mData[0] / length, this->mData[1] / length, this->mData[2] / length);
+		}
+
+		// FastRsqrt instead of sqrt and divide, relative error <= 5e-7 for floats
+		Vec3<T> Normalize(Utilities::FastMathTag) const
+		{
+			const T invLength = Utilities::FastRsqrt(this->Length2());
+			return Vec3<T>(this->mData[0] * invLength, this->mData[1] * invLength, this->mData[2] * invLength);
 		}
 
 		void NormalizeSelf()
 		{
 			T length = this->Length();
-			this->mX /= length;
-			this->mY /= length;
-			this->mZ /= length;
+			this->mData[0] /= length;
+			this->mData[1] /= length;
+			this->mData[2] /= length;
 		}
 
-		static Vec3<T> Lerp(Vec3<T> Start, Vec3<T> End, float Alpha)
+		static constexpr Vec3<T> Lerp(Vec3<T> Start, Vec3<T> End, float Alpha)
 		{
 			return Vec3<T>(((1 - Alpha) * Start) + (End * Alpha));
 		}
 
-		T& operator[](const int pIdx)
+		// unchecked in release builds, asserts the index when NDEBUG is not defined
+		constexpr T& operator[](const int pIdx)
 		{
-			switch (pIdx)
-			{
-			case 0:		return mX;
-			case 1:		return mY;
-			case 2:		return mZ;
+			assert(pIdx >= 0 && pIdx < 3 && "Vec3 index out of range");
+			return this->mData[pIdx];
+		}
 
-			case 'x':	return mX;
-			case 'y':	return mY;
-			case 'z':	return mZ;
+		constexpr const T& operator[](const int pIdx) const
+		{
+			assert(pIdx >= 0 && pIdx < 3 && "Vec3 index out of range");
+			return this->mData[pIdx];
+		}
 
-			default:	return mX;
+		// by axis name as the const char* overload, a char must not convert to an index
+		template <typename Char, std::enable_if_t<std::is_same_v<Char, char>, int> = 0>
+		constexpr T& operator[](const Char pAxis)
+		{
+			switch (pAxis)
+			{
+			case 'x': return this->mData[0];
+			case 'y': return this->mData[1];
+			case 'z': return this->mData[2];
+
+			default: return this->mData[0];
 			}
 		}
 
-		const T operator[](const int pIdx) const
+		template <typename Char, std::enable_if_t<std::is_same_v<Char, char>, int> = 0>
+		constexpr const T& operator[](const Char pAxis) const
 		{
-			switch (pIdx)
+			switch (pAxis)
 			{
-			case 0:		return mX;
-			case 1:		return mY;
-			case 2:		return mZ;
-
-			case 'x':	return mX;
-			case 'y':	return mY;
-			case 'z':	return mZ;
+			case 'x': return this->mData[0];
+			case 'y': return this->mData[1];
+			case 'z': return this->mData[2];
 
-			default:	return mX;
+			default: return this->mData[0];
 			}
 		}
 
-		T& operator[](const char* pIdx)
+		template <std::size_t pIdx> constexpr T& get()
+		{
+			static_assert(pIdx < 3, "Vec3 index out of range");
+			return this->mData[pIdx];
+		}
+
+		template <std::size_t pIdx> constexpr const T& get() const
+		{
+			static_assert(pIdx < 3, "Vec3 index out of range");
+			return this->mData[pIdx];
+		}
+
+		// Swizzle<2, 1, 0>() == (z, y, x), Swizzle<0, 2>() == (x, z) as a Vec2
+		template <int... pIdx> constexpr auto Swizzle() const
+		{
+			static_assert(sizeof...(pIdx) >= 2 && sizeof...(pIdx) <= 3, "Vec3 swizzles have 2 or 3 components");
+			static_assert(((pIdx >= 0 && pIdx < 3) && ...), "Vec3 swizzle index out of range");
+
+			if constexpr (sizeof...(pIdx) == 2)
+				return Vec2<T>(this->mData[pIdx]...);
+			else
+				return Vec3<T>(this->mData[pIdx]...);
+		}
+
+		constexpr T& operator[](const char* pIdx)
 		{
 			switch (pIdx[0])
 			{
-			case 'x': return mX;
-			case 'y': return mY;
-			case 'z': return mZ;
+			case 'x': return mData[0];
+			case 'y': return mData[1];
+			case 'z': return mData[2];
 
-			default: return mX;
+			default: return mData[0];
 			}
 		}
 
-		const T operator[](const char* pIdx) const
+		constexpr const T operator[](const char* pIdx) const
 		{
 			switch (pIdx[0])
 			{
-			case 'x': return mX;
-			case 'y': return mY;
-			case 'z': return mZ;
+			case 'x': return mData[0];
+			case 'y': return mData[1];
+			case 'z': return mData[2];
 
-			default: return mX;
+			default: return mData[0];
 			}
 		}
 
-		const bool operator==(const Vec3<T>& pOther) const
+		// exact, component-wise
+		constexpr bool operator==(const Vec3<T>& pOther) const
 		{
-			if (this == &pOther)
-				return true;
-
-			return std::abs(this->Length() - pOther.Length()) <= std::numeric_limits<T>::epsilon() ||
-				std::abs(this->Length() - pOther.Length()) <= std::numeric_limits<T>::epsilon() *
-				std::max(std::abs(this->Length()), std::abs(pOther.Length()));
+			return this->mData[0] == pOther.mData[0] && this->mData[1] == pOther.mData[1] &&
+				this->mData[2] == pOther.mData[2];
 		}
 
-		const bool operator!=(const Vec3<T>& pOther) const
+		constexpr bool operator!=(const Vec3<T>& pOther) const
 		{
 			return !(*this == pOther);
 		}
 
-		const bool operator<(const Vec3<T>& pOther) const
+		// pAbsEps covers components near zero, pRelEps scales with the larger magnitude
+		constexpr bool ApproxEqual(const Vec3<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
 		{
-			return this->Length() < pOther.Length();
+			return Utilities::ApproxEqual(this->mData[0], pOther.mData[0], pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mData[1], pOther.mData[1], pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mData[2], pOther.mData[2], pAbsEps, pRelEps);
 		}
 
-		const bool operator<=(const Vec3<T>& pOther) const
+		bool UlpEqual(const Vec3<T>& pOther, const unsigned int pMaxUlps = 4) const
 		{
-			return this->Length() < pOther.Length() || (*this == pOther);
+			return Utilities::UlpEqual(this->mData[0], pOther.mData[0], pMaxUlps) &&
+				Utilities::UlpEqual(this->mData[1], pOther.mData[1], pMaxUlps) &&
+				Utilities::UlpEqual(this->mData[2], pOther.mData[2], pMaxUlps);
 		}
 
-		const bool operator>(const Vec3<T>& pOther) const
+		// ordered by magnitude
+		constexpr bool operator<(const Vec3<T>& pOther) const
 		{
-			return !(*this < pOther);
+			return this->Length2() < pOther.Length2();
 		}
 
-		const bool operator>=(const Vec3<T>& pOther) const
+		constexpr bool operator<=(const Vec3<T>& pOther) const
 		{
-			return !(*this <= pOther);
+			return this->Length2() <= pOther.Length2();
 		}
 
-		Vec3<T> operator+(const Vec3<T>& pOther) const
+		constexpr bool operator>(const Vec3<T>& pOther) const
 		{
-			return Vec3(this->mX + pOther.mX, this->mY + pOther.mY, this->mZ + pOther.mZ);
+			return this->Length2() > pOther.Length2();
 		}
 
-		void operator+=(const Vec3<T>& pOther)
+		constexpr bool operator>=(const Vec3<T>& pOther) const
 		{
-			this->mX += pOther.mX;
-			this->mY += pOther.mY;
-			this->mZ += pOther.mZ;
+			return this->Length2() >= pOther.Length2();
+		}
+
+		constexpr Vec3<T> operator+(const Vec3<T>& pOther) const
+		{
+			return Vec3(this->mData[0] + pOther.mData[0], this->mData[1] + pOther.mData[1], this->mData[2] + pOther.mData[2]);
+		}
+
+		constexpr void operator+=(const Vec3<T>& pOther)
+		{
+			this->mData[0] += pOther.mData[0];
+			this->mData[1] += pOther.mData[1];
+			this->mData[2] += pOther.mData[2];
 		}
 		
-		void operator+=(const T& pValue)
+		constexpr void operator+=(const T& pValue)
 		{
-			this->mX += pValue;
-			this->mY += pValue;
-			this->mZ += pValue;
+			this->mData[0] += pValue;
+			this->mData[1] += pValue;
+			this->mData[2] += pValue;
 		}
 
-		Vec3<T> operator-(const Vec3<T>& pOther) const
+		constexpr Vec3<T> operator-(const Vec3<T>& pOther) const
 		{
-			return Vec3(this->mX - pOther.mX, this->mY - pOther.mY, this->mZ - pOther.mZ);
+			return Vec3(this->mData[0] - pOther.mData[0], this->mData[1] - pOther.mData[1], this->mData[2] - pOther.mData[2]);
 		}
 
-		void operator-=(const Vec3<T>& pOther)
+		constexpr void operator-=(const Vec3<T>& pOther)
 		{
-			this->mX -= pOther.mX;
-			this->mY -= pOther.mY;
-			this->mZ -= pOther.mZ;
+			this->mData[0] -= pOther.mData[0];
+			this->mData[1] -= pOther.mData[1];
+			this->mData[2] -= pOther.mData[2];
 		}
 
-		void operator-=(const T& pValue)
+		constexpr void operator-=(const T& pValue)
 		{
-			this->mX -= pValue;
-			this->mY -= pValue;
-			this->mZ -= pValue;
+			this->mData[0] -= pValue;
+			this->mData[1] -= pValue;
+			this->mData[2] -= pValue;
 		}
 
-		Vec3<T> operator-() const
+		constexpr Vec3<T> operator-() const
 		{
-			return Vec3(-this->mX, -this->mY, -this->mZ);
+			return Vec3(-this->mData[0], -this->mData[1], -this->mData[2]);
 		}
 
-		Vec3<T> operator*(const T pValue) const
+		constexpr Vec3<T> operator*(const T pValue) const
 		{
 			return this->ScaleUniform(pValue);
 		}
 
-		void operator*=(const T pValue)
+		constexpr void operator*=(const T pValue)
 		{
 			*this = this->ScaleUniform(pValue);
 		}
 
-		Vec3<T> operator*(const Vec3<T>& pOther) const
+		constexpr Vec3<T> operator*(const Vec3<T>& pOther) const
 		{
-			return Vec3<T>(this->mX * pOther.mX, this->mZ * pOther.mZ, this->mZ * pOther.mZ);
+			return Vec3<T>(this->mData[0] * pOther.mData[0], this->mData[1] * pOther.mData[1], this->mData[2] * pOther.mData[2]);
 		}
 
-		void operator*=(const Vec3<T>& pOther)
+		constexpr void operator*=(const Vec3<T>& pOther)
 		{
-			this->mX *= pOther.mX;
-			this->mY *= pOther.mY;
-			this->mZ *= pOther.mZ;
+			this->mData[0] *= pOther.mData[0];
+			this->mData[1] *= pOther.mData[1];
+			this->mData[2] *= pOther.mData[2];
 		}
 
-		Vec3<T> operator/(const T pValue) const
+		constexpr Vec3<T> operator/(const T pValue) const
 		{
-			return Vec3(this->mX / pValue, this->mY / pValue, this->mZ / pValue);
+			return Vec3(this->mData[0] / pValue, this->mData[1] / pValue, this->mData[2] / pValue);
 		}
 
-		void operator/=(const T pValue)
+		constexpr void operator/=(const T pValue)
 		{
-			this->mX /= pValue;
-			this->mY /= pValue;
-			this->mZ /= pValue;
+			this->mData[0] /= pValue;
+			this->mData[1] /= pValue;
+			this->mData[2] /= pValue;
 		}
 
-		Vec3<T> operator/(const Vec3<T>& pOther) const
+		constexpr Vec3<T> operator/(const Vec3<T>& pOther) const
 		{
-			return Vec3<T>(this->mX / pOther.mX, this->mY / pOther.mY, this->mZ / pOther.mZ);
+			return Vec3<T>(this->mData[0] / pOther.mData[0], this->mData[1] / pOther.mData[1], this->mData[2] / pOther.mData[2]);
 		}
 
-		void operator/=(const Vec3<T>& pOther)
+		constexpr void operator/=(const Vec3<T>& pOther)
 		{
-			this->mX /= pOther.mX;
-			this->mY /= pOther.mY;
-			this->mZ /= pOther.mZ;
+			this->mData[0] /= pOther.mData[0];
+			this->mData[1] /= pOther.mData[1];
+			this->mData[2] /= pOther.mData[2];
 		}
 
 		void operator++(int)
 		{
 			T length = this->Length();
-			this->mX *= (length + 1) / length;
-			this->mY *= (length + 1) / length;
-			this->mZ *= (length + 1) / length;
+			this->mData[0] *= (length + 1) / length;
+			this->mData[1] *= (length + 1) / length;
+			this->mData[2] *= (length + 1) / length;
 		}
 
 		void operator--(int)
 		{
 			T length = this->Length();
-			this->mX *= (length - 1) / length;
-			this->mY *= (length - 1) / length;
-			this->mZ *= (length - 1) / length;
+			this->mData[0] *= (length - 1) / length;
+			this->mData[1] *= (length - 1) / length;
+			this->mData[2] *= (length - 1) / length;
 		}
 	};
 
-	template<class T> Vec3<T> operator*(const double pValue, const Vec3<T>& pOther)
+	template<class T> constexpr Vec3<T> operator*(const double pValue, const Vec3<T>& pOther)
 	{
 		return pOther * T(pValue);
 	}
 
-	template<class T> Vec3<T> operator/(const double pValue, const Vec3<T>& pOther)
+	template<class T> constexpr Vec3<T> operator/(const double pValue, const Vec3<T>& pOther)
 	{
 		return Vec3<T>(T(pValue / pOther.X()), T(pValue / pOther.Y()), T(pValue / pOther.Z()));
 	}
 
-	template<class T> Vec3<T> operator/(const Vec3<T>& pFirst, const Vec3<T>& pSecond)
+	template<class T> constexpr Vec3<T> operator/(const Vec3<T>& pFirst, const Vec3<T>& pSecond)
 	{
 		return Vec3<T>(pFirst.X() / pSecond.X(), pFirst.Y() / pSecond.Y(), pFirst.Z() / pSecond.Z());
 	}
 
-	template<class T> const T operator,(const Vec3<T>& pOther1, const Vec3<T>& pOther2)
+	template<class T> constexpr const T operator,(const Vec3<T>& pOther1, const Vec3<T>& pOther2)
 	{
 		return pOther1.DotProduct(pOther2);
 	}
 
-	template<class T> const Vec3<T> Vec3<T>::mZero = Vec3();
-	template<class T> const Vec3<T> Vec3<T>::mOne = Vec3(1);
-	template<class T> const Vec3<T> Vec3<T>::mUp(0, 1, 0);
-	template<class T> const Vec3<T> Vec3<T>::mDown(0, -1, 0);
-	template<class T> const Vec3<T> Vec3<T>::mLeft(-1, 0, 0);
-	template<class T> const Vec3<T> Vec3<T>::mRight(1, 0, 0);
-	template<class T> const Vec3<T> Vec3<T>::mForward(0, 0, 1);
-	template<class T> const Vec3<T> Vec3<T>::mBackward(0, 0, -1);
-	template<class T> const T Vec3<T>::mUnitVal = 1;
+	template<class T> constexpr Vec3<T> Vec3<T>::mZero = Vec3();
+	template<class T> constexpr Vec3<T> Vec3<T>::mOne = Vec3(1);
+	template<class T> constexpr Vec3<T> Vec3<T>::mUp(0, 1, 0);
+	template<class T> constexpr Vec3<T> Vec3<T>::mDown(0, -1, 0);
+	template<class T> constexpr Vec3<T> Vec3<T>::mLeft(-1, 0, 0);
+	template<class T> constexpr Vec3<T> Vec3<T>::mRight(1, 0, 0);
+	template<class T> constexpr Vec3<T> Vec3<T>::mForward(0, 0, 1);
+	template<class T> constexpr Vec3<T> Vec3<T>::mBackward(0, 0, -1);
+	template<class T> constexpr T Vec3<T>::mUnitVal = 1;
 
 	typedef Vec3<float>		FVec3;
 	typedef Vec3<double>	DVec3;
-}
\ No newline at end of file
+
+	static_assert(sizeof(FVec3) == 3 * sizeof(float), "FVec3 arrays must be tightly packed");
+	static_assert(std::is_trivially_copyable_v<FVec3> && std::is_standard_layout_v<FVec3>,
+		"FVec3 must be trivially copyable and standard layout");
+	static_assert(std::is_trivially_copyable_v<DVec3> && std::is_standard_layout_v<DVec3>,
+		"DVec3 must be trivially copyable and standard layout");
+}
+
+/* -----
+Structured bindings: auto [x, y, z] = v3;
+----- */
+namespace std
+{
+	template <typename T> struct tuple_size<lm::Vec3<T>> : integral_constant<size_t, 3> {};
+	template <size_t pIdx, typename T> struct tuple_element<pIdx, lm::Vec3<T>> { using type = T; };
+}
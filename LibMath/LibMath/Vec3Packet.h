@@ -0,0 +1,220 @@
+#pragma once
+
+#include "Simd.h"
+#include "Vec3.h"
+
+namespace lm
+{
+	/* -----
+	Vec3Packet<P> holds P::Width independent Vec3<float> in SoA registers, so one call
+	runs the same operation on every lane. Comparisons return P::Mask and Select
+	picks lanes without branching.
+	----- */
+
+	template <typename P> class Vec3Packet
+	{
+	public:
+		using Pack = P;
+		using Mask = typename P::Mask;
+
+		static constexpr std::size_t Width = P::Width;
+
+	private:
+		P mX;
+		P mY;
+		P mZ;
+
+	public:
+		Vec3Packet()
+			: mX(P::Splat(0)), mY(P::Splat(0)), mZ(P::Splat(0))
+		{}
+
+		// same vector in every lane
+		Vec3Packet(const Vec3<float>& pValue)
+			: mX(P::Splat(pValue.X())), mY(P::Splat(pValue.Y())), mZ(P::Splat(pValue.Z()))
+		{}
+
+		Vec3Packet(const P& pX, const P& pY, const P& pZ)
+			: mX(pX), mY(pY), mZ(pZ)
+		{}
+
+		// reads Width vectors from pSource
+		static Vec3Packet<P> Load(const Vec3<float>* pSource)
+		{
+			float x[Width], y[Width], z[Width];
+			for (std::size_t i = 0; i < Width; i++)
+			{
+				x[i] = pSource[i].X();
+				y[i] = pSource[i].Y();
+				z[i] = pSource[i].Z();
+			}
+
+			return Vec3Packet<P>(P::Load(x), P::Load(y), P::Load(z));
+		}
+
+		// writes Width vectors to pDestination
+		void Store(Vec3<float>* pDestination) const
+		{
+			float x[Width], y[Width], z[Width];
+			this->mX.Store(x);
+			this->mY.Store(y);
+			this->mZ.Store(z);
+
+			for (std::size_t i = 0; i < Width; i++)
+				pDestination[i] = Vec3<float>(x[i], y[i], z[i]);
+		}
+
+		Vec3<float> Get(const std::size_t pLane) const
+		{
+			Vec3<float> lanes[Width];
+			this->Store(lanes);
+			return lanes[pLane];
+		}
+
+		P& X()
+		{
+			return this->mX;
+		}
+
+		P& Y()
+		{
+			return this->mY;
+		}
+
+		P& Z()
+		{
+			return this->mZ;
+		}
+
+		const P& X() const
+		{
+			return this->mX;
+		}
+
+		const P& Y() const
+		{
+			return this->mY;
+		}
+
+		const P& Z() const
+		{
+			return this->mZ;
+		}
+
+		P Length() const
+		{
+			return Simd::Sqrt(this->Length2());
+		}
+
+		P Length2() const
+		{
+			return this->DotProduct(*this);
+		}
+
+		P DotProduct(const Vec3Packet<P>& pOther) const
+		{
+			return (this->mX * pOther.mX) + (this->mY * pOther.mY) + (this->mZ * pOther.mZ);
+		}
+
+		const Vec3Packet<P> CrossProduct(const Vec3Packet<P>& pOther) const
+		{
+			return Vec3Packet<P>((this->mY * pOther.mZ) - (this->mZ * pOther.mY),
+				(this->mZ * pOther.mX) - (this->mX * pOther.mZ),
+				(this->mX * pOther.mY) - (this->mY * pOther.mX));
+		}
+
+		Vec3Packet<P> Normalize() const
+		{
+			const P length = this->Length();
+			return Vec3Packet<P>(this->mX / length, this->mY / length, this->mZ / length);
+		}
+
+		void NormalizeSelf()
+		{
+			*this = this->Normalize();
+		}
+
+		static Vec3Packet<P> Lerp(const Vec3Packet<P>& pStart, const Vec3Packet<P>& pEnd, const P& pAlpha)
+		{
+			return (pStart * (P::Splat(1) - pAlpha)) + (pEnd * pAlpha);
+		}
+
+		static Vec3Packet<P> Min(const Vec3Packet<P>& pLeft, const Vec3Packet<P>& pRight)
+		{
+			return Vec3Packet<P>(Simd::Min(pLeft.mX, pRight.mX), Simd::Min(pLeft.mY, pRight.mY),
+				Simd::Min(pLeft.mZ, pRight.mZ));
+		}
+
+		static Vec3Packet<P> Max(const Vec3Packet<P>& pLeft, const Vec3Packet<P>& pRight)
+		{
+			return Vec3Packet<P>(Simd::Max(pLeft.mX, pRight.mX), Simd::Max(pLeft.mY, pRight.mY),
+				Simd::Max(pLeft.mZ, pRight.mZ));
+		}
+
+		// lane-wise pMask ? pIfTrue : pIfFalse
+		static Vec3Packet<P> Select(const Mask& pMask, const Vec3Packet<P>& pIfTrue, const Vec3Packet<P>& pIfFalse)
+		{
+			return Vec3Packet<P>(Simd::Select(pMask, pIfTrue.mX, pIfFalse.mX),
+				Simd::Select(pMask, pIfTrue.mY, pIfFalse.mY),
+				Simd::Select(pMask, pIfTrue.mZ, pIfFalse.mZ));
+		}
+
+		Mask operator==(const Vec3Packet<P>& pOther) const
+		{
+			return (this->mX == pOther.mX) & (this->mY == pOther.mY) & (this->mZ == pOther.mZ);
+		}
+
+		Mask operator!=(const Vec3Packet<P>& pOther) const
+		{
+			return !(*this == pOther);
+		}
+
+		Vec3Packet<P> operator+(const Vec3Packet<P>& pOther) const
+		{
+			return Vec3Packet<P>(this->mX + pOther.mX, this->mY + pOther.mY, this->mZ + pOther.mZ);
+		}
+
+		Vec3Packet<P> operator-(const Vec3Packet<P>& pOther) const
+		{
+			return Vec3Packet<P>(this->mX - pOther.mX, this->mY - pOther.mY, this->mZ - pOther.mZ);
+		}
+
+		Vec3Packet<P> operator-() const
+		{
+			return Vec3Packet<P>(-this->mX, -this->mY, -this->mZ);
+		}
+
+		Vec3Packet<P> operator*(const Vec3Packet<P>& pOther) const
+		{
+			return Vec3Packet<P>(this->mX * pOther.mX, this->mY * pOther.mY, this->mZ * pOther.mZ);
+		}
+
+		Vec3Packet<P> operator*(const P& pValue) const
+		{
+			return Vec3Packet<P>(this->mX * pValue, this->mY * pValue, this->mZ * pValue);
+		}
+
+		Vec3Packet<P> operator/(const P& pValue) const
+		{
+			return Vec3Packet<P>(this->mX / pValue, this->mY / pValue, this->mZ / pValue);
+		}
+
+		void operator+=(const Vec3Packet<P>& pOther)
+		{
+			*this = *this + pOther;
+		}
+
+		void operator-=(const Vec3Packet<P>& pOther)
+		{
+			*this = *this - pOther;
+		}
+
+		void operator*=(const P& pValue)
+		{
+			*this = *this * pValue;
+		}
+	};
+
+	typedef Vec3Packet<Simd::Float4>	Vec3x4;
+	typedef Vec3Packet<Simd::Float8>	Vec3x8;
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "Simd.h"
+#include "Vec3.h"
+
+namespace lm
+{
+	/* -----
+	Structure-of-arrays storage for large Vec3 streams: one aligned lane per component
+	so the bulk functions below run Simd::Pack<T>::Type::Width elements per iteration.
+	----- */
+
+	template <typename T> class Vec3SoA
+	{
+	public:
+		using Lane = std::vector<T, Simd::AlignedAllocator<T>>;
+
+		// behaves like a Vec3<T> that reads and writes element pIdx of the container
+		class Element
+		{
+		private:
+			Vec3SoA<T>* mOwner;
+			std::size_t mIdx;
+
+		public:
+			Element(Vec3SoA<T>& pOwner, const std::size_t pIdx)
+			{
+				this->mOwner = &pOwner;
+				this->mIdx = pIdx;
+			}
+
+			T& X()
+			{
+				return this->mOwner->mX[this->mIdx];
+			}
+
+			T& Y()
+			{
+				return this->mOwner->mY[this->mIdx];
+			}
+
+			T& Z()
+			{
+				return this->mOwner->mZ[this->mIdx];
+			}
+
+			const T X() const
+			{
+				return this->mOwner->mX[this->mIdx];
+			}
+
+			const T Y() const
+			{
+				return this->mOwner->mY[this->mIdx];
+			}
+
+			const T Z() const
+			{
+				return this->mOwner->mZ[this->mIdx];
+			}
+
+			operator Vec3<T>() const
+			{
+				return Vec3<T>(this->X(), this->Y(), this->Z());
+			}
+
+			Element& operator=(const Vec3<T>& pOther)
+			{
+				this->X() = pOther.X();
+				this->Y() = pOther.Y();
+				this->Z() = pOther.Z();
+				return *this;
+			}
+
+			Element& operator=(const Element& pOther)
+			{
+				return *this = Vec3<T>(pOther);
+			}
+
+			const T Length() const
+			{
+				return Vec3<T>(*this).Length();
+			}
+
+			const T Length2() const
+			{
+				return Vec3<T>(*this).Length2();
+			}
+
+			const T DotProduct(const Vec3<T>& pOther) const
+			{
+				return Vec3<T>(*this).DotProduct(pOther);
+			}
+
+			const Vec3<T> CrossProduct(const Vec3<T>& pOther) const
+			{
+				return Vec3<T>(*this).CrossProduct(pOther);
+			}
+
+			Vec3<T> Normalize() const
+			{
+				return Vec3<T>(*this).Normalize();
+			}
+
+			void NormalizeSelf()
+			{
+				*this = this->Normalize();
+			}
+		};
+
+	private:
+		Lane mX;
+		Lane mY;
+		Lane mZ;
+
+	public:
+		Vec3SoA() = default;
+
+		Vec3SoA(const std::size_t pSize)
+		{
+			this->Resize(pSize);
+		}
+
+		Vec3SoA(const Vec3<T>* pSource, const std::size_t pCount)
+		{
+			this->Resize(pCount);
+			for (std::size_t i = 0; i < pCount; i++)
+			{
+				this->mX[i] = pSource[i].X();
+				this->mY[i] = pSource[i].Y();
+				this->mZ[i] = pSource[i].Z();
+			}
+		}
+
+		std::size_t Size() const
+		{
+			return this->mX.size();
+		}
+
+		void Resize(const std::size_t pSize)
+		{
+			this->mX.resize(pSize);
+			this->mY.resize(pSize);
+			this->mZ.resize(pSize);
+		}
+
+		void Reserve(const std::size_t pCapacity)
+		{
+			this->mX.reserve(pCapacity);
+			this->mY.reserve(pCapacity);
+			this->mZ.reserve(pCapacity);
+		}
+
+		void Clear()
+		{
+			this->mX.clear();
+			this->mY.clear();
+			this->mZ.clear();
+		}
+
+		void PushBack(const Vec3<T>& pValue)
+		{
+			this->mX.push_back(pValue.X());
+			this->mY.push_back(pValue.Y());
+			this->mZ.push_back(pValue.Z());
+		}
+
+		// writes the container back to AoS form, pOut must hold Size() elements
+		void Store(Vec3<T>* pOut) const
+		{
+			for (std::size_t i = 0; i < this->Size(); i++)
+				pOut[i] = Vec3<T>(this->mX[i], this->mY[i], this->mZ[i]);
+		}
+
+		T* X()
+		{
+			return this->mX.data();
+		}
+
+		T* Y()
+		{
+			return this->mY.data();
+		}
+
+		T* Z()
+		{
+			return this->mZ.data();
+		}
+
+		const T* X() const
+		{
+			return this->mX.data();
+		}
+
+		const T* Y() const
+		{
+			return this->mY.data();
+		}
+
+		const T* Z() const
+		{
+			return this->mZ.data();
+		}
+
+		Element operator[](const std::size_t pIdx)
+		{
+			return Element(*this, pIdx);
+		}
+
+		const Vec3<T> operator[](const std::size_t pIdx) const
+		{
+			return Vec3<T>(this->mX[pIdx], this->mY[pIdx], this->mZ[pIdx]);
+		}
+
+		/* -----
+		Bulk functions: pResult must hold Size() values, pOther must be at least as long as this.
+		----- */
+
+		void DotProduct(const Vec3SoA<T>& pOther, T* pResult) const
+		{
+			Simd::ForEachPack<T>(this->Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P x = P::Load(&this->mX[i]) * P::Load(&pOther.mX[i]);
+				const P y = P::Load(&this->mY[i]) * P::Load(&pOther.mY[i]);
+				const P z = P::Load(&this->mZ[i]) * P::Load(&pOther.mZ[i]);
+				(x + y + z).Store(&pResult[i]);
+			});
+		}
+
+		void CrossProduct(const Vec3SoA<T>& pOther, Vec3SoA<T>& pResult) const
+		{
+			pResult.Resize(this->Size());
+			Simd::ForEachPack<T>(this->Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P ax = P::Load(&this->mX[i]), ay = P::Load(&this->mY[i]), az = P::Load(&this->mZ[i]);
+				const P bx = P::Load(&pOther.mX[i]), by = P::Load(&pOther.mY[i]), bz = P::Load(&pOther.mZ[i]);
+				((ay * bz) - (az * by)).Store(&pResult.mX[i]);
+				((az * bx) - (ax * bz)).Store(&pResult.mY[i]);
+				((ax * by) - (ay * bx)).Store(&pResult.mZ[i]);
+			});
+		}
+
+		void Length2(T* pResult) const
+		{
+			this->DotProduct(*this, pResult);
+		}
+
+		void Length(T* pResult) const
+		{
+			Simd::ForEachPack<T>(this->Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P x = P::Load(&this->mX[i]), y = P::Load(&this->mY[i]), z = P::Load(&this->mZ[i]);
+				Simd::Sqrt((x * x) + (y * y) + (z * z)).Store(&pResult[i]);
+			});
+		}
+
+		void Normalize(Vec3SoA<T>& pResult) const
+		{
+			pResult.Resize(this->Size());
+			Simd::ForEachPack<T>(this->Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P x = P::Load(&this->mX[i]), y = P::Load(&this->mY[i]), z = P::Load(&this->mZ[i]);
+				const P length = Simd::Sqrt((x * x) + (y * y) + (z * z));
+				(x / length).Store(&pResult.mX[i]);
+				(y / length).Store(&pResult.mY[i]);
+				(z / length).Store(&pResult.mZ[i]);
+			});
+		}
+
+		void NormalizeSelf()
+		{
+			this->Normalize(*this);
+		}
+
+		static void Lerp(const Vec3SoA<T>& pStart, const Vec3SoA<T>& pEnd, const T pAlpha, Vec3SoA<T>& pResult)
+		{
+			pResult.Resize(pStart.Size());
+			Simd::ForEachPack<T>(pStart.Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P alpha = P::Splat(pAlpha);
+				const P inverse = P::Splat(1 - pAlpha);
+				((inverse * P::Load(&pStart.mX[i])) + (P::Load(&pEnd.mX[i]) * alpha)).Store(&pResult.mX[i]);
+				((inverse * P::Load(&pStart.mY[i])) + (P::Load(&pEnd.mY[i]) * alpha)).Store(&pResult.mY[i]);
+				((inverse * P::Load(&pStart.mZ[i])) + (P::Load(&pEnd.mZ[i]) * alpha)).Store(&pResult.mZ[i]);
+			});
+		}
+	};
+
+	typedef Vec3SoA<float>	FVec3SoA;
+	typedef Vec3SoA<double>	DVec3SoA;
+}
@@ -1,7 +1,9 @@
 #pragma once
+#include <type_traits>
 #include <limits>
 #include <algorithm>
 #include "Vec3.h"
+#include "Simd.h"
 
 #ifndef HALF_CIRCLE
 #define HALF_CIRCLE 180.0f
@@ -13,13 +15,10 @@
 
 namespace lm
 {
-	template <typename T> class Vec4
+	template <typename T> class alignas(Simd::VectorAlignment<T>::value) Vec4
 	{
 	private:
-		T mX;
-		T mY;
-		T mZ;
-		T mW;
+		T mData[4];
 
 	public:
 		static const T mUnitVal;
@@ -30,153 +29,110 @@ namespace lm
 		static const Vec4<T> mLeft;
 		static const Vec4<T> mRight;
 
-		Vec4()
-		{
-			this->mX = 0;
-			this->mY = 0;
-			this->mZ = 0;
-			this->mW = 0;
-		}
+		constexpr Vec4()
+			: mData{ 0, 0, 0, 0 }
+		{}
 
-		Vec4(const T pInit)
-		{
-			this->mX = pInit;
-			this->mY = pInit;
-			this->mZ = pInit;
-			this->mW = pInit;
-		}
+		constexpr Vec4(const T pInit)
+			: mData{ pInit, pInit, pInit, pInit }
+		{}
 
-		Vec4(const T pX, const T pY, const T pZ, const T pW)
-		{
-			this->mX = pX;
-			this->mY = pY;
-			this->mZ = pZ;
-			this->mW = pW;
-		}
+		constexpr Vec4(const T pX, const T pY, const T pZ, const T pW)
+			: mData{ pX, pY, pZ, pW }
+		{}
 
 		//Under directXMath, XMFLOAT4.w is initialized at 0
-		Vec4(const Vec3<T>& pVec3, float pW = 0)
-		{
-			this->mX = pVec3.X();
-			this->mY = pVec3.Y();
-			this->mZ = pVec3.Z();
-			this->mW = pW;
-		}
+		constexpr Vec4(const Vec3<T>& pVec3, float pW = 0)
+			: mData{ pVec3.X(), pVec3.Y(), pVec3.Z(), T(pW) }
+		{}
 
-		Vec4(const Vec4<T>& pOther)
-		{
-			this->mX = pOther.mX;
-			this->mY = pOther.mY;
-			this->mZ = pOther.mZ;
-			this->mW = pOther.mW;
-		}
+		Vec4(const Vec4<T>& pOther) = default;
+		Vec4(Vec4<T>&& pOther) noexcept = default;
+		Vec4<T>& operator=(const Vec4<T>& pOther) = default;
+		Vec4<T>& operator=(Vec4<T>&& pOther) noexcept = default;
 
-		Vec4(Vec4<T>&& pOther) noexcept
+		constexpr T& X()
 		{
-			this->mX = std::move(pOther.mX);
-			this->mY = std::move(pOther.mY);
-			this->mZ = std::move(pOther.mZ);
-			this->mW = std::move(pOther.mW);
+			return this->mData[0];
 		}
 
-		Vec4& operator=(const Vec4<T>& pOther)
+		constexpr T& Y()
 		{
-			if (this == &pOther)
-				return *this;
-
-			this->mX = pOther.mX;
-			this->mY = pOther.mY;
-			this->mZ = pOther.mZ;
-			this->mW = pOther.mW;
-
-			return *this;
+			return this->mData[1];
 		}
 
-		Vec4& operator=(Vec4<T>&& pOther) noexcept
+		constexpr T& Z()
 		{
-			if (this == &pOther)
-				return *this;
-
-			this->mX = std::move(pOther.mX);
-			this->mY = std::move(pOther.mY);
-			this->mZ = std::move(pOther.mZ);
-			this->mW = std::move(pOther.mW);
-
-			return *this;
+			return this->mData[2];
 		}
 
-		T& X()
+		constexpr T& W()
 		{
-			return this->mX;
+			return this->mData[3];
 		}
 
-		T& Y()
+		constexpr const T X() const
 		{
-			return this->mY;
+			return this->mData[0];
 		}
 
-		T& Z()
+		constexpr const T Y() const
 		{
-			return this->mZ;
+			return this->mData[1];
 		}
 
-		T& W()
+		constexpr const T Z() const
 		{
-			return this->mW;
+			return this->mData[2];
 		}
 
-		const T X() const
+		constexpr const T W() const
 		{
-			return this->mX;
+			return this->mData[3];
 		}
 
-		const T Y() const
+		constexpr T* Data()
 		{
-			return this->mY;
+			return this->mData;
 		}
 
-		const T Z() const
+		constexpr const T* Data() const
 		{
-			return this->mZ;
-		}
-
-		const T W() const
-		{
-			return this->mW;
+			return this->mData;
 		}
 
 		const T Length() const
 		{
-			return sqrt((this->mX * this->mX) +
-				(this->mY * this->mY) +
-				(this->mZ * this->mZ) +
-				(this->mW * this->mW));
+			return sqrt((this->mData[0] * this->mData[0]) +
+				(this->mData[1] * this->mData[1]) +
+				(this->mData[2] * this->mData[2]) +
+				(this->mData[3] * this->mData[3]));
 		}
 
-		const T Length2() const
+		constexpr const T Length2() const
 		{
-			return (this->mX * this->mX) +
-				(this->mY * this->mY) + 
-				(this->mZ * this->mZ) +
-				(this->mW * this->mW);
+			return (this->mData[0] * this->mData[0]) +
+				(this->mData[1] * this->mData[1]) + 
+				(this->mData[2] * this->mData[2]) +
+				(this->mData[3] * this->mData[3]);
 		}
 
-		bool IsLongerThan(Vec4<T> const& pOther) const	// return true if this vector Length2 is greater than the other
+		constexpr bool IsLongerThan(Vec4<T> const& pOther) const	// return true if this vector Length2 is greater than the other
 		{
-			return this->Length() > pOther.Length();
+			return this->Length2() > pOther.Length2();
 		}
 
-		bool IsShorterThan(Vec4<T> const& pOther) const	// return true if this vector Length2 is less than the other
+		constexpr bool IsShorterThan(Vec4<T> const& pOther) const	// return true if this vector Length2 is less than the other
 		{
-			return this->Length() < pOther.Length();
+			return this->Length2() < pOther.Length2();
 		}
 
 		const T DistanceFrom(Vec4<T> const& pOther) const // return distance between 2 points
 		{
-			return sqrt((pOther.mX - this.mX) * (pOther.mX - this.mX) +
-				(pOther.mY - this.mY) * (pOther.mY - this.mY) +
-				(pOther.mZ - this.mZ) * (pOther.mZ - this.mZ) +
-				(pOther.mW - this.mW) * (pOther.mW - this.mW));
+			return sqrt((pOther.mData[0] - this->mData[0]) * (pOther.mData[0] - this->mData[0]) +
+				(pOther.mData[1] - this->mData[1]) * (pOther.mData[1] - this->mData[1]) +
+				(pOther.mData[2] - this->mData[2]) * (pOther.mData[2] - this->mData[2]) +
+				(pOther.mData[3] - this->mData[3]) * (pOther.mData[3] - this->mData[3]));
 		}
 
 		const bool IsUnit() const
@@ -186,12 +142,18 @@ namespace lm
 				std::max(std::abs(this->Length()), std::abs(Vec4<T>::mUnitVal));
 		}
 
-		const T DotProduct(const Vec4<T>& pOther) const
+		constexpr const T DotProduct(const Vec4<T>& pOther) const
 		{
-			return (this->mX * pOther.mX) +
-				(this->mY * pOther.mY) + 
-				(this->mZ * pOther.mZ) +
-				(this->mW * pOther.mW);
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+					return Simd::Dot4(this->Data(), pOther.Data());
+			}
+
+			return (this->mData[0] * pOther.mData[0]) +
+				(this->mData[1] * pOther.mData[1]) + 
+				(this->mData[2] * pOther.mData[2]) +
+				(this->mData[3] * pOther.mData[3]);
 		}
 
 		 /* ----- 
@@ -201,10 +163,10 @@ namespace lm
 		/*Vec4<T> Perpendicular(const Vec4<T>& pOther) const
 		{
 			const Vec4<T> proj = this->ProjectOnTo(pOther);
-			return Vec4<T>(this->mX - proj.mX,
-				this->mY - proj.mY,
-				this->mZ - proj.mZ,
-				this->mW - proj.mW);
+			return Vec4<T>(this->mData[0] - proj.mData[0],
+				this->mData[1] - proj.mData[1],
+				this->mData[2] - proj.mData[2],
+				this->mData[3] - proj.mData[3]);
 		}*/
 
 
@@ -215,9 +177,9 @@ namespace lm
 		if we want a "cross-product" for 4D dimension, we should do it with 3 4d vectors
 		----- */
 
-		const Vec4<T> OrthogonalVector() const // return a vector orthogonal to self
+		constexpr const Vec4<T> OrthogonalVector() const // return a vector orthogonal to self
 		{
-			return Vec4<T>(this->mZ, this->mW, -this->mX, -this->mY);
+			return Vec4<T>(this->mData[2], this->mData[3], -this->mData[0], -this->mData[1]);
 		}
 
 		const T RadAngle(const Vec4<T>& pOther) const
@@ -248,10 +210,10 @@ namespace lm
 			const T length = pOther.Length2();
 			const T division = product / length;
 
-			return Vec4<T>(division * pOther.mX,
-				division * pOther.mY,
-				division * pOther.mZ,
-				division * pOther.mW);
+			return Vec4<T>(division * pOther.mData[0],
+				division * pOther.mData[1],
+				division * pOther.mData[2],
+				division * pOther.mData[3]);
 		}*/
 
 		Vec4<T> Reflexion(const Vec4<T>& pOther) const
@@ -261,10 +223,10 @@ namespace lm
 			{
 				/*			Vec4<T> proj = this->ProjectOnTo(pOther);
 							proj *= 2;
-							return Vec4<T>(this->mX - proj.mX,
-								this->mY - proj.mY,
-								this->mZ - proj.mZ,
-								this->mW - proj.mW);*/
+							return Vec4<T>(this->mData[0] - proj.mData[0],
+								this->mData[1] - proj.mData[1],
+								this->mData[2] - proj.mData[2],
+								this->mData[3] - proj.mData[3]);*/
 
 				tmp = pOther.Normalize();
 			}
@@ -273,285 +235,428 @@ namespace lm
 			const T doubledProduct = 2 * product;
 			const Vec4<T> vecProduct = doubledProduct * tmp;
 
-			return Vec4<T>(this->mX - vecProduct.mX,
-				this->mY - vecProduct.mY,
-				this->mZ - vecProduct.mZ,
-				this->mW - vecProduct.mW);
+			return Vec4<T>(this->mData[0] - vecProduct.mData[0],
+				this->mData[1] - vecProduct.mData[1],
+				this->mData[2] - vecProduct.mData[2],
+				this->mData[3] - vecProduct.mData[3]);
 		}
 
-		Vec4<T> Add(const Vec4<T>& pOther) const
+		constexpr Vec4<T> Add(const Vec4<T>& pOther) const
 		{
-			return Vec4<T>(this->mX + pOther.mX, this->mY + pOther.mY, this->mZ + pOther.mZ,
-				this->mW + pOther.mW);
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Vec4<T> result;
+					Simd::Add4(this->Data(), pOther.Data(), result.Data());
+					return result;
+				}
+			}
+
+			return Vec4<T>(this->mData[0] + pOther.mData[0], this->mData[1] + pOther.mData[1], this->mData[2] + pOther.mData[2],
+				this->mData[3] + pOther.mData[3]);
 		}
 
-		void AddSelf(const Vec4<T>& pOther)
+		constexpr void AddSelf(const Vec4<T>& pOther)
 		{
-			this->mX += pOther.mX;
-			this->mY += pOther.mY;
-			this->mZ += pOther.mZ;
-			this->mW += pOther.mW;
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Simd::Add4(this->Data(), pOther.Data(), this->Data());
+					return;
+				}
+			}
+
+			this->mData[0] += pOther.mData[0];
+			this->mData[1] += pOther.mData[1];
+			this->mData[2] += pOther.mData[2];
+			this->mData[3] += pOther.mData[3];
 		}
 
-		Vec4<T> Scale(const T pScale) const
+		constexpr Vec4<T> Scale(const T pScale) const
 		{
-			return Vec4<T>(this->mX * pScale,
-				this->mY * pScale,
-				this->mZ * pScale,
-				this->mW * pScale);
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Vec4<T> result;
+					Simd::Scale4(this->Data(), pScale, result.Data());
+					return result;
+				}
+			}
+
+			return Vec4<T>(this->mData[0] * pScale,
+				this->mData[1] * pScale,
+				this->mData[2] * pScale,
+				this->mData[3] * pScale);
 		}
 
-		void ScaleSelf(const T pScale)
+		constexpr void ScaleSelf(const T pScale)
 		{
-			this->mX *= pScale;
-			this->mY *= pScale;
-			this->mZ *= pScale;
-			this->mW *= pScale;
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Simd::Scale4(this->Data(), pScale, this->Data());
+					return;
+				}
+			}
+
+			this->mData[0] *= pScale;
+			this->mData[1] *= pScale;
+			this->mData[2] *= pScale;
+			this->mData[3] *= pScale;
 		}
 
 		Vec4<T> Normalize() const
 		{
 			T length = this->Length();
-			return Vec4<T>(this->mX / length,
-				this->mY / length,
-				this->mZ / length,
-				this->mW / length);
+			return Vec4<T>(this->mData[0] / length,
+				this->mData[1] / length,
+				this->mData[2] / length,
+				this->mData[3] / length);
+		}
+
+		// FastRsqrt instead of sqrt and divide, relative error <= 5e-7 for floats
+		Vec4<T> Normalize(Utilities::FastMathTag) const
+		{
+			const T invLength = Utilities::FastRsqrt(this->Length2());
+			return Vec4<T>(this->mData[0] * invLength,
+				this->mData[1] * invLength,
+				this->mData[2] * invLength,
+				this->mData[3] * invLength);
 		}
 
 		void NormalizeSelf()
 		{
 			T length = this->Length();
-			this->mX /= length;
-			this->mY /= length;
-			this->mZ /= length;
-			this->mW /= length;
+			this->mData[0] /= length;
+			this->mData[1] /= length;
+			this->mData[2] /= length;
+			this->mData[3] /= length;
 		}
 
-		T& operator[](const int pIdx)
+		// unchecked in release builds, asserts the index when NDEBUG is not defined
+		constexpr T& operator[](const int pIdx)
 		{
-			switch (pIdx)
-			{
-			case 0:		return mX;
-			case 1:		return mY;
-			case 2:		return mZ;
-			case 3:		return mW;
+			assert(pIdx >= 0 && pIdx < 4 && "Vec4 index out of range");
+			return this->mData[pIdx];
+		}
 
-			case 'x':	return mX;
-			case 'y':	return mY;
-			case 'z':	return mZ;
-			case 'w':	return mW;
+		constexpr const T& operator[](const int pIdx) const
+		{
+			assert(pIdx >= 0 && pIdx < 4 && "Vec4 index out of range");
+			return this->mData[pIdx];
+		}
+
+		// by axis name as the const char* overload, a char must not convert to an index
+		template <typename Char, std::enable_if_t<std::is_same_v<Char, char>, int> = 0>
+		constexpr T& operator[](const Char pAxis)
+		{
+			switch (pAxis)
+			{
+			case 'x': return this->mData[0];
+			case 'y': return this->mData[1];
+			case 'z': return this->mData[2];
+			case 'w': return this->mData[3];
 
-			default:	return mX;
+			default: return this->mData[0];
 			}
 		}
 
-		const T operator[](const int pIdx) const
+		template <typename Char, std::enable_if_t<std::is_same_v<Char, char>, int> = 0>
+		constexpr const T& operator[](const Char pAxis) const
 		{
-			switch (pIdx)
+			switch (pAxis)
 			{
-			case 0:		return mX;
-			case 1:		return mY;
-			case 2:		return mZ;
-			case 3:		return mW;
+			case 'x': return this->mData[0];
+			case 'y': return this->mData[1];
+			case 'z': return this->mData[2];
+			case 'w': return this->mData[3];
 
-			case 'x':	return mX;
-			case 'y':	return mY;
-			case 'z':	return mZ;
-			case 'w':	return mW;
+			default: return this->mData[0];
+			}
+		}
+
+		template <std::size_t pIdx> constexpr T& get()
+		{
+			static_assert(pIdx < 4, "Vec4 index out of range");
+			return this->mData[pIdx];
+		}
 
-			default:	return mX;
+		template <std::size_t pIdx> constexpr const T& get() const
+		{
+			static_assert(pIdx < 4, "Vec4 index out of range");
+			return this->mData[pIdx];
+		}
+
+		// Swizzle<3, 2, 1, 0>() == (w, z, y, x), Swizzle<0, 1, 2>() == (x, y, z) as a Vec3
+		template <int... pIdx> constexpr auto Swizzle() const
+		{
+			static_assert(sizeof...(pIdx) >= 2 && sizeof...(pIdx) <= 4, "Vec4 swizzles have 2 to 4 components");
+			static_assert(((pIdx >= 0 && pIdx < 4) && ...), "Vec4 swizzle index out of range");
+
+			if constexpr (sizeof...(pIdx) == 2)
+				return Vec2<T>(this->mData[pIdx]...);
+			else if constexpr (sizeof...(pIdx) == 3)
+				return Vec3<T>(this->mData[pIdx]...);
+			else
+			{
+				if constexpr (Simd::IsAccelerated<T>)
+				{
+					if (!Simd::IsConstantEvaluated())
+					{
+						Vec4<T> result;
+						Simd::Shuffle4<pIdx...>(this->Data(), result.Data());
+						return result;
+					}
+				}
+
+				return Vec4<T>(this->mData[pIdx]...);
 			}
 		}
 
-		T& operator[](const char* pIdx)
+		constexpr T& operator[](const char* pIdx)
 		{
 			switch (pIdx[0])
 			{
-			case 'x': return mX;
-			case 'y': return mY;
-			case 'z': return mZ;
-			case 'w': return mW;
+			case 'x': return mData[0];
+			case 'y': return mData[1];
+			case 'z': return mData[2];
+			case 'w': return mData[3];
 
-			default: return mX;
+			default: return mData[0];
 			}
 		}
 
-		const T operator[](const char* pIdx) const
+		constexpr const T operator[](const char* pIdx) const
 		{
 			switch (pIdx[0])
 			{
-			case 'x': return mX;
-			case 'y': return mY;
-			case 'z': return mZ;
-			case 'w': return mW;
+			case 'x': return mData[0];
+			case 'y': return mData[1];
+			case 'z': return mData[2];
+			case 'w': return mData[3];
 
-			default: return  mX;
+			default: return  mData[0];
 			}
 		}
 
-		const bool operator==(const Vec4<T>& pOther) const
+		// exact, component-wise
+		constexpr bool operator==(const Vec4<T>& pOther) const
 		{
-			if (this == &pOther)
-				return true;
-
-			return std::abs(this->Length() - pOther.Length()) <= std::numeric_limits<T>::epsilon() ||
-				std::abs(this->Length() - pOther.Length()) <= std::numeric_limits<T>::epsilon() *
-				std::max(std::abs(this->Length()), std::abs(pOther.Length()));
+			return this->mData[0] == pOther.mData[0] && this->mData[1] == pOther.mData[1] &&
+				this->mData[2] == pOther.mData[2] && this->mData[3] == pOther.mData[3];
 		}
 
-		const bool operator!=(const Vec4<T>& pOther) const
+		constexpr bool operator!=(const Vec4<T>& pOther) const
 		{
 			return !(*this == pOther);
 		}
 
-		const bool operator<(const Vec4<T>& pOther) const
+		// pAbsEps covers components near zero, pRelEps scales with the larger magnitude
+		constexpr bool ApproxEqual(const Vec4<T>& pOther, const T pAbsEps = std::numeric_limits<T>::epsilon(),
+			const T pRelEps = std::numeric_limits<T>::epsilon()) const
 		{
-			return this->Length() < pOther.Length();
+			return Utilities::ApproxEqual(this->mData[0], pOther.mData[0], pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mData[1], pOther.mData[1], pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mData[2], pOther.mData[2], pAbsEps, pRelEps) &&
+				Utilities::ApproxEqual(this->mData[3], pOther.mData[3], pAbsEps, pRelEps);
 		}
 
-		const bool operator<=(const Vec4<T>& pOther) const
+		bool UlpEqual(const Vec4<T>& pOther, const unsigned int pMaxUlps = 4) const
 		{
-			return this->Length() < pOther.Length() || (*this == pOther);
+			return Utilities::UlpEqual(this->mData[0], pOther.mData[0], pMaxUlps) &&
+				Utilities::UlpEqual(this->mData[1], pOther.mData[1], pMaxUlps) &&
+				Utilities::UlpEqual(this->mData[2], pOther.mData[2], pMaxUlps) &&
+				Utilities::UlpEqual(this->mData[3], pOther.mData[3], pMaxUlps);
 		}
 
-		const bool operator>(const Vec4<T>& pOther) const
+		// ordered by magnitude
+		constexpr bool operator<(const Vec4<T>& pOther) const
 		{
-			return !(*this < pOther);
+			return this->Length2() < pOther.Length2();
 		}
 
-		const bool operator>=(const Vec4<T>& pOther) const
+		constexpr bool operator<=(const Vec4<T>& pOther) const
 		{
-			return !(*this <= pOther);
+			return this->Length2() <= pOther.Length2();
 		}
 
-		Vec4<T> operator+(const Vec4<T>& pOther) const
+		constexpr bool operator>(const Vec4<T>& pOther) const
 		{
-			return Vec4(this->mX + pOther.mX, this->mY + pOther.mY, this->mZ + pOther.mZ, this->mW + pOther.mW);
+			return this->Length2() > pOther.Length2();
 		}
 
-		void operator+=(const Vec4<T>& pOther)
+		constexpr bool operator>=(const Vec4<T>& pOther) const
 		{
-			this->mX += pOther.mX;
-			this->mY += pOther.mY;
-			this->mZ += pOther.mZ;
-			this->mW += pOther.mW;
+			return this->Length2() >= pOther.Length2();
 		}
 
-		Vec4<T> operator-(const Vec4<T>& pOther) const
+		constexpr Vec4<T> operator+(const Vec4<T>& pOther) const
 		{
-			return Vec4(this->mX - pOther.mX,
-				this->mY - pOther.mY,
-				this->mZ - pOther.mZ,
-				this->mW - pOther.mW);
+			return this->Add(pOther);
 		}
 
-		void operator-=(const Vec4<T>& pOther)
+		constexpr void operator+=(const Vec4<T>& pOther)
 		{
-			this->mX -= pOther.mX;
-			this->mY -= pOther.mY;
-			this->mZ -= pOther.mZ;
-			this->mW -= pOther.mW;
+			this->AddSelf(pOther);
 		}
 
-		Vec4<T> operator-() const
+		constexpr Vec4<T> operator-(const Vec4<T>& pOther) const
 		{
-			return Vec4(-this->mX, -this->mY, -this->mZ, this->mW);
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Vec4<T> result;
+					Simd::Sub4(this->Data(), pOther.Data(), result.Data());
+					return result;
+				}
+			}
+
+			return Vec4(this->mData[0] - pOther.mData[0],
+				this->mData[1] - pOther.mData[1],
+				this->mData[2] - pOther.mData[2],
+				this->mData[3] - pOther.mData[3]);
+		}
+
+		constexpr void operator-=(const Vec4<T>& pOther)
+		{
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Simd::Sub4(this->Data(), pOther.Data(), this->Data());
+					return;
+				}
+			}
+
+			this->mData[0] -= pOther.mData[0];
+			this->mData[1] -= pOther.mData[1];
+			this->mData[2] -= pOther.mData[2];
+			this->mData[3] -= pOther.mData[3];
+		}
+
+		constexpr Vec4<T> operator-() const
+		{
+			return Vec4(-this->mData[0], -this->mData[1], -this->mData[2], this->mData[3]);
 		}
 
-		Vec4<T> operator*(const T pValue) const
+		constexpr Vec4<T> operator*(const T pValue) const
 		{
 			return this->Scale(pValue);
 		}
 
-		void operator*=(const T pValue)
+		constexpr void operator*=(const T pValue)
 		{
 			*this = this->Scale(pValue);
 		}
 
-		Vec4<T> operator*(const Vec4<T>& pOther) const
+		constexpr Vec4<T> operator*(const Vec4<T>& pOther) const
 		{
-			return Vec4<T>(this->mX * pOther.mX,
-				this->mY * pOther.mY,
-				this->mZ * pOther.mZ,
-				this->mW * pOther.mW);
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Vec4<T> result;
+					Simd::Mul4(this->Data(), pOther.Data(), result.Data());
+					return result;
+				}
+			}
+
+			return Vec4<T>(this->mData[0] * pOther.mData[0],
+				this->mData[1] * pOther.mData[1],
+				this->mData[2] * pOther.mData[2],
+				this->mData[3] * pOther.mData[3]);
 		}
 
-		void operator*=(const Vec4<T>& pOther)
+		constexpr void operator*=(const Vec4<T>& pOther)
 		{
-			this->mX *= pOther.mX;
-			this->mY *= pOther.mY;
-			this->mZ *= pOther.mZ;
-			this->mW *= pOther.mW;
+			if constexpr (Simd::IsAccelerated<T>)
+			{
+				if (!Simd::IsConstantEvaluated())
+				{
+					Simd::Mul4(this->Data(), pOther.Data(), this->Data());
+					return;
+				}
+			}
+
+			this->mData[0] *= pOther.mData[0];
+			this->mData[1] *= pOther.mData[1];
+			this->mData[2] *= pOther.mData[2];
+			this->mData[3] *= pOther.mData[3];
 		}
 
-		Vec4<T> operator/(const T pValue) const
+		constexpr Vec4<T> operator/(const T pValue) const
 		{
-			return Vec4(this->mX / pValue,
-				this->mY / pValue,
-				this->mZ / pValue,
-				this->mW / pValue);
+			return Vec4(this->mData[0] / pValue,
+				this->mData[1] / pValue,
+				this->mData[2] / pValue,
+				this->mData[3] / pValue);
 		}
 
-		void operator/=(const T pValue)
+		constexpr void operator/=(const T pValue)
 		{
-			this->mX /= pValue;
-			this->mY /= pValue;
-			this->mZ /= pValue;
-			this->mW /= pValue;
+			this->mData[0] /= pValue;
+			this->mData[1] /= pValue;
+			this->mData[2] /= pValue;
+			this->mData[3] /= pValue;
 		}
 
-		Vec4<T> operator/(const Vec4<T>& pOther) const
+		constexpr Vec4<T> operator/(const Vec4<T>& pOther) const
 		{
-			return Vec4<T>(this->mX / pOther.mX,
-				this->mY / pOther.mY,
-				this->mZ / pOther.mZ,
-				this->mW / pOther.mW);
+			return Vec4<T>(this->mData[0] / pOther.mData[0],
+				this->mData[1] / pOther.mData[1],
+				this->mData[2] / pOther.mData[2],
+				this->mData[3] / pOther.mData[3]);
 		}
 
-		void operator/=(const Vec4<T>& pOther)
+		constexpr void operator/=(const Vec4<T>& pOther)
 		{
-			this->mX /= pOther.mX;
-			this->mY /= pOther.mY;
-			this->mZ /= pOther.mZ;
-			this->mW /= pOther.mW;
+			this->mData[0] /= pOther.mData[0];
+			this->mData[1] /= pOther.mData[1];
+			this->mData[2] /= pOther.mData[2];
+			this->mData[3] /= pOther.mData[3];
 		}
 
 		void operator++(int)
 		{
 			T length = this->Length();
-			this->mX *= (length + 1) / length;
-			this->mY *= (length + 1) / length;
-			this->mZ *= (length + 1) / length;
-			this->mW *= (length + 1) / length;
+			this->mData[0] *= (length + 1) / length;
+			this->mData[1] *= (length + 1) / length;
+			this->mData[2] *= (length + 1) / length;
+			this->mData[3] *= (length + 1) / length;
 		}
 
 		void operator--(int)
 		{
 			T length = this->Length();
-			this->mX *= (length - 1) / length;
-			this->mY *= (length - 1) / length;
-			this->mZ *= (length - 1) / length;
-			this->mW *= (length - 1) / length;
+			this->mData[0] *= (length - 1) / length;
+			this->mData[1] *= (length - 1) / length;
+			this->mData[2] *= (length - 1) / length;
+			this->mData[3] *= (length - 1) / length;
 		}
 
-		void HomogenizeSelf()
+		constexpr void HomogenizeSelf()
 		{
-			if (this->mW == 0)
+			if (this->mData[3] == 0)
 				return;
 
-			this->mX /= this->mW;
-			this->mY /= this->mW;
-			this->mZ /= this->mW;
+			this->mData[0] /= this->mData[3];
+			this->mData[1] /= this->mData[3];
+			this->mData[2] /= this->mData[3];
 		}
 
-		Vec4<T> Homogenize()
+		constexpr Vec4<T> Homogenize()
 		{
-			if (this->mW == 0)
+			if (this->mData[3] == 0)
 				return Vec4<T>();
 
-			return Vec4<T>(this->mX / this->mW,
-				this->mY / this->mW,
-				this->mZ / this->mW,
+			return Vec4<T>(this->mData[0] / this->mData[3],
+				this->mData[1] / this->mData[3],
+				this->mData[2] / this->mData[3],
 				1);
 		}
 
@@ -561,12 +666,12 @@ namespace lm
 		}
 	};
 
-	template<class T> Vec4<T> operator*(const double pValue, const Vec4<T>& pOther)
+	template<class T> constexpr Vec4<T> operator*(const double pValue, const Vec4<T>& pOther)
 	{
 		return pOther * T(pValue);
 	}
 
-	template<class T> Vec4<T> operator/(const double pValue, const Vec4<T>& pOther)
+	template<class T> constexpr Vec4<T> operator/(const double pValue, const Vec4<T>& pOther)
 	{
 		return Vec4<T>(T(pValue / pOther.X()),
 			T(pValue / pOther.Y()),
@@ -574,19 +679,36 @@ namespace lm
 			T(pValue / pOther.W()));
 	}
 
-	template<class T> const T operator,(const Vec4<T>& pOther1, const Vec4<T>& pOther2)
+	template<class T> constexpr const T operator,(const Vec4<T>& pOther1, const Vec4<T>& pOther2)
 	{
 		return pOther1.DotProduct(pOther2);
 	}
 
-	template<class T> const Vec4<T> Vec4<T>::mZero = Vec4();
-	template<class T> const Vec4<T> Vec4<T>::mOne = Vec4(1);
-	template<class T> const Vec4<T> Vec4<T>::mUp(0, 1, 0, 0);
-	template<class T> const Vec4<T> Vec4<T>::mDown(0, -1, 0, 0);
-	template<class T> const Vec4<T> Vec4<T>::mLeft(-1, 0, 0, 0);
-	template<class T> const Vec4<T> Vec4<T>::mRight(1, 0, 0, 0);
-	template<class T> const T Vec4<T>::mUnitVal = 1;
+	template<class T> constexpr Vec4<T> Vec4<T>::mZero = Vec4();
+	template<class T> constexpr Vec4<T> Vec4<T>::mOne = Vec4(1);
+	template<class T> constexpr Vec4<T> Vec4<T>::mUp(0, 1, 0, 0);
+	template<class T> constexpr Vec4<T> Vec4<T>::mDown(0, -1, 0, 0);
+	template<class T> constexpr Vec4<T> Vec4<T>::mLeft(-1, 0, 0, 0);
+	template<class T> constexpr Vec4<T> Vec4<T>::mRight(1, 0, 0, 0);
+	template<class T> constexpr T Vec4<T>::mUnitVal = 1;
 
 	typedef Vec4<float>		FVec4;
 	typedef Vec4<double>	DVec4;
-}
\ No newline at end of file
+
+	static_assert(sizeof(FVec4) == 4 * sizeof(float), "FVec4 must map onto a single SIMD register");
+	static_assert(alignof(FVec4) == Simd::VectorAlignment<float>::value,
+		"FVec4 must keep its SIMD alignment inside arrays and upload buffers");
+	static_assert(std::is_trivially_copyable_v<FVec4> && std::is_standard_layout_v<FVec4>,
+		"FVec4 must be trivially copyable and standard layout");
+	static_assert(std::is_trivially_copyable_v<DVec4> && std::is_standard_layout_v<DVec4>,
+		"DVec4 must be trivially copyable and standard layout");
+}
+
+/* -----
+Structured bindings: auto [x, y, z, w] = v4;
+----- */
+namespace std
+{
+	template <typename T> struct tuple_size<lm::Vec4<T>> : integral_constant<size_t, 4> {};
+	template <size_t pIdx, typename T> struct tuple_element<pIdx, lm::Vec4<T>> { using type = T; };
+}
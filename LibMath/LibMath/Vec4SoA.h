@@ -0,0 +1,312 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "Simd.h"
+#include "Vec4.h"
+
+namespace lm
+{
+	/* -----
+	Structure-of-arrays storage for large Vec4 streams: one aligned lane per component
+	so the bulk functions below run Simd::Pack<T>::Type::Width elements per iteration.
+	----- */
+
+	template <typename T> class Vec4SoA
+	{
+	public:
+		using Lane = std::vector<T, Simd::AlignedAllocator<T>>;
+
+		// behaves like a Vec4<T> that reads and writes element pIdx of the container
+		class Element
+		{
+		private:
+			Vec4SoA<T>* mOwner;
+			std::size_t mIdx;
+
+		public:
+			Element(Vec4SoA<T>& pOwner, const std::size_t pIdx)
+			{
+				this->mOwner = &pOwner;
+				this->mIdx = pIdx;
+			}
+
+			T& X()
+			{
+				return this->mOwner->mX[this->mIdx];
+			}
+
+			T& Y()
+			{
+				return this->mOwner->mY[this->mIdx];
+			}
+
+			T& Z()
+			{
+				return this->mOwner->mZ[this->mIdx];
+			}
+
+			T& W()
+			{
+				return this->mOwner->mW[this->mIdx];
+			}
+
+			const T X() const
+			{
+				return this->mOwner->mX[this->mIdx];
+			}
+
+			const T Y() const
+			{
+				return this->mOwner->mY[this->mIdx];
+			}
+
+			const T Z() const
+			{
+				return this->mOwner->mZ[this->mIdx];
+			}
+
+			const T W() const
+			{
+				return this->mOwner->mW[this->mIdx];
+			}
+
+			operator Vec4<T>() const
+			{
+				return Vec4<T>(this->X(), this->Y(), this->Z(), this->W());
+			}
+
+			Element& operator=(const Vec4<T>& pOther)
+			{
+				this->X() = pOther.X();
+				this->Y() = pOther.Y();
+				this->Z() = pOther.Z();
+				this->W() = pOther.W();
+				return *this;
+			}
+
+			Element& operator=(const Element& pOther)
+			{
+				return *this = Vec4<T>(pOther);
+			}
+
+			const T Length() const
+			{
+				return Vec4<T>(*this).Length();
+			}
+
+			const T Length2() const
+			{
+				return Vec4<T>(*this).Length2();
+			}
+
+			const T DotProduct(const Vec4<T>& pOther) const
+			{
+				return Vec4<T>(*this).DotProduct(pOther);
+			}
+
+			Vec4<T> Normalize() const
+			{
+				return Vec4<T>(*this).Normalize();
+			}
+
+			void NormalizeSelf()
+			{
+				*this = this->Normalize();
+			}
+		};
+
+	private:
+		Lane mX;
+		Lane mY;
+		Lane mZ;
+		Lane mW;
+
+	public:
+		Vec4SoA() = default;
+
+		Vec4SoA(const std::size_t pSize)
+		{
+			this->Resize(pSize);
+		}
+
+		Vec4SoA(const Vec4<T>* pSource, const std::size_t pCount)
+		{
+			this->Resize(pCount);
+			for (std::size_t i = 0; i < pCount; i++)
+			{
+				this->mX[i] = pSource[i].X();
+				this->mY[i] = pSource[i].Y();
+				this->mZ[i] = pSource[i].Z();
+				this->mW[i] = pSource[i].W();
+			}
+		}
+
+		std::size_t Size() const
+		{
+			return this->mX.size();
+		}
+
+		void Resize(const std::size_t pSize)
+		{
+			this->mX.resize(pSize);
+			this->mY.resize(pSize);
+			this->mZ.resize(pSize);
+			this->mW.resize(pSize);
+		}
+
+		void Reserve(const std::size_t pCapacity)
+		{
+			this->mX.reserve(pCapacity);
+			this->mY.reserve(pCapacity);
+			this->mZ.reserve(pCapacity);
+			this->mW.reserve(pCapacity);
+		}
+
+		void Clear()
+		{
+			this->mX.clear();
+			this->mY.clear();
+			this->mZ.clear();
+			this->mW.clear();
+		}
+
+		void PushBack(const Vec4<T>& pValue)
+		{
+			this->mX.push_back(pValue.X());
+			this->mY.push_back(pValue.Y());
+			this->mZ.push_back(pValue.Z());
+			this->mW.push_back(pValue.W());
+		}
+
+		// writes the container back to AoS form, pOut must hold Size() elements
+		void Store(Vec4<T>* pOut) const
+		{
+			for (std::size_t i = 0; i < this->Size(); i++)
+				pOut[i] = Vec4<T>(this->mX[i], this->mY[i], this->mZ[i], this->mW[i]);
+		}
+
+		T* X()
+		{
+			return this->mX.data();
+		}
+
+		T* Y()
+		{
+			return this->mY.data();
+		}
+
+		T* Z()
+		{
+			return this->mZ.data();
+		}
+
+		T* W()
+		{
+			return this->mW.data();
+		}
+
+		const T* X() const
+		{
+			return this->mX.data();
+		}
+
+		const T* Y() const
+		{
+			return this->mY.data();
+		}
+
+		const T* Z() const
+		{
+			return this->mZ.data();
+		}
+
+		const T* W() const
+		{
+			return this->mW.data();
+		}
+
+		Element operator[](const std::size_t pIdx)
+		{
+			return Element(*this, pIdx);
+		}
+
+		const Vec4<T> operator[](const std::size_t pIdx) const
+		{
+			return Vec4<T>(this->mX[pIdx], this->mY[pIdx], this->mZ[pIdx], this->mW[pIdx]);
+		}
+
+		/* -----
+		Bulk functions: pResult must hold Size() values, pOther must be at least as long as this.
+		----- */
+
+		void DotProduct(const Vec4SoA<T>& pOther, T* pResult) const
+		{
+			Simd::ForEachPack<T>(this->Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P x = P::Load(&this->mX[i]) * P::Load(&pOther.mX[i]);
+				const P y = P::Load(&this->mY[i]) * P::Load(&pOther.mY[i]);
+				const P z = P::Load(&this->mZ[i]) * P::Load(&pOther.mZ[i]);
+				const P w = P::Load(&this->mW[i]) * P::Load(&pOther.mW[i]);
+				(x + y + z + w).Store(&pResult[i]);
+			});
+		}
+
+		void Length2(T* pResult) const
+		{
+			this->DotProduct(*this, pResult);
+		}
+
+		void Length(T* pResult) const
+		{
+			Simd::ForEachPack<T>(this->Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P x = P::Load(&this->mX[i]), y = P::Load(&this->mY[i]);
+				const P z = P::Load(&this->mZ[i]), w = P::Load(&this->mW[i]);
+				Simd::Sqrt((x * x) + (y * y) + (z * z) + (w * w)).Store(&pResult[i]);
+			});
+		}
+
+		void Normalize(Vec4SoA<T>& pResult) const
+		{
+			pResult.Resize(this->Size());
+			Simd::ForEachPack<T>(this->Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P x = P::Load(&this->mX[i]), y = P::Load(&this->mY[i]);
+				const P z = P::Load(&this->mZ[i]), w = P::Load(&this->mW[i]);
+				const P length = Simd::Sqrt((x * x) + (y * y) + (z * z) + (w * w));
+				(x / length).Store(&pResult.mX[i]);
+				(y / length).Store(&pResult.mY[i]);
+				(z / length).Store(&pResult.mZ[i]);
+				(w / length).Store(&pResult.mW[i]);
+			});
+		}
+
+		void NormalizeSelf()
+		{
+			this->Normalize(*this);
+		}
+
+		static void Lerp(const Vec4SoA<T>& pStart, const Vec4SoA<T>& pEnd, const T pAlpha, Vec4SoA<T>& pResult)
+		{
+			pResult.Resize(pStart.Size());
+			Simd::ForEachPack<T>(pStart.Size(), [&](auto pPack, const std::size_t i)
+			{
+				using P = decltype(pPack);
+				const P alpha = P::Splat(pAlpha);
+				const P inverse = P::Splat(1 - pAlpha);
+				((inverse * P::Load(&pStart.mX[i])) + (P::Load(&pEnd.mX[i]) * alpha)).Store(&pResult.mX[i]);
+				((inverse * P::Load(&pStart.mY[i])) + (P::Load(&pEnd.mY[i]) * alpha)).Store(&pResult.mY[i]);
+				((inverse * P::Load(&pStart.mZ[i])) + (P::Load(&pEnd.mZ[i]) * alpha)).Store(&pResult.mZ[i]);
+				((inverse * P::Load(&pStart.mW[i])) + (P::Load(&pEnd.mW[i]) * alpha)).Store(&pResult.mW[i]);
+			});
+		}
+	};
+
+	typedef Vec4SoA<float>	FVec4SoA;
+	typedef Vec4SoA<double>	DVec4SoA;
+}
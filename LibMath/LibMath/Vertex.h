@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
 #include "Vec3.h"
 namespace lm
 {
@@ -51,5 +55,84 @@ namespace lm
 		FVec3& GetNormal() { return mNormal; }
 		FVec2& GetTextCoords() { return mTextCoords; }
 		FVec3& GetColor() { return mColor; }
+
+		const FVec3& GetPosition() const { return mPosition; }
+		const FVec3& GetNormal() const { return mNormal; }
+		const FVec2& GetTextCoords() const { return mTextCoords; }
+		const FVec3& GetColor() const { return mColor; }
+	};
+
+	/* -----
+	Vertex with up to 4 bone influences, the input of SkinVertices (Skinning.h).
+	Unused influences keep a weight of 0, their index must still be inside the palette.
+	----- */
+
+	class SkinnedVertex
+	{
+	public:
+		static constexpr std::size_t mMaxInfluences = 4;
+
+	private:
+		FVec3 mPosition{};
+		FVec3 mNormal{};
+		FVec2 mTextCoords{};
+		FVec3 mColor{};
+		std::uint16_t mBoneIndices[mMaxInfluences]{};
+		float mBoneWeights[mMaxInfluences]{};
+
+	public:
+		SkinnedVertex() = default;
+
+		explicit SkinnedVertex(const Vertex& pVertex)
+			: mPosition{ pVertex.GetPosition() }, mNormal{ pVertex.GetNormal() },
+			mTextCoords{ pVertex.GetTextCoords() }, mColor{ pVertex.GetColor() }
+		{}
+
+		SkinnedVertex(const Vertex& pVertex, const std::uint16_t (&pBoneIndices)[mMaxInfluences],
+			const float (&pBoneWeights)[mMaxInfluences])
+			: SkinnedVertex(pVertex)
+		{
+			for (std::size_t i = 0; i < mMaxInfluences; i++)
+				this->SetInfluence(i, pBoneIndices[i], pBoneWeights[i]);
+		}
+
+		void SetInfluence(const std::size_t pSlot, const std::uint16_t pBone, const float pWeight)
+		{
+			assert(pSlot < mMaxInfluences && "SkinnedVertex influence out of range");
+			this->mBoneIndices[pSlot] = pBone;
+			this->mBoneWeights[pSlot] = pWeight;
+		}
+
+		// rescales the weights to sum to 1, left untouched when they are all 0
+		void NormalizeWeights()
+		{
+			float sum = 0.f;
+			for (const float weight : this->mBoneWeights)
+				sum += weight;
+
+			if (sum == 0.f)
+				return;
+
+			for (float& weight : this->mBoneWeights)
+				weight /= sum;
+		}
+
+		Vertex ToVertex() const
+		{
+			return Vertex(this->mPosition, this->mNormal, this->mTextCoords, this->mColor);
+		}
+
+		FVec3& GetPosition() { return mPosition; }
+		FVec3& GetNormal() { return mNormal; }
+		FVec2& GetTextCoords() { return mTextCoords; }
+		FVec3& GetColor() { return mColor; }
+
+		const FVec3& GetPosition() const { return mPosition; }
+		const FVec3& GetNormal() const { return mNormal; }
+		const FVec2& GetTextCoords() const { return mTextCoords; }
+		const FVec3& GetColor() const { return mColor; }
+
+		std::uint16_t GetBoneIndex(const std::size_t pSlot) const { return mBoneIndices[pSlot]; }
+		float GetBoneWeight(const std::size_t pSlot) const { return mBoneWeights[pSlot]; }
 	};
 }
\ No newline at end of file
@@ -0,0 +1,317 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+#include "AABB.h"
+#include "Mat4.h"
+#include "MeshNormals.h"
+#include "MeshOptimize.h"
+#include "MeshWeld.h"
+#include "Parallel.h"
+#include "Simd.h"
+#include "Vertex.h"
+#include "VertexStream.h"
+
+namespace lm
+{
+	// Interleaved is an array of Vertex, Deinterleaved one packed array per attribute
+	enum class VertexLayout
+	{
+		Interleaved, Deinterleaved
+	};
+
+	/* -----
+	Mesh vertices in either layout. Interleaved keeps each vertex in one cache line region for
+	per-vertex work and matches Vertex for uploads, Deinterleaved streams a single attribute
+	through the packed kernels (Mat4::TransformPoints, AABB::FromPoints). The attribute views
+	work in both layouts and stay valid until the buffer is resized or its layout changes.
+	----- */
+
+	class VertexBuffer
+	{
+	public:
+		explicit VertexBuffer(const VertexLayout pLayout = VertexLayout::Interleaved)
+			: mLayout(pLayout)
+		{}
+
+		VertexBuffer(const Vertex* pVertices, const std::size_t pCount, const VertexLayout pLayout = VertexLayout::Interleaved)
+			: mLayout(pLayout)
+		{
+			this->Resize(pCount);
+			for (std::size_t i = 0; i < pCount; i++)
+				this->SetVertex(i, pVertices[i]);
+		}
+
+		/* Rule of five */
+		VertexBuffer(const VertexBuffer& pOther) = default;
+		VertexBuffer(VertexBuffer&& pOther) noexcept = default;
+		VertexBuffer& operator=(const VertexBuffer& pOther) = default;
+		VertexBuffer& operator=(VertexBuffer&& pOther) noexcept = default;
+
+		/**/
+
+		VertexLayout GetLayout() const { return mLayout; }
+
+		std::size_t Size() const
+		{
+			return this->mLayout == VertexLayout::Interleaved ? this->mVertices.size() : this->mPositions.size();
+		}
+
+		void Resize(const std::size_t pSize)
+		{
+			if (this->mLayout == VertexLayout::Interleaved)
+			{
+				this->mVertices.resize(pSize);
+				return;
+			}
+
+			this->mPositions.resize(pSize);
+			this->mNormals.resize(pSize);
+			this->mTextCoords.resize(pSize);
+			this->mColors.resize(pSize);
+		}
+
+		void Reserve(const std::size_t pCapacity)
+		{
+			if (this->mLayout == VertexLayout::Interleaved)
+			{
+				this->mVertices.reserve(pCapacity);
+				return;
+			}
+
+			this->mPositions.reserve(pCapacity);
+			this->mNormals.reserve(pCapacity);
+			this->mTextCoords.reserve(pCapacity);
+			this->mColors.reserve(pCapacity);
+		}
+
+		void Clear()
+		{
+			this->Resize(0);
+		}
+
+		void PushBack(const Vertex& pVertex)
+		{
+			if (this->mLayout == VertexLayout::Interleaved)
+			{
+				this->mVertices.push_back(pVertex);
+				return;
+			}
+
+			this->mPositions.push_back(pVertex.GetPosition());
+			this->mNormals.push_back(pVertex.GetNormal());
+			this->mTextCoords.push_back(pVertex.GetTextCoords());
+			this->mColors.push_back(pVertex.GetColor());
+		}
+
+		Vertex GetVertex(const std::size_t pIdx) const
+		{
+			if (this->mLayout == VertexLayout::Interleaved)
+				return this->mVertices[pIdx];
+
+			return Vertex(this->mPositions[pIdx], this->mNormals[pIdx], this->mTextCoords[pIdx], this->mColors[pIdx]);
+		}
+
+		void SetVertex(const std::size_t pIdx, const Vertex& pVertex)
+		{
+			if (this->mLayout == VertexLayout::Interleaved)
+			{
+				this->mVertices[pIdx] = pVertex;
+				return;
+			}
+
+			this->mPositions[pIdx] = pVertex.GetPosition();
+			this->mNormals[pIdx] = pVertex.GetNormal();
+			this->mTextCoords[pIdx] = pVertex.GetTextCoords();
+			this->mColors[pIdx] = pVertex.GetColor();
+		}
+
+		// the interleaved storage, null in the deinterleaved layout
+		Vertex* GetVertices()
+		{
+			return this->mLayout == VertexLayout::Interleaved ? this->mVertices.data() : nullptr;
+		}
+
+		const Vertex* GetVertices() const
+		{
+			return this->mLayout == VertexLayout::Interleaved ? this->mVertices.data() : nullptr;
+		}
+
+		VertexStream<FVec3> GetPositions() { return this->Stream(this->mPositions, &Vertex::GetPosition); }
+		VertexStream<FVec3> GetNormals() { return this->Stream(this->mNormals, &Vertex::GetNormal); }
+		VertexStream<FVec2> GetTextCoords() { return this->Stream(this->mTextCoords, &Vertex::GetTextCoords); }
+		VertexStream<FVec3> GetColors() { return this->Stream(this->mColors, &Vertex::GetColor); }
+
+		VertexStream<const FVec3> GetPositions() const { return const_cast<VertexBuffer*>(this)->GetPositions(); }
+		VertexStream<const FVec3> GetNormals() const { return const_cast<VertexBuffer*>(this)->GetNormals(); }
+		VertexStream<const FVec2> GetTextCoords() const { return const_cast<VertexBuffer*>(this)->GetTextCoords(); }
+		VertexStream<const FVec3> GetColors() const { return const_cast<VertexBuffer*>(this)->GetColors(); }
+
+		// converts the storage, the views taken before are invalidated
+		void SetLayout(const VertexLayout pLayout)
+		{
+			if (pLayout == this->mLayout)
+				return;
+
+			VertexBuffer converted(pLayout);
+			converted.Resize(this->Size());
+			for (std::size_t i = 0; i < this->Size(); i++)
+				converted.SetVertex(i, this->GetVertex(i));
+
+			*this = std::move(converted);
+		}
+
+		// writes Size() vertices to pOut in the interleaved layout
+		void CopyTo(Vertex* pOut) const
+		{
+			for (std::size_t i = 0; i < this->Size(); i++)
+				pOut[i] = this->GetVertex(i);
+		}
+
+		/* -----
+		Moves the positions by pMatrix (row-vector convention) and the normals by its inverse
+		transpose, renormalized, so they stay perpendicular under non-uniform scales. Interleaved
+		transforms both attributes of a vertex at once with a Float4 per matrix row,
+		Deinterleaved runs the packed Mat4 kernels over each stream. Threaded by vertex ranges
+		as described in Parallel.h.
+		----- */
+		void Transform(const FMat4& pMatrix, const unsigned int pThreadCount = 0)
+		{
+			const FMat4 normalMatrix = pMatrix.Inverse().Transpose();
+
+			if (this->mLayout == VertexLayout::Deinterleaved)
+			{
+				FVec3* positions = this->mPositions.data();
+				FVec3* normals = this->mNormals.data();
+				Parallel::ForRanges(this->Size(), Parallel::mMinElementsPerThread, pThreadCount,
+					[&](const std::size_t pBegin, const std::size_t pEnd)
+					{
+						pMatrix.TransformPoints(positions + pBegin, positions + pBegin, pEnd - pBegin);
+						normalMatrix.TransformDirections(normals + pBegin, normals + pBegin, pEnd - pBegin);
+						for (std::size_t i = pBegin; i < pEnd; i++)
+							normals[i] = Meshes::NormalizeOrZero(normals[i]);
+					});
+				return;
+			}
+
+			Vertex* vertices = this->mVertices.data();
+			Parallel::ForRanges(this->Size(), Parallel::mMinElementsPerThread, pThreadCount,
+				[&](const std::size_t pBegin, const std::size_t pEnd)
+				{
+					using Simd::Float4;
+
+					const Float4 rows[4] = { Float4::Load(pMatrix[0].Data()), Float4::Load(pMatrix[1].Data()),
+						Float4::Load(pMatrix[2].Data()), Float4::Load(pMatrix[3].Data()) };
+					const Float4 normalRows[3] = { Float4::Load(normalMatrix[0].Data()), Float4::Load(normalMatrix[1].Data()),
+						Float4::Load(normalMatrix[2].Data()) };
+
+					alignas(16) float result[4];
+					for (std::size_t i = pBegin; i < pEnd; i++)
+					{
+						FVec3& position = vertices[i].GetPosition();
+						(Float4::Splat(position.X()) * rows[0] + Float4::Splat(position.Y()) * rows[1] +
+							Float4::Splat(position.Z()) * rows[2] + rows[3]).Store(result);
+						position = FVec3(result[0], result[1], result[2]);
+
+						FVec3& normal = vertices[i].GetNormal();
+						(Float4::Splat(normal.X()) * normalRows[0] + Float4::Splat(normal.Y()) * normalRows[1] +
+							Float4::Splat(normal.Z()) * normalRows[2]).Store(result);
+						normal = Meshes::NormalizeOrZero(FVec3(result[0], result[1], result[2]));
+					}
+				});
+		}
+
+		// smooth normals from the positions, see ComputeNormals (MeshNormals.h)
+		void RecomputeNormals(const std::uint32_t* pIndices, const std::size_t pIndexCount,
+			const NormalWeighting pWeighting = NormalWeighting::Area, const unsigned int pThreadCount = 0)
+		{
+			ComputeNormals(this->GetPositions(), pIndices, pIndexCount, this->GetNormals(), pWeighting, pThreadCount);
+		}
+
+		// one tangent frame per vertex into pTangents, see ComputeTangents (MeshNormals.h)
+		void ComputeTangents(const std::uint32_t* pIndices, const std::size_t pIndexCount, FVec4* pTangents,
+			const unsigned int pThreadCount = 0) const
+		{
+			lm::ComputeTangents(this->GetPositions(), this->GetNormals(), this->GetTextCoords(), pIndices, pIndexCount,
+				VertexStream<FVec4>(pTangents, this->Size()), pThreadCount);
+		}
+
+		/* -----
+		Merges the duplicate vertices in place, keeping the first of each group in its original
+		order, and writes to pIndices the new index of every former vertex (see GenerateVertexRemap).
+		The buffer is left untouched and false is returned when the unique vertices do not fit Index.
+		----- */
+		template <typename Index> bool Weld(std::vector<Index>& pIndices, const WeldTolerance& pTolerance = WeldTolerance(),
+			const unsigned int pThreadCount = 0)
+		{
+			static_assert(std::is_same_v<Index, std::uint32_t> || std::is_same_v<Index, std::uint16_t>,
+				"VertexBuffer::Weld writes 16 or 32 bits indices");
+
+			const std::size_t count = this->Size();
+			std::vector<std::uint32_t> remap(count);
+			const std::size_t unique = GenerateVertexRemap(this->GetPositions(), this->GetNormals(), this->GetTextCoords(),
+				this->GetColors(), remap.data(), pTolerance, pThreadCount);
+
+			pIndices.clear();
+			if (unique > std::size_t(std::numeric_limits<Index>::max()) + 1)
+				return false;
+
+			// a representative never moves forward, so the compaction can run in place
+			std::size_t next = 0;
+			for (std::size_t i = 0; i < count; i++)
+				if (remap[i] == next)
+					this->SetVertex(next++, this->GetVertex(i));
+			this->Resize(unique);
+
+			pIndices.assign(remap.begin(), remap.end());
+			return true;
+		}
+
+		// reorders the vertices as pIndices first uses them and rewrites the indices, see GenerateFetchRemap
+		template <typename Index> std::size_t OptimizeVertexFetch(Index* pIndices, const std::size_t pIndexCount)
+		{
+			const std::size_t count = this->Size();
+			std::vector<std::uint32_t> remap(count);
+			const std::size_t used = GenerateFetchRemap(pIndices, pIndexCount, count, remap.data());
+
+			VertexBuffer reordered(this->mLayout);
+			reordered.Resize(count);
+			for (std::size_t vertex = 0; vertex < count; vertex++)
+				reordered.SetVertex(remap[vertex], this->GetVertex(vertex));
+			*this = std::move(reordered);
+
+			for (std::size_t i = 0; i < pIndexCount; i++)
+				pIndices[i] = Index(remap[pIndices[i]]);
+			return used;
+		}
+
+		// bounds of the positions, the packed path of AABB::FromPoints when deinterleaved
+		FAABB GetBounds() const
+		{
+			const VertexStream<const FVec3> positions = this->GetPositions();
+			return FAABB::FromPoints(positions.Data(), positions.Size(), positions.Stride());
+		}
+
+	private:
+		template <typename T> VertexStream<T> Stream(std::vector<T>& pStream, T& (Vertex::*pAttribute)())
+		{
+			if (this->mLayout == VertexLayout::Deinterleaved)
+				return VertexStream<T>(pStream.data(), pStream.size());
+
+			if (this->mVertices.empty())
+				return VertexStream<T>(nullptr, 0, sizeof(Vertex));
+
+			return VertexStream<T>(&(this->mVertices[0].*pAttribute)(), this->mVertices.size(), sizeof(Vertex));
+		}
+
+		VertexLayout mLayout;
+		std::vector<Vertex> mVertices;
+		std::vector<FVec3> mPositions;
+		std::vector<FVec3> mNormals;
+		std::vector<FVec2> mTextCoords;
+		std::vector<FVec3> mColors;
+	};
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Vec3.h"
+
+namespace lm
+{
+	namespace Meshes
+	{
+		// unit normal, or zero for the degenerate ones instead of a NaN
+		inline FVec3 NormalizeOrZero(const FVec3& pNormal)
+		{
+			const float length2 = pNormal.Length2();
+			return length2 > 0.f ? pNormal * (1.f / std::sqrt(length2)) : FVec3(0.f);
+		}
+	}
+
+	/* -----
+	Element pIdx of an attribute whose elements are pStride bytes apart: sizeof(Vertex) from
+	&vertices[0].GetPosition() reads the positions of a vertex buffer in place, sizeof(T) a
+	packed array. The addressing of VertexStream, for the functions taking a pointer and a stride.
+	----- */
+	template <typename T> T& Strided(T* pData, const std::size_t pIdx, const std::size_t pStride)
+	{
+		using Byte = std::conditional_t<std::is_const_v<T>, const std::uint8_t, std::uint8_t>;
+		return *reinterpret_cast<T*>(reinterpret_cast<Byte*>(pData) + pIdx * pStride);
+	}
+
+	/* -----
+	Non-owning view of one attribute, elements pStride bytes apart as in Strided. A const T
+	gives a read-only view.
+	----- */
+
+	template <typename T> class VertexStream
+	{
+	public:
+		constexpr VertexStream() = default;
+
+		VertexStream(T* pData, const std::size_t pCount, const std::size_t pStride = sizeof(T))
+			: mData(pData), mCount(pCount), mStride(pStride)
+		{}
+
+		/* Rule of five */
+		VertexStream(const VertexStream<T>& pOther) = default;
+		VertexStream(VertexStream<T>&& pOther) noexcept = default;
+		VertexStream<T>& operator=(const VertexStream<T>& pOther) = default;
+		VertexStream<T>& operator=(VertexStream<T>&& pOther) noexcept = default;
+
+		/**/
+
+		// a writable view converts to a read-only one
+		operator VertexStream<const T>() const
+		{
+			return VertexStream<const T>(this->mData, this->mCount, this->mStride);
+		}
+
+		T& operator[](const std::size_t pIdx) const
+		{
+			return Strided(this->mData, pIdx, this->mStride);
+		}
+
+		T* Data() const { return mData; }
+		std::size_t Size() const { return mCount; }
+		std::size_t Stride() const { return mStride; }
+
+		// true when the elements are contiguous, the view is then a plain T array
+		bool IsPacked() const
+		{
+			return this->mStride == sizeof(T);
+		}
+
+	private:
+		T* mData = nullptr;
+		std::size_t mCount = 0;
+		std::size_t mStride = sizeof(T);
+	};
+}
@@ -0,0 +1,623 @@
+#pragma once
+
+/*
+* Portable reference implementation of the subset of DirectXMath used by the unit tests.
+* Follows the scalar (_XM_NO_INTRINSICS_) code path of the Microsoft headers so results
+* match what the tests see on Windows.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace DirectX
+{
+	struct XMVECTOR
+	{
+		float v[4];
+	};
+
+	struct XMMATRIX
+	{
+		XMVECTOR r[4];
+	};
+
+	struct XMFLOAT2
+	{
+		float x, y;
+
+		XMFLOAT2() = default;
+		constexpr XMFLOAT2(float pX, float pY) : x(pX), y(pY) {}
+	};
+
+	struct XMFLOAT3
+	{
+		float x, y, z;
+
+		XMFLOAT3() = default;
+		constexpr XMFLOAT3(float pX, float pY, float pZ) : x(pX), y(pY), z(pZ) {}
+	};
+
+	struct XMFLOAT4
+	{
+		float x, y, z, w;
+
+		XMFLOAT4() = default;
+		constexpr XMFLOAT4(float pX, float pY, float pZ, float pW) : x(pX), y(pY), z(pZ), w(pW) {}
+	};
+
+	struct XMFLOAT3X3
+	{
+		float m[3][3];
+
+		XMFLOAT3X3() = default;
+		constexpr XMFLOAT3X3(float p00, float p01, float p02,
+			float p10, float p11, float p12,
+			float p20, float p21, float p22)
+			: m{ { p00, p01, p02 }, { p10, p11, p12 }, { p20, p21, p22 } }
+		{}
+
+		float operator()(size_t pRow, size_t pColumn) const { return m[pRow][pColumn]; }
+		float& operator()(size_t pRow, size_t pColumn) { return m[pRow][pColumn]; }
+	};
+
+	struct XMFLOAT4X4
+	{
+		union
+		{
+			struct
+			{
+				float _11, _12, _13, _14;
+				float _21, _22, _23, _24;
+				float _31, _32, _33, _34;
+				float _41, _42, _43, _44;
+			};
+			float m[4][4];
+		};
+
+		XMFLOAT4X4() = default;
+		constexpr XMFLOAT4X4(float p00, float p01, float p02, float p03,
+			float p10, float p11, float p12, float p13,
+			float p20, float p21, float p22, float p23,
+			float p30, float p31, float p32, float p33)
+			: m{ { p00, p01, p02, p03 }, { p10, p11, p12, p13 },
+				{ p20, p21, p22, p23 }, { p30, p31, p32, p33 } }
+		{}
+
+		float operator()(size_t pRow, size_t pColumn) const { return m[pRow][pColumn]; }
+		float& operator()(size_t pRow, size_t pColumn) { return m[pRow][pColumn]; }
+	};
+
+	/* ----- Load / Store ----- */
+
+	inline XMVECTOR XMLoadFloat2(const XMFLOAT2* pSource)
+	{
+		return XMVECTOR{ pSource->x, pSource->y, 0.f, 0.f };
+	}
+
+	inline XMVECTOR XMLoadFloat3(const XMFLOAT3* pSource)
+	{
+		return XMVECTOR{ pSource->x, pSource->y, pSource->z, 0.f };
+	}
+
+	inline XMVECTOR XMLoadFloat4(const XMFLOAT4* pSource)
+	{
+		return XMVECTOR{ pSource->x, pSource->y, pSource->z, pSource->w };
+	}
+
+	inline XMMATRIX XMLoadFloat3x3(const XMFLOAT3X3* pSource)
+	{
+		XMMATRIX m{};
+		for (int i = 0; i < 3; i++)
+			m.r[i] = XMVECTOR{ pSource->m[i][0], pSource->m[i][1], pSource->m[i][2], 0.f };
+		m.r[3] = XMVECTOR{ 0.f, 0.f, 0.f, 1.f };
+		return m;
+	}
+
+	inline XMMATRIX XMLoadFloat4x4(const XMFLOAT4X4* pSource)
+	{
+		XMMATRIX m{};
+		for (int i = 0; i < 4; i++)
+			m.r[i] = XMVECTOR{ pSource->m[i][0], pSource->m[i][1], pSource->m[i][2], pSource->m[i][3] };
+		return m;
+	}
+
+	inline void XMStoreFloat2(XMFLOAT2* pDestination, const XMVECTOR& pV)
+	{
+		pDestination->x = pV.v[0];
+		pDestination->y = pV.v[1];
+	}
+
+	inline void XMStoreFloat3(XMFLOAT3* pDestination, const XMVECTOR& pV)
+	{
+		pDestination->x = pV.v[0];
+		pDestination->y = pV.v[1];
+		pDestination->z = pV.v[2];
+	}
+
+	inline void XMStoreFloat4(XMFLOAT4* pDestination, const XMVECTOR& pV)
+	{
+		pDestination->x = pV.v[0];
+		pDestination->y = pV.v[1];
+		pDestination->z = pV.v[2];
+		pDestination->w = pV.v[3];
+	}
+
+	inline void XMStoreFloat3x3(XMFLOAT3X3* pDestination, const XMMATRIX& pM)
+	{
+		for (int i = 0; i < 3; i++)
+			for (int j = 0; j < 3; j++)
+				pDestination->m[i][j] = pM.r[i].v[j];
+	}
+
+	inline void XMStoreFloat4x4(XMFLOAT4X4* pDestination, const XMMATRIX& pM)
+	{
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				pDestination->m[i][j] = pM.r[i].v[j];
+	}
+
+	/* ----- Vector ----- */
+
+	inline XMVECTOR XMVectorReplicate(float pValue)
+	{
+		return XMVECTOR{ pValue, pValue, pValue, pValue };
+	}
+
+	inline XMVECTOR XMVectorAdd(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVECTOR{ pV1.v[0] + pV2.v[0], pV1.v[1] + pV2.v[1], pV1.v[2] + pV2.v[2], pV1.v[3] + pV2.v[3] };
+	}
+
+	inline XMVECTOR XMVectorSubtract(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVECTOR{ pV1.v[0] - pV2.v[0], pV1.v[1] - pV2.v[1], pV1.v[2] - pV2.v[2], pV1.v[3] - pV2.v[3] };
+	}
+
+	inline XMVECTOR XMVectorMultiply(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVECTOR{ pV1.v[0] * pV2.v[0], pV1.v[1] * pV2.v[1], pV1.v[2] * pV2.v[2], pV1.v[3] * pV2.v[3] };
+	}
+
+	inline XMVECTOR XMVectorDivide(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVECTOR{ pV1.v[0] / pV2.v[0], pV1.v[1] / pV2.v[1], pV1.v[2] / pV2.v[2], pV1.v[3] / pV2.v[3] };
+	}
+
+	inline XMVECTOR XMVectorScale(const XMVECTOR& pV, float pScale)
+	{
+		return XMVECTOR{ pV.v[0] * pScale, pV.v[1] * pScale, pV.v[2] * pScale, pV.v[3] * pScale };
+	}
+
+	inline XMVECTOR XMVectorSwizzle(const XMVECTOR& pV, uint32_t pE0, uint32_t pE1, uint32_t pE2, uint32_t pE3)
+	{
+		return XMVECTOR{ pV.v[pE0], pV.v[pE1], pV.v[pE2], pV.v[pE3] };
+	}
+
+	inline XMVECTOR XMVector2Dot(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVectorReplicate(pV1.v[0] * pV2.v[0] + pV1.v[1] * pV2.v[1]);
+	}
+
+	inline XMVECTOR XMVector3Dot(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVectorReplicate(pV1.v[0] * pV2.v[0] + pV1.v[1] * pV2.v[1] + pV1.v[2] * pV2.v[2]);
+	}
+
+	inline XMVECTOR XMVector4Dot(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVectorReplicate(pV1.v[0] * pV2.v[0] + pV1.v[1] * pV2.v[1] +
+			pV1.v[2] * pV2.v[2] + pV1.v[3] * pV2.v[3]);
+	}
+
+	inline XMVECTOR XMVector2Cross(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVectorReplicate(pV1.v[0] * pV2.v[1] - pV1.v[1] * pV2.v[0]);
+	}
+
+	inline XMVECTOR XMVector3Cross(const XMVECTOR& pV1, const XMVECTOR& pV2)
+	{
+		return XMVECTOR{ pV1.v[1] * pV2.v[2] - pV1.v[2] * pV2.v[1],
+			pV1.v[2] * pV2.v[0] - pV1.v[0] * pV2.v[2],
+			pV1.v[0] * pV2.v[1] - pV1.v[1] * pV2.v[0], 0.f };
+	}
+
+	inline XMVECTOR XMVector2Length(const XMVECTOR& pV)
+	{
+		return XMVectorReplicate(std::sqrt(XMVector2Dot(pV, pV).v[0]));
+	}
+
+	inline XMVECTOR XMVector3Length(const XMVECTOR& pV)
+	{
+		return XMVectorReplicate(std::sqrt(XMVector3Dot(pV, pV).v[0]));
+	}
+
+	inline XMVECTOR XMVector4Length(const XMVECTOR& pV)
+	{
+		return XMVectorReplicate(std::sqrt(XMVector4Dot(pV, pV).v[0]));
+	}
+
+	inline XMVECTOR XMVectorNormalizeByLength(const XMVECTOR& pV, float pLength)
+	{
+		if (pLength > 0.f)
+			return XMVectorScale(pV, 1.f / pLength);
+
+		return XMVECTOR{ 0.f, 0.f, 0.f, 0.f };
+	}
+
+	inline XMVECTOR XMVector2Normalize(const XMVECTOR& pV)
+	{
+		return XMVectorNormalizeByLength(pV, XMVector2Length(pV).v[0]);
+	}
+
+	inline XMVECTOR XMVector3Normalize(const XMVECTOR& pV)
+	{
+		return XMVectorNormalizeByLength(pV, XMVector3Length(pV).v[0]);
+	}
+
+	inline XMVECTOR XMVector4Normalize(const XMVECTOR& pV)
+	{
+		return XMVectorNormalizeByLength(pV, XMVector4Length(pV).v[0]);
+	}
+
+	inline XMVECTOR XMVector2Reflect(const XMVECTOR& pIncident, const XMVECTOR& pNormal)
+	{
+		const float dot = XMVector2Dot(pIncident, pNormal).v[0];
+		return XMVectorSubtract(pIncident, XMVectorScale(pNormal, 2.f * dot));
+	}
+
+	inline XMVECTOR XMVector3Reflect(const XMVECTOR& pIncident, const XMVECTOR& pNormal)
+	{
+		const float dot = XMVector3Dot(pIncident, pNormal).v[0];
+		return XMVectorSubtract(pIncident, XMVectorScale(pNormal, 2.f * dot));
+	}
+
+	inline XMVECTOR XMVector4Reflect(const XMVECTOR& pIncident, const XMVECTOR& pNormal)
+	{
+		const float dot = XMVector4Dot(pIncident, pNormal).v[0];
+		return XMVectorSubtract(pIncident, XMVectorScale(pNormal, 2.f * dot));
+	}
+
+	inline XMVECTOR XMVector4Orthogonal(const XMVECTOR& pV)
+	{
+		return XMVECTOR{ pV.v[2], pV.v[3], -pV.v[0], -pV.v[1] };
+	}
+
+	/* ----- Matrix ----- */
+
+	inline XMMATRIX XMMatrixMultiply(const XMMATRIX& pM1, const XMMATRIX& pM2)
+	{
+		XMMATRIX result{};
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				result.r[i].v[j] = pM1.r[i].v[0] * pM2.r[0].v[j] + pM1.r[i].v[1] * pM2.r[1].v[j] +
+					pM1.r[i].v[2] * pM2.r[2].v[j] + pM1.r[i].v[3] * pM2.r[3].v[j];
+		return result;
+	}
+
+	inline XMMATRIX operator*(const XMMATRIX& pM1, const XMMATRIX& pM2)
+	{
+		return XMMatrixMultiply(pM1, pM2);
+	}
+
+	inline XMMATRIX& operator*=(XMMATRIX& pM1, const XMMATRIX& pM2)
+	{
+		pM1 = XMMatrixMultiply(pM1, pM2);
+		return pM1;
+	}
+
+	inline XMMATRIX XMMatrixTranspose(const XMMATRIX& pM)
+	{
+		XMMATRIX result{};
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				result.r[i].v[j] = pM.r[j].v[i];
+		return result;
+	}
+
+	inline XMMATRIX XMMatrixIdentity()
+	{
+		return XMMATRIX{ { { 1.f, 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f, 0.f },
+			{ 0.f, 0.f, 1.f, 0.f }, { 0.f, 0.f, 0.f, 1.f } } };
+	}
+
+	inline bool XMMatrixIsIdentity(const XMMATRIX& pM)
+	{
+		const XMMATRIX identity = XMMatrixIdentity();
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				if (pM.r[i].v[j] != identity.r[i].v[j])
+					return false;
+		return true;
+	}
+
+	inline float XMMatrixDeterminantScalar(const XMMATRIX& pM)
+	{
+		const float (&m)[4] = pM.r[0].v;
+		const float s0 = pM.r[2].v[2] * pM.r[3].v[3] - pM.r[2].v[3] * pM.r[3].v[2];
+		const float s1 = pM.r[2].v[1] * pM.r[3].v[3] - pM.r[2].v[3] * pM.r[3].v[1];
+		const float s2 = pM.r[2].v[1] * pM.r[3].v[2] - pM.r[2].v[2] * pM.r[3].v[1];
+		const float s3 = pM.r[2].v[0] * pM.r[3].v[3] - pM.r[2].v[3] * pM.r[3].v[0];
+		const float s4 = pM.r[2].v[0] * pM.r[3].v[2] - pM.r[2].v[2] * pM.r[3].v[0];
+		const float s5 = pM.r[2].v[0] * pM.r[3].v[1] - pM.r[2].v[1] * pM.r[3].v[0];
+
+		const float c0 = pM.r[1].v[1] * s0 - pM.r[1].v[2] * s1 + pM.r[1].v[3] * s2;
+		const float c1 = pM.r[1].v[0] * s0 - pM.r[1].v[2] * s3 + pM.r[1].v[3] * s4;
+		const float c2 = pM.r[1].v[0] * s1 - pM.r[1].v[1] * s3 + pM.r[1].v[3] * s5;
+		const float c3 = pM.r[1].v[0] * s2 - pM.r[1].v[1] * s4 + pM.r[1].v[2] * s5;
+
+		return m[0] * c0 - m[1] * c1 + m[2] * c2 - m[3] * c3;
+	}
+
+	inline XMVECTOR XMMatrixDeterminant(const XMMATRIX& pM)
+	{
+		return XMVectorReplicate(XMMatrixDeterminantScalar(pM));
+	}
+
+	inline XMMATRIX XMMatrixInverse(XMVECTOR* pDeterminant, const XMMATRIX& pM)
+	{
+		float a[16];
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				a[i * 4 + j] = pM.r[i].v[j];
+
+		float inv[16];
+		inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] +
+			a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+		inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] -
+			a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+		inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] +
+			a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+		inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] -
+			a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+		inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] -
+			a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+		inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] +
+			a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+		inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] -
+			a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+		inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] +
+			a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+		inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] +
+			a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+		inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] -
+			a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+		inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] +
+			a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+		inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] -
+			a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+		inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] -
+			a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+		inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] +
+			a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+		inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] -
+			a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+		inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] +
+			a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+		const float det = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+		if (pDeterminant)
+			*pDeterminant = XMVectorReplicate(det);
+
+		const float invDet = 1.f / det;
+		XMMATRIX result{};
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 4; j++)
+				result.r[i].v[j] = inv[i * 4 + j] * invDet;
+		return result;
+	}
+
+	inline XMMATRIX XMMatrixRotationX(float pAngle)
+	{
+		const float s = std::sin(pAngle);
+		const float c = std::cos(pAngle);
+		return XMMATRIX{ { { 1.f, 0.f, 0.f, 0.f }, { 0.f, c, s, 0.f },
+			{ 0.f, -s, c, 0.f }, { 0.f, 0.f, 0.f, 1.f } } };
+	}
+
+	inline XMMATRIX XMMatrixRotationY(float pAngle)
+	{
+		const float s = std::sin(pAngle);
+		const float c = std::cos(pAngle);
+		return XMMATRIX{ { { c, 0.f, -s, 0.f }, { 0.f, 1.f, 0.f, 0.f },
+			{ s, 0.f, c, 0.f }, { 0.f, 0.f, 0.f, 1.f } } };
+	}
+
+	inline XMMATRIX XMMatrixRotationZ(float pAngle)
+	{
+		const float s = std::sin(pAngle);
+		const float c = std::cos(pAngle);
+		return XMMATRIX{ { { c, s, 0.f, 0.f }, { -s, c, 0.f, 0.f },
+			{ 0.f, 0.f, 1.f, 0.f }, { 0.f, 0.f, 0.f, 1.f } } };
+	}
+
+	inline XMMATRIX XMMatrixRotationQuaternion(const XMVECTOR& pQuaternion)
+	{
+		const float x = pQuaternion.v[0];
+		const float y = pQuaternion.v[1];
+		const float z = pQuaternion.v[2];
+		const float w = pQuaternion.v[3];
+
+		return XMMATRIX{ {
+			{ 1.f - 2.f * (y * y + z * z), 2.f * (x * y + z * w), 2.f * (x * z - y * w), 0.f },
+			{ 2.f * (x * y - z * w), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + x * w), 0.f },
+			{ 2.f * (x * z + y * w), 2.f * (y * z - x * w), 1.f - 2.f * (x * x + y * y), 0.f },
+			{ 0.f, 0.f, 0.f, 1.f } } };
+	}
+
+	inline XMMATRIX XMMatrixLookToLH(const XMVECTOR& pEye, const XMVECTOR& pDirection, const XMVECTOR& pUp)
+	{
+		const XMVECTOR r2 = XMVector3Normalize(pDirection);
+		const XMVECTOR r0 = XMVector3Normalize(XMVector3Cross(pUp, r2));
+		const XMVECTOR r1 = XMVector3Cross(r2, r0);
+		const XMVECTOR negEye = XMVECTOR{ -pEye.v[0], -pEye.v[1], -pEye.v[2], -pEye.v[3] };
+
+		const float d0 = XMVector3Dot(r0, negEye).v[0];
+		const float d1 = XMVector3Dot(r1, negEye).v[0];
+		const float d2 = XMVector3Dot(r2, negEye).v[0];
+
+		const XMMATRIX m{ { { r0.v[0], r0.v[1], r0.v[2], d0 }, { r1.v[0], r1.v[1], r1.v[2], d1 },
+			{ r2.v[0], r2.v[1], r2.v[2], d2 }, { 0.f, 0.f, 0.f, 1.f } } };
+		return XMMatrixTranspose(m);
+	}
+
+	inline XMMATRIX XMMatrixLookAtLH(const XMVECTOR& pEye, const XMVECTOR& pFocus, const XMVECTOR& pUp)
+	{
+		return XMMatrixLookToLH(pEye, XMVectorSubtract(pFocus, pEye), pUp);
+	}
+
+	inline XMMATRIX XMMatrixLookAtRH(const XMVECTOR& pEye, const XMVECTOR& pFocus, const XMVECTOR& pUp)
+	{
+		return XMMatrixLookToLH(pEye, XMVectorSubtract(pEye, pFocus), pUp);
+	}
+
+	inline XMMATRIX XMMatrixPerspectiveFovRH(float pFovAngleY, float pAspectRatio, float pNearZ, float pFarZ)
+	{
+		const float sinFov = std::sin(0.5f * pFovAngleY);
+		const float cosFov = std::cos(0.5f * pFovAngleY);
+
+		const float height = cosFov / sinFov;
+		const float width = height / pAspectRatio;
+		const float range = pFarZ / (pNearZ - pFarZ);
+
+		return XMMATRIX{ { { width, 0.f, 0.f, 0.f }, { 0.f, height, 0.f, 0.f },
+			{ 0.f, 0.f, range, -1.f }, { 0.f, 0.f, range * pNearZ, 0.f } } };
+	}
+
+	/* ----- Quaternion ----- */
+
+	inline XMVECTOR XMQuaternionDot(const XMVECTOR& pQ1, const XMVECTOR& pQ2)
+	{
+		return XMVector4Dot(pQ1, pQ2);
+	}
+
+	inline XMVECTOR XMQuaternionLength(const XMVECTOR& pQ)
+	{
+		return XMVector4Length(pQ);
+	}
+
+	inline XMVECTOR XMQuaternionNormalize(const XMVECTOR& pQ)
+	{
+		return XMVector4Normalize(pQ);
+	}
+
+	inline XMVECTOR XMQuaternionConjugate(const XMVECTOR& pQ)
+	{
+		return XMVECTOR{ -pQ.v[0], -pQ.v[1], -pQ.v[2], pQ.v[3] };
+	}
+
+	// Returns pQ2 * pQ1 (rotation by pQ1 followed by pQ2), as DirectXMath does
+	inline XMVECTOR XMQuaternionMultiply(const XMVECTOR& pQ1, const XMVECTOR& pQ2)
+	{
+		const float* a = pQ1.v;
+		const float* b = pQ2.v;
+		return XMVECTOR{ b[3] * a[0] + b[0] * a[3] + b[1] * a[2] - b[2] * a[1],
+			b[3] * a[1] - b[0] * a[2] + b[1] * a[3] + b[2] * a[0],
+			b[3] * a[2] + b[0] * a[1] - b[1] * a[0] + b[2] * a[3],
+			b[3] * a[3] - b[0] * a[0] - b[1] * a[1] - b[2] * a[2] };
+	}
+
+	inline XMVECTOR XMQuaternionRotationNormal(const XMVECTOR& pNormalAxis, float pAngle)
+	{
+		const float s = std::sin(0.5f * pAngle);
+		const float c = std::cos(0.5f * pAngle);
+		return XMVECTOR{ pNormalAxis.v[0] * s, pNormalAxis.v[1] * s, pNormalAxis.v[2] * s, c };
+	}
+
+	inline XMVECTOR XMQuaternionRotationAxis(const XMVECTOR& pAxis, float pAngle)
+	{
+		return XMQuaternionRotationNormal(XMVector3Normalize(pAxis), pAngle);
+	}
+
+	inline XMVECTOR XMQuaternionRotationRollPitchYaw(float pPitch, float pYaw, float pRoll)
+	{
+		const float sp = std::sin(0.5f * pPitch);
+		const float cp = std::cos(0.5f * pPitch);
+		const float sy = std::sin(0.5f * pYaw);
+		const float cy = std::cos(0.5f * pYaw);
+		const float sr = std::sin(0.5f * pRoll);
+		const float cr = std::cos(0.5f * pRoll);
+
+		return XMVECTOR{ cr * sp * cy + sr * cp * sy,
+			cr * cp * sy - sr * sp * cy,
+			sr * cp * cy - cr * sp * sy,
+			cr * cp * cy + sr * sp * sy };
+	}
+
+	inline XMVECTOR XMQuaternionRotationMatrix(const XMMATRIX& pM)
+	{
+		const float r00 = pM.r[0].v[0], r01 = pM.r[0].v[1], r02 = pM.r[0].v[2];
+		const float r10 = pM.r[1].v[0], r11 = pM.r[1].v[1], r12 = pM.r[1].v[2];
+		const float r20 = pM.r[2].v[0], r21 = pM.r[2].v[1], r22 = pM.r[2].v[2];
+
+		if (r22 <= 0.f)
+		{
+			const float dif10 = r11 - r00;
+			const float omr22 = 1.f - r22;
+			if (dif10 <= 0.f)
+			{
+				const float fourXSqr = omr22 - dif10;
+				const float inv4x = 0.5f / std::sqrt(fourXSqr);
+				return XMVECTOR{ fourXSqr * inv4x, (r01 + r10) * inv4x, (r02 + r20) * inv4x, (r12 - r21) * inv4x };
+			}
+
+			const float fourYSqr = omr22 + dif10;
+			const float inv4y = 0.5f / std::sqrt(fourYSqr);
+			return XMVECTOR{ (r01 + r10) * inv4y, fourYSqr * inv4y, (r12 + r21) * inv4y, (r20 - r02) * inv4y };
+		}
+
+		const float sum10 = r11 + r00;
+		const float opr22 = 1.f + r22;
+		if (sum10 <= 0.f)
+		{
+			const float fourZSqr = opr22 - sum10;
+			const float inv4z = 0.5f / std::sqrt(fourZSqr);
+			return XMVECTOR{ (r02 + r20) * inv4z, (r12 + r21) * inv4z, fourZSqr * inv4z, (r01 - r10) * inv4z };
+		}
+
+		const float fourWSqr = opr22 + sum10;
+		const float inv4w = 0.5f / std::sqrt(fourWSqr);
+		return XMVECTOR{ (r12 - r21) * inv4w, (r20 - r02) * inv4w, (r01 - r10) * inv4w, fourWSqr * inv4w };
+	}
+
+	inline XMVECTOR XMQuaternionSlerp(const XMVECTOR& pQ0, const XMVECTOR& pQ1, float pT)
+	{
+		float cosOmega = XMQuaternionDot(pQ0, pQ1).v[0];
+		float sign = 1.f;
+		if (cosOmega < 0.f)
+		{
+			cosOmega = -cosOmega;
+			sign = -1.f;
+		}
+
+		float scale0 = 1.f - pT;
+		float scale1 = pT;
+		if (cosOmega < 1.f - 0.00001f)
+		{
+			const float sinOmega = std::sqrt(1.f - cosOmega * cosOmega);
+			const float omega = std::atan2(sinOmega, cosOmega);
+			scale0 = std::sin((1.f - pT) * omega) / sinOmega;
+			scale1 = std::sin(pT * omega) / sinOmega;
+		}
+
+		scale1 *= sign;
+		return XMVectorAdd(XMVectorScale(pQ0, scale0), XMVectorScale(pQ1, scale1));
+	}
+
+	inline XMMATRIX XMMatrixScaling(float pScaleX, float pScaleY, float pScaleZ)
+	{
+		return XMMATRIX{ { { pScaleX, 0.f, 0.f, 0.f }, { 0.f, pScaleY, 0.f, 0.f },
+			{ 0.f, 0.f, pScaleZ, 0.f }, { 0.f, 0.f, 0.f, 1.f } } };
+	}
+
+	inline XMMATRIX XMMatrixTranslation(float pOffsetX, float pOffsetY, float pOffsetZ)
+	{
+		return XMMATRIX{ { { 1.f, 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f, 0.f },
+			{ 0.f, 0.f, 1.f, 0.f }, { pOffsetX, pOffsetY, pOffsetZ, 1.f } } };
+	}
+
+	inline XMMATRIX XMMatrixRotationRollPitchYaw(float pPitch, float pYaw, float pRoll)
+	{
+		return XMMatrixRotationQuaternion(XMQuaternionRotationRollPitchYaw(pPitch, pYaw, pRoll));
+	}
+}
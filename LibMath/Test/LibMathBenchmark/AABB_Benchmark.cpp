@@ -0,0 +1,82 @@
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "../../LibMath/AABB.h"
+#include "../../LibMath/Transform.h"
+#include "../../LibMath/Vertex.h"
+
+using namespace lm;
+
+/* -----
+Bounds of a point cloud and of a vertex buffer against the hand-written loop, then Arvo's
+transform against the eight transformed corners and the batched TransformBoxes.
+----- */
+
+TEST_CASE("AABB", "[benchmark][bounds][aabb]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	std::vector<FVec3> points;
+	std::vector<Vertex> vertices;
+	std::vector<FAABB> boxes, result(count);
+	std::vector<FMat4> matrices;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const FVec3 point(BenchmarkValue(i, -10.f, 10.f), BenchmarkValue(i + 1, -10.f, 10.f), BenchmarkValue(i + 2, -10.f, 10.f));
+		points.push_back(point);
+		vertices.emplace_back(point);
+		boxes.push_back(FAABB::FromCenterExtents(point, FVec3(BenchmarkValue(i, .1f, 2.f))));
+		matrices.push_back(FTransform(point, FQuat::RotationAxis(BenchmarkValue(i, 0.f, 6.f), FVec3(0.f, 1.f, 1.f))).ToMat4());
+	}
+
+	BENCHMARK(BenchmarkName("Vertex positions loop", count))
+	{
+		FVec3 min = vertices[0].GetPosition(), max = min;
+		for (const Vertex& vertex : vertices)
+			for (int axis = 0; axis < 3; axis++)
+			{
+				min[axis] = std::min(min[axis], vertex.GetPosition()[axis]);
+				max[axis] = std::max(max[axis], vertex.GetPosition()[axis]);
+			}
+		return FAABB(min, max);
+	};
+
+	BENCHMARK(BenchmarkName("FromPoints vertices", count))
+	{
+		return FAABB::FromPoints(&vertices[0].GetPosition(), count, sizeof(Vertex));
+	};
+
+	BENCHMARK(BenchmarkName("FromPoints FVec3", count))
+	{
+		return FAABB::FromPoints(points.data(), count);
+	};
+
+	BENCHMARK(BenchmarkName("Transform 8 corners", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			FAABB box;
+			for (int corner = 0; corner < 8; corner++)
+			{
+				const FVec4 point = matrices[i] * FVec4(corner & 1 ? boxes[i].mMax.X() : boxes[i].mMin.X(),
+					corner & 2 ? boxes[i].mMax.Y() : boxes[i].mMin.Y(), corner & 4 ? boxes[i].mMax.Z() : boxes[i].mMin.Z(), 1.f);
+				box.MergeSelf(FVec3(point.X(), point.Y(), point.Z()));
+			}
+			result[i] = box;
+		}
+		return result[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("TransformBoxes 1 thread", count))
+	{
+		TransformBoxes(boxes.data(), matrices.data(), count, result.data(), 1);
+		return result[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("TransformBoxes", count))
+	{
+		TransformBoxes(boxes.data(), matrices.data(), count, result.data());
+		return result[count - 1];
+	};
+}
@@ -0,0 +1,136 @@
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "../../LibMath/Mat4.h"
+
+using namespace lm;
+
+/* -----
+Element access measured against the accessors it replaced: a switch that also
+accepted 'x'/'y'/'z'/'w' and a row lookup that bounds-checked and fell back to row 0.
+The matrix product is written with indices on purpose, it is the loop shape those
+accessors were slowing down.
+----- */
+
+static float LegacyElement(const FVec4& pVec, const int pIdx)
+{
+	switch (pIdx)
+	{
+	case 0:		return pVec.X();
+	case 1:		return pVec.Y();
+	case 2:		return pVec.Z();
+	case 3:		return pVec.W();
+
+	case 'x':	return pVec.X();
+	case 'y':	return pVec.Y();
+	case 'z':	return pVec.Z();
+	case 'w':	return pVec.W();
+
+	default:	return pVec.X();
+	}
+}
+
+static const FVec4 LegacyRow(const FMat4& pMat, const int pIdx)
+{
+	if (pIdx >= 0 && pIdx < 4)
+		return pMat[pIdx];
+
+	return pMat[0];
+}
+
+static FMat4 LegacyProduct(const FMat4& pLeft, const FMat4& pRight)
+{
+	FMat4 result;
+	for (int i = 0; i < 4; i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			float sum = 0.f;
+			for (int k = 0; k < 4; k++)
+				sum += LegacyElement(LegacyRow(pLeft, i), k) * LegacyElement(LegacyRow(pRight, k), j);
+			result[i][j] = sum;
+		}
+	}
+	return result;
+}
+
+static FMat4 IndexedProduct(const FMat4& pLeft, const FMat4& pRight)
+{
+	FMat4 result;
+	for (int i = 0; i < 4; i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			float sum = 0.f;
+			for (int k = 0; k < 4; k++)
+				sum += pLeft[i][k] * pRight[k][j];
+			result[i][j] = sum;
+		}
+	}
+	return result;
+}
+
+TEST_CASE("Element access", "[benchmark][access]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	std::vector<FVec4> vectors;
+	std::vector<FMat4> matrices;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		vectors.push_back(FVec4(BenchmarkValue(i, -1.f, 1.f), BenchmarkValue(i + 1, -1.f, 1.f),
+			BenchmarkValue(i + 2, -1.f, 1.f), 1.f));
+		matrices.push_back(FMat4::Translation(FVec3(vectors.back().X(), vectors.back().Y(), vectors.back().Z())));
+	}
+
+	std::vector<FMat4> result(count);
+
+	BENCHMARK(BenchmarkName("Legacy switch operator[]", count))
+	{
+		float sum = 0.f;
+		for (std::size_t i = 0; i < count; i++)
+			for (int j = 0; j < 4; j++)
+				sum += LegacyElement(vectors[i], j);
+		return sum;
+	};
+
+	BENCHMARK(BenchmarkName("operator[]", count))
+	{
+		float sum = 0.f;
+		for (std::size_t i = 0; i < count; i++)
+			for (int j = 0; j < 4; j++)
+				sum += vectors[i][j];
+		return sum;
+	};
+
+	BENCHMARK(BenchmarkName("get<I>", count))
+	{
+		float sum = 0.f;
+		for (std::size_t i = 0; i < count; i++)
+			sum += vectors[i].get<0>() + vectors[i].get<1>() + vectors[i].get<2>() + vectors[i].get<3>();
+		return sum;
+	};
+
+	BENCHMARK(BenchmarkName("Swizzle<3, 2, 1, 0>", count))
+	{
+		FVec4 sum;
+		for (std::size_t i = 0; i < count; i++)
+			sum += vectors[i].Swizzle<3, 2, 1, 0>();
+		return sum.X();
+	};
+
+	BENCHMARK(BenchmarkName("Legacy indexed Mat4 product", count))
+	{
+		for (std::size_t i = 0; i + 1 < count; i++)
+			result[i] = LegacyProduct(matrices[i], matrices[i + 1]);
+		return result[0][3][0];
+	};
+
+	BENCHMARK(BenchmarkName("Indexed Mat4 product", count))
+	{
+		for (std::size_t i = 0; i + 1 < count; i++)
+			result[i] = IndexedProduct(matrices[i], matrices[i + 1]);
+		return result[0][3][0];
+	};
+}
@@ -0,0 +1,159 @@
+#include "Benchmark.h"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../LibMath/BVH.h"
+
+using namespace lm;
+
+namespace
+{
+	struct Terrain
+	{
+		std::vector<FVec3> mPositions;
+		std::vector<std::uint32_t> mIndices;
+		std::vector<FAABB> mBounds;
+	};
+}
+
+// about pTriangleCount triangles of a bumpy height field
+static Terrain MakeTerrain(const std::size_t pTriangleCount)
+{
+	const std::uint32_t size = std::uint32_t(std::sqrt(double(pTriangleCount) / 2.0));
+
+	Terrain terrain;
+	for (std::uint32_t z = 0; z <= size; z++)
+		for (std::uint32_t x = 0; x <= size; x++)
+			terrain.mPositions.emplace_back(float(x), 8.f * std::sin(.05f * float(x)) * std::cos(.03f * float(z)) +
+				BenchmarkValue(z * (size + 1) + x, 0.f, .5f), float(z));
+
+	for (std::uint32_t z = 0; z < size; z++)
+		for (std::uint32_t x = 0; x < size; x++)
+		{
+			const std::uint32_t corner = z * (size + 1) + x;
+			for (const std::uint32_t index : { corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2 })
+				terrain.mIndices.push_back(index);
+		}
+
+	terrain.mBounds.resize(terrain.mIndices.size() / 3);
+	TriangleBounds(terrain.mPositions.data(), terrain.mIndices.data(), terrain.mBounds.size(), terrain.mBounds.data());
+	return terrain;
+}
+
+static bool HitTriangle(const Terrain& pTerrain, const FRay& pRay, const std::uint32_t pTriangle, float& pDistance)
+{
+	const FVec3& a = pTerrain.mPositions[pTerrain.mIndices[3 * pTriangle]];
+	const FVec3 edge1 = pTerrain.mPositions[pTerrain.mIndices[3 * pTriangle + 1]] - a;
+	const FVec3 edge2 = pTerrain.mPositions[pTerrain.mIndices[3 * pTriangle + 2]] - a;
+
+	const FVec3 p = pRay.GetDirection().CrossProduct(edge2);
+	const float inverse = 1.f / edge1.DotProduct(p);
+	const FVec3 s = pRay.GetOrigin() - a;
+	const float u = s.DotProduct(p) * inverse;
+	const FVec3 q = s.CrossProduct(edge1);
+	const float v = pRay.GetDirection().DotProduct(q) * inverse;
+	const float t = edge2.DotProduct(q) * inverse;
+	if (!(u >= 0.f && v >= 0.f && u + v <= 1.f && t >= 0.f && t < pDistance))
+		return false;
+
+	pDistance = t;
+	return true;
+}
+
+/* -----
+Build time of the binned SAH builder on 16 triangles per batch element (1M triangles for
+the large batch) and the collapse to 4 and 8 children, then closest hit raycasts and
+sphere queries of one batch of rays against that mesh.
+----- */
+
+TEST_CASE("BVH", "[benchmark][bounds][bvh]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+	const Terrain terrain = MakeTerrain(16 * count);
+	const std::size_t triangleCount = terrain.mBounds.size();
+	const float size = terrain.mPositions.back().X();
+
+	FBVH bvh;
+	bvh.Build(terrain.mBounds.data(), triangleCount);
+	const FBVH4 bvh4(bvh);
+	const FBVH8 bvh8(bvh);
+
+	std::vector<FRay> rays;
+	std::vector<FVec3> centers;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const FVec3 origin(BenchmarkValue(i, 0.f, size), 20.f, BenchmarkValue(i + 1, 0.f, size));
+		rays.emplace_back(origin, FVec3(BenchmarkValue(i + 2, -1.f, 1.f), -1.f, BenchmarkValue(i + 3, -1.f, 1.f)));
+		centers.emplace_back(origin.X(), 0.f, origin.Z());
+	}
+
+	BENCHMARK(BenchmarkName("Build 1 thread triangles", triangleCount))
+	{
+		FBVH result;
+		result.Build(terrain.mBounds.data(), triangleCount, 4, 1);
+		return result.GetNodeCount();
+	};
+
+	BENCHMARK(BenchmarkName("Build triangles", triangleCount))
+	{
+		FBVH result;
+		result.Build(terrain.mBounds.data(), triangleCount);
+		return result.GetNodeCount();
+	};
+
+	BENCHMARK(BenchmarkName("Collapse to BVH8 triangles", triangleCount))
+	{
+		return FBVH8(bvh).GetNodeCount();
+	};
+
+	const auto raycasts = [&rays, &terrain](const auto& pTree)
+	{
+		float total = 0.f;
+		for (const FRay& ray : rays)
+		{
+			float distance = 1000.f;
+			pTree.Raycast(ray, distance, [&terrain, &ray](const std::uint32_t pTriangle, float& pDistance)
+				{
+					return HitTriangle(terrain, ray, pTriangle, pDistance);
+				});
+			total += distance;
+		}
+		return total;
+	};
+
+	BENCHMARK(BenchmarkName("Raycast BVH rays", count))
+	{
+		return raycasts(bvh);
+	};
+
+	BENCHMARK(BenchmarkName("Raycast BVH4 rays", count))
+	{
+		return raycasts(bvh4);
+	};
+
+	BENCHMARK(BenchmarkName("Raycast BVH8 rays", count))
+	{
+		return raycasts(bvh8);
+	};
+
+	const auto spheres = [&centers](const auto& pTree)
+	{
+		std::size_t found = 0;
+		for (const FVec3& center : centers)
+			pTree.QuerySphere(center, 4.f, [&found](const std::uint32_t) { found++; });
+		return found;
+	};
+
+	BENCHMARK(BenchmarkName("QuerySphere BVH spheres", count))
+	{
+		return spheres(bvh);
+	};
+
+	BENCHMARK(BenchmarkName("QuerySphere BVH8 spheres", count))
+	{
+		return spheres(bvh8);
+	};
+}
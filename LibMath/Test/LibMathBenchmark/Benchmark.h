@@ -0,0 +1,28 @@
+#pragma once
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstddef>
+#include <string>
+
+/* -----
+Shared by every benchmark file: each benchmark runs once per batch size,
+a batch that stays in L1/L2 and a frame sized one that streams from memory.
+----- */
+
+#define BENCHMARK_BATCH_SIZE() GENERATE(std::size_t(1024), std::size_t(65536))
+
+// "Inverse" + 1024 -> "Inverse/1024", the batch size is parsed back by the csv/json reporters
+inline std::string BenchmarkName(const char* pName, const std::size_t pBatchSize)
+{
+	return std::string(pName) + '/' + std::to_string(pBatchSize);
+}
+
+// deterministic values in [pMin, pMax) so every run measures the same data
+inline float BenchmarkValue(const std::size_t pIndex, const float pMin, const float pMax)
+{
+	const unsigned int hash = static_cast<unsigned int>(pIndex) * 2654435761u;
+	return pMin + (pMax - pMin) * float(hash >> 8) / float(1u << 24);
+}
@@ -0,0 +1,108 @@
+#include "Benchmark.h"
+
+#include <cmath>
+#include <vector>
+
+#include "../../LibMath/FastMath.h"
+
+using namespace lm;
+
+TEST_CASE("FastMath", "[benchmark][fastmath]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+	const std::size_t packed = count - count % Simd::Float8::Width;
+
+	std::vector<float> angles;
+	std::vector<float> values;
+	std::vector<float> others;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		angles.push_back(BenchmarkValue(i, -10.f, 10.f));
+		values.push_back(BenchmarkValue(i + 1, -1.f, 1.f));
+		others.push_back(BenchmarkValue(i + 2, -1.f, 1.f));
+	}
+
+	std::vector<float> sin(count);
+	std::vector<float> cos(count);
+
+	BENCHMARK(BenchmarkName("std::sin + std::cos", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			sin[i] = std::sin(angles[i]);
+			cos[i] = std::cos(angles[i]);
+		}
+		return sin[count - 1] + cos[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("SinCos", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			Utilities::SinCos(angles[i], sin[i], cos[i]);
+		return sin[count - 1] + cos[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("SinCos Float8", count))
+	{
+		for (std::size_t i = 0; i < packed; i += Simd::Float8::Width)
+		{
+			Simd::Float8 sinPack, cosPack;
+			Utilities::SinCos(Simd::Float8::Load(&angles[i]), sinPack, cosPack);
+			sinPack.Store(&sin[i]);
+			cosPack.Store(&cos[i]);
+		}
+		return sin[0] + cos[0];
+	};
+
+	BENCHMARK(BenchmarkName("1 / std::sqrt", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			sin[i] = 1.f / std::sqrt(angles[i] * angles[i] + 1.f);
+		return sin[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("FastRsqrt", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			sin[i] = Utilities::FastRsqrt(angles[i] * angles[i] + 1.f);
+		return sin[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("FastRsqrt Float8", count))
+	{
+		for (std::size_t i = 0; i < packed; i += Simd::Float8::Width)
+		{
+			const Simd::Float8 angle = Simd::Float8::Load(&angles[i]);
+			Utilities::FastRsqrt(angle * angle + Simd::Float8::Splat(1.f)).Store(&sin[i]);
+		}
+		return sin[0];
+	};
+
+	BENCHMARK(BenchmarkName("std::acos", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			sin[i] = std::acos(values[i]);
+		return sin[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("FastAcos Float8", count))
+	{
+		for (std::size_t i = 0; i < packed; i += Simd::Float8::Width)
+			Utilities::FastAcos(Simd::Float8::Load(&values[i])).Store(&sin[i]);
+		return sin[0];
+	};
+
+	BENCHMARK(BenchmarkName("std::atan2", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			sin[i] = std::atan2(values[i], others[i]);
+		return sin[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("FastAtan2 Float8", count))
+	{
+		for (std::size_t i = 0; i < packed; i += Simd::Float8::Width)
+			Utilities::FastAtan2(Simd::Float8::Load(&values[i]), Simd::Float8::Load(&others[i])).Store(&sin[i]);
+		return sin[0];
+	};
+}
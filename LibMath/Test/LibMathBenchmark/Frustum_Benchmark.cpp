@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "../../LibMath/Frustum.h"
+
+using namespace lm;
+
+/* -----
+Batched sphere and box culling against the scalar test of one bound at a time, bounds
+spread around the camera so that about half of them are visible.
+----- */
+
+TEST_CASE("Frustum", "[benchmark][culling][frustum]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	const FMat4 view = FMat4::LookAtRH(FVec3(0.f, 5.f, 20.f), FVec3(0.f, 0.f, 0.f), FVec3(0.f, 1.f, 0.f));
+	const FFrustum frustum(view * FMat4::PerspectiveRH(70.f, 16.f / 9.f, .1f, 500.f));
+
+	FVec3SoA centers, extents;
+	std::vector<float> radii;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		centers.PushBack(FVec3(BenchmarkValue(i, -100.f, 100.f), BenchmarkValue(i + 1, -100.f, 100.f),
+			BenchmarkValue(i + 2, -100.f, 100.f)));
+		extents.PushBack(FVec3(BenchmarkValue(i, .1f, 4.f), BenchmarkValue(i + 3, .1f, 4.f), BenchmarkValue(i + 5, .1f, 4.f)));
+		radii.push_back(BenchmarkValue(i + 7, .1f, 4.f));
+	}
+
+	std::vector<std::uint64_t> visible((count + 63) / 64);
+
+	BENCHMARK(BenchmarkName("IntersectsSphere loop", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+			if (frustum.IntersectsSphere(FVec3(centers.X()[i], centers.Y()[i], centers.Z()[i]), radii[i]))
+				visible[i / 64] |= bit;
+			else
+				visible[i / 64] &= ~bit;
+		}
+		return visible[0];
+	};
+
+	BENCHMARK(BenchmarkName("CullSpheres", count))
+	{
+		frustum.CullSpheres(centers, radii.data(), visible.data());
+		return visible[0];
+	};
+
+	BENCHMARK(BenchmarkName("IntersectsBox loop", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+			if (frustum.IntersectsBox(FVec3(centers.X()[i], centers.Y()[i], centers.Z()[i]),
+				FVec3(extents.X()[i], extents.Y()[i], extents.Z()[i])))
+				visible[i / 64] |= bit;
+			else
+				visible[i / 64] &= ~bit;
+		}
+		return visible[0];
+	};
+
+	BENCHMARK(BenchmarkName("CullBoxes", count))
+	{
+		frustum.CullBoxes(centers, extents, visible.data());
+		return visible[0];
+	};
+}
@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "../../LibMath/Hierarchy.h"
+
+using namespace lm;
+
+// depth-first, four children per node, cut once pCount nodes exist
+static void AddSubtree(FHierarchy& pHierarchy, const std::size_t pParent, const std::size_t pDepth, const std::size_t pCount)
+{
+	if (pHierarchy.Size() >= pCount)
+		return;
+
+	const std::size_t index = pHierarchy.Size();
+	const FTransform local(FVec3(BenchmarkValue(index, -1.f, 1.f), 1.f, 0.f),
+		FQuat::RotationAxis(BenchmarkValue(index, 0.f, 6.f), FVec3(0.f, 1.f, 1.f)));
+	const std::size_t node = pHierarchy.AddNode(local, pParent);
+
+	for (std::size_t i = 0; i < 4 && pDepth > 0; i++)
+		AddSubtree(pHierarchy, node, pDepth - 1, pCount);
+}
+
+/* -----
+Hierarchy::Update against recomputing every world matrix with operator* each frame, with
+every node animated and with one node in a hundred animated.
+----- */
+
+TEST_CASE("Hierarchy", "[benchmark][transform][hierarchy]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	FHierarchy hierarchy;
+	hierarchy.Reserve(count);
+	AddSubtree(hierarchy, FHierarchy::mNoParent, 8, count);
+	hierarchy.Update(1);
+
+	std::vector<FMat4> worlds(hierarchy.Size());
+
+	BENCHMARK(BenchmarkName("Every world with operator*", count))
+	{
+		for (std::size_t i = 0; i < hierarchy.Size(); i++)
+		{
+			const std::size_t parent = hierarchy.GetParent(i);
+			worlds[i] = parent == FHierarchy::mNoParent ? hierarchy.GetLocal(i).ToMat4() :
+				hierarchy.GetLocal(i).ToMat4() * worlds[parent];
+		}
+		return worlds[count - 1][3][0];
+	};
+
+	BENCHMARK(BenchmarkName("Update every node dirty 1 thread", count))
+	{
+		for (std::size_t i = 0; i < hierarchy.Size(); i++)
+			hierarchy.SetLocal(i, hierarchy.GetLocal(i));
+		hierarchy.Update(1);
+		return hierarchy.GetWorld(count - 1)[3][0];
+	};
+
+	BENCHMARK(BenchmarkName("Update every node dirty", count))
+	{
+		for (std::size_t i = 0; i < hierarchy.Size(); i++)
+			hierarchy.SetLocal(i, hierarchy.GetLocal(i));
+		hierarchy.Update();
+		return hierarchy.GetWorld(count - 1)[3][0];
+	};
+
+	BENCHMARK(BenchmarkName("Update 1% dirty 1 thread", count))
+	{
+		for (std::size_t i = 50; i < hierarchy.Size(); i += 100)
+			hierarchy.SetLocal(i, hierarchy.GetLocal(i));
+		hierarchy.Update(1);
+		return hierarchy.GetWorld(count - 1)[3][0];
+	};
+}
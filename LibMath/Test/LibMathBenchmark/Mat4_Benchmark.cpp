@@ -0,0 +1,122 @@
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "../../LibMath/Mat4.h"
+
+using namespace lm;
+
+TEST_CASE("Matrix4", "[benchmark][matrix]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	const FMat4 scale{ 1.5f, 0.f, 0.f, 0.f,
+		0.f, 2.f, 0.f, 0.f,
+		0.f, 0.f, .5f, 0.f,
+		0.f, 0.f, 0.f, 1.f };
+
+	// camera/bone like transforms
+	std::vector<FMat4> affine;
+	std::vector<FMat4> rigid;
+	std::vector<FVec4> vectors;
+	std::vector<FVec3> points;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const float angle = BenchmarkValue(i, 0.f, 360.f);
+		const FMat4 rotation = FMat4::zRotation(-angle) * FMat4::xRotation(angle) * FMat4::yRotation(angle * .5f);
+		const FMat4 translation = FMat4::Translation(FVec3(BenchmarkValue(i, -100.f, 100.f), -float(i), 3.f));
+
+		rigid.push_back(rotation * translation);
+		affine.push_back(scale * rigid.back());
+		vectors.push_back(FVec4(BenchmarkValue(i, -1.f, 1.f), BenchmarkValue(i + 1, -1.f, 1.f), 2.f, 1.f));
+		points.push_back(FVec3(vectors.back().X(), vectors.back().Y(), vectors.back().Z()));
+	}
+
+	std::vector<FMat4> result(count);
+	std::vector<FVec4> resultVectors(count);
+	std::vector<FVec3> resultPoints(count);
+	std::vector<float> resultScalars(count);
+
+	BENCHMARK(BenchmarkName("DotProduct", count))
+	{
+		for (std::size_t i = 0; i + 1 < count; i++)
+			result[i] = affine[i].DotProduct(affine[i + 1]);
+		return result[0][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("Determinant", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			resultScalars[i] = affine[i].Determinant();
+		return resultScalars[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("Adjugate * 1 / Determinant", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = affine[i].Adjugate() * (1.f / affine[i].Determinant());
+		return result[count - 1][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("Inverse", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = affine[i].Inverse();
+		return result[count - 1][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("InverseAffine", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = affine[i].InverseAffine();
+		return result[count - 1][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("InverseRigid", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = rigid[i].InverseRigid();
+		return result[count - 1][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("operator*(Vec4)", count))
+	{
+		const FMat4& matrix = affine[0];
+		for (std::size_t i = 0; i < count; i++)
+			resultVectors[i] = matrix * vectors[i];
+		return resultVectors[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("TransformVec4", count))
+	{
+		affine[0].TransformVec4(vectors.data(), resultVectors.data(), count);
+		return resultVectors[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("TransformPoints", count))
+	{
+		affine[0].TransformPoints(points.data(), resultPoints.data(), count);
+		return resultPoints[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("Rotation zxy", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const float angle = vectors[i].X() * 180.f;
+			result[i] = FMat4::zRotation(-angle) * FMat4::xRotation(angle) * FMat4::yRotation(angle * .5f);
+		}
+		return result[count - 1][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("Rotation zxy(FastMath)", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const float angle = vectors[i].X() * 180.f;
+			result[i] = FMat4::zRotation(-angle, Utilities::FastMath) * FMat4::xRotation(angle, Utilities::FastMath) *
+				FMat4::yRotation(angle * .5f, Utilities::FastMath);
+		}
+		return result[count - 1][0][0];
+	};
+}
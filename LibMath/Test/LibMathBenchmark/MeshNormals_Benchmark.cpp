@@ -0,0 +1,140 @@
+#include "Benchmark.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../LibMath/MeshNormals.h"
+
+using namespace lm;
+
+// pSize x pSize quads with a noisy height, in scanline order
+static void MakeGrid(const std::uint32_t pSize, std::vector<Vertex>& pVertices, std::vector<std::uint32_t>& pIndices)
+{
+	pVertices.reserve(std::size_t(pSize + 1) * (pSize + 1));
+	for (std::uint32_t z = 0; z <= pSize; z++)
+		for (std::uint32_t x = 0; x <= pSize; x++)
+		{
+			const std::size_t i = pVertices.size();
+			pVertices.emplace_back(FVec3(float(x), BenchmarkValue(i, -1.f, 1.f), float(z)), FVec3(), FVec2(float(x), float(z)));
+		}
+
+	pIndices.reserve(std::size_t(6) * pSize * pSize);
+	for (std::uint32_t z = 0; z < pSize; z++)
+		for (std::uint32_t x = 0; x < pSize; x++)
+		{
+			const std::uint32_t corner = z * (pSize + 1) + x;
+			for (const std::uint32_t index : { corner, corner + pSize + 1, corner + 1, corner + 1, corner + pSize + 1, corner + pSize + 2 })
+				pIndices.push_back(index);
+		}
+}
+
+/* -----
+Smooth normals and tangents of a grid mesh: the serial scatter straight into the Vertex
+array against ComputeNormals and ComputeTangents on one thread and on every thread.
+----- */
+
+TEST_CASE("MeshNormals", "[benchmark][mesh][normals]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	// a square grid of about count vertices
+	std::uint32_t size = 1;
+	while ((size + 2) * (size + 2) <= count)
+		size++;
+
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	MakeGrid(size, vertices, indices);
+
+	std::vector<FVec4> tangents(vertices.size());
+
+	BENCHMARK(BenchmarkName("Vertex normals loop", vertices.size()))
+	{
+		for (Vertex& vertex : vertices)
+			vertex.GetNormal() = FVec3(0.f);
+
+		for (std::size_t i = 0; i < indices.size(); i += 3)
+		{
+			Vertex& a = vertices[indices[i]];
+			Vertex& b = vertices[indices[i + 1]];
+			Vertex& c = vertices[indices[i + 2]];
+			const FVec3 normal = (b.GetPosition() - a.GetPosition()).CrossProduct(c.GetPosition() - a.GetPosition());
+			a.GetNormal() += normal;
+			b.GetNormal() += normal;
+			c.GetNormal() += normal;
+		}
+
+		for (Vertex& vertex : vertices)
+			vertex.GetNormal() = vertex.GetNormal().Normalize();
+		return vertices[0].GetNormal().Y();
+	};
+
+	BENCHMARK(BenchmarkName("ComputeNormals area 1 thread", vertices.size()))
+	{
+		ComputeNormals(vertices.data(), vertices.size(), indices.data(), indices.size(), NormalWeighting::Area, 1);
+		return vertices[0].GetNormal().Y();
+	};
+
+	BENCHMARK(BenchmarkName("ComputeNormals area", vertices.size()))
+	{
+		ComputeNormals(vertices.data(), vertices.size(), indices.data(), indices.size(), NormalWeighting::Area);
+		return vertices[0].GetNormal().Y();
+	};
+
+	BENCHMARK(BenchmarkName("ComputeNormals angle", vertices.size()))
+	{
+		ComputeNormals(vertices.data(), vertices.size(), indices.data(), indices.size(), NormalWeighting::Angle);
+		return vertices[0].GetNormal().Y();
+	};
+
+	BENCHMARK(BenchmarkName("ComputeTangents 1 thread", vertices.size()))
+	{
+		ComputeTangents(vertices.data(), vertices.size(), indices.data(), indices.size(), tangents.data(), 1);
+		return tangents[0].W();
+	};
+
+	BENCHMARK(BenchmarkName("ComputeTangents", vertices.size()))
+	{
+		ComputeTangents(vertices.data(), vertices.size(), indices.data(), indices.size(), tangents.data());
+		return tangents[0].W();
+	};
+}
+
+/* -----
+Scaling at production size: a grid of 10M triangles, about 5M vertices, against 1, 2, 4...
+threads up to every hardware thread. Hidden from the default run for its size, run it with
+LibMathBenchmark "[large]" --benchmark-samples 10.
+----- */
+
+TEST_CASE("MeshNormals large", "[.][large][mesh][normals]")
+{
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	MakeGrid(2237, vertices, indices);
+
+	std::vector<FVec4> tangents(vertices.size());
+
+	const unsigned int hardware = Parallel::ThreadCount(0);
+	std::vector<unsigned int> threadCounts;
+	for (unsigned int threads = 1; threads < hardware; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(hardware);
+
+	for (const unsigned int threads : threadCounts)
+	{
+		const std::string suffix = ' ' + std::to_string(threads) + (threads == 1 ? " thread" : " threads");
+
+		BENCHMARK(BenchmarkName(("ComputeNormals area" + suffix).c_str(), vertices.size()))
+		{
+			ComputeNormals(vertices.data(), vertices.size(), indices.data(), indices.size(), NormalWeighting::Area, threads);
+			return vertices[0].GetNormal().Y();
+		};
+
+		BENCHMARK(BenchmarkName(("ComputeTangents" + suffix).c_str(), vertices.size()))
+		{
+			ComputeTangents(vertices.data(), vertices.size(), indices.data(), indices.size(), tangents.data(), threads);
+			return tangents[0].W();
+		};
+	}
+}
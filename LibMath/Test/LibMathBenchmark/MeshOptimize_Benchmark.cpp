@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../../LibMath/MeshOptimize.h"
+
+using namespace lm;
+
+/* -----
+The index optimizers on a grid mesh whose triangles and vertices come shuffled, as from an
+importer that ignores locality. An indexed walk over the positions, the access pattern of
+a CPU-side batch over the triangles, runs before and after the reordering.
+----- */
+
+TEST_CASE("MeshOptimize", "[benchmark][mesh][optimize]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	// a square grid of about count vertices
+	std::uint32_t size = 1;
+	while ((size + 2) * (size + 2) <= count)
+		size++;
+
+	std::vector<Vertex> vertices;
+	for (std::uint32_t z = 0; z <= size; z++)
+		for (std::uint32_t x = 0; x <= size; x++)
+		{
+			const std::size_t i = vertices.size();
+			vertices.emplace_back(FVec3(float(x), BenchmarkValue(i, -1.f, 1.f), float(z)));
+		}
+
+	std::vector<std::uint32_t> indices;
+	for (std::uint32_t z = 0; z < size; z++)
+		for (std::uint32_t x = 0; x < size; x++)
+		{
+			const std::uint32_t corner = z * (size + 1) + x;
+			for (const std::uint32_t index : { corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2 })
+				indices.push_back(index);
+		}
+
+	// a fixed shuffle of the triangles and of the vertices
+	const std::size_t triangleCount = indices.size() / 3;
+	for (std::size_t i = 0; i < triangleCount; i++)
+	{
+		const std::size_t j = (i * 7919) % triangleCount;
+		for (int k = 0; k < 3; k++)
+			std::swap(indices[3 * i + k], indices[3 * j + k]);
+	}
+
+	std::vector<std::uint32_t> shuffle(vertices.size());
+	for (std::size_t i = 0; i < vertices.size(); i++)
+		shuffle[i] = std::uint32_t(i);
+	for (std::size_t i = 0; i < vertices.size(); i++)
+		std::swap(shuffle[i], shuffle[(i * 104729) % vertices.size()]);
+
+	const std::vector<Vertex> ordered = vertices;
+	for (std::size_t i = 0; i < vertices.size(); i++)
+		vertices[shuffle[i]] = ordered[i];
+	for (std::uint32_t& index : indices)
+		index = shuffle[index];
+
+	const auto walk = [](const std::vector<Vertex>& pVertices, const std::vector<std::uint32_t>& pIndices)
+	{
+		FVec3 sum(0.f);
+		for (const std::uint32_t index : pIndices)
+			sum += pVertices[index].GetPosition();
+		return sum.X();
+	};
+
+	BENCHMARK(BenchmarkName("Indexed walk import order", vertices.size()))
+	{
+		return walk(vertices, indices);
+	};
+
+	std::vector<std::uint32_t> optimized(indices.size());
+	BENCHMARK(BenchmarkName("OptimizeVertexCache", vertices.size()))
+	{
+		OptimizeVertexCache(indices.data(), indices.size(), vertices.size(), optimized.data());
+		return optimized[0];
+	};
+
+	const VertexStream<const FVec3> positions(&vertices[0].GetPosition(), vertices.size(), sizeof(Vertex));
+	std::vector<std::uint32_t> sorted(indices.size());
+	BENCHMARK(BenchmarkName("OptimizeOverdraw", vertices.size()))
+	{
+		OptimizeOverdraw(optimized.data(), optimized.size(), positions, sorted.data());
+		return sorted[0];
+	};
+
+	std::vector<Vertex> fetched;
+	std::vector<std::uint32_t> fetchedIndices;
+	BENCHMARK(BenchmarkName("OptimizeVertexFetch", vertices.size()))
+	{
+		fetched = vertices;
+		fetchedIndices = optimized;
+		return OptimizeVertexFetch(fetched.data(), fetched.size(), fetchedIndices.data(), fetchedIndices.size());
+	};
+
+	BENCHMARK(BenchmarkName("Indexed walk optimized", vertices.size()))
+	{
+		return walk(fetched, fetchedIndices);
+	};
+
+	BENCHMARK(BenchmarkName("AnalyzeVertexCache", vertices.size()))
+	{
+		return AnalyzeVertexCache(optimized.data(), optimized.size(), vertices.size()).mTransformed;
+	};
+
+	const VertexCacheStatistics before = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+	const VertexCacheStatistics after = AnalyzeVertexCache(optimized.data(), optimized.size(), vertices.size());
+	const VertexCacheStatistics overdraw = AnalyzeVertexCache(sorted.data(), sorted.size(), vertices.size());
+	WARN("ACMR / ATVR (FIFO 16) import " << before.mAcmr << " / " << before.mAtvr << ", vertex cache " << after.mAcmr <<
+		" / " << after.mAtvr << ", overdraw " << overdraw.mAcmr << " / " << overdraw.mAtvr);
+}
@@ -0,0 +1,90 @@
+#include "Benchmark.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../../LibMath/MeshWeld.h"
+
+using namespace lm;
+
+/* -----
+Welding a grid mesh given as a triangle soup, every inner vertex repeated 6 times: the open
+addressing tables of GenerateVertexRemap against std::unordered_map on the same keys.
+----- */
+
+namespace
+{
+	struct WeldKeyHash
+	{
+		std::size_t operator()(const Meshes::WeldKey& pKey) const
+		{
+			return std::size_t(Meshes::HashWeldKey(pKey));
+		}
+	};
+}
+
+TEST_CASE("MeshWeld", "[benchmark][mesh][weld]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	// a square grid of about count unique vertices
+	std::uint32_t size = 1;
+	while ((size + 2) * (size + 2) <= count)
+		size++;
+
+	std::vector<Vertex> soup;
+	for (std::uint32_t z = 0; z < size; z++)
+		for (std::uint32_t x = 0; x < size; x++)
+			for (const std::uint32_t corner : { 0u, 2u, 1u, 1u, 2u, 3u })
+			{
+				const std::uint32_t px = x + (corner & 1), pz = z + (corner >> 1);
+				const std::size_t i = pz * (size + 1) + px;
+				soup.emplace_back(FVec3(float(px), BenchmarkValue(i, -1.f, 1.f), float(pz)), FVec3(0.f, 1.f, 0.f),
+					FVec2(float(px), float(pz)));
+			}
+
+	std::vector<std::uint32_t> remap(soup.size());
+	std::vector<Vertex> unique;
+	std::vector<std::uint16_t> shortIndices;
+
+	BENCHMARK(BenchmarkName("std::unordered_map", soup.size()))
+	{
+		std::unordered_map<Meshes::WeldKey, std::uint32_t, WeldKeyHash> table;
+		for (std::size_t i = 0; i < soup.size(); i++)
+		{
+			Meshes::WeldKey key;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				key[axis] = Meshes::QuantizeAttribute(soup[i].GetPosition()[axis], 0.f);
+				key[3 + axis] = Meshes::QuantizeAttribute(soup[i].GetNormal()[axis], 0.f);
+				key[8 + axis] = Meshes::QuantizeAttribute(soup[i].GetColor()[axis], 0.f);
+			}
+			key[6] = Meshes::QuantizeAttribute(soup[i].GetTextCoords().X(), 0.f);
+			key[7] = Meshes::QuantizeAttribute(soup[i].GetTextCoords().Y(), 0.f);
+			remap[i] = table.emplace(key, std::uint32_t(table.size())).first->second;
+		}
+		return table.size();
+	};
+
+	BENCHMARK(BenchmarkName("GenerateVertexRemap 1 thread", soup.size()))
+	{
+		return GenerateVertexRemap(soup.data(), soup.size(), remap.data(), WeldTolerance(), 1);
+	};
+
+	BENCHMARK(BenchmarkName("GenerateVertexRemap", soup.size()))
+	{
+		return GenerateVertexRemap(soup.data(), soup.size(), remap.data());
+	};
+
+	BENCHMARK(BenchmarkName("GenerateVertexRemap tolerance", soup.size()))
+	{
+		return GenerateVertexRemap(soup.data(), soup.size(), remap.data(), WeldTolerance(1e-4f));
+	};
+
+	BENCHMARK(BenchmarkName("WeldVertices uint16", soup.size()))
+	{
+		WeldVertices(soup.data(), soup.size(), unique, shortIndices);
+		return unique.size();
+	};
+}
@@ -0,0 +1,151 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../../LibMath/QuatPacket.h"
+
+using namespace lm;
+
+// double precision Slerp, the reference for the accuracy tiers
+static DQuat ReferenceSlerp(const FQuat& pStart, const FQuat& pEnd, const double pAlpha)
+{
+	const DQuat from(pStart.mX, pStart.mY, pStart.mZ, pStart.mW);
+	DQuat to(pEnd.mX, pEnd.mY, pEnd.mZ, pEnd.mW);
+
+	double cosAngle = from.DotProduct(to);
+	if (cosAngle < 0)
+	{
+		cosAngle = -cosAngle;
+		to = DQuat(-to.mX, -to.mY, -to.mZ, -to.mW);
+	}
+
+	const double angle = std::acos(std::min(cosAngle, 1.));
+	if (angle < 1e-9)
+		return from;
+
+	const double ratioA = std::sin((1 - pAlpha) * angle) / std::sin(angle);
+	const double ratioB = std::sin(pAlpha * angle) / std::sin(angle);
+	return DQuat(from.mX * ratioA + to.mX * ratioB, from.mY * ratioA + to.mY * ratioB,
+		from.mZ * ratioA + to.mZ * ratioB, from.mW * ratioA + to.mW * ratioB);
+}
+
+// largest rotation angle between pResult and the reference, in radians
+static double MaxAngularError(const std::vector<FQuat>& pStart, const std::vector<FQuat>& pEnd,
+	const std::vector<FQuat>& pResult, const double pAlpha)
+{
+	double maxError = 0;
+	for (std::size_t i = 0; i < pResult.size(); i++)
+	{
+		const DQuat expected = ReferenceSlerp(pStart[i], pEnd[i], pAlpha);
+		const DQuat result(pResult[i].mX, pResult[i].mY, pResult[i].mZ, pResult[i].mW);
+		const double dot = std::abs(result.Normalize().DotProduct(expected.Normalize()));
+		maxError = std::max(maxError, 2 * std::acos(std::min(dot, 1.)));
+	}
+	return maxError;
+}
+
+TEST_CASE("Quaternion", "[benchmark][quaternion]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	// animation style pairs of keyframes
+	std::vector<FQuat> start;
+	std::vector<FQuat> end;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const FVec3 axis(BenchmarkValue(i, -1.f, 1.f), BenchmarkValue(i + 1, -1.f, 1.f), 1.f);
+		start.push_back(FQuat::RotationAxis(BenchmarkValue(i, -3.f, 3.f), axis));
+		end.push_back(FQuat::RotationAxis(BenchmarkValue(i + 7, -3.f, 3.f), axis));
+	}
+
+	std::vector<FQuat> result(count);
+
+	BENCHMARK(BenchmarkName("Slerp", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = FQuat::Slerp(start[i], end[i], .35f);
+		return result[count - 1].mW;
+	};
+
+	BENCHMARK(BenchmarkName("Quatx8::Slerp", count))
+	{
+		for (std::size_t i = 0; i + Quatx8::Width <= count; i += Quatx8::Width)
+			Quatx8::Slerp(Quatx8::Load(&start[i]), Quatx8::Load(&end[i]), .35f).Store(&result[i]);
+		return result[count - 1].mW;
+	};
+
+	BENCHMARK(BenchmarkName("BatchSlerp Fast", count))
+	{
+		BatchSlerp(start.data(), end.data(), .35f, result.data(), count, SlerpAccuracy::Fast);
+		return result[count - 1].mW;
+	};
+
+	BENCHMARK(BenchmarkName("BatchSlerp Precise", count))
+	{
+		BatchSlerp(start.data(), end.data(), .35f, result.data(), count, SlerpAccuracy::Precise);
+		return result[count - 1].mW;
+	};
+
+	BENCHMARK(BenchmarkName("BatchSlerp Exact", count))
+	{
+		BatchSlerp(start.data(), end.data(), .35f, result.data(), count, SlerpAccuracy::Exact);
+		return result[count - 1].mW;
+	};
+
+	BENCHMARK(BenchmarkName("BatchNlerp", count))
+	{
+		BatchNlerp(start.data(), end.data(), .35f, result.data(), count);
+		return result[count - 1].mW;
+	};
+
+	// accuracy of every variant against a double precision Slerp, reported next to the timings
+	for (std::size_t i = 0; i < count; i++)
+		result[i] = FQuat::Slerp(start[i], end[i], .35f);
+	const double slerpError = MaxAngularError(start, end, result, .35);
+
+	double tierErrors[3];
+	const SlerpAccuracy tiers[] = { SlerpAccuracy::Fast, SlerpAccuracy::Precise, SlerpAccuracy::Exact };
+	for (std::size_t tier = 0; tier < 3; tier++)
+	{
+		BatchSlerp(start.data(), end.data(), .35f, result.data(), count, tiers[tier]);
+		tierErrors[tier] = MaxAngularError(start, end, result, .35);
+	}
+
+	BatchNlerp(start.data(), end.data(), .35f, result.data(), count);
+	const double nlerpError = MaxAngularError(start, end, result, .35);
+
+	WARN("max angular error (rad) Slerp " << slerpError << ", BatchSlerp Fast " << tierErrors[0] <<
+		", Precise " << tierErrors[1] << ", Exact " << tierErrors[2] << ", BatchNlerp " << nlerpError);
+	CHECK(tierErrors[0] < 2e-5);
+	CHECK(tierErrors[1] < 1e-6);
+
+	BENCHMARK(BenchmarkName("Normalize", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = start[i].Normalize();
+		return result[count - 1].mW;
+	};
+
+	BENCHMARK(BenchmarkName("Normalize(FastMath)", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = start[i].Normalize(Utilities::FastMath);
+		return result[count - 1].mW;
+	};
+
+	BENCHMARK(BenchmarkName("RotationAxis", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = FQuat::RotationAxis(start[i].mX * 6.f, FVec3(start[i].mY, start[i].mZ, 1.f));
+		return result[count - 1].mW;
+	};
+
+	BENCHMARK(BenchmarkName("RotationAxis(FastMath)", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = FQuat::RotationAxis(start[i].mX * 6.f, FVec3(start[i].mY, start[i].mZ, 1.f), Utilities::FastMath);
+		return result[count - 1].mW;
+	};
+}
@@ -0,0 +1,96 @@
+#include "Benchmark.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "../../LibMath/RayPacket.h"
+#include "../../LibMath/Vertex.h"
+
+using namespace lm;
+
+/* -----
+One ray against a triangle soup read from a vertex buffer: the scalar Moller-Trumbore and
+watertight loops against RaycastTriangles, then scalar slab tests against Rayx8 packets.
+----- */
+
+TEST_CASE("Ray", "[benchmark][ray]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	std::vector<Vertex> vertices;
+	std::vector<std::uint32_t> indices;
+	std::vector<FAABB> boxes;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const FVec3 center(BenchmarkValue(i, -10.f, 10.f), BenchmarkValue(i + 1, -10.f, 10.f), BenchmarkValue(i + 2, -20.f, -5.f));
+		vertices.emplace_back(center + FVec3(-.1f, -.1f, 0.f));
+		vertices.emplace_back(center + FVec3(.1f, -.1f, .05f));
+		vertices.emplace_back(center + FVec3(0.f, .1f, -.05f));
+		for (std::uint32_t corner = 0; corner < 3; corner++)
+			indices.push_back(std::uint32_t(3 * i) + corner);
+		boxes.push_back(FAABB::FromCenterExtents(center, FVec3(.2f)));
+	}
+
+	const FRay ray(FVec3(0.f, 0.f, 0.f), FVec3(.1f, -.05f, -1.f));
+	std::vector<FRay> rays;
+	for (std::size_t i = 0; i < 8; i++)
+		rays.emplace_back(FVec3(0.f), FVec3(BenchmarkValue(i, -.5f, .5f), BenchmarkValue(i + 3, -.5f, .5f), -1.f));
+
+	const auto position = [&vertices, &indices](const std::size_t pIndex) -> const FVec3&
+	{
+		return vertices[indices[pIndex]].GetPosition();
+	};
+
+	BENCHMARK(BenchmarkName("Moller-Trumbore loop", count))
+	{
+		FRayHit hit;
+		for (std::size_t i = 0; i < count; i++)
+			if (ray.IntersectTriangle(position(3 * i), position(3 * i + 1), position(3 * i + 2), hit))
+				hit.mPrimitive = std::uint32_t(i);
+		return hit.mPrimitive;
+	};
+
+	BENCHMARK(BenchmarkName("Watertight loop", count))
+	{
+		FRayHit hit;
+		for (std::size_t i = 0; i < count; i++)
+			if (ray.IntersectTriangleWatertight(position(3 * i), position(3 * i + 1), position(3 * i + 2), hit))
+				hit.mPrimitive = std::uint32_t(i);
+		return hit.mPrimitive;
+	};
+
+	BENCHMARK(BenchmarkName("RaycastTriangles", count))
+	{
+		FRayHit hit;
+		RaycastTriangles(ray, &vertices[0].GetPosition(), indices.data(), count, hit, sizeof(Vertex));
+		return hit.mPrimitive;
+	};
+
+	BENCHMARK(BenchmarkName("8 rays IntersectBox loop", count))
+	{
+		int hits = 0;
+		for (const FAABB& box : boxes)
+			for (const FRay& current : rays)
+			{
+				float entry;
+				hits += current.IntersectBox(box, 100.f, entry) ? 1 : 0;
+			}
+		return hits;
+	};
+
+	BENCHMARK(BenchmarkName("Rayx8 IntersectBox", count))
+	{
+		const Rayx8 packet = Rayx8::Load(rays.data());
+		const Simd::Float8 maxDistance = Simd::Float8::Splat(100.f);
+
+		int hits = 0;
+		for (const FAABB& box : boxes)
+		{
+			Simd::Float8 entry;
+			const int bits = packet.IntersectBox(box, maxDistance, entry).Bits();
+			for (int lane = 0; lane < 8; lane++)
+				hits += bits >> lane & 1;
+		}
+		return hits;
+	};
+}
@@ -0,0 +1,175 @@
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <catch2/reporters/catch_reporter_streaming_base.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../../LibMath/Simd.h"
+
+/* -----
+Machine readable reporters for the benchmark target, one row/object per benchmark:
+	LibMathBenchmark --reporter csv::out=results.csv
+	LibMathBenchmark --reporter json::out=results.json
+Times are in nanoseconds for one batch, per_element_ns divides by the batch size
+taken from the "Name/BatchSize" benchmark name (see Benchmark.h).
+Define LIBMATH_REVISION (git hash, tag...) at compile time to stamp the results.
+----- */
+
+#ifndef LIBMATH_REVISION
+#define LIBMATH_REVISION "unknown"
+#endif
+
+namespace
+{
+	// the widest tier the build targets, the compiler predefines __AVX2__ and __AVX512F__ for them
+	const char* InstructionSet()
+	{
+#if defined(LIBMATH_AVX) && defined(__AVX512F__)
+		return "avx512";
+#elif defined(LIBMATH_AVX) && defined(__AVX2__)
+		return "avx2";
+#elif defined(LIBMATH_AVX)
+		return "avx";
+#elif defined(LIBMATH_SSE)
+		return "sse";
+#else
+		return "scalar";
+#endif
+	}
+
+	struct BenchmarkResult
+	{
+		std::string mTestCase;
+		std::string mName;
+		unsigned long long mBatchSize;
+		unsigned int mSamples;
+		int mIterations;
+		double mMean;
+		double mMeanLow;
+		double mMeanHigh;
+		double mStandardDeviation;
+		double mOutlierVariance;
+	};
+
+	class ResultReporter : public Catch::StreamingReporterBase
+	{
+	protected:
+		std::vector<BenchmarkResult> mResults;
+
+	public:
+		ResultReporter(Catch::ReporterConfig&& pConfig)
+			: StreamingReporterBase(CATCH_MOVE(pConfig))
+		{}
+
+		void benchmarkEnded(Catch::BenchmarkStats<> const& pStats) override
+		{
+			BenchmarkResult result;
+			result.mTestCase = this->currentTestCaseInfo ? this->currentTestCaseInfo->name : std::string();
+			result.mName = pStats.info.name;
+			result.mBatchSize = 1;
+			result.mSamples = pStats.info.samples;
+			result.mIterations = pStats.info.iterations;
+			result.mMean = pStats.mean.point.count();
+			result.mMeanLow = pStats.mean.lower_bound.count();
+			result.mMeanHigh = pStats.mean.upper_bound.count();
+			result.mStandardDeviation = pStats.standardDeviation.point.count();
+			result.mOutlierVariance = pStats.outlierVariance;
+
+			const std::size_t separator = result.mName.rfind('/');
+			if (separator != std::string::npos)
+			{
+				result.mBatchSize = std::stoull(result.mName.substr(separator + 1));
+				result.mName.erase(separator);
+			}
+
+			this->mResults.push_back(result);
+		}
+	};
+
+	class CsvReporter : public ResultReporter
+	{
+	public:
+		using ResultReporter::ResultReporter;
+
+		static std::string getDescription()
+		{
+			return "Benchmark results as comma separated values";
+		}
+
+		void testRunEnded(Catch::TestRunStats const& pStats) override
+		{
+			this->m_stream << "revision,isa,test_case,benchmark,batch_size,samples,iterations,"
+				"mean_ns,mean_low_ns,mean_high_ns,std_dev_ns,outlier_variance,per_element_ns\n";
+
+			for (const BenchmarkResult& result : this->mResults)
+			{
+				this->m_stream << LIBMATH_REVISION << ',' << InstructionSet() << ','
+					<< '"' << result.mTestCase << "\",\"" << result.mName << "\","
+					<< result.mBatchSize << ',' << result.mSamples << ',' << result.mIterations << ','
+					<< result.mMean << ',' << result.mMeanLow << ',' << result.mMeanHigh << ','
+					<< result.mStandardDeviation << ',' << result.mOutlierVariance << ','
+					<< result.mMean / double(result.mBatchSize) << '\n';
+			}
+
+			StreamingReporterBase::testRunEnded(pStats);
+		}
+	};
+
+	class JsonReporter : public ResultReporter
+	{
+	private:
+		static std::string Quote(const std::string& pValue)
+		{
+			std::string quoted = "\"";
+			for (const char character : pValue)
+			{
+				if (character == '"' || character == '\\')
+					quoted += '\\';
+				quoted += character;
+			}
+			return quoted + '"';
+		}
+
+	public:
+		using ResultReporter::ResultReporter;
+
+		static std::string getDescription()
+		{
+			return "Benchmark results as a JSON document";
+		}
+
+		void testRunEnded(Catch::TestRunStats const& pStats) override
+		{
+			this->m_stream << "{\n"
+				<< "  \"revision\": " << Quote(LIBMATH_REVISION) << ",\n"
+				<< "  \"isa\": " << Quote(InstructionSet()) << ",\n"
+				<< "  \"benchmarks\": [";
+
+			for (std::size_t i = 0; i < this->mResults.size(); i++)
+			{
+				const BenchmarkResult& result = this->mResults[i];
+				this->m_stream << (i == 0 ? "\n" : ",\n")
+					<< "    { \"test_case\": " << Quote(result.mTestCase)
+					<< ", \"benchmark\": " << Quote(result.mName)
+					<< ", \"batch_size\": " << result.mBatchSize
+					<< ", \"samples\": " << result.mSamples
+					<< ", \"iterations\": " << result.mIterations
+					<< ", \"mean_ns\": " << result.mMean
+					<< ", \"mean_low_ns\": " << result.mMeanLow
+					<< ", \"mean_high_ns\": " << result.mMeanHigh
+					<< ", \"std_dev_ns\": " << result.mStandardDeviation
+					<< ", \"outlier_variance\": " << result.mOutlierVariance
+					<< ", \"per_element_ns\": " << result.mMean / double(result.mBatchSize) << " }";
+			}
+
+			this->m_stream << "\n  ]\n}\n";
+
+			StreamingReporterBase::testRunEnded(pStats);
+		}
+	};
+}
+
+CATCH_REGISTER_REPORTER("csv", CsvReporter)
+CATCH_REGISTER_REPORTER("json", JsonReporter)
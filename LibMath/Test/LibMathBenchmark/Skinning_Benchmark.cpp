@@ -0,0 +1,82 @@
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "../../LibMath/Skinning.h"
+
+using namespace lm;
+
+/* -----
+SkinVertices against the per-vertex path it replaces: every influence transforms the
+vertex with Mat4 * Vec4 and the results are blended.
+----- */
+
+TEST_CASE("Skinning", "[benchmark][skinning]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+	constexpr std::size_t paletteSize = 64;
+
+	std::vector<FMat4> palette;
+	std::vector<FDualQuat> dualPalette;
+	for (std::size_t i = 0; i < paletteSize; i++)
+	{
+		const float angle = BenchmarkValue(i, 0.f, 360.f);
+		const FVec3 translation(BenchmarkValue(i, -1.f, 1.f), 0.f, BenchmarkValue(i + 1, -1.f, 1.f));
+		palette.push_back(FMat4::zRotation(angle) * FMat4::xRotation(-angle) * FMat4::Translation(translation));
+		dualPalette.push_back(FDualQuat(FQuat::RotationAxis(angle, FVec3(1.f, 0.f, 1.f)), translation));
+	}
+
+	// two to four influences per vertex, like a character mesh
+	std::vector<SkinnedVertex> mesh;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		const Vertex vertex(FVec3(BenchmarkValue(i, -1.f, 1.f), BenchmarkValue(i + 1, 0.f, 2.f), BenchmarkValue(i + 2, -1.f, 1.f)),
+			FVec3(0.f, 1.f, 0.f));
+
+		SkinnedVertex skinned(vertex);
+		for (std::size_t k = 0; k < 2 + i % 3; k++)
+			skinned.SetInfluence(k, std::uint16_t((i + k * 5) % paletteSize), BenchmarkValue(i + k, .1f, 1.f));
+		skinned.NormalizeWeights();
+		mesh.push_back(skinned);
+	}
+
+	std::vector<FVec3> positions(count);
+	std::vector<FVec3> normals(count);
+
+	BENCHMARK(BenchmarkName("Mat4 * Vec4 per influence", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			FVec4 position(0.f, 0.f, 0.f, 0.f);
+			FVec4 normal(0.f, 0.f, 0.f, 0.f);
+			for (std::size_t k = 0; k < SkinnedVertex::mMaxInfluences; k++)
+			{
+				const FMat4& bone = palette[mesh[i].GetBoneIndex(k)];
+				position += (bone * FVec4(mesh[i].GetPosition(), 1.f)) * mesh[i].GetBoneWeight(k);
+				normal += (bone * FVec4(mesh[i].GetNormal(), 0.f)) * mesh[i].GetBoneWeight(k);
+			}
+
+			positions[i] = FVec3(position.X(), position.Y(), position.Z());
+			normals[i] = FVec3(normal.X(), normal.Y(), normal.Z()).Normalize();
+		}
+		return positions[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("SkinVertices 1 thread", count))
+	{
+		SkinVertices(mesh.data(), count, palette.data(), paletteSize, positions.data(), normals.data(), 1);
+		return positions[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("SkinVertices", count))
+	{
+		SkinVertices(mesh.data(), count, palette.data(), paletteSize, positions.data(), normals.data());
+		return positions[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("SkinVertices dual quaternion 1 thread", count))
+	{
+		SkinVertices(mesh.data(), count, dualPalette.data(), paletteSize, positions.data(), normals.data(), 1);
+		return positions[count - 1].X();
+	};
+}
@@ -0,0 +1,82 @@
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "../../LibMath/Transform.h"
+
+using namespace lm;
+
+/* -----
+Scene-graph style updates: building, composing and inverting transforms kept as
+translation/rotation/scale against the same work done on 4x4 matrices.
+----- */
+
+TEST_CASE("Transform", "[benchmark][transform]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	std::vector<FVec3> positions;
+	std::vector<FVec3> angles;
+	std::vector<FVec3> scales;
+	std::vector<FTransform> transforms;
+	std::vector<FMat4> matrices;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		positions.push_back(FVec3(BenchmarkValue(i, -100.f, 100.f), -float(i), 3.f));
+		angles.push_back(FVec3(BenchmarkValue(i, 0.f, 360.f), BenchmarkValue(i + 1, 0.f, 360.f), BenchmarkValue(i + 2, 0.f, 360.f)));
+		scales.push_back(FVec3(BenchmarkValue(i, .5f, 2.f), BenchmarkValue(i, .5f, 2.f), BenchmarkValue(i, .5f, 2.f)));
+
+		transforms.push_back(FTransform(positions.back(), FQuat::RotationAxis(angles.back().X(), angles.back()), scales.back()));
+		matrices.push_back(transforms.back().ToMat4());
+	}
+
+	std::vector<FTransform> resultTransforms(count);
+	std::vector<FMat4> resultMatrices(count);
+
+	BENCHMARK(BenchmarkName("Mat4 Scale * Rotations * Translation", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const FMat4 scale(FVec4(scales[i].X(), 0.f, 0.f, 0.f), FVec4(0.f, scales[i].Y(), 0.f, 0.f),
+				FVec4(0.f, 0.f, scales[i].Z(), 0.f), FVec4(0.f, 0.f, 0.f, 1.f));
+			resultMatrices[i] = scale * FMat4::yRotation(angles[i].Y()) * FMat4::xRotation(angles[i].X()) *
+				FMat4::zRotation(angles[i].Z()) * FMat4::Translation(positions[i]);
+		}
+		return resultMatrices[count - 1][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("Transform ToMat4", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			resultMatrices[i] = transforms[i].ToMat4();
+		return resultMatrices[count - 1][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("Mat4 * Mat4", count))
+	{
+		for (std::size_t i = 0; i + 1 < count; i++)
+			resultMatrices[i] = matrices[i + 1] * matrices[i];
+		return resultMatrices[0][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("Transform * Transform", count))
+	{
+		for (std::size_t i = 0; i + 1 < count; i++)
+			resultTransforms[i] = transforms[i] * transforms[i + 1];
+		return resultTransforms[0].mTranslation.X();
+	};
+
+	BENCHMARK(BenchmarkName("Mat4 InverseAffine", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			resultMatrices[i] = matrices[i].InverseAffine();
+		return resultMatrices[count - 1][0][0];
+	};
+
+	BENCHMARK(BenchmarkName("Transform Inverse", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			resultTransforms[i] = transforms[i].Inverse();
+		return resultTransforms[count - 1].mTranslation.X();
+	};
+}
@@ -0,0 +1,64 @@
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "../../LibMath/Vec3Packet.h"
+#include "../../LibMath/Vec3SoA.h"
+
+using namespace lm;
+
+TEST_CASE("Vector3", "[benchmark][vector]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	std::vector<FVec3> vectors;
+	for (std::size_t i = 0; i < count; i++)
+		vectors.push_back(FVec3(BenchmarkValue(i, -10.f, 10.f), BenchmarkValue(i + 1, -10.f, 10.f),
+			BenchmarkValue(i + 2, .5f, 10.f)));
+
+	const FVec3SoA soa{ vectors.data(), count };
+
+	std::vector<FVec3> result(count);
+	std::vector<float> resultScalars(count);
+	FVec3SoA resultSoa{ count };
+
+	BENCHMARK(BenchmarkName("Normalize", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = vectors[i].Normalize();
+		return result[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("Normalize(FastMath)", count))
+	{
+		for (std::size_t i = 0; i < count; i++)
+			result[i] = vectors[i].Normalize(Utilities::FastMath);
+		return result[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("Vec3SoA::Normalize", count))
+	{
+		soa.Normalize(resultSoa);
+		return resultSoa.X()[count - 1];
+	};
+
+	BENCHMARK(BenchmarkName("Vec3x8::Normalize", count))
+	{
+		for (std::size_t i = 0; i + Vec3x8::Width <= count; i += Vec3x8::Width)
+			Vec3x8::Load(&vectors[i]).Normalize().Store(&result[i]);
+		return result[count - 1].X();
+	};
+
+	BENCHMARK(BenchmarkName("DotProduct", count))
+	{
+		for (std::size_t i = 0; i + 1 < count; i++)
+			resultScalars[i] = vectors[i].DotProduct(vectors[i + 1]);
+		return resultScalars[0];
+	};
+
+	BENCHMARK(BenchmarkName("Vec3SoA::DotProduct", count))
+	{
+		soa.DotProduct(soa, resultScalars.data());
+		return resultScalars[0];
+	};
+}
@@ -0,0 +1,92 @@
+#include "Benchmark.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "../../LibMath/VertexBuffer.h"
+
+using namespace lm;
+
+/* -----
+The bulk operations of VertexBuffer in both layouts, the transform against a Mat4 * Vec4
+loop over a Vertex array. Normals and bounds are recomputed on a grid mesh.
+----- */
+
+TEST_CASE("VertexBuffer", "[benchmark][mesh][vertexbuffer]")
+{
+	const std::size_t count = BENCHMARK_BATCH_SIZE();
+
+	// a square grid of about count vertices
+	std::uint32_t size = 1;
+	while ((size + 2) * (size + 2) <= count)
+		size++;
+
+	std::vector<Vertex> vertices;
+	for (std::uint32_t z = 0; z <= size; z++)
+		for (std::uint32_t x = 0; x <= size; x++)
+		{
+			const std::size_t i = vertices.size();
+			vertices.emplace_back(FVec3(float(x), BenchmarkValue(i, -1.f, 1.f), float(z)), FVec3(0.f, 1.f, 0.f));
+		}
+
+	std::vector<std::uint32_t> indices;
+	for (std::uint32_t z = 0; z < size; z++)
+		for (std::uint32_t x = 0; x < size; x++)
+		{
+			const std::uint32_t corner = z * (size + 1) + x;
+			for (const std::uint32_t index : { corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2 })
+				indices.push_back(index);
+		}
+
+	const FMat4 matrix = FMat4::yRotation(.3f) * FMat4::Translation(FVec3(1.f, 2.f, 3.f));
+	const FMat4 normalMatrix = matrix.Inverse().Transpose();
+
+	VertexBuffer interleaved(vertices.data(), vertices.size());
+	VertexBuffer deinterleaved(vertices.data(), vertices.size(), VertexLayout::Deinterleaved);
+
+	BENCHMARK(BenchmarkName("Vertex Mat4 * Vec4 loop", vertices.size()))
+	{
+		for (Vertex& vertex : vertices)
+		{
+			const FVec4 position = matrix * FVec4(vertex.GetPosition(), 1.f);
+			const FVec4 normal = normalMatrix * FVec4(vertex.GetNormal(), 0.f);
+			vertex.GetPosition() = FVec3(position.X(), position.Y(), position.Z());
+			vertex.GetNormal() = FVec3(normal.X(), normal.Y(), normal.Z()).Normalize();
+		}
+		return vertices[0].GetPosition().X();
+	};
+
+	BENCHMARK(BenchmarkName("Transform interleaved", vertices.size()))
+	{
+		interleaved.Transform(matrix, 1);
+		return interleaved.GetPositions()[0].X();
+	};
+
+	BENCHMARK(BenchmarkName("Transform deinterleaved", vertices.size()))
+	{
+		deinterleaved.Transform(matrix, 1);
+		return deinterleaved.GetPositions()[0].X();
+	};
+
+	BENCHMARK(BenchmarkName("RecomputeNormals interleaved", vertices.size()))
+	{
+		interleaved.RecomputeNormals(indices.data(), indices.size());
+		return interleaved.GetNormals()[0].Y();
+	};
+
+	BENCHMARK(BenchmarkName("RecomputeNormals deinterleaved", vertices.size()))
+	{
+		deinterleaved.RecomputeNormals(indices.data(), indices.size());
+		return deinterleaved.GetNormals()[0].Y();
+	};
+
+	BENCHMARK(BenchmarkName("GetBounds interleaved", vertices.size()))
+	{
+		return interleaved.GetBounds();
+	};
+
+	BENCHMARK(BenchmarkName("GetBounds deinterleaved", vertices.size()))
+	{
+		return deinterleaved.GetBounds();
+	};
+}
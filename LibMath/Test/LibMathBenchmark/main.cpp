@@ -0,0 +1,32 @@
+#include <catch2/catch_session.hpp>
+
+#include <vector>
+
+/*
+* Benchmark target, every test case here is a set of Catch2 BENCHMARKs run for each batch size
+* of Benchmark.h.
+*
+* usage
+*
+* LibMathBenchmark                                        run everything, console output
+* LibMathBenchmark "[matrix]"                             run a single group (matrix, vector, quaternion)
+* LibMathBenchmark --reporter json::out=results.json      machine readable results (see Reporters.cpp)
+* LibMathBenchmark --reporter console --reporter csv::out=results.csv
+* LibMathBenchmark --benchmark-samples 20                 quicker, less precise run
+* LibMathBenchmark "[large]" --benchmark-samples 10       production sized meshes, hidden by default
+*/
+
+int main(int argc, char* argv[])
+{
+	std::vector<char const*> arguments;
+	for (int i = 0; i < argc; i++)
+	{
+		arguments.push_back(argv[i]);
+	}
+
+	// no test spec given: run every benchmark
+	if (argc == 1)
+		arguments.push_back("[benchmark]");
+
+	return Catch::Session().run((int)arguments.size(), &arguments[0]);
+}
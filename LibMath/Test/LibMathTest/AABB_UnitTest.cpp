@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/AABB.h"
+#include "../../LibMath/Transform.h"
+#include "../../LibMath/Vertex.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace lm;
+
+static FVec3 MakePoint(const std::size_t pIndex)
+{
+	const float t = float(pIndex);
+	return FVec3(10.f * std::sin(.7f * t), 5.f * std::cos(1.3f * t) - 2.f, 3.f * std::sin(.2f * t) + .01f * t);
+}
+
+// one point at a time, the reference of the SIMD reductions
+static FAABB MergedPoints(const std::vector<FVec3>& pPoints, const std::size_t pCount)
+{
+	FAABB box;
+	for (std::size_t i = 0; i < pCount; i++)
+		box.MergeSelf(pPoints[i]);
+	return box;
+}
+
+// the eight corners through the matrix
+static FAABB TransformedCorners(const FAABB& pBox, const FMat4& pMatrix)
+{
+	FAABB box;
+	for (int corner = 0; corner < 8; corner++)
+	{
+		const FVec4 point = pMatrix * FVec4(corner & 1 ? pBox.mMax.X() : pBox.mMin.X(), corner & 2 ? pBox.mMax.Y() : pBox.mMin.Y(),
+			corner & 4 ? pBox.mMax.Z() : pBox.mMin.Z(), 1.f);
+		box.MergeSelf(FVec3(point.X(), point.Y(), point.Z()));
+	}
+	return box;
+}
+
+TEST_CASE("AABB", "[.all][bounds][AABB]")
+{
+	const FAABB box(FVec3(-1.f, 0.f, 2.f), FVec3(3.f, 2.f, 3.f));
+
+	SECTION("Instantiation")
+	{
+		CHECK(FAABB().IsEmpty());
+		CHECK_FALSE(box.IsEmpty());
+		CHECK(FAABB::FromCenterExtents(FVec3(1.f, 1.f, 2.5f), FVec3(2.f, 1.f, .5f)) == box);
+		CHECK(FAABB().Merge(FVec3(1.f, 2.f, 3.f)) == FAABB(FVec3(1.f, 2.f, 3.f), FVec3(1.f, 2.f, 3.f)));
+		CHECK(FAABB().Merge(box) == box);
+		CHECK(FAABB::FromPoints(nullptr, 0).IsEmpty());
+	}
+
+	SECTION("Functionality")
+	{
+		CHECK(box.GetCenter() == FVec3(1.f, 1.f, 2.5f));
+		CHECK(box.GetExtents() == FVec3(2.f, 1.f, .5f));
+		CHECK(box.GetSize() == FVec3(4.f, 2.f, 1.f));
+		CHECK(box.SurfaceArea() == Catch::Approx(2.f * (8.f + 2.f + 4.f)));
+		CHECK(box.Volume() == Catch::Approx(8.f));
+		CHECK(FAABB().SurfaceArea() == 0.f);
+		CHECK(FAABB().Volume() == 0.f);
+
+		CHECK(box.Contains(FVec3(3.f, 0.f, 2.5f)));
+		CHECK_FALSE(box.Contains(FVec3(3.1f, 0.f, 2.5f)));
+		CHECK(box.Contains(FAABB(FVec3(0.f, 0.f, 2.f), FVec3(1.f, 1.f, 2.f))));
+		CHECK_FALSE(box.Contains(FAABB(FVec3(0.f, 0.f, 2.f), FVec3(1.f, 1.f, 4.f))));
+		CHECK_FALSE(box.Contains(FAABB()));
+
+		const FAABB other(FVec3(2.f, 1.f, -5.f), FVec3(6.f, 1.5f, 2.5f));
+		CHECK(box.Intersects(other));
+		CHECK(box.Intersection(other) == FAABB(FVec3(2.f, 1.f, 2.f), FVec3(3.f, 1.5f, 2.5f)));
+		CHECK(box.Merge(other) == FAABB(FVec3(-1.f, 0.f, -5.f), FVec3(6.f, 2.f, 3.f)));
+		CHECK(box.Intersects(FAABB(FVec3(3.f, 2.f, 3.f), FVec3(4.f, 4.f, 4.f))));
+		CHECK_FALSE(box.Intersects(FAABB(FVec3(3.1f, 0.f, 2.f), FVec3(4.f, 4.f, 4.f))));
+		CHECK_FALSE(box.Intersects(FAABB()));
+		CHECK(box.Intersection(FAABB(FVec3(5.f), FVec3(6.f))).IsEmpty());
+	}
+
+	SECTION("FromPoints")
+	{
+		std::vector<FVec3> points;
+		std::vector<Vertex> vertices;
+		for (std::size_t i = 0; i < 1003; i++)
+		{
+			points.push_back(MakePoint(i));
+			vertices.emplace_back(MakePoint(i), FVec3(100.f, -100.f, 100.f));
+		}
+
+		for (const std::size_t count : { 1, 2, 3, 4, 5, 7, 8, 13, 64, 1003 })
+		{
+			const FAABB expected = MergedPoints(points, count);
+			CHECK(FAABB::FromPoints(points.data(), count) == expected);
+			CHECK(FAABB::FromPoints(&vertices[0].GetPosition(), count, sizeof(Vertex)) == expected);
+
+			FVec3SoA soa;
+			for (std::size_t i = 0; i < count; i++)
+				soa.PushBack(points[i]);
+			CHECK(FAABB::FromPoints(soa) == expected);
+		}
+
+		std::vector<DVec3> doubles;
+		DAABB expected;
+		for (std::size_t i = 0; i < 101; i++)
+		{
+			doubles.emplace_back(MakePoint(i).X(), MakePoint(i).Y(), MakePoint(i).Z());
+			expected.MergeSelf(doubles.back());
+		}
+		CHECK(DAABB::FromPoints(doubles.data(), doubles.size()) == expected);
+	}
+
+	SECTION("Transformation")
+	{
+		const FTransform transform(FVec3(3.f, -1.f, .5f), FQuat::RotationAxis(.8f, FVec3(1.f, -2.f, .5f)), FVec3(2.f, .5f, 1.5f));
+		const FMat4 matrix = transform.ToMat4();
+
+		// a box around the transformed box, touching it: the corners give the same bounds
+		CHECK(box.Transform(matrix).ApproxEqual(TransformedCorners(box, matrix), 1e-5f, 1e-5f));
+		CHECK(box.Transform(FMat4::mIdentity) == box);
+		CHECK(FAABB().Transform(matrix).IsEmpty());
+
+		const DAABB boxDouble(DVec3(-1., 0., 2.), DVec3(3., 2., 3.));
+		const DMat4 matrixDouble = DTransform(DVec3(3., -1., .5), DQuat::RotationAxis(.8, DVec3(1., -2., .5)), DVec3(2., .5, 1.5)).ToMat4();
+		const DAABB transformedDouble = boxDouble.Transform(matrixDouble);
+		const FAABB transformed = box.Transform(matrix);
+		CHECK(transformedDouble.mMin.X() == Catch::Approx(transformed.mMin.X()).margin(1e-5));
+		CHECK(transformedDouble.mMax.Z() == Catch::Approx(transformed.mMax.Z()).margin(1e-5));
+
+		// more boxes than a thread range, split over 4 threads
+		const std::size_t count = 2 * Parallel::mMinElementsPerThread + 5;
+		std::vector<FAABB> boxes, result(count);
+		std::vector<FMat4> matrices;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			boxes.push_back(FAABB::FromCenterExtents(MakePoint(i), FVec3(.5f + float(i % 3))));
+			matrices.push_back(FTransform(MakePoint(i + 1), FQuat::RotationAxis(float(i), FVec3(0.f, 1.f, 1.f))).ToMat4());
+		}
+		TransformBoxes(boxes.data(), matrices.data(), count, result.data(), 4);
+
+		bool same = true;
+		for (std::size_t i = 0; i < count; i++)
+			same = same && result[i] == boxes[i].Transform(matrices[i]);
+		CHECK(same);
+	}
+}
@@ -0,0 +1,271 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/BVH.h"
+#include "MeshGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace lm;
+
+namespace
+{
+	struct Mesh
+	{
+		std::vector<FVec3> mPositions;
+		std::vector<std::uint32_t> mIndices;
+		std::vector<FAABB> mBounds;
+
+		std::size_t TriangleCount() const
+		{
+			return this->mIndices.size() / 3;
+		}
+	};
+}
+
+// pSize x pSize quads of a bumpy height field, two triangles each
+static Mesh MakeTerrain(const std::uint32_t pSize)
+{
+	std::vector<Vertex> vertices;
+	Mesh mesh;
+	mesh.mIndices = AppendGrid(vertices, pSize, [](const float pX, const float pZ) { return 3.f * std::sin(.3f * pX) * std::cos(.2f * pZ); });
+	for (const Vertex& vertex : vertices)
+		mesh.mPositions.push_back(vertex.GetPosition());
+
+	mesh.mBounds.resize(mesh.TriangleCount());
+	TriangleBounds(mesh.mPositions.data(), mesh.mIndices.data(), mesh.TriangleCount(), mesh.mBounds.data());
+	return mesh;
+}
+
+// Moller-Trumbore, the primitive test given to the traversals
+static bool HitTriangle(const Mesh& pMesh, const FRay& pRay, const std::uint32_t pTriangle, float& pDistance)
+{
+	const FVec3& a = pMesh.mPositions[pMesh.mIndices[3 * pTriangle]];
+	const FVec3 edge1 = pMesh.mPositions[pMesh.mIndices[3 * pTriangle + 1]] - a;
+	const FVec3 edge2 = pMesh.mPositions[pMesh.mIndices[3 * pTriangle + 2]] - a;
+
+	const FVec3 p = pRay.GetDirection().CrossProduct(edge2);
+	const float determinant = edge1.DotProduct(p);
+	if (std::abs(determinant) < 1e-12f)
+		return false;
+
+	const float inverse = 1.f / determinant;
+	const FVec3 s = pRay.GetOrigin() - a;
+	const float u = s.DotProduct(p) * inverse;
+	const FVec3 q = s.CrossProduct(edge1);
+	const float v = pRay.GetDirection().DotProduct(q) * inverse;
+	const float t = edge2.DotProduct(q) * inverse;
+	if (u < 0.f || v < 0.f || u + v > 1.f || t < 0.f || t >= pDistance)
+		return false;
+
+	pDistance = t;
+	return true;
+}
+
+static FRay MakeRay(const std::size_t pIndex, const float pSize)
+{
+	const float t = float(pIndex);
+	const FVec3 origin(pSize * (.5f + .45f * std::sin(1.7f * t)), 6.f + 4.f * std::sin(.3f * t), pSize * (.5f + .45f * std::cos(2.3f * t)));
+	const FVec3 direction(std::sin(.9f * t), -.2f - .8f * float(pIndex % 5) / 4.f, std::cos(1.1f * t));
+	return FRay(origin, direction);
+}
+
+static std::vector<std::uint32_t> Sorted(std::vector<std::uint32_t> pValues)
+{
+	std::sort(pValues.begin(), pValues.end());
+	return pValues;
+}
+
+static bool IsSubset(const std::vector<std::uint32_t>& pSorted, const std::vector<std::uint32_t>& pSortedSuperset)
+{
+	return std::includes(pSortedSuperset.begin(), pSortedSuperset.end(), pSorted.begin(), pSorted.end());
+}
+
+TEST_CASE("BVH", "[.all][bounds][BVH]")
+{
+	const Mesh mesh = MakeTerrain(40);
+
+	FBVH bvh;
+	bvh.Build(mesh.mBounds.data(), mesh.TriangleCount(), 4, 1);
+	const FBVH4 bvh4(bvh);
+	const FBVH8 bvh8(bvh);
+
+	SECTION("Build")
+	{
+		REQUIRE(bvh.GetPrimitiveCount() == mesh.TriangleCount());
+		CHECK(bvh.GetBounds() == FAABB::FromPoints(mesh.mPositions.data(), mesh.mPositions.size()));
+
+		// every primitive in exactly one leaf, leaves within the size limit, children inside parents
+		std::vector<std::uint32_t> seen(mesh.TriangleCount(), 0);
+		std::size_t leaves = 0;
+		bool contained = true;
+		for (std::size_t i = 0; i < bvh.GetNodeCount(); i++)
+		{
+			const FBVH::Node& node = bvh.GetNodes()[i];
+			if (node.IsLeaf())
+			{
+				leaves++;
+				CHECK(node.mCount <= 4);
+				for (std::uint32_t j = node.mLeftFirst; j < node.mLeftFirst + node.mCount; j++)
+				{
+					seen[bvh.GetIndices()[j]]++;
+					contained = contained && node.GetBounds().Contains(mesh.mBounds[bvh.GetIndices()[j]]);
+				}
+			}
+			else
+				for (const std::uint32_t child : { node.mLeftFirst, node.mLeftFirst + 1 })
+					contained = contained && child > i && node.GetBounds().Contains(bvh.GetNodes()[child].GetBounds());
+		}
+		CHECK(contained);
+		CHECK(std::all_of(seen.begin(), seen.end(), [](const std::uint32_t pCount) { return pCount == 1; }));
+		CHECK(bvh.GetNodeCount() == 2 * leaves - 1);
+
+		CHECK(bvh4.GetNodeCount() < bvh.GetNodeCount() / 3);
+		CHECK(bvh8.GetNodeCount() < bvh4.GetNodeCount());
+
+		// identical centroids cannot be separated, large ranges are halved anyway
+		const std::vector<FAABB> stacked(100, FAABB(FVec3(0.f), FVec3(1.f)));
+		FBVH degenerate;
+		degenerate.Build(stacked.data(), stacked.size(), 8, 1);
+		for (std::size_t i = 0; i < degenerate.GetNodeCount(); i++)
+			CHECK(degenerate.GetNodes()[i].mCount <= 8);
+
+		// each box 32 times further than the previous one: the binning peels one per level, the median
+		// splits taking over at half the maximum depth still stop at the leaf size
+		std::vector<AABB<double>> spread;
+		for (int i = 0; i < 100; i++)
+			spread.emplace_back(Vec3<double>(std::pow(32., i), 0., 0.), Vec3<double>(std::pow(32., i) + 1., 1., 1.));
+		BVH<double> deep;
+		deep.Build(spread.data(), spread.size(), 8, 1);
+		std::size_t deepLeaves = 0;
+		for (std::size_t i = 0; i < deep.GetNodeCount(); i++)
+			if (deep.GetNodes()[i].IsLeaf())
+			{
+				deepLeaves++;
+				CHECK(deep.GetNodes()[i].mCount <= 8);
+			}
+		CHECK(deepLeaves < 50);
+
+		FBVH empty;
+		empty.Build(nullptr, 0);
+		float distance = 10.f;
+		CHECK(empty.GetNodeCount() == 0);
+		CHECK_FALSE(empty.Raycast(FRay(FVec3(0.f), FVec3(1.f, 0.f, 0.f)), distance, [](std::uint32_t, float&) { return true; }));
+		CHECK_FALSE(FBVH4(empty).Raycast(FRay(FVec3(0.f), FVec3(1.f, 0.f, 0.f)), distance, [](std::uint32_t, float&) { return true; }));
+	}
+
+	SECTION("Raycast")
+	{
+		std::size_t hits = 0;
+		for (std::size_t i = 0; i < 500; i++)
+		{
+			const FRay ray = MakeRay(i, 40.f);
+
+			float expected = 100.f;
+			std::uint32_t expectedTriangle = 0;
+			for (std::uint32_t triangle = 0; triangle < mesh.TriangleCount(); triangle++)
+				if (HitTriangle(mesh, ray, triangle, expected))
+					expectedTriangle = triangle;
+
+			float distances[3] = { 100.f, 100.f, 100.f };
+			std::uint32_t triangles[3] = {};
+			const bool hit = bvh.Raycast(ray, distances[0], [&](const std::uint32_t pTriangle, float& pDistance)
+				{
+					return HitTriangle(mesh, ray, pTriangle, pDistance) && (triangles[0] = pTriangle, true);
+				});
+			bvh4.Raycast(ray, distances[1], [&](const std::uint32_t pTriangle, float& pDistance)
+				{
+					return HitTriangle(mesh, ray, pTriangle, pDistance) && (triangles[1] = pTriangle, true);
+				});
+			bvh8.Raycast(ray, distances[2], [&](const std::uint32_t pTriangle, float& pDistance)
+				{
+					return HitTriangle(mesh, ray, pTriangle, pDistance) && (triangles[2] = pTriangle, true);
+				});
+
+			CHECK(hit == (expected < 100.f));
+			hits += hit;
+			for (int tree = 0; tree < 3; tree++)
+			{
+				CHECK(distances[tree] == Catch::Approx(expected).epsilon(1e-6));
+				if (expected < 100.f)
+					CHECK(triangles[tree] == expectedTriangle);
+			}
+		}
+		CHECK(hits > 250);
+	}
+
+	SECTION("Query")
+	{
+		for (std::size_t i = 0; i < 50; i++)
+		{
+			const float t = float(i);
+			const FVec3 center(20.f + 18.f * std::sin(t), 2.f * std::cos(t), 20.f + 18.f * std::cos(.7f * t));
+			const float radius = .5f + float(i % 4);
+			const FAABB box = FAABB::FromCenterExtents(center, FVec3(radius, .5f * radius, 1.f));
+
+			std::vector<std::uint32_t> inSphere, inBox;
+			for (std::uint32_t triangle = 0; triangle < mesh.TriangleCount(); triangle++)
+			{
+				if (mesh.mBounds[triangle].SquaredDistance(center) <= radius * radius)
+					inSphere.push_back(triangle);
+				if (mesh.mBounds[triangle].Intersects(box))
+					inBox.push_back(triangle);
+			}
+
+			std::vector<std::uint32_t> spheres[3], boxes[3];
+			bvh.QuerySphere(center, radius, [&](const std::uint32_t pTriangle) { spheres[0].push_back(pTriangle); });
+			bvh4.QuerySphere(center, radius, [&](const std::uint32_t pTriangle) { spheres[1].push_back(pTriangle); });
+			bvh8.QuerySphere(center, radius, [&](const std::uint32_t pTriangle) { spheres[2].push_back(pTriangle); });
+			bvh.QueryBox(box, [&](const std::uint32_t pTriangle) { boxes[0].push_back(pTriangle); });
+			bvh4.QueryBox(box, [&](const std::uint32_t pTriangle) { boxes[1].push_back(pTriangle); });
+			bvh8.QueryBox(box, [&](const std::uint32_t pTriangle) { boxes[2].push_back(pTriangle); });
+
+			// candidates: every overlapping primitive once, plus their leaf neighbours
+			for (int tree = 0; tree < 3; tree++)
+			{
+				const std::vector<std::uint32_t> sphere = Sorted(spheres[tree]);
+				const std::vector<std::uint32_t> boxed = Sorted(boxes[tree]);
+				CHECK(IsSubset(inSphere, sphere));
+				CHECK(IsSubset(inBox, boxed));
+				CHECK(std::adjacent_find(sphere.begin(), sphere.end()) == sphere.end());
+				CHECK(std::adjacent_find(boxed.begin(), boxed.end()) == boxed.end());
+				CHECK(sphere.size() <= inSphere.size() + 64);
+			}
+			CHECK(Sorted(spheres[0]) == Sorted(spheres[1]));
+			CHECK(Sorted(boxes[0]) == Sorted(boxes[2]));
+		}
+	}
+
+	SECTION("Threads")
+	{
+		const Mesh terrain = MakeTerrain(130);
+		REQUIRE(terrain.TriangleCount() >= 2 * Parallel::mMinElementsPerThread);
+
+		FBVH serial, threaded;
+		serial.Build(terrain.mBounds.data(), terrain.TriangleCount(), 4, 1);
+		threaded.Build(terrain.mBounds.data(), terrain.TriangleCount(), 4, 4);
+
+		// the same splits, only the node order differs
+		CHECK(threaded.GetNodeCount() == serial.GetNodeCount());
+		CHECK(std::equal(serial.GetIndices(), serial.GetIndices() + serial.GetPrimitiveCount(), threaded.GetIndices()));
+
+		for (std::size_t i = 0; i < 200; i++)
+		{
+			const FRay ray = MakeRay(i, 130.f);
+			float serialDistance = 1000.f, threadedDistance = 1000.f;
+			serial.Raycast(ray, serialDistance, [&](const std::uint32_t pTriangle, float& pDistance)
+				{
+					return HitTriangle(terrain, ray, pTriangle, pDistance);
+				});
+			threaded.Raycast(ray, threadedDistance, [&](const std::uint32_t pTriangle, float& pDistance)
+				{
+					return HitTriangle(terrain, ray, pTriangle, pDistance);
+				});
+			CHECK(threadedDistance == Catch::Approx(serialDistance).epsilon(1e-6));
+		}
+	}
+}
@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/DualQuaternion.h"
+
+using namespace lm;
+
+#define CHECK_DUAL_VEC3(vector, expected)				  \
+CHECK((vector).X() == Catch::Approx((expected).X()).margin(1e-5)); \
+CHECK((vector).Y() == Catch::Approx((expected).Y()).margin(1e-5)); \
+CHECK((vector).Z() == Catch::Approx((expected).Z()).margin(1e-5))
+
+static FVec3 Transformed(const FMat4& pMatrix, const FVec3& pPoint)
+{
+	const FVec4 result = pMatrix * FVec4(pPoint, 1.f);
+	return FVec3(result.X(), result.Y(), result.Z());
+}
+
+TEST_CASE("DualQuaternion", "[.all][quaternion][DualQuaternion]")
+{
+	const FQuat rotation = FQuat::RotationAxis(1.1f, FVec3(1.f, 2.f, -.5f));
+	const FVec3 translation(3.f, -1.f, .5f);
+	const FDualQuat transform(rotation, translation);
+
+	const FDualQuat other(FQuat::RotationAxis(-2.4f, FVec3(0.f, 1.f, 1.f)), FVec3(-2.f, 4.f, 1.f));
+	const FVec3 point(.5f, -2.f, 1.5f);
+
+	SECTION("Instantiation")
+	{
+		CHECK(FDualQuat() == FDualQuat(FQuat(), FQuat()));
+		CHECK(FDualQuat::mIdentity.TransformPoint(point) == point);
+
+		CHECK(transform.GetRotation() == rotation);
+		CHECK_DUAL_VEC3(transform.GetTranslation(), translation);
+
+		constexpr FDualQuat moved(FQuat(0.f, 0.f, 0.f, 1.f), FVec3(1.f, 2.f, 3.f));
+		STATIC_REQUIRE(moved.GetTranslation().Y() == 2.f);
+		STATIC_REQUIRE(moved.TransformPoint(FVec3(1.f, 1.f, 1.f)).Z() == 4.f);
+	}
+
+	SECTION("Transform")
+	{
+		// rotation then translation
+		FQuat rotate = rotation;
+		CHECK_DUAL_VEC3(transform.TransformPoint(point), rotate * point + translation);
+		CHECK_DUAL_VEC3(transform.TransformDirection(point), rotate * point);
+		CHECK_DUAL_VEC3(Transformed(transform.ToMat4(), point), transform.TransformPoint(point));
+	}
+
+	SECTION("Arithmetic")
+	{
+		// a * b applies b first, the reverse of the row-vector matrix product
+		const FDualQuat product = transform * other;
+		CHECK_DUAL_VEC3(product.TransformPoint(point), transform.TransformPoint(other.TransformPoint(point)));
+		CHECK_DUAL_VEC3(product.TransformPoint(point), Transformed(other.ToMat4() * transform.ToMat4(), point));
+
+		const FDualQuat identity = transform * transform.Conjugate();
+		CHECK(identity.ApproxEqual(FDualQuat::mIdentity, 1e-6f));
+
+		const FDualQuat scaled = transform * 3.f;
+		const FDualQuat normalized = scaled.Normalize();
+		CHECK(normalized.ApproxEqual(transform, 1e-6f));
+		CHECK(normalized.mReal.DotProduct(normalized.mDual) == Catch::Approx(0.f).margin(1e-6));
+
+		FDualQuat self = scaled;
+		self.NormalizeSelf();
+		CHECK(self.ApproxEqual(normalized, 1e-7f));
+	}
+
+	SECTION("Sclerp")
+	{
+		CHECK(FDualQuat::Sclerp(transform, other, 0.f).ApproxEqual(transform, 1e-5f));
+
+		const FDualQuat end = FDualQuat::Sclerp(transform, other, 1.f);
+		CHECK_DUAL_VEC3(end.TransformPoint(point), other.TransformPoint(point));
+
+		// constant screw motion: two half steps land on the end
+		const FDualQuat half = FDualQuat::Sclerp(FDualQuat::mIdentity, other, .5f);
+		CHECK_DUAL_VEC3((half * half).TransformPoint(point), other.TransformPoint(point));
+
+		// the rotation follows Slerp
+		const FDualQuat quarter = FDualQuat::Sclerp(FDualQuat::mIdentity, other, .25f);
+		CHECK(quarter.mReal.ApproxEqual(FQuat::Slerp(FQuat(0.f, 0.f, 0.f, 1.f), other.mReal, .25f), 1e-5f));
+
+		// pure translation
+		const FDualQuat moved(FQuat(0.f, 0.f, 0.f, 1.f), FVec3(4.f, 0.f, -2.f));
+		CHECK_DUAL_VEC3(FDualQuat::Sclerp(FDualQuat::mIdentity, moved, .25f).GetTranslation(), FVec3(1.f, 0.f, -.5f));
+	}
+
+	SECTION("Blend")
+	{
+		const float single = 1.f;
+		CHECK(FDualQuat::Blend(&transform, &single, 1).ApproxEqual(transform, 1e-6f));
+
+		// q and -q are the same transform, the blend must not cancel them
+		const FDualQuat pair[2] = { transform, transform * -1.f };
+		const float weights[2] = { .5f, .5f };
+		CHECK(FDualQuat::Blend(pair, weights, 2).ApproxEqual(transform, 1e-6f));
+
+		// twisting both ways around an axis keeps the point at its distance from the axis
+		const FDualQuat twist[2] = { FDualQuat(FQuat::RotationAxis(1.5f, FVec3(1.f, 0.f, 0.f)), FVec3()),
+			FDualQuat(FQuat::RotationAxis(-1.5f, FVec3(1.f, 0.f, 0.f)), FVec3()) };
+		const FVec3 blended = FDualQuat::Blend(twist, weights, 2).TransformPoint(FVec3(0.f, 1.f, 0.f));
+		CHECK(blended.Length() == Catch::Approx(1.f));
+
+		// an unweighted input opposite to one of the twists does not pick the hemisphere
+		const FDualQuat padded[3] = { FDualQuat(FQuat::RotationAxis(3.f, FVec3(1.f, 0.f, 0.f)), FVec3()), twist[0], twist[1] };
+		const float paddedWeights[3] = { 0.f, .5f, .5f };
+		CHECK(FDualQuat::Blend(padded, paddedWeights, 3).ApproxEqual(FDualQuat::Blend(twist, weights, 2), 1e-6f));
+
+		// no weight at all gives the identity instead of a NaN
+		const float noWeights[2] = { 0.f, 0.f };
+		CHECK(FDualQuat::Blend(twist, noWeights, 2) == FDualQuat::mIdentity);
+	}
+}
@@ -0,0 +1,178 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include "../../LibMath/Quaternion.h"
+#include "../../LibMath/FastMath.h"
+
+#include <cmath>
+
+using namespace lm;
+
+// largest |error| of pFunction(x) - pReference(x) over pCount samples of [pMin, pMax]
+template <typename Function, typename Reference>
+static double MaxError(const float pMin, const float pMax, const int pCount, Function&& pFunction, Reference&& pReference)
+{
+	double maxError = 0.0;
+	for (int i = 0; i <= pCount; i++)
+	{
+		const float x = pMin + (pMax - pMin) * float(i) / float(pCount);
+		maxError = std::max(maxError, std::abs(double(pFunction(x)) - pReference(double(x))));
+	}
+	return maxError;
+}
+
+TEST_CASE("FastMath", "[.all][utilities][FastMath]")
+{
+	SECTION("SinCos")
+	{
+		const double sinError = MaxError(-8192.f, 8192.f, 1 << 20,
+			[](const float x) { float s, c; Utilities::SinCos(x, s, c); return s; },
+			[](const double x) { return std::sin(x); });
+		const double cosError = MaxError(-8192.f, 8192.f, 1 << 20,
+			[](const float x) { float s, c; Utilities::SinCos(x, s, c); return c; },
+			[](const double x) { return std::cos(x); });
+
+		CHECK(sinError <= 1e-7);
+		CHECK(cosError <= 1e-7);
+
+		float sin, cos;
+		Utilities::SinCos(0.f, sin, cos);
+		CHECK(sin == 0.f);
+		CHECK(cos == 1.f);
+
+		double sinD, cosD;
+		Utilities::SinCos(1.0, sinD, cosD);
+		CHECK(sinD == std::sin(1.0));
+		CHECK(cosD == std::cos(1.0));
+	}
+
+	SECTION("FastRsqrt")
+	{
+		double maxError = 0.0;
+		for (int exponent = -40; exponent <= 40; exponent++)
+			for (int i = 0; i < 1024; i++)
+			{
+				const float x = std::ldexp(1.f + float(i) / 1024.f, exponent);
+				maxError = std::max(maxError, std::abs(double(Utilities::FastRsqrt(x)) * std::sqrt(double(x)) - 1.0));
+			}
+
+		CHECK(maxError <= 5e-7);
+		CHECK(Utilities::FastRsqrt(4.0) == .5);
+	}
+
+	SECTION("FastAcos")
+	{
+		const double error = MaxError(-1.f, 1.f, 1 << 20,
+			[](const float x) { return Utilities::FastAcos(x); },
+			[](const double x) { return std::acos(x); });
+
+		CHECK(error <= 7e-5);
+		CHECK(Utilities::FastAcos(2.f) == Catch::Approx(0.f).margin(1e-6f));
+		CHECK(Utilities::FastAcos(-2.f) == Catch::Approx(float(M_PI)).margin(1e-6f));
+	}
+
+	SECTION("FastAtan2")
+	{
+		double maxError = 0.0;
+		for (int i = 0; i < 1 << 16; i++)
+		{
+			const double angle = -M_PI + 2.0 * M_PI * (i + .5) / double(1 << 16);
+			const float radius = 1.f + float(i % 7);
+			const float y = float(std::sin(angle)) * radius;
+			const float x = float(std::cos(angle)) * radius;
+			maxError = std::max(maxError, std::abs(Utilities::FastAtan2(y, x) - std::atan2(double(y), double(x))));
+		}
+
+		CHECK(maxError <= 2e-6);
+		CHECK(Utilities::FastAtan2(0.f, 0.f) == 0.f);
+		CHECK(Utilities::FastAtan2(1.f, 0.f) == Catch::Approx(float(M_PI / 2)));
+		CHECK(Utilities::FastAtan2(0.f, -1.f) == Catch::Approx(float(M_PI)));
+	}
+
+	SECTION("Opt-in overloads")
+	{
+		// the fast builders match the std ones within the SinCos bound
+		for (const float angle : { -725.f, -90.f, 0.f, 32.f, 108.f, 213.f, 1080.f })
+		{
+			CHECK(FMat4::xRotation(angle, Utilities::FastMath).ApproxEqual(FMat4::xRotation(angle), 2e-7f));
+			CHECK(FMat4::yRotation(angle, Utilities::FastMath).ApproxEqual(FMat4::yRotation(angle), 2e-7f));
+			CHECK(FMat4::zRotation(angle, Utilities::FastMath).ApproxEqual(FMat4::zRotation(angle), 2e-7f));
+		}
+
+		const FVec3 axis(1.f, -2.f, .5f);
+		CHECK(FQuat::RotationAxis(1.3f, axis, Utilities::FastMath).ApproxEqual(FQuat::RotationAxis(1.3f, axis), 1e-6f));
+		CHECK(FQuat::RotationAxis(-4.f, axis, Utilities::FastMath).ApproxEqual(FQuat::RotationAxis(-4.f, axis), 1e-6f));
+
+		CHECK(FVec2(3.f, -4.f).Normalize(Utilities::FastMath).ApproxEqual(FVec2(3.f, -4.f).Normalize(), 1e-6f));
+		CHECK(axis.Normalize(Utilities::FastMath).ApproxEqual(axis.Normalize(), 1e-6f));
+		CHECK(FVec4(1.f, 2.f, -3.f, 4.f).Normalize(Utilities::FastMath).ApproxEqual(FVec4(1.f, 2.f, -3.f, 4.f).Normalize(), 1e-6f));
+		CHECK(FQuat(1.f, 2.f, -3.f, 4.f).Normalize(Utilities::FastMath).ApproxEqual(FQuat(1.f, 2.f, -3.f, 4.f).Normalize(), 1e-6f));
+		CHECK(DVec3(1.0, -2.0, .5).Normalize(Utilities::FastMath) == DVec3(1.0, -2.0, .5).Normalize());
+	}
+}
+
+TEMPLATE_TEST_CASE("FastMathPacket", "[.all][utilities][FastMathPacket]", Simd::Float4, Simd::Float8)
+{
+	constexpr std::size_t width = TestType::Width;
+
+	// every lane is held to the same bound as the scalar form
+	float input[width];
+	float other[width];
+	for (std::size_t i = 0; i < width; i++)
+	{
+		input[i] = -1.f + 2.f * float(i) / float(width - 1);
+		other[i] = .75f - .3f * float(i);
+	}
+
+	const TestType x = TestType::Load(input);
+	const TestType y = TestType::Load(other);
+	float result[width];
+	float second[width];
+
+	SECTION("SinCos")
+	{
+		float angle[width];
+		for (std::size_t i = 0; i < width; i++)
+			angle[i] = input[i] * 1000.f;
+
+		TestType sin, cos;
+		Utilities::SinCos(TestType::Load(angle), sin, cos);
+		sin.Store(result);
+		cos.Store(second);
+
+		for (std::size_t i = 0; i < width; i++)
+		{
+			CHECK(std::abs(result[i] - std::sin(double(angle[i]))) <= 1e-7);
+			CHECK(std::abs(second[i] - std::cos(double(angle[i]))) <= 1e-7);
+		}
+	}
+
+	SECTION("FastRsqrt")
+	{
+		Utilities::FastRsqrt(y * y + TestType::Splat(.01f)).Store(result);
+
+		for (std::size_t i = 0; i < width; i++)
+			CHECK(std::abs(result[i] * std::sqrt(double(other[i]) * other[i] + .01) - 1.0) <= 5e-7);
+	}
+
+	SECTION("FastAcos")
+	{
+		Utilities::FastAcos(x).Store(result);
+
+		for (std::size_t i = 0; i < width; i++)
+			CHECK(std::abs(result[i] - std::acos(double(input[i]))) <= 7e-5);
+	}
+
+	SECTION("FastAtan2")
+	{
+		Utilities::FastAtan2(y, x).Store(result);
+		Utilities::FastAtan2(TestType::Splat(0.f), TestType::Splat(0.f)).Store(second);
+
+		for (std::size_t i = 0; i < width; i++)
+		{
+			CHECK(std::abs(result[i] - std::atan2(double(other[i]), double(input[i]))) <= 2e-6);
+			CHECK(second[i] == 0.f);
+		}
+	}
+}
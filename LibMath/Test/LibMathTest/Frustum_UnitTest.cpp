@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/Frustum.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace lm;
+
+static bool VisibleBit(const std::vector<std::uint64_t>& pVisible, const std::size_t pIndex)
+{
+	return (pVisible[pIndex / 64] >> (pIndex % 64) & 1) != 0;
+}
+
+TEST_CASE("Frustum", "[.all][culling][Frustum]")
+{
+	SECTION("Plane")
+	{
+		const FPlane plane = FPlane::FromPoints(FVec3(0.f, 2.f, 0.f), FVec3(1.f, 2.f, 0.f), FVec3(0.f, 2.f, -1.f));
+		CHECK(plane.ApproxEqual(FPlane(FVec3(0.f, 1.f, 0.f), -2.f)));
+		CHECK(plane.SignedDistance(FVec3(5.f, 5.f, 5.f)) == Catch::Approx(3.f));
+		CHECK(plane.SignedDistance(FVec3(0.f, -1.f, 0.f)) == Catch::Approx(-3.f));
+
+		const FPlane scaled = FPlane(FVec3(0.f, 0.f, 4.f), 8.f).Normalize();
+		CHECK(scaled.ApproxEqual(FPlane(FVec3(0.f, 0.f, 1.f), 2.f)));
+		CHECK(FPlane::FromPointNormal(FVec3(0.f, 0.f, -2.f), FVec3(0.f, 0.f, 1.f)).ApproxEqual(scaled));
+		CHECK(scaled != plane);
+	}
+
+	SECTION("Extraction")
+	{
+		// 90 degrees, square: the side planes are x = +-z and y = +-z in view space
+		const FFrustum frustum(FMat4::PerspectiveRH(90.f, 1.f, 1.f, 100.f));
+		CHECK(frustum.mPlanes[FFrustum::Near].ApproxEqual(FPlane(FVec3(0.f, 0.f, -1.f), -1.f), 1e-5f));
+		CHECK(frustum.mPlanes[FFrustum::Far].ApproxEqual(FPlane(FVec3(0.f, 0.f, 1.f), 100.f), 1e-4f, 1e-5f));
+		CHECK(frustum.mPlanes[FFrustum::Right].mNormal.ApproxEqual(FVec3(-1.f, 0.f, -1.f).Normalize(), 1e-5f));
+
+		CHECK(frustum.ContainsPoint(FVec3(0.f, 0.f, -10.f)));
+		CHECK(frustum.ContainsPoint(FVec3(9.f, -9.f, -10.f)));
+		CHECK_FALSE(frustum.ContainsPoint(FVec3(0.f, 0.f, 10.f)));
+		CHECK_FALSE(frustum.ContainsPoint(FVec3(0.f, 0.f, -.5f)));
+		CHECK_FALSE(frustum.ContainsPoint(FVec3(0.f, 0.f, -101.f)));
+		CHECK_FALSE(frustum.ContainsPoint(FVec3(11.f, 0.f, -10.f)));
+
+		// (15, 0, -10) lies 5 / sqrt(2) ~ 3.54 outside the right plane
+		CHECK(frustum.IntersectsSphere(FVec3(15.f, 0.f, -10.f), 4.f));
+		CHECK_FALSE(frustum.IntersectsSphere(FVec3(15.f, 0.f, -10.f), 3.f));
+		CHECK(frustum.IntersectsBox(FVec3(0.f, 0.f, 2.f), FVec3(1.f, 1.f, 3.5f)));
+		CHECK_FALSE(frustum.IntersectsBox(FVec3(0.f, 0.f, 2.f), FVec3(1.f, 1.f, 2.5f)));
+
+		// the [0, 1] depth range gives the same volume
+		const FFrustum direct(FMat4::PerspectiveRHDirect(90.f, 1.f, 1.f, 100.f), ClipDepth::ZeroToOne);
+		for (int side = 0; side < FFrustum::SideCount; side++)
+			CHECK(direct.mPlanes[side].ApproxEqual(frustum.mPlanes[side], 1e-4f, 1e-5f));
+
+		// view * projection gives world-space planes
+		const FMat4 view = FMat4::LookAtRH(FVec3(0.f, 0.f, 50.f), FVec3(0.f, 0.f, 0.f), FVec3(0.f, 1.f, 0.f));
+		const FFrustum world(view * FMat4::PerspectiveRH(90.f, 1.f, 1.f, 100.f));
+		CHECK(world.ContainsPoint(FVec3(0.f, 0.f, 0.f)));
+		CHECK(world.ContainsPoint(FVec3(0.f, 0.f, 48.5f)));
+		CHECK_FALSE(world.ContainsPoint(FVec3(0.f, 0.f, 49.5f)));
+		CHECK_FALSE(world.ContainsPoint(FVec3(0.f, 0.f, 60.f)));
+		CHECK_FALSE(world.ContainsPoint(FVec3(60.f, 0.f, 0.f)));
+	}
+
+	SECTION("Batch")
+	{
+		const FFrustum frustum(FMat4::PerspectiveRH(70.f, 1.5f, .5f, 80.f));
+		const DFrustum frustumDouble(DMat4::PerspectiveRH(70.f, 1.5f, .5f, 80.f));
+
+		// odd count: full words, a partial word and a scalar tail
+		const std::size_t count = 1001;
+		FVec3SoA centers, extents;
+		DVec3SoA centersDouble, extentsDouble;
+		std::vector<float> radii;
+		std::vector<double> radiiDouble;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const float t = float(i);
+			const FVec3 center(60.f * std::sin(.37f * t), 40.f * std::cos(.11f * t), -50.f + 55.f * std::sin(.05f * t));
+			const FVec3 extent(.5f + float(i % 7), 1.f + float(i % 3), .25f + float(i % 5));
+			centers.PushBack(center);
+			extents.PushBack(extent);
+			radii.push_back(extent.X());
+			centersDouble.PushBack(DVec3(center.X(), center.Y(), center.Z()));
+			extentsDouble.PushBack(DVec3(extent.X(), extent.Y(), extent.Z()));
+			radiiDouble.push_back(extent.X());
+		}
+
+		std::vector<std::uint64_t> spheres((count + 63) / 64, ~std::uint64_t(0));
+		std::vector<std::uint64_t> boxes((count + 63) / 64, ~std::uint64_t(0));
+		frustum.CullSpheres(centers, radii.data(), spheres.data());
+		frustum.CullBoxes(centers, extents, boxes.data());
+
+		std::size_t sphereMismatches = 0, boxMismatches = 0, visible = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const FVec3 center(centers.X()[i], centers.Y()[i], centers.Z()[i]);
+			const FVec3 extent(extents.X()[i], extents.Y()[i], extents.Z()[i]);
+			sphereMismatches += VisibleBit(spheres, i) != frustum.IntersectsSphere(center, radii[i]);
+			boxMismatches += VisibleBit(boxes, i) != frustum.IntersectsBox(center, extent);
+			visible += VisibleBit(boxes, i);
+		}
+		CHECK(sphereMismatches == 0);
+		CHECK(boxMismatches == 0);
+		CHECK(visible > count / 10);
+		CHECK(visible < count - count / 10);
+
+		// bits past the last bound are cleared
+		CHECK((spheres.back() >> (count % 64)) == 0);
+		CHECK((boxes.back() >> (count % 64)) == 0);
+
+		// double runs the scalar path, same answers away from the plane boundaries
+		std::vector<std::uint64_t> boxesDouble((count + 63) / 64);
+		std::vector<std::uint64_t> spheresDouble((count + 63) / 64);
+		frustumDouble.CullBoxes(centersDouble, extentsDouble, boxesDouble.data());
+		frustumDouble.CullSpheres(centersDouble, radiiDouble.data(), spheresDouble.data());
+		std::size_t doubleMismatches = 0;
+		for (std::size_t i = 0; i < count; i++)
+		{
+			const DVec3 center(centersDouble.X()[i], centersDouble.Y()[i], centersDouble.Z()[i]);
+			doubleMismatches += VisibleBit(boxesDouble, i) != frustumDouble.IntersectsBox(center,
+				DVec3(extentsDouble.X()[i], extentsDouble.Y()[i], extentsDouble.Z()[i]));
+			doubleMismatches += VisibleBit(spheresDouble, i) != frustumDouble.IntersectsSphere(center, radiiDouble[i]);
+		}
+		CHECK(doubleMismatches == 0);
+
+		// empty input writes nothing
+		FVec3SoA none;
+		std::uint64_t untouched = 42;
+		frustum.CullSpheres(none, radii.data(), &untouched);
+		CHECK(untouched == 42);
+	}
+}
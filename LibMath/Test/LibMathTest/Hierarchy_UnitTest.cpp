@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/Hierarchy.h"
+
+#include <vector>
+
+using namespace lm;
+
+static FTransform MakeLocal(const std::size_t pIndex)
+{
+	const float t = float(pIndex);
+	return FTransform(FVec3(std::sin(t), 1.f, .1f * t), FQuat::RotationAxis(.3f * t, FVec3(1.f, t, 2.f)),
+		FVec3(1.f + .1f * float(pIndex % 3), 1.f, 1.f - .05f * float(pIndex % 4)));
+}
+
+// depth-first: every node gets pBranching children until pDepth
+static void AddSubtree(FHierarchy& pHierarchy, const std::size_t pParent, const std::size_t pBranching, const std::size_t pDepth)
+{
+	const std::size_t node = pHierarchy.AddNode(MakeLocal(pHierarchy.Size()), pParent);
+	if (pDepth == 0)
+		return;
+
+	for (std::size_t i = 0; i < pBranching; i++)
+		AddSubtree(pHierarchy, node, pBranching, pDepth - 1);
+}
+
+// every world recomputed from scratch with operator*
+static std::vector<FMat4> ReferenceWorlds(const FHierarchy& pHierarchy)
+{
+	std::vector<FMat4> worlds;
+	for (std::size_t i = 0; i < pHierarchy.Size(); i++)
+	{
+		const std::size_t parent = pHierarchy.GetParent(i);
+		worlds.push_back(parent == FHierarchy::mNoParent ? pHierarchy.GetLocal(i).ToMat4() :
+			pHierarchy.GetLocal(i).ToMat4() * worlds[parent]);
+	}
+	return worlds;
+}
+
+static bool WorldsMatch(const FHierarchy& pHierarchy)
+{
+	const std::vector<FMat4> reference = ReferenceWorlds(pHierarchy);
+	for (std::size_t i = 0; i < pHierarchy.Size(); i++)
+		if (pHierarchy.GetWorld(i) != reference[i])
+			return false;
+
+	return true;
+}
+
+TEST_CASE("Hierarchy", "[.all][transform][Hierarchy]")
+{
+	SECTION("Update")
+	{
+		FHierarchy hierarchy;
+		AddSubtree(hierarchy, FHierarchy::mNoParent, 3, 3);
+		AddSubtree(hierarchy, FHierarchy::mNoParent, 2, 2);
+
+		CHECK(hierarchy.Size() == 40 + 7);
+		CHECK(hierarchy.GetSubtreeEnd(0) == 40);
+		CHECK(hierarchy.GetSubtreeEnd(1) == 14);
+		CHECK(hierarchy.GetParent(40) == FHierarchy::mNoParent);
+
+		// no world matrix is computed before the first Update
+		for (std::size_t i = 0; i < hierarchy.Size(); i++)
+			CHECK_FALSE(hierarchy.WorldChanged(i));
+
+		hierarchy.Update(1);
+		CHECK(WorldsMatch(hierarchy));
+		for (std::size_t i = 0; i < hierarchy.Size(); i++)
+			CHECK(hierarchy.WorldChanged(i));
+
+		// a point goes through the local transforms from the node up to the root
+		const std::size_t leaf = 3;
+		const FVec3 point(.5f, -1.f, 2.f);
+		const FVec3 expected = hierarchy.GetLocal(0).TransformPoint(hierarchy.GetLocal(1).TransformPoint(
+			hierarchy.GetLocal(2).TransformPoint(hierarchy.GetLocal(leaf).TransformPoint(point))));
+		const FVec4 world = hierarchy.GetWorld(leaf) * FVec4(point, 1.f);
+		CHECK(world.X() == Catch::Approx(expected.X()).margin(1e-4));
+		CHECK(world.Y() == Catch::Approx(expected.Y()).margin(1e-4));
+		CHECK(world.Z() == Catch::Approx(expected.Z()).margin(1e-4));
+	}
+
+	SECTION("Dirty")
+	{
+		FHierarchy hierarchy;
+		AddSubtree(hierarchy, FHierarchy::mNoParent, 3, 3);
+		hierarchy.Update(1);
+
+		hierarchy.Update(1);
+		for (std::size_t i = 0; i < hierarchy.Size(); i++)
+			CHECK_FALSE(hierarchy.WorldChanged(i));
+
+		// only the subtree of the edited node is recomputed
+		const std::size_t node = 14;
+		hierarchy.SetLocal(node, MakeLocal(100));
+		hierarchy.SetLocal(hierarchy.GetSubtreeEnd(node) - 1, MakeLocal(200));
+		hierarchy.Update(1);
+
+		CHECK(WorldsMatch(hierarchy));
+		for (std::size_t i = 0; i < hierarchy.Size(); i++)
+			CHECK(hierarchy.WorldChanged(i) == (i >= node && i < hierarchy.GetSubtreeEnd(node)));
+
+		// nodes added after an update are picked up by the next one
+		hierarchy.AddNode(MakeLocal(300), hierarchy.GetParent(hierarchy.Size() - 1));
+		hierarchy.Update(1);
+		CHECK(WorldsMatch(hierarchy));
+		CHECK(hierarchy.WorldChanged(hierarchy.Size() - 1));
+		CHECK_FALSE(hierarchy.WorldChanged(0));
+	}
+
+	SECTION("Threads")
+	{
+		// a lone scene root above wide subtrees, alone then followed by a second root
+		for (const bool secondRoot : { false, true })
+		{
+			FHierarchy hierarchy;
+			AddSubtree(hierarchy, FHierarchy::mNoParent, 6, 5);
+			if (secondRoot)
+				AddSubtree(hierarchy, FHierarchy::mNoParent, 4, 3);
+			REQUIRE(hierarchy.Size() > 2 * Parallel::mMinElementsPerThread);
+
+			FHierarchy threaded = hierarchy;
+			hierarchy.Update(1);
+			threaded.Update(4);
+			CHECK(WorldsMatch(threaded));
+
+			for (const std::size_t node : { std::size_t(1), std::size_t(500), std::size_t(9000), hierarchy.Size() - 1 })
+			{
+				hierarchy.SetLocal(node, MakeLocal(node + 7));
+				threaded.SetLocal(node, MakeLocal(node + 7));
+			}
+			hierarchy.Update(1);
+			threaded.Update(4);
+
+			// same arithmetic per node, the split must not change a bit
+			bool same = true;
+			for (std::size_t i = 0; i < hierarchy.Size(); i++)
+				same = same && threaded.GetWorld(i) == hierarchy.GetWorld(i) &&
+					threaded.WorldChanged(i) == hierarchy.WorldChanged(i);
+			CHECK(same);
+
+			threaded.SetLocal(0, MakeLocal(1));
+			threaded.Update(4);
+			CHECK(WorldsMatch(threaded));
+			CHECK(threaded.WorldChanged(9000));
+
+			threaded.Update(4);
+			CHECK_FALSE(threaded.WorldChanged(0));
+			CHECK_FALSE(threaded.WorldChanged(9000));
+		}
+	}
+}
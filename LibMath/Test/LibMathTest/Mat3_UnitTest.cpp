@@ -3,6 +3,7 @@
 
 #include "../../LibMath/Mat3.h"
 #include <DirectXMath.h>
+#include <cstring>
 
 using namespace lm;
 using namespace DirectX;
@@ -19,12 +20,12 @@ CHECK(matrix[2][0] == Catch::Approx(matrixDir(2, 0))); \
 CHECK(matrix[2][1] == Catch::Approx(matrixDir(2, 1))); \
 CHECK(matrix[2][2] == Catch::Approx(matrixDir(2, 2)))
 
-XMMATRIX ToMatrix(const M3& pM3)
+static XMMATRIX ToMatrix(const M3& pM3)
 {
 	return XMLoadFloat3x3(&pM3);
 }
 
-M3 ToFloat(const XMMATRIX& pMatrix)
+static M3 ToFloat(const XMMATRIX& pMatrix)
 {
 	M3 m3;
 	XMStoreFloat3x3(&m3, pMatrix);
@@ -67,8 +68,8 @@ TEST_CASE("Matrix3", "[.all][matrix][Matrix3]")
 		CHECK_MATRIX3X3(empty, emptyD);
 
 		// DirectX compatibility
-		//CHECK(sizeof FMat3 == sizeof XMVECTOR);
-		//CHECK(memcmp(&allParam, &allParamD, sizeof FMat3));
+		CHECK(sizeof(FMat3) == sizeof(M3));
+		CHECK(std::memcmp(&allParam, &allParamD, sizeof(FMat3)) == 0);
 	}
 
 	SECTION("Accessor")
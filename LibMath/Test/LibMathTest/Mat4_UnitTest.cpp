@@ -3,6 +3,8 @@
 
 #include "../../LibMath/Mat4.h"
 #include <DirectXMath.h>
+#include <cstring>
+#include <vector>
 
 using namespace lm;
 using namespace DirectX;
@@ -26,12 +28,12 @@ CHECK(matrix[3][1] == Catch::Approx(matrixDir(3, 1))); \
 CHECK(matrix[3][2] == Catch::Approx(matrixDir(3, 2))); \
 CHECK(matrix[3][3] == Catch::Approx(matrixDir(3, 3)))
 
-XMMATRIX ToMatrix(const M4& pM4)
+static XMMATRIX ToMatrix(const M4& pM4)
 {
 	return XMLoadFloat4x4(&pM4);
 }
 
-M4 ToFloat(const XMMATRIX& pMatrix)
+static M4 ToFloat(const XMMATRIX& pMatrix)
 {
 	M4 M4;
 	XMStoreFloat4x4(&M4, pMatrix);
@@ -77,8 +79,19 @@ TEST_CASE("Matrix4", "[.all][matrix][Matrix4]")
 		CHECK_MATRIX4X4(empty, emptyD);
 
 		// DirectX compatibility
-		//CHECK(sizeof FMat4 == sizeof XMVECTOR);
-		//CHECK(memcmp(&allParam, &allParamD, sizeof FMat4));
+		CHECK(sizeof(FMat4) == sizeof(M4));
+		CHECK(std::memcmp(&allParam, &allParamD, sizeof(FMat4)) == 0);
+
+		// bulk copies into an upload buffer and back
+		std::vector<FMat4> matrices{ allParam, FMat4::mIdentity, oneParam };
+		std::vector<float> upload(matrices.size() * 16);
+		std::memcpy(upload.data(), matrices.data(), matrices.size() * sizeof(FMat4));
+		CHECK(upload[16 + 15] == 1.f);
+
+		std::vector<FMat4> readBack(matrices.size());
+		std::memcpy(static_cast<void*>(readBack.data()), upload.data(), upload.size() * sizeof(float));
+		for (size_t i = 0; i < matrices.size(); i++)
+			CHECK(readBack[i] == matrices[i]);
 	}
 
 	SECTION("Accessor")
@@ -209,6 +222,20 @@ TEST_CASE("Matrix4", "[.all][matrix][Matrix4]")
 		CHECK(twos != FMat4{ 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, .5f, 2.f, 2.f });
 		CHECK(twos != FMat4{ 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, .5f, 2.f });
 		CHECK(twos != FMat4{ 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, 2.f, .5f });
+
+		// rows of the same length are no longer equal
+		FMat4 swapped(vec1, vec0, vec2, vec3);
+		CHECK(Self != swapped);
+		FMat4 permuted(FVec4(.5f, 2.5f, 2.f, 3.f), vec1, vec2, vec3);
+		CHECK(Self != permuted);
+
+		// approximate comparisons
+		FMat4 roundTrip = Self.Inverse().Inverse();
+		CHECK(Self.ApproxEqual(roundTrip, 1e-5f, 1e-5f));
+		CHECK_FALSE(Self.ApproxEqual(twos, 1e-5f, 1e-5f));
+		CHECK((Self * Self.Inverse()).ApproxEqual(FMat4::mIdentity, 1e-5f, 1e-5f));
+		CHECK(Self.UlpEqual(Self, 0));
+		CHECK_FALSE(Self.UlpEqual(permuted));
 	}
 
 	SECTION("Constant")
@@ -220,6 +247,30 @@ TEST_CASE("Matrix4", "[.all][matrix][Matrix4]")
 		CHECK_MATRIX4X4(FMat4::mIdentity, identity);
 	}
 
+	SECTION("Compile time")
+	{
+		constexpr FMat4 frustum = FMat4::CreateFrustum(-1.f, 1.f, -.75f, .75f, .5f, 1000.f);
+		constexpr FMat4 scaled = FMat4(2.f) * frustum;
+		STATIC_REQUIRE(scaled[2][3] == -2.f);
+		STATIC_REQUIRE(scaled.Transpose()[3][2] == -2.f);
+
+		constexpr FMat4 inverse = FMat4(4.f).Inverse();
+		STATIC_REQUIRE(inverse[0][0] == .25f);
+		STATIC_REQUIRE(FMat4::mIdentity.Determinant() == 1.f);
+
+		constexpr FVec4 translated = FMat4::Translation(FVec3(1.f, 2.f, 3.f)) * FVec4(0.f, 0.f, 0.f, 1.f);
+		STATIC_REQUIRE(translated.Y() == 2.f);
+
+		// same result as the runtime kernels
+		FMat4 runtimeScale{ 2.f };
+		FMat4 runtimeScaled = runtimeScale * frustum;
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = 0; j < 4; j++)
+				CHECK(scaled[i][j] == runtimeScaled[i][j]);
+		}
+	}
+
 	SECTION("Arithmetic")
 	{
 		FMat4 const small{ 2.5f, .5f, 2.f, 1.5f,
@@ -304,6 +355,31 @@ TEST_CASE("Matrix4", "[.all][matrix][Matrix4]")
 			XMVECTOR vecTmp = XMMatrixDeterminant(baseDir);
 			M4 tmp = ToFloat(XMMatrixInverse(&vecTmp, baseDir));
 			CHECK_MATRIX4X4(base.Inverse(), tmp);
+
+			// scale, rotation and translation
+			XMMATRIX affineDir = XMMatrixScaling(2.f, .5f, 3.f) * XMMatrixRotationRollPitchYaw(.3f, 1.2f, -.7f) *
+				XMMatrixTranslation(4.f, -2.5f, 8.f);
+			M4 affineD = ToFloat(affineDir);
+			FMat4 affine{ affineD._11, affineD._12, affineD._13, affineD._14,
+				affineD._21, affineD._22, affineD._23, affineD._24,
+				affineD._31, affineD._32, affineD._33, affineD._34,
+				affineD._41, affineD._42, affineD._43, affineD._44 };
+
+			M4 affineInverse = ToFloat(XMMatrixInverse(nullptr, affineDir));
+			CHECK_MATRIX4X4(affine.Inverse(), affineInverse);
+			CHECK_MATRIX4X4(affine.InverseAffine(), affineInverse);
+
+			// rotation and translation only
+			XMMATRIX rigidDir = XMMatrixRotationRollPitchYaw(-1.1f, .4f, 2.f) * XMMatrixTranslation(-3.f, 1.5f, 6.f);
+			M4 rigidD = ToFloat(rigidDir);
+			FMat4 rigid{ rigidD._11, rigidD._12, rigidD._13, rigidD._14,
+				rigidD._21, rigidD._22, rigidD._23, rigidD._24,
+				rigidD._31, rigidD._32, rigidD._33, rigidD._34,
+				rigidD._41, rigidD._42, rigidD._43, rigidD._44 };
+
+			M4 rigidInverse = ToFloat(XMMatrixInverse(nullptr, rigidDir));
+			CHECK_MATRIX4X4(rigid.InverseRigid(), rigidInverse);
+			CHECK_MATRIX4X4(rigid.InverseAffine(), rigidInverse);
 		}
 
 		SECTION("Identity")
@@ -353,6 +429,50 @@ TEST_CASE("Matrix4", "[.all][matrix][Matrix4]")
 			}
 		}
 
+		SECTION("Batch")
+		{
+			FVec3 points[7];
+			FVec4 vectors[7];
+			for (int i = 0; i < 7; i++)
+			{
+				points[i] = FVec3(1.5f * i, .5f - i, 2.f + .25f * i);
+				vectors[i] = FVec4(points[i], .5f * i);
+			}
+
+			FVec3 transformed[7];
+			base.TransformPoints(points, transformed, 7);
+			for (int i = 0; i < 7; i++)
+			{
+				FVec4 single = base * FVec4(points[i], 1.f);
+				CHECK(transformed[i].X() == Catch::Approx(single.X()));
+				CHECK(transformed[i].Y() == Catch::Approx(single.Y()));
+				CHECK(transformed[i].Z() == Catch::Approx(single.Z()));
+			}
+
+			base.TransformDirections(points, transformed, 7);
+			for (int i = 0; i < 7; i++)
+			{
+				FVec4 single = base * FVec4(points[i], 0.f);
+				CHECK(transformed[i].X() == Catch::Approx(single.X()));
+				CHECK(transformed[i].Y() == Catch::Approx(single.Y()));
+				CHECK(transformed[i].Z() == Catch::Approx(single.Z()));
+			}
+
+			FVec4 expected[7];
+			for (int i = 0; i < 7; i++)
+				expected[i] = base * vectors[i];
+
+			// in place
+			base.TransformVec4(vectors, vectors, 7);
+			for (int i = 0; i < 7; i++)
+			{
+				CHECK(vectors[i].X() == Catch::Approx(expected[i].X()));
+				CHECK(vectors[i].Y() == Catch::Approx(expected[i].Y()));
+				CHECK(vectors[i].Z() == Catch::Approx(expected[i].Z()));
+				CHECK(vectors[i].W() == Catch::Approx(expected[i].W()));
+			}
+		}
+
 		SECTION("Perspective")
 		{
 			CHECK_MATRIX4X4(FMat4::PerspectiveRHDirect(45.f, 800.f / 600.f, .5f, 1000.f), 
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../../LibMath/Vertex.h"
+
+/* -----
+Shared by the mesh tests: pSize x pSize quads over the xz plane appended to pVertices, two
+triangles each, counter-clockwise seen from +y. y = pHeight(x, z), uv = (pUScale * x, z).
+pShuffle takes the triangles out of scanline order. Returns the indices of the grid.
+----- */
+template <typename Height>
+std::vector<std::uint32_t> AppendGrid(std::vector<lm::Vertex>& pVertices, const std::uint32_t pSize, Height&& pHeight,
+	const float pUScale = 1.f, const bool pShuffle = false)
+{
+	const std::uint32_t first = std::uint32_t(pVertices.size());
+	for (std::uint32_t z = 0; z <= pSize; z++)
+		for (std::uint32_t x = 0; x <= pSize; x++)
+			pVertices.emplace_back(lm::FVec3(float(x), pHeight(float(x), float(z)), float(z)), lm::FVec3(),
+				lm::FVec2(pUScale * float(x), float(z)));
+
+	std::vector<std::uint32_t> indices;
+	for (std::uint32_t z = 0; z < pSize; z++)
+		for (std::uint32_t x = 0; x < pSize; x++)
+		{
+			const std::uint32_t corner = first + z * (pSize + 1) + x;
+			for (const std::uint32_t index : { corner, corner + pSize + 1, corner + 1, corner + 1, corner + pSize + 1, corner + pSize + 2 })
+				indices.push_back(index);
+		}
+
+	if (pShuffle)
+	{
+		const std::size_t triangleCount = indices.size() / 3;
+		for (std::size_t i = 0; i < triangleCount; i++)
+		{
+			const std::size_t j = (i * 7919) % triangleCount;
+			for (int k = 0; k < 3; k++)
+				std::swap(indices[3 * i + k], indices[3 * j + k]);
+		}
+	}
+	return indices;
+}
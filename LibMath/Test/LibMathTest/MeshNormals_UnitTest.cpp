@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/MeshNormals.h"
+#include "../../LibMath/VertexBuffer.h"
+#include "MeshGrid.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace lm;
+
+// y of a bumpy surface over y = 0, flat for pAmplitude = 0
+static auto Bump(const float pAmplitude)
+{
+	return [pAmplitude](const float pX, const float pZ) { return pAmplitude * std::sin(.4f * pX) * std::cos(.3f * pZ); };
+}
+
+TEST_CASE("MeshNormals", "[.all][mesh][MeshNormals]")
+{
+	SECTION("Weighting")
+	{
+		// cube of side 2 with shared corners, two triangles per face, outward winding
+		std::vector<Vertex> cube;
+		for (int i = 0; i < 8; i++)
+			cube.emplace_back(i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f);
+
+		const std::vector<std::uint32_t> indices = {
+			0, 4, 6, 0, 6, 2,	// -x
+			1, 3, 7, 1, 7, 5,	// +x
+			0, 1, 5, 0, 5, 4,	// -y
+			2, 6, 7, 2, 7, 3,	// +y
+			0, 2, 3, 0, 3, 1,	// -z
+			4, 5, 7, 4, 7, 6 };	// +z
+
+		// every face spans 90 degrees at a corner however it is split
+		ComputeNormals(cube.data(), cube.size(), indices.data(), indices.size(), NormalWeighting::Angle);
+		for (const Vertex& vertex : cube)
+			CHECK(vertex.GetNormal().ApproxEqual(vertex.GetPosition().Normalize(), 1e-6f));
+
+		// by area the corners touched by two triangles of a face lean towards it
+		ComputeNormals(cube.data(), cube.size(), indices.data(), indices.size());
+		CHECK(cube[0].GetNormal().ApproxEqual(FVec3(-2.f, -2.f, -2.f).Normalize(), 1e-6f));
+		CHECK_FALSE(cube[4].GetNormal().ApproxEqual(cube[4].GetPosition().Normalize(), 1e-3f));
+		for (const Vertex& vertex : cube)
+		{
+			CHECK(vertex.GetNormal().Length() == Catch::Approx(1.f));
+			CHECK(vertex.GetNormal().DotProduct(vertex.GetPosition()) > 0.f);
+		}
+
+		// a vertex used by no triangle, and degenerate triangles, give a zero normal
+		cube.emplace_back(5.f, 5.f, 5.f);
+		std::vector<std::uint32_t> degenerate = indices;
+		for (const std::uint32_t index : { 8u, 8u, 8u })
+			degenerate.push_back(index);
+		ComputeNormals(cube.data(), cube.size(), degenerate.data(), degenerate.size(), NormalWeighting::Angle);
+		CHECK(cube[8].GetNormal() == FVec3(0.f));
+		CHECK(cube[7].GetNormal().ApproxEqual(FVec3(1.f, 1.f, 1.f).Normalize(), 1e-6f));
+	}
+
+	SECTION("Threads")
+	{
+		// enough vertices for 3 ranges, each vertex adds its triangles in the same order on any thread
+		std::vector<Vertex> vertices;
+		const std::vector<std::uint32_t> indices = AppendGrid(vertices, 160, Bump(2.f));
+		REQUIRE(vertices.size() >= 3 * Parallel::mMinElementsPerThread);
+
+		for (const NormalWeighting weighting : { NormalWeighting::Area, NormalWeighting::Angle })
+		{
+			std::vector<Vertex> single = vertices, threaded = vertices;
+			ComputeNormals(single.data(), single.size(), indices.data(), indices.size(), weighting, 1);
+			ComputeNormals(threaded.data(), threaded.size(), indices.data(), indices.size(), weighting, 3);
+
+			std::vector<FVec4> singleTangents(vertices.size()), threadedTangents(vertices.size());
+			ComputeTangents(single.data(), single.size(), indices.data(), indices.size(), singleTangents.data(), 1);
+			ComputeTangents(threaded.data(), threaded.size(), indices.data(), indices.size(), threadedTangents.data(), 3);
+
+			bool same = true;
+			for (std::size_t i = 0; i < vertices.size(); i++)
+				same = same && single[i].GetNormal() == threaded[i].GetNormal() && singleTangents[i] == threadedTangents[i];
+			CHECK(same);
+		}
+	}
+
+	SECTION("Tangents")
+	{
+		// flat: the tangent follows +u = +x, the bitangent +v = +z = -(normal x tangent)
+		std::vector<Vertex> flat;
+		std::vector<std::uint32_t> indices = AppendGrid(flat, 4, Bump(0.f));
+		ComputeNormals(flat.data(), flat.size(), indices.data(), indices.size());
+
+		std::vector<FVec4> tangents(flat.size());
+		ComputeTangents(flat.data(), flat.size(), indices.data(), indices.size(), tangents.data());
+		for (std::size_t i = 0; i < flat.size(); i++)
+		{
+			CHECK(flat[i].GetNormal().ApproxEqual(FVec3(0.f, 1.f, 0.f), 1e-6f));
+			CHECK(tangents[i].ApproxEqual(FVec4(1.f, 0.f, 0.f, -1.f), 1e-6f));
+		}
+
+		// mirrored u flips the tangent and the handedness
+		std::vector<Vertex> mirrored;
+		indices = AppendGrid(mirrored, 4, Bump(0.f), -1.f);
+		ComputeNormals(mirrored.data(), mirrored.size(), indices.data(), indices.size());
+		ComputeTangents(mirrored.data(), mirrored.size(), indices.data(), indices.size(), tangents.data());
+		for (const FVec4& tangent : tangents)
+			CHECK(tangent.ApproxEqual(FVec4(-1.f, 0.f, 0.f, 1.f), 1e-6f));
+
+		// bumpy: unit tangents perpendicular to the normals, the bitangent still along +z
+		std::vector<Vertex> bumpy;
+		indices = AppendGrid(bumpy, 12, Bump(1.5f), 2.f);
+		ComputeNormals(bumpy.data(), bumpy.size(), indices.data(), indices.size(), NormalWeighting::Angle);
+		tangents.resize(bumpy.size());
+		ComputeTangents(bumpy.data(), bumpy.size(), indices.data(), indices.size(), tangents.data());
+		for (std::size_t i = 0; i < bumpy.size(); i++)
+		{
+			const FVec3 tangent(tangents[i].X(), tangents[i].Y(), tangents[i].Z());
+			CHECK(tangent.Length() == Catch::Approx(1.f));
+			CHECK(tangent.DotProduct(bumpy[i].GetNormal()) == Catch::Approx(0.f).margin(1e-5));
+			CHECK(tangent.X() > 0.f);
+			CHECK((bumpy[i].GetNormal().CrossProduct(tangent) * tangents[i].W()).Z() > 0.f);
+		}
+
+		// without usable coordinates the tangent is any unit vector perpendicular to the normal
+		std::vector<Vertex> untextured;
+		indices = AppendGrid(untextured, 4, Bump(0.f));
+		for (Vertex& vertex : untextured)
+		{
+			vertex.GetTextCoords() = FVec2(.5f, .5f);
+			vertex.GetNormal() = FVec3(1.f, 0.f, 0.f);
+		}
+		tangents.resize(untextured.size());
+		ComputeTangents(untextured.data(), untextured.size(), indices.data(), indices.size(), tangents.data());
+		CHECK(tangents[3].ApproxEqual(FVec4(0.f, 1.f, 0.f, 1.f), 1e-6f));
+	}
+
+	SECTION("VertexBuffer")
+	{
+		std::vector<Vertex> vertices;
+		const std::vector<std::uint32_t> indices = AppendGrid(vertices, 9, Bump(1.f));
+
+		VertexBuffer interleaved(vertices.data(), vertices.size());
+		VertexBuffer deinterleaved(vertices.data(), vertices.size(), VertexLayout::Deinterleaved);
+		interleaved.RecomputeNormals(indices.data(), indices.size(), NormalWeighting::Angle);
+		deinterleaved.RecomputeNormals(indices.data(), indices.size(), NormalWeighting::Angle);
+
+		std::vector<FVec4> interleavedTangents(vertices.size()), deinterleavedTangents(vertices.size());
+		interleaved.ComputeTangents(indices.data(), indices.size(), interleavedTangents.data());
+		deinterleaved.ComputeTangents(indices.data(), indices.size(), deinterleavedTangents.data());
+
+		ComputeNormals(vertices.data(), vertices.size(), indices.data(), indices.size(), NormalWeighting::Angle);
+		for (std::size_t i = 0; i < vertices.size(); i++)
+		{
+			CHECK(interleaved.GetNormals()[i].ApproxEqual(vertices[i].GetNormal(), 1e-6f));
+			CHECK(deinterleaved.GetNormals()[i].ApproxEqual(vertices[i].GetNormal(), 1e-6f));
+			CHECK(interleavedTangents[i].ApproxEqual(deinterleavedTangents[i], 1e-6f));
+		}
+	}
+}
@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/MeshOptimize.h"
+#include "../../LibMath/VertexBuffer.h"
+#include "MeshGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace lm;
+
+// pSize x pSize quads in the y = pHeight plane, triangles shuffled out of scanline order
+static std::vector<std::uint32_t> MakeShuffledGrid(const std::uint32_t pSize, const float pHeight, std::vector<Vertex>& pVertices)
+{
+	return AppendGrid(pVertices, pSize, [pHeight](float, float) { return pHeight; }, 1.f, true);
+}
+
+// latitude-longitude sphere of radius pRadius, outward winding
+static void AppendSphere(const float pRadius, std::vector<Vertex>& pVertices, std::vector<std::uint32_t>& pIndices)
+{
+	const std::uint32_t rings = 12, sectors = 24, first = std::uint32_t(pVertices.size());
+	for (std::uint32_t ring = 0; ring <= rings; ring++)
+		for (std::uint32_t sector = 0; sector <= sectors; sector++)
+		{
+			const float theta = 3.14159265f * float(ring) / float(rings), phi = 6.28318531f * float(sector) / float(sectors);
+			pVertices.emplace_back(pRadius * std::sin(theta) * std::cos(phi), pRadius * std::cos(theta), pRadius * std::sin(theta) * std::sin(phi));
+		}
+
+	for (std::uint32_t ring = 0; ring < rings; ring++)
+		for (std::uint32_t sector = 0; sector < sectors; sector++)
+		{
+			const std::uint32_t corner = first + ring * (sectors + 1) + sector;
+			for (const std::uint32_t index : { corner, corner + 1, corner + sectors + 1, corner + 1, corner + sectors + 2, corner + sectors + 1 })
+				pIndices.push_back(index);
+		}
+}
+
+// the triangles as a sorted list, each one keeping its winding
+template <typename Index> static std::vector<std::array<std::uint32_t, 3>> Triangles(const std::vector<Index>& pIndices)
+{
+	std::vector<std::array<std::uint32_t, 3>> triangles;
+	for (std::size_t i = 0; i + 2 < pIndices.size(); i += 3)
+		triangles.push_back({ pIndices[i], pIndices[i + 1], pIndices[i + 2] });
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+TEST_CASE("MeshOptimize", "[.all][mesh][MeshOptimize]")
+{
+	SECTION("Statistics")
+	{
+		const std::vector<std::uint32_t> twice = { 0, 1, 2, 0, 1, 2 };
+
+		// a FIFO of 2 has pushed out vertex 0 when the triangle comes back, then loses every vertex in turn
+		VertexCacheStatistics statistics = AnalyzeVertexCache(twice.data(), twice.size(), 3, 2);
+		CHECK(statistics.mTransformed == 6);
+		CHECK(statistics.mAcmr == 3.f);
+		CHECK(statistics.mAtvr == 2.f);
+
+		statistics = AnalyzeVertexCache(twice.data(), twice.size(), 3, 3);
+		CHECK(statistics.mTransformed == 3);
+		CHECK(statistics.mAcmr == 1.5f);
+		CHECK(statistics.mAtvr == 1.f);
+
+		statistics = AnalyzeVertexCache(twice.data(), 0, 3);
+		CHECK(statistics.mTransformed == 0);
+		CHECK(statistics.mAcmr == 0.f);
+	}
+
+	SECTION("VertexCache")
+	{
+		std::vector<Vertex> vertices;
+		const std::vector<std::uint32_t> indices = MakeShuffledGrid(40, 0.f, vertices);
+		const VertexCacheStatistics before = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+		std::vector<std::uint32_t> optimized(indices.size());
+		OptimizeVertexCache(indices.data(), indices.size(), vertices.size(), optimized.data());
+		const VertexCacheStatistics after = AnalyzeVertexCache(optimized.data(), optimized.size(), vertices.size());
+
+		// a regular grid costs at least 0.5 vertex per triangle
+		CHECK(before.mAcmr > 2.f);
+		CHECK(after.mAcmr < .8f);
+		CHECK(after.mAtvr < 1.6f);
+		CHECK(Triangles(optimized) == Triangles(indices));
+
+		// in place and with 16 bits indices
+		std::vector<std::uint32_t> inPlace = indices;
+		OptimizeVertexCache(inPlace.data(), inPlace.size(), vertices.size(), inPlace.data());
+		CHECK(inPlace == optimized);
+
+		const std::vector<std::uint16_t> shortIndices(indices.begin(), indices.end());
+		std::vector<std::uint16_t> shortOptimized(indices.size());
+		OptimizeVertexCache(shortIndices.data(), shortIndices.size(), vertices.size(), shortOptimized.data());
+		CHECK(std::equal(shortOptimized.begin(), shortOptimized.end(), optimized.begin()));
+
+		// degenerate triangles and unused vertices
+		std::vector<std::uint32_t> degenerate = { 0, 0, 1, 1, 2, 3, 3, 3, 3 };
+		const std::vector<std::uint32_t> source = degenerate;
+		OptimizeVertexCache(degenerate.data(), degenerate.size(), 6, degenerate.data());
+		CHECK(Triangles(degenerate) == Triangles(source));
+	}
+
+	SECTION("Overdraw")
+	{
+		// two parallel sheets facing +y drawn bottom first: the top one hides the other and goes first
+		std::vector<Vertex> vertices;
+		std::vector<std::uint32_t> indices = MakeShuffledGrid(4, -1.f, vertices);
+		const std::vector<std::uint32_t> top = MakeShuffledGrid(4, 1.f, vertices);
+		OptimizeVertexCache(indices.data(), indices.size(), vertices.size(), indices.data());
+		std::vector<std::uint32_t> topOptimized(top.size());
+		OptimizeVertexCache(top.data(), top.size(), vertices.size(), topOptimized.data());
+		indices.insert(indices.end(), topOptimized.begin(), topOptimized.end());
+
+		std::vector<std::uint32_t> sorted(indices.size());
+		const VertexStream<const FVec3> positions(&vertices[0].GetPosition(), vertices.size(), sizeof(Vertex));
+		OptimizeOverdraw(indices.data(), indices.size(), positions, sorted.data());
+		CHECK(Triangles(std::vector<std::uint32_t>(sorted.begin(), sorted.begin() + top.size())) == Triangles(top));
+		CHECK(Triangles(sorted) == Triangles(indices));
+
+		// an inner sphere inside an outer one: a few more misses at the default threshold
+		vertices.clear();
+		indices.clear();
+		AppendSphere(.5f, vertices, indices);
+		const std::size_t innerIndexCount = indices.size();
+		AppendSphere(1.f, vertices, indices);
+		OptimizeVertexCache(indices.data(), indices.size(), vertices.size(), indices.data());
+		const VertexCacheStatistics before = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+		sorted.resize(indices.size());
+		const VertexStream<const FVec3> spherePositions(&vertices[0].GetPosition(), vertices.size(), sizeof(Vertex));
+		OptimizeOverdraw(indices.data(), indices.size(), spherePositions, sorted.data());
+		CHECK(AnalyzeVertexCache(sorted.data(), sorted.size(), vertices.size()).mAcmr <= 1.2f * before.mAcmr);
+		CHECK(Triangles(sorted) == Triangles(indices));
+
+		// clusters small enough to stay on one side of the spheres put the whole outer one first
+		std::vector<std::uint32_t> fine(indices.size());
+		OptimizeOverdraw(indices.data(), indices.size(), spherePositions, fine.data(), 1.5f);
+		const std::uint32_t innerVertexCount = std::uint32_t(vertices.size() / 2);
+		CHECK(std::all_of(fine.begin(), fine.end() - innerIndexCount,
+			[innerVertexCount](const std::uint32_t pIndex) { return pIndex >= innerVertexCount; }));
+		CHECK(AnalyzeVertexCache(fine.data(), fine.size(), vertices.size()).mAcmr < 1.5f);
+
+		// in place
+		OptimizeOverdraw(indices.data(), indices.size(), spherePositions, indices.data());
+		CHECK(indices == sorted);
+	}
+
+	SECTION("VertexFetch")
+	{
+		std::vector<Vertex> vertices;
+		std::vector<std::uint32_t> indices = MakeShuffledGrid(10, 0.f, vertices);
+		OptimizeVertexCache(indices.data(), indices.size(), vertices.size(), indices.data());
+		vertices.emplace_back(50.f, 50.f, 50.f);
+		vertices.insert(vertices.begin(), Vertex(60.f, 60.f, 60.f));
+		for (std::uint32_t& index : indices)
+			index++;
+
+		std::vector<Vertex> corners;
+		for (const std::uint32_t index : indices)
+			corners.push_back(vertices[index]);
+
+		VertexBuffer buffer(vertices.data(), vertices.size(), VertexLayout::Deinterleaved);
+		std::vector<std::uint16_t> shortIndices(indices.begin(), indices.end());
+
+		CHECK(OptimizeVertexFetch(vertices.data(), vertices.size(), indices.data(), indices.size()) == 121);
+		CHECK(buffer.OptimizeVertexFetch(shortIndices.data(), shortIndices.size()) == 121);
+
+		// the indices only ever step to the next unseen vertex, the corners are unchanged
+		std::uint32_t next = 0;
+		bool forward = true, same = true;
+		for (std::size_t i = 0; i < indices.size(); i++)
+		{
+			forward = forward && indices[i] <= next;
+			next = std::max(next, indices[i] + 1);
+			same = same && vertices[indices[i]] == corners[i] && buffer.GetVertex(shortIndices[i]) == corners[i] &&
+				shortIndices[i] == indices[i];
+		}
+		CHECK(forward);
+		CHECK(same);
+
+		// the unused vertices move to the end in their original order
+		CHECK(vertices[121] == Vertex(60.f, 60.f, 60.f));
+		CHECK(vertices[122] == Vertex(50.f, 50.f, 50.f));
+		CHECK(buffer.GetVertex(122) == Vertex(50.f, 50.f, 50.f));
+	}
+}
@@ -0,0 +1,187 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../../LibMath/MeshWeld.h"
+#include "../../LibMath/VertexBuffer.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace lm;
+
+// one vertex per corner of a cube of side 2, 12 triangles with flat normals
+static std::vector<Vertex> MakeCubeSoup(const bool pFlatNormals)
+{
+	const int faces[6][4] = { { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 2, 3, 1 }, { 4, 5, 7, 6 } };
+	const FVec3 normals[6] = { FVec3(-1.f, 0.f, 0.f), FVec3(1.f, 0.f, 0.f), FVec3(0.f, -1.f, 0.f),
+		FVec3(0.f, 1.f, 0.f), FVec3(0.f, 0.f, -1.f), FVec3(0.f, 0.f, 1.f) };
+
+	std::vector<Vertex> soup;
+	for (int face = 0; face < 6; face++)
+		for (const int corner : { 0, 1, 2, 0, 2, 3 })
+		{
+			const int i = faces[face][corner];
+			soup.emplace_back(FVec3(i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f),
+				pFlatNormals ? normals[face] : FVec3(0.f));
+		}
+	return soup;
+}
+
+// pSize x pSize quads as a triangle soup, the corner vertices repeated by every triangle
+static std::vector<Vertex> MakeGridSoup(const std::uint32_t pSize)
+{
+	std::vector<Vertex> soup;
+	for (std::uint32_t z = 0; z < pSize; z++)
+		for (std::uint32_t x = 0; x < pSize; x++)
+			for (const std::uint32_t corner : { 0u, 2u, 1u, 1u, 2u, 3u })
+			{
+				const float px = float(x + (corner & 1)), pz = float(z + (corner >> 1));
+				soup.emplace_back(FVec3(px, 0.f, pz), FVec3(0.f, 1.f, 0.f), FVec2(px / float(pSize), pz / float(pSize)));
+			}
+	return soup;
+}
+
+static bool SameVertex(const Vertex& pLeft, const Vertex& pRight)
+{
+	return pLeft == pRight && pLeft.GetNormal() == pRight.GetNormal();
+}
+
+TEST_CASE("MeshWeld", "[.all][mesh][MeshWeld]")
+{
+	SECTION("Exact")
+	{
+		// the flat normals split every corner in 3, the smooth cube shares them
+		for (const bool flat : { true, false })
+		{
+			const std::vector<Vertex> soup = MakeCubeSoup(flat);
+
+			std::vector<Vertex> unique;
+			std::vector<std::uint32_t> indices;
+			REQUIRE(WeldVertices(soup.data(), soup.size(), unique, indices));
+			CHECK(unique.size() == (flat ? 24 : 8));
+			REQUIRE(indices.size() == soup.size());
+
+			bool rebuilt = true;
+			for (std::size_t i = 0; i < soup.size(); i++)
+				rebuilt = rebuilt && SameVertex(unique[indices[i]], soup[i]);
+			CHECK(rebuilt);
+
+			// numbered in order of first use
+			CHECK(indices[0] == 0);
+			CHECK(indices[1] == 1);
+			CHECK(indices[2] == 2);
+			CHECK(indices[3] == 0);
+
+			std::vector<std::uint16_t> shortIndices;
+			REQUIRE(WeldVertices(soup.data(), soup.size(), unique, shortIndices));
+			for (std::size_t i = 0; i < soup.size(); i++)
+				CHECK(shortIndices[i] == indices[i]);
+		}
+
+		// every attribute takes part, -0 and +0 are the same value
+		std::vector<Vertex> vertices(6, Vertex(FVec3(1.f, 0.f, 2.f), FVec3(0.f, 1.f, 0.f), FVec2(.5f, .5f), FVec3(1.f)));
+		vertices[1].GetPosition().Y() = -0.f;
+		vertices[2].GetNormal().X() = 1e-7f;
+		vertices[3].GetTextCoords().Y() = .5000001f;
+		vertices[4].GetColor().Z() = .9f;
+
+		std::vector<std::uint32_t> remap(vertices.size());
+		CHECK(GenerateVertexRemap(vertices.data(), vertices.size(), remap.data()) == 4);
+		CHECK(remap == std::vector<std::uint32_t>{ 0, 0, 1, 2, 3, 0 });
+		CHECK(GenerateVertexRemap(vertices.data(), 0, remap.data()) == 0);
+	}
+
+	SECTION("Tolerance")
+	{
+		// the copies of a corner are off by less than 1e-5 around the border of two cells of 1e-3
+		std::vector<Vertex> soup = MakeCubeSoup(false);
+		for (std::size_t i = 0; i < soup.size(); i++)
+			soup[i].GetPosition() += FVec3(5e-4f) + FVec3(float(i % 5) * 2e-6f, -float(i % 3) * 2e-6f, float(i % 2) * 3e-6f);
+
+		std::vector<Vertex> unique;
+		std::vector<std::uint32_t> indices;
+		REQUIRE(WeldVertices(soup.data(), soup.size(), unique, indices));
+		CHECK(unique.size() > 8);
+
+		REQUIRE(WeldVertices(soup.data(), soup.size(), unique, indices, WeldTolerance(1e-3f)));
+		CHECK(unique.size() == 8);
+		for (std::size_t i = 0; i < soup.size(); i++)
+			CHECK(unique[indices[i]].GetPosition().ApproxEqual(soup[i].GetPosition(), 1e-5f));
+
+		// a tolerance on the positions only keeps apart the texture seams
+		soup[0].GetTextCoords() = FVec2(1e-4f, 0.f);
+		REQUIRE(WeldVertices(soup.data(), soup.size(), unique, indices, WeldTolerance(1e-3f, 0.f, 0.f, 0.f)));
+		CHECK(unique.size() == 9);
+		REQUIRE(WeldVertices(soup.data(), soup.size(), unique, indices, WeldTolerance(1e-3f)));
+		CHECK(unique.size() == 8);
+
+		// a distance: values across 0 or a cell border merge, they join the first vertex in reach
+		std::vector<Vertex> line(7, Vertex(FVec3(0.f)));
+		line[1].GetPosition().X() = -1e-7f;
+		line[2].GetPosition().X() = .0011f;
+		line[3].GetPosition().X() = .0005f - 1e-6f;
+		line[4].GetPosition().X() = .0005f + 1e-6f;
+		line[5].GetPosition().X() = .0015f - 1e-6f;
+		line[6].GetPosition().X() = .0015f + 1e-6f;
+
+		std::vector<std::uint32_t> remap(line.size());
+		CHECK(GenerateVertexRemap(line.data(), line.size(), remap.data(), WeldTolerance(1e-3f)) == 2);
+		CHECK(remap == std::vector<std::uint32_t>{ 0, 0, 1, 0, 0, 1, 1 });
+
+		// the same on the normals, which are not hashed
+		for (Vertex& vertex : line)
+			std::swap(vertex.GetPosition(), vertex.GetNormal());
+		CHECK(GenerateVertexRemap(line.data(), line.size(), remap.data(), WeldTolerance(0.f, 1e-3f, 0.f, 0.f)) == 2);
+		CHECK(remap == std::vector<std::uint32_t>{ 0, 0, 1, 0, 0, 1, 1 });
+	}
+
+	SECTION("Threads")
+	{
+		// enough vertices for 3 tables, the result does not depend on how they are split
+		const std::vector<Vertex> soup = MakeGridSoup(160);
+		REQUIRE(soup.size() >= 3 * Parallel::mMinElementsPerThread);
+
+		std::vector<std::uint32_t> single(soup.size()), threaded(soup.size());
+		CHECK(GenerateVertexRemap(soup.data(), soup.size(), single.data(), WeldTolerance(), 1) == 161 * 161);
+		CHECK(GenerateVertexRemap(soup.data(), soup.size(), threaded.data(), WeldTolerance(), 3) == 161 * 161);
+		CHECK(single == threaded);
+
+		// with a tolerance the neighbour cells stay in the table of the vertex
+		std::vector<Vertex> jittered = soup;
+		for (std::size_t i = 0; i < jittered.size(); i++)
+			jittered[i].GetPosition() += FVec3(float(i % 7) * 1e-4f, 0.f, -float(i % 5) * 1e-4f);
+		CHECK(GenerateVertexRemap(jittered.data(), jittered.size(), single.data(), WeldTolerance(1e-3f, 0.f, 0.f, 0.f), 1) == 161 * 161);
+		CHECK(GenerateVertexRemap(jittered.data(), jittered.size(), threaded.data(), WeldTolerance(1e-3f, 0.f, 0.f, 0.f), 3) == 161 * 161);
+		CHECK(single == threaded);
+
+		// 261 * 261 unique vertices do not fit 16 bits indices
+		const std::vector<Vertex> large = MakeGridSoup(260);
+		std::vector<Vertex> unique(1);
+		std::vector<std::uint16_t> shortIndices(1);
+		CHECK_FALSE(WeldVertices(large.data(), large.size(), unique, shortIndices));
+		CHECK(unique.empty());
+		CHECK(shortIndices.empty());
+	}
+
+	SECTION("VertexBuffer")
+	{
+		const std::vector<Vertex> soup = MakeGridSoup(6);
+
+		std::vector<Vertex> unique;
+		std::vector<std::uint32_t> expected;
+		REQUIRE(WeldVertices(soup.data(), soup.size(), unique, expected));
+
+		for (const VertexLayout layout : { VertexLayout::Interleaved, VertexLayout::Deinterleaved })
+		{
+			VertexBuffer buffer(soup.data(), soup.size(), layout);
+			std::vector<std::uint16_t> indices;
+			REQUIRE(buffer.Weld(indices));
+			REQUIRE(buffer.Size() == unique.size());
+			for (std::size_t i = 0; i < unique.size(); i++)
+				CHECK(SameVertex(buffer.GetVertex(i), unique[i]));
+
+			REQUIRE(indices.size() == expected.size());
+			for (std::size_t i = 0; i < indices.size(); i++)
+				CHECK(indices[i] == expected[i]);
+		}
+	}
+}
@@ -0,0 +1,249 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+#include "../../LibMath/QuatPacket.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace lm;
+
+#define CHECK_PACKET_VEC3(vector, expected)			   \
+CHECK((vector).X() == Catch::Approx((expected).X())); \
+CHECK((vector).Y() == Catch::Approx((expected).Y())); \
+CHECK((vector).Z() == Catch::Approx((expected).Z()))
+
+#define CHECK_PACKET_QUAT(quat, expected)			 \
+CHECK((quat).mX == Catch::Approx((expected).mX)); \
+CHECK((quat).mY == Catch::Approx((expected).mY)); \
+CHECK((quat).mZ == Catch::Approx((expected).mZ)); \
+CHECK((quat).mW == Catch::Approx((expected).mW))
+
+TEMPLATE_TEST_CASE("Vector3Packet", "[.all][vector][Vector3Packet]", Vec3x4, Vec3x8)
+{
+	constexpr std::size_t width = TestType::Width;
+
+	FVec3 first[width];
+	FVec3 second[width];
+	for (std::size_t i = 0; i < width; i++)
+	{
+		first[i] = FVec3(1.f + i, -2.f + .5f * i, .25f * i + 3.f);
+		second[i] = FVec3(.5f * i - 4.f, 2.f, 1.f + i * i * .1f);
+	}
+
+	const TestType a = TestType::Load(first);
+	const TestType b = TestType::Load(second);
+
+	SECTION("Instantiation")
+	{
+		FVec3 stored[width];
+		a.Store(stored);
+		for (std::size_t i = 0; i < width; i++)
+		{
+			CHECK_PACKET_VEC3(stored[i], first[i]);
+			CHECK_PACKET_VEC3(a.Get(i), first[i]);
+		}
+
+		const TestType splat{ FVec3(1.f, 2.f, 3.f) };
+		CHECK_PACKET_VEC3(splat.Get(width - 1), FVec3(1.f, 2.f, 3.f));
+
+		const TestType empty;
+		CHECK_PACKET_VEC3(empty.Get(0), FVec3::mZero);
+	}
+
+	SECTION("Functionality")
+	{
+		float dot[width], length[width];
+		a.DotProduct(b).Store(dot);
+		a.Length().Store(length);
+
+		const TestType cross = a.CrossProduct(b);
+		const TestType normalized = a.Normalize();
+		const TestType lerp = TestType::Lerp(a, b, TestType::Pack::Splat(.3f));
+
+		for (std::size_t i = 0; i < width; i++)
+		{
+			CHECK(dot[i] == Catch::Approx(first[i].DotProduct(second[i])));
+			CHECK(length[i] == Catch::Approx(first[i].Length()));
+			CHECK_PACKET_VEC3(cross.Get(i), first[i].CrossProduct(second[i]));
+			CHECK_PACKET_VEC3(normalized.Get(i), first[i].Normalize());
+			CHECK_PACKET_VEC3(lerp.Get(i), FVec3::Lerp(first[i], second[i], .3f));
+		}
+	}
+
+	SECTION("Comparator")
+	{
+		// lanes where first is longer than second
+		const typename TestType::Mask longer = a.Length2() > b.Length2();
+		const TestType longest = TestType::Select(longer, a, b);
+
+		int expectedBits = 0;
+		for (std::size_t i = 0; i < width; i++)
+		{
+			const bool isLonger = first[i].Length2() > second[i].Length2();
+			expectedBits |= int(isLonger) << i;
+			CHECK_PACKET_VEC3(longest.Get(i), isLonger ? first[i] : second[i]);
+		}
+
+		CHECK(longer.Bits() == expectedBits);
+		CHECK((a == a).All());
+		CHECK((a != a).None());
+		CHECK((a != b).Any());
+		CHECK((longer | !longer).All());
+		CHECK((longer & !longer).None());
+	}
+}
+
+TEMPLATE_TEST_CASE("QuaternionPacket", "[.all][quaternion][QuaternionPacket]", Quatx4, Quatx8)
+{
+	constexpr std::size_t width = TestType::Width;
+
+	FQuat first[width];
+	FQuat second[width];
+	for (std::size_t i = 0; i < width; i++)
+	{
+		first[i] = FQuat::RotationAxis(.3f * i, FVec3(1.f, .5f * i, 2.f));
+
+		// odd lanes are nearly parallel and even lanes have a negative dot to cover every Slerp branch
+		if (i % 2 == 1)
+			second[i] = FQuat::RotationAxis(.3f * i + .05f, FVec3(1.f, .5f * i, 2.f));
+		else
+			second[i] = FQuat::RotationAxis(-2.5f - .2f * i, FVec3(-1.f, 1.f, .25f * i));
+	}
+
+	const TestType a = TestType::Load(first);
+	const TestType b = TestType::Load(second);
+
+	SECTION("Instantiation")
+	{
+		FQuat stored[width];
+		a.Store(stored);
+		for (std::size_t i = 0; i < width; i++)
+		{
+			CHECK_PACKET_QUAT(stored[i], first[i]);
+		}
+	}
+
+	SECTION("Functionality")
+	{
+		const TestType product = a * b;
+		const TestType normalized = (a * TestType::Pack::Splat(3.f)).Normalize();
+		const TestType conjugate = a.Conjugate();
+
+		float dot[width];
+		a.DotProduct(b).Store(dot);
+
+		FVec3 points[width];
+		for (std::size_t i = 0; i < width; i++)
+			points[i] = FVec3(1.f, -2.f * i, .5f);
+
+		const Vec3Packet<typename TestType::Pack> rotated = a * Vec3Packet<typename TestType::Pack>::Load(points);
+
+		for (std::size_t i = 0; i < width; i++)
+		{
+			CHECK(dot[i] == Catch::Approx(first[i].DotProduct(second[i])));
+			CHECK_PACKET_QUAT(product.Get(i), first[i] * second[i]);
+			CHECK_PACKET_QUAT(normalized.Get(i), first[i].Normalize());
+			CHECK_PACKET_QUAT(conjugate.Get(i), first[i].Conjugate());
+			CHECK_PACKET_VEC3(rotated.Get(i), first[i] * points[i]);
+		}
+	}
+
+	SECTION("Interpolation")
+	{
+		for (const float alpha : { 0.f, .25f, .5f, 1.f, 2.f })
+		{
+			const TestType slerp = TestType::Slerp(a, b, alpha);
+			const TestType lerp = TestType::Lerp(a, b, alpha);
+
+			const TestType nlerp = TestType::Nlerp(a, b, TestType::Pack::Splat(alpha));
+			const TestType fast = TestType::Slerp(a, b, TestType::Pack::Splat(alpha), SlerpAccuracy::Fast);
+			const TestType precise = TestType::Slerp(a, b, TestType::Pack::Splat(alpha), SlerpAccuracy::Precise);
+
+			for (std::size_t i = 0; i < width; i++)
+			{
+				const FQuat expected = FQuat::Slerp(first[i], second[i], alpha);
+				CHECK_PACKET_QUAT(slerp.Get(i), expected);
+				CHECK_PACKET_QUAT(lerp.Get(i), FQuat::Lerp(first[i], second[i], alpha));
+				CHECK_PACKET_QUAT(nlerp.Get(i), FQuat::Nlerp(first[i], second[i], alpha));
+				// the tiers renormalize, Slerp does not on its near-parallel Lerp
+				CHECK(fast.Get(i).ApproxEqual(expected.Normalize(), 1e-3f, 0.f));
+				CHECK(precise.Get(i).ApproxEqual(expected.Normalize(), 1e-5f, 0.f));
+			}
+		}
+	}
+}
+
+// angle of the rotation taking pA to pB, atan2 form since acos(dot) is ill conditioned near 1
+static float AngularError(const FQuat& pA, const FQuat& pB)
+{
+	const double sign = pA.DotProduct(pB) < 0.f ? -1. : 1.;
+	const double dx = double(pA.mX) - sign * pB.mX, sx = double(pA.mX) + sign * pB.mX;
+	const double dy = double(pA.mY) - sign * pB.mY, sy = double(pA.mY) + sign * pB.mY;
+	const double dz = double(pA.mZ) - sign * pB.mZ, sz = double(pA.mZ) + sign * pB.mZ;
+	const double dw = double(pA.mW) - sign * pB.mW, sw = double(pA.mW) + sign * pB.mW;
+
+	return float(4. * std::atan2(std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw),
+		std::sqrt(sx * sx + sy * sy + sz * sz + sw * sw)));
+}
+
+TEST_CASE("QuaternionBatch", "[.all][quaternion][QuaternionBatch]")
+{
+	// not a multiple of the packet width so the padded tail is covered
+	constexpr std::size_t count = 21;
+
+	std::vector<FQuat> start, end;
+	std::vector<float> alphas;
+	for (std::size_t i = 0; i < count; i++)
+	{
+		start.push_back(FQuat::RotationAxis(.4f * i - 3.f, FVec3(1.f, .25f * i, -2.f)));
+		end.push_back(FQuat::RotationAxis(2.9f - .3f * i, FVec3(-.5f * i, 1.f, 1.f)));
+		alphas.push_back(float(i) / (count - 1));
+	}
+
+	// nearly parallel and opposite pairs
+	end[3] = FQuat::RotationAxis(.4f * 3 - 3.f + .01f, FVec3(1.f, .75f, -2.f));
+	end[4] = FQuat(-start[4].mX, -start[4].mY, -start[4].mZ, -start[4].mW);
+
+	std::vector<FQuat> result(count);
+
+	SECTION("Slerp")
+	{
+		const SlerpAccuracy tiers[] = { SlerpAccuracy::Fast, SlerpAccuracy::Precise, SlerpAccuracy::Exact };
+		const float tolerances[] = { 2e-5f, 2e-5f, 2e-5f };
+
+		for (std::size_t tier = 0; tier < 3; tier++)
+		{
+			BatchSlerp(start.data(), end.data(), .3f, result.data(), count, tiers[tier]);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				CHECK(AngularError(result[i], FQuat::Slerp(start[i], end[i], .3f)) <= tolerances[tier]);
+				CHECK(result[i].Length() == Catch::Approx(1.f));
+			}
+
+			BatchSlerp(start.data(), end.data(), alphas.data(), result.data(), count, tiers[tier]);
+			for (std::size_t i = 0; i < count; i++)
+				CHECK(AngularError(result[i], FQuat::Slerp(start[i], end[i], alphas[i])) <= tolerances[tier]);
+		}
+
+		// in place
+		std::vector<FQuat> inPlace = start;
+		BatchSlerp(inPlace.data(), end.data(), .6f, inPlace.data(), count);
+		for (std::size_t i = 0; i < count; i++)
+			CHECK(AngularError(inPlace[i], FQuat::Slerp(start[i], end[i], .6f)) <= 2e-5f);
+	}
+
+	SECTION("Nlerp")
+	{
+		BatchNlerp(start.data(), end.data(), alphas.data(), result.data(), count);
+		for (std::size_t i = 0; i < count; i++)
+		{
+			CHECK_PACKET_QUAT(result[i], FQuat::Nlerp(start[i], end[i], alphas[i]));
+		}
+
+		BatchNlerp(start.data(), end.data(), 0.f, result.data(), count);
+		for (std::size_t i = 0; i < count; i++)
+			CHECK(AngularError(result[i], start[i]) <= 1e-3f);
+	}
+}
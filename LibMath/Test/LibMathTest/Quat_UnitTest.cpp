@@ -25,12 +25,12 @@ CHECK(matrix[2][0] == Catch::Approx(matrixDir(2, 0))); \
 CHECK(matrix[2][1] == Catch::Approx(matrixDir(2, 1))); \
 CHECK(matrix[2][2] == Catch::Approx(matrixDir(2, 2)))
 
-XMVECTOR ToQuat(const QuatD& pV4)
+static XMVECTOR ToQuat(const QuatD& pV4)
 {
 	return XMLoadFloat4(&pV4);
 }
 
-QuatD ToFloatFromQuat(const XMVECTOR& pVector)
+static QuatD ToFloatFromQuat(const XMVECTOR& pVector)
 {
 	QuatD v4F;
 	XMStoreFloat4(&v4F, pVector);
@@ -101,6 +101,14 @@ TEST_CASE("Quaternion", "[.all][vector][Quaternion]")
 		CHECK(twos != FQuat{ 2.f, 2.f, .5f, 2.f });
 		CHECK(twos != FQuat{ 2.f, 2.f, 2.f, .5f });
 
+		// q and -q describe the same rotation but compare different component-wise
+		FQuat rotation = FQuat::EulerToQuat(.5f, 1.25f, -.75f, FQuat::axis_order::ZXY);
+		FQuat negated{ -rotation.mX, -rotation.mY, -rotation.mZ, -rotation.mW };
+		CHECK(rotation != negated);
+		CHECK_FALSE(rotation.ApproxEqual(negated));
+		CHECK(rotation.ApproxEqual(rotation * FQuat{ 0.f, 0.f, 0.f, 1.f }, 1e-6f, 1e-6f));
+		CHECK(rotation.UlpEqual(rotation));
+
 		// testing comparaision fonctionnality
 		FQuat small{ 2.5f, .5f, 2.f, 3.f };
 		FQuat big{ 3.75f, 3.f, .75f, 1.5f };
@@ -116,6 +124,16 @@ TEST_CASE("Quaternion", "[.all][vector][Quaternion]")
 		CHECK_QUAT(FQuat::mZero, QuatD(0.f, 0.f, 0.f, 0.f));
 	}
 
+	SECTION("Compile time")
+	{
+		constexpr FQuat identity{ 0.f, 0.f, 0.f, 1.f };
+		constexpr FQuat rotation = identity * FQuat(0.f, 1.f, 0.f, 0.f);
+		STATIC_REQUIRE(rotation.mY == 1.f);
+		STATIC_REQUIRE(rotation.Conjugate().mY == -1.f);
+		STATIC_REQUIRE(rotation.DotProduct(identity) == 0.f);
+		STATIC_REQUIRE(FQuat::Lerp(FQuat::mZero, FQuat::mOne, .25f).mW == .25f);
+	}
+
 	SECTION("Arithmetic")
 	{
 		FQuat const small{ 2.5f, .5f, 2.f, 3.f };
@@ -226,11 +244,14 @@ TEST_CASE("Quaternion", "[.all][vector][Quaternion]")
 		{
 			SECTION("To quat")
 			{
-				FMat3 const baseMat{ 2.5f, .5f, 2.f, 1.5f, .75f, .25f, 2.75f,  2.25f, 1.25f };
+				// a quaternion only represents orthonormal matrices, build a rotation
+				XMMATRIX baseMatD = XMMatrixRotationRollPitchYaw(.5f, 1.25f, -.75f);
+				XMFLOAT3X3 mat;
+				XMStoreFloat3x3(&mat, baseMatD);
+
+				FMat3 const baseMat{ mat(0, 0), mat(0, 1), mat(0, 2), mat(1, 0), mat(1, 1), mat(1, 2), mat(2, 0), mat(2, 1), mat(2, 2) };
 				FQuat cQuat = FQuat::GetRotationQuaternion(baseMat);
 
-				XMFLOAT3X3 mat(2.5f, .5f, 2.f, 1.5f, .75f, .25f, 2.75f, 2.25f, 1.25f);
-				XMMATRIX baseMatD = XMLoadFloat3x3(&mat);
 				XMFLOAT4 dQuat = ToFloatFromQuat(XMQuaternionRotationMatrix(baseMatD));
 				CHECK_QUAT(cQuat, dQuat);
 			}
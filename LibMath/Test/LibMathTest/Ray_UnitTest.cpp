@@ -0,0 +1,220 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/RayPacket.h"
+#include "../../LibMath/Vertex.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace lm;
+
+TEST_CASE("Ray", "[.all][bounds][Ray]")
+{
+	SECTION("Box")
+	{
+		const FAABB box(FVec3(-1.f, -1.f, -1.f), FVec3(1.f, 1.f, 1.f));
+		float entry = 0.f;
+
+		CHECK(FRay(FVec3(-5.f, 0.f, 0.f), FVec3(1.f, 0.f, 0.f)).IntersectBox(box, 100.f, entry));
+		CHECK(entry == Catch::Approx(4.f));
+		CHECK_FALSE(FRay(FVec3(-5.f, 0.f, 0.f), FVec3(1.f, 0.f, 0.f)).IntersectBox(box, 3.f, entry));
+		CHECK_FALSE(FRay(FVec3(-5.f, 0.f, 0.f), FVec3(-1.f, 0.f, 0.f)).IntersectBox(box, 100.f, entry));
+		CHECK_FALSE(FRay(FVec3(-5.f, 2.f, 0.f), FVec3(1.f, 0.f, 0.f)).IntersectBox(box, 100.f, entry));
+
+		// inside: entry at 0
+		CHECK(FRay(FVec3(0.f, 0.f, 0.f), FVec3(0.f, 1.f, 0.f)).IntersectBox(box, 100.f, entry));
+		CHECK(entry == 0.f);
+
+		// grazing the face y = 1 with a zero y direction
+		CHECK(FRay(FVec3(-5.f, 1.f, 0.f), FVec3(1.f, 0.f, 0.f)).IntersectBox(box, 100.f, entry));
+	}
+
+	SECTION("Triangle")
+	{
+		const FVec3 a(0.f, 0.f, 0.f), b(2.f, 0.f, 0.f), c(0.f, 2.f, 0.f);
+
+		FRayHit hit;
+		CHECK(FRay(FVec3(.5f, .25f, 3.f), FVec3(0.f, 0.f, -1.f)).IntersectTriangle(a, b, c, hit));
+		CHECK(hit.mDistance == Catch::Approx(3.f));
+		CHECK(hit.mU == Catch::Approx(.25f));
+		CHECK(hit.mV == Catch::Approx(.125f));
+		CHECK(hit.mPrimitive == FRayHit().mPrimitive);
+
+		// both faces, the ray direction is not normalized
+		hit = FRayHit();
+		CHECK(FRay(FVec3(.5f, .25f, -3.f), FVec3(0.f, 0.f, 2.f)).IntersectTriangle(a, b, c, hit));
+		CHECK(hit.mDistance == Catch::Approx(1.5f));
+
+		// misses: outside, behind, parallel and farther than the current hit
+		hit = FRayHit();
+		CHECK_FALSE(FRay(FVec3(1.5f, 1.5f, 3.f), FVec3(0.f, 0.f, -1.f)).IntersectTriangle(a, b, c, hit));
+		CHECK_FALSE(FRay(FVec3(.5f, .25f, 3.f), FVec3(0.f, 0.f, 1.f)).IntersectTriangle(a, b, c, hit));
+		CHECK_FALSE(FRay(FVec3(.5f, .25f, 3.f), FVec3(1.f, 0.f, 0.f)).IntersectTriangle(a, b, c, hit));
+		hit.mDistance = 2.f;
+		CHECK_FALSE(FRay(FVec3(.5f, .25f, 3.f), FVec3(0.f, 0.f, -1.f)).IntersectTriangle(a, b, c, hit));
+		CHECK(hit.mDistance == 2.f);
+
+		DRayHit hitDouble;
+		CHECK(DRay(DVec3(.5, .25, 3.), DVec3(0., 0., -1.)).IntersectTriangle(DVec3(0., 0., 0.), DVec3(2., 0., 0.), DVec3(0., 2., 0.), hitDouble));
+		CHECK(hitDouble.mDistance == Catch::Approx(3.));
+	}
+
+	SECTION("Watertight")
+	{
+		// same hits as Moller-Trumbore away from the edges, for every dominant axis and sign
+		const FVec3 a(.3f, -1.f, .2f), b(1.7f, .4f, -.5f), c(-.6f, 1.1f, .8f);
+		for (int i = 0; i < 200; i++)
+		{
+			const float t = float(i);
+			const FVec3 target = a * .2f + b * (.3f + .001f * t) + c * (.5f - .001f * t);
+			const FVec3 origin(5.f * std::sin(t), 5.f * std::cos(1.3f * t), 5.f * std::sin(.7f * t + 1.f));
+			const FRay ray(origin, target - origin);
+
+			FRayHit hit, hitWatertight;
+			REQUIRE(ray.IntersectTriangle(a, b, c, hit));
+			REQUIRE(ray.IntersectTriangleWatertight(a, b, c, hitWatertight));
+			CHECK(hitWatertight.mDistance == Catch::Approx(hit.mDistance).epsilon(1e-4));
+			CHECK(hitWatertight.mU == Catch::Approx(hit.mU).margin(1e-4));
+			CHECK(hitWatertight.mV == Catch::Approx(hit.mV).margin(1e-4));
+
+			FRayHit miss;
+			CHECK_FALSE(FRay(origin, a * 1.2f - b * .1f - c * .1f - origin).IntersectTriangleWatertight(a, b, c, miss));
+		}
+
+		// closed fan around the center: rays through its shared edges and its center always hit
+		const FVec3 center(0.f, 0.f, 0.f);
+		std::vector<FVec3> rim;
+		for (int i = 0; i < 7; i++)
+			rim.emplace_back(std::cos(.8975979f * float(i)) * 1.3f, std::sin(.8975979f * float(i)) * 1.3f, .1f * float(i % 3));
+
+		for (int i = 0; i < 7; i++)
+			for (int j = 0; j < 16; j++)
+			{
+				const FVec3 target = center + rim[i] * (float(j) / 16.f);
+				const FVec3 origin(.37f * float(j) - 3.f, .11f * float(i) - .4f, 4.f);
+				const FRay ray(origin, target - origin);
+
+				FRayHit hit;
+				bool found = false;
+				for (int triangle = 0; triangle < 7; triangle++)
+					found = ray.IntersectTriangleWatertight(center, rim[triangle], rim[(triangle + 1) % 7], hit) || found;
+				CHECK(found);
+			}
+	}
+
+	SECTION("Packet")
+	{
+		const FAABB box(FVec3(-1.f, -2.f, -1.f), FVec3(2.f, 1.f, 3.f));
+		std::vector<FRay> rays;
+		for (int i = 0; i < 8; i++)
+		{
+			const float t = float(i);
+			const FVec3 origin(6.f * std::sin(t), 4.f * std::cos(2.f * t), 5.f * std::sin(.5f * t));
+			rays.emplace_back(origin, FVec3(.3f * t - 1.f, std::cos(3.f * t), .5f) * (i % 2 == 0 ? 1.f : -1.f) - origin * .1f);
+		}
+		rays[3] = FRay(FVec3(-5.f, 1.f, 0.f), FVec3(1.f, 0.f, 0.f));
+
+		const Rayx8 packet = Rayx8::Load(rays.data());
+		Simd::Float8 entry = Simd::Float8::Splat(0.f);
+		const int lanes = packet.IntersectBox(box, Simd::Float8::Splat(50.f), entry).Bits();
+
+		float entries[8];
+		entry.Store(entries);
+		int expected = 0;
+		for (int i = 0; i < 8; i++)
+		{
+			float scalarEntry = 0.f;
+			if (rays[i].IntersectBox(box, 50.f, scalarEntry))
+			{
+				expected |= 1 << i;
+				CHECK(entries[i] == Catch::Approx(scalarEntry));
+			}
+		}
+		CHECK(lanes == expected);
+		CHECK(expected != 0);
+		CHECK(expected != 0xFF);
+
+		const Rayx4 packet4 = Rayx4::Load(rays.data());
+		Simd::Float4 entry4 = Simd::Float4::Splat(0.f);
+		CHECK(packet4.IntersectBox(box, Simd::Float4::Splat(50.f), entry4).Bits() == (expected & 0xF));
+
+		// one ray against 4 triangles, lanes keep their own closest hit
+		const FRay ray(FVec3(.2f, .3f, 5.f), FVec3(0.f, 0.f, -1.f));
+		const FVec3 as[4] = { FVec3(0.f, 0.f, 1.f), FVec3(0.f, 0.f, 2.f), FVec3(3.f, 3.f, 0.f), FVec3(0.f, 0.f, 7.f) };
+		const FVec3 bs[4] = { FVec3(1.f, 0.f, 1.f), FVec3(1.f, 0.f, 2.f), FVec3(4.f, 3.f, 0.f), FVec3(1.f, 0.f, 7.f) };
+		const FVec3 cs[4] = { FVec3(0.f, 1.f, 1.f), FVec3(0.f, 1.f, 3.f), FVec3(3.f, 4.f, 0.f), FVec3(0.f, 1.f, 7.f) };
+
+		Simd::Float4 distance = Simd::Float4::Splat(10.f);
+		Simd::Float4 u = Simd::Float4::Splat(0.f), v = Simd::Float4::Splat(0.f);
+		const int hits = Rayx4(ray).IntersectTriangles(Vec3x4::Load(as), Vec3x4::Load(bs), Vec3x4::Load(cs), distance, u, v).Bits();
+		CHECK(hits == 0x3);
+
+		float distances[4], us[4], vs[4];
+		distance.Store(distances);
+		u.Store(us);
+		v.Store(vs);
+		for (int i = 0; i < 4; i++)
+		{
+			FRayHit hit;
+			hit.mDistance = 10.f;
+			CHECK(ray.IntersectTriangle(as[i], bs[i], cs[i], hit) == ((hits >> i & 1) != 0));
+			CHECK(distances[i] == Catch::Approx(hit.mDistance));
+			CHECK(us[i] == Catch::Approx(hit.mU));
+			CHECK(vs[i] == Catch::Approx(hit.mV));
+		}
+	}
+
+	SECTION("Mesh")
+	{
+		// 11 x 11 grid of wavy quads read through a Vertex stream: packed steps and a scalar tail
+		const std::uint32_t size = 11;
+		std::vector<Vertex> vertices;
+		for (std::uint32_t z = 0; z <= size; z++)
+			for (std::uint32_t x = 0; x <= size; x++)
+				vertices.emplace_back(float(x), std::sin(.7f * float(x)) * std::cos(.5f * float(z)), float(z));
+
+		std::vector<std::uint32_t> indices;
+		for (std::uint32_t z = 0; z < size; z++)
+			for (std::uint32_t x = 0; x < size; x++)
+			{
+				const std::uint32_t corner = z * (size + 1) + x;
+				for (const std::uint32_t index : { corner, corner + size + 1, corner + 1, corner + 1, corner + size + 1, corner + size + 2 })
+					indices.push_back(index);
+			}
+		const std::size_t triangleCount = indices.size() / 3;
+		REQUIRE(triangleCount % 8 != 0);
+
+		int hitCount = 0;
+		for (int i = 0; i < 64; i++)
+		{
+			const float t = float(i);
+			const FRay ray(FVec3(5.5f + 4.f * std::sin(t), 4.f, 5.5f + 4.f * std::cos(1.7f * t)),
+				FVec3(std::sin(2.3f * t), -1.f, .6f * std::cos(t)));
+
+			FRayHit expected;
+			for (std::size_t triangle = 0; triangle < triangleCount; triangle++)
+				if (ray.IntersectTriangle(vertices[indices[3 * triangle]].GetPosition(), vertices[indices[3 * triangle + 1]].GetPosition(),
+					vertices[indices[3 * triangle + 2]].GetPosition(), expected))
+					expected.mPrimitive = std::uint32_t(triangle);
+
+			FRayHit hit;
+			const bool found = RaycastTriangles(ray, &vertices[0].GetPosition(), indices.data(), triangleCount, hit, sizeof(Vertex));
+			CHECK(found == (expected.mPrimitive != FRayHit().mPrimitive));
+			CHECK(hit.mPrimitive == expected.mPrimitive);
+			CHECK(hit.mDistance == Catch::Approx(expected.mDistance));
+			CHECK(hit.mU == Catch::Approx(expected.mU).margin(1e-5));
+			CHECK(hit.mV == Catch::Approx(expected.mV).margin(1e-5));
+			hitCount += found ? 1 : 0;
+		}
+		CHECK(hitCount > 32);
+
+		// a closer hit given by the caller is kept
+		FRayHit blocked;
+		blocked.mDistance = .1f;
+		CHECK_FALSE(RaycastTriangles(FRay(FVec3(5.5f, 4.f, 5.5f), FVec3(0.f, -1.f, 0.f)), &vertices[0].GetPosition(),
+			indices.data(), triangleCount, blocked, sizeof(Vertex)));
+		CHECK(blocked.mDistance == .1f);
+	}
+}
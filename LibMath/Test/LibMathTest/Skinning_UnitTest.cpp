@@ -0,0 +1,226 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/Skinning.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace lm;
+
+#define CHECK_SKINNED_VEC3(vector, expected)				\
+CHECK((vector).X() == Catch::Approx((expected).X()).margin(1e-5)); \
+CHECK((vector).Y() == Catch::Approx((expected).Y()).margin(1e-5)); \
+CHECK((vector).Z() == Catch::Approx((expected).Z()).margin(1e-5))
+
+// blends the transformed vertex instead of the matrices
+static FVec3 ReferenceSkin(const SkinnedVertex& pVertex, const std::vector<FMat4>& pPalette, const FVec3& pValue, const float pW)
+{
+	FVec4 result(0.f, 0.f, 0.f, 0.f);
+	for (std::size_t k = 0; k < SkinnedVertex::mMaxInfluences; k++)
+		result += (pPalette[pVertex.GetBoneIndex(k)] * FVec4(pValue, pW)) * pVertex.GetBoneWeight(k);
+
+	return FVec3(result.X(), result.Y(), result.Z());
+}
+
+static std::vector<SkinnedVertex> MakeMesh(const std::size_t pCount, const std::size_t pPaletteSize)
+{
+	std::vector<SkinnedVertex> mesh;
+	for (std::size_t i = 0; i < pCount; i++)
+	{
+		const float t = float(i);
+		const Vertex vertex(FVec3(std::sin(t), .1f * t, std::cos(t * .7f)), FVec3(std::cos(t), 1.f, std::sin(t)).Normalize());
+
+		const std::uint16_t first = std::uint16_t(i % pPaletteSize);
+		const std::uint16_t second = std::uint16_t((i * 7 + 3) % pPaletteSize);
+		SkinnedVertex skinned(vertex, { first, second, std::uint16_t((i + 1) % pPaletteSize), 0 },
+			{ 1.f + float(i % 3), float(i % 4), i % 5 == 0 ? .5f : 0.f, 0.f });
+		skinned.NormalizeWeights();
+		mesh.push_back(skinned);
+	}
+	return mesh;
+}
+
+static std::vector<FMat4> MakePalette(const std::size_t pCount)
+{
+	std::vector<FMat4> palette;
+	for (std::size_t i = 0; i < pCount; i++)
+	{
+		const float angle = 25.f * float(i);
+		const float scale = 1.f + .25f * float(i % 3);
+		const FMat4 uniformScale(FVec4(scale, 0.f, 0.f, 0.f), FVec4(0.f, scale, 0.f, 0.f), FVec4(0.f, 0.f, scale, 0.f),
+			FVec4(0.f, 0.f, 0.f, 1.f));
+
+		palette.push_back(FMat4::zRotation(angle) * FMat4::xRotation(-angle * .5f) * uniformScale *
+			FMat4::Translation(FVec3(float(i), -2.f * float(i), .5f)));
+	}
+	return palette;
+}
+
+TEST_CASE("Skinning", "[.all][skinning][Skinning]")
+{
+	SECTION("SkinnedVertex")
+	{
+		const Vertex vertex(FVec3(1.f, 2.f, 3.f), FVec3(0.f, 1.f, 0.f), FVec2(.25f, .75f), FVec3(1.f, 0.f, 0.f));
+
+		SkinnedVertex skinned(vertex, { 3, 1, 0, 0 }, { 2.f, 6.f, 0.f, 0.f });
+		CHECK(skinned.GetBoneIndex(0) == 3);
+		CHECK(skinned.GetBoneIndex(1) == 1);
+		CHECK(skinned.GetBoneWeight(1) == 6.f);
+
+		skinned.NormalizeWeights();
+		CHECK(skinned.GetBoneWeight(0) == .25f);
+		CHECK(skinned.GetBoneWeight(1) == .75f);
+		CHECK(skinned.GetBoneWeight(2) == 0.f);
+		CHECK(skinned.ToVertex() == vertex);
+		CHECK(skinned.GetTextCoords() == FVec2(.25f, .75f));
+
+		SkinnedVertex unweighted(vertex);
+		unweighted.NormalizeWeights();
+		CHECK(unweighted.GetBoneWeight(0) == 0.f);
+	}
+
+	SECTION("Single bone")
+	{
+		const std::vector<FMat4> palette{ FMat4::mIdentity, FMat4::Translation(FVec3(1.f, -2.f, 3.f)) };
+		const Vertex vertex(FVec3(1.f, 2.f, 3.f), FVec3(0.f, 2.f, 0.f));
+
+		const SkinnedVertex mesh[2] = { SkinnedVertex(vertex, { 0, 0, 0, 0 }, { 1.f, 0.f, 0.f, 0.f }),
+			SkinnedVertex(vertex, { 1, 0, 0, 0 }, { 1.f, 0.f, 0.f, 0.f }) };
+
+		FVec3 positions[2];
+		FVec3 normals[2];
+		SkinVertices(mesh, 2, palette.data(), palette.size(), positions, normals);
+
+		CHECK(positions[0] == FVec3(1.f, 2.f, 3.f));
+		CHECK(positions[1] == FVec3(2.f, 0.f, 6.f));
+		CHECK(normals[0] == FVec3(0.f, 1.f, 0.f));
+		CHECK(normals[1] == FVec3(0.f, 1.f, 0.f));
+	}
+
+	SECTION("Blend")
+	{
+		const std::vector<FMat4> palette = MakePalette(6);
+		const std::vector<SkinnedVertex> mesh = MakeMesh(37, palette.size());
+
+		std::vector<FVec3> positions(mesh.size());
+		std::vector<FVec3> normals(mesh.size());
+		SkinVertices(mesh.data(), mesh.size(), palette.data(), palette.size(), positions.data(), normals.data());
+
+		for (std::size_t i = 0; i < mesh.size(); i++)
+		{
+			const FVec3 expectedPosition = ReferenceSkin(mesh[i], palette, mesh[i].GetPosition(), 1.f);
+			const FVec3 expectedNormal = ReferenceSkin(mesh[i], palette, mesh[i].GetNormal(), 0.f).Normalize();
+
+			CHECK_SKINNED_VEC3(positions[i], expectedPosition);
+			CHECK_SKINNED_VEC3(normals[i], expectedNormal);
+		}
+	}
+
+	SECTION("Threads")
+	{
+		const std::vector<FMat4> palette = MakePalette(9);
+		const std::vector<SkinnedVertex> mesh = MakeMesh(3 * Parallel::mMinElementsPerThread + 5, palette.size());
+
+		std::vector<FVec3> positions(mesh.size());
+		std::vector<FVec3> normals(mesh.size());
+		SkinVertices(mesh.data(), mesh.size(), palette.data(), palette.size(), positions.data(), normals.data(), 1);
+
+		// same kernel per vertex, the split must not change a bit
+		std::vector<FVec3> threadedPositions(mesh.size());
+		std::vector<FVec3> threadedNormals(mesh.size());
+		SkinVertices(mesh.data(), mesh.size(), palette.data(), palette.size(), threadedPositions.data(), threadedNormals.data(), 4);
+		CHECK(threadedPositions == positions);
+		CHECK(threadedNormals == normals);
+
+		std::vector<FVec3> positionsOnly(mesh.size());
+		SkinVertices(mesh.data(), mesh.size(), palette.data(), palette.size(), positionsOnly.data(), nullptr, 4);
+		CHECK(positionsOnly == positions);
+	}
+
+	SECTION("Dual quaternion")
+	{
+		std::vector<FDualQuat> dualPalette;
+		std::vector<FMat4> matrixPalette;
+		for (std::size_t i = 0; i < 6; i++)
+		{
+			const float t = float(i);
+			dualPalette.push_back(FDualQuat(FQuat::RotationAxis(.4f * t - 1.f, FVec3(1.f, t, 2.f)), FVec3(t, -1.f, .5f * t)));
+			matrixPalette.push_back(dualPalette.back().ToMat4());
+		}
+
+		const std::vector<SkinnedVertex> mesh = MakeMesh(37, dualPalette.size());
+
+		std::vector<FVec3> positions(mesh.size());
+		std::vector<FVec3> normals(mesh.size());
+		SkinVertices(mesh.data(), mesh.size(), dualPalette.data(), dualPalette.size(), positions.data(), normals.data());
+
+		for (std::size_t i = 0; i < mesh.size(); i++)
+		{
+			FDualQuat bones[SkinnedVertex::mMaxInfluences];
+			float weights[SkinnedVertex::mMaxInfluences];
+			for (std::size_t k = 0; k < SkinnedVertex::mMaxInfluences; k++)
+			{
+				bones[k] = dualPalette[mesh[i].GetBoneIndex(k)];
+				weights[k] = mesh[i].GetBoneWeight(k);
+			}
+
+			const FDualQuat blend = FDualQuat::Blend(bones, weights, SkinnedVertex::mMaxInfluences);
+			CHECK_SKINNED_VEC3(positions[i], blend.TransformPoint(mesh[i].GetPosition()));
+			CHECK_SKINNED_VEC3(normals[i], blend.TransformDirection(mesh[i].GetNormal()));
+			CHECK(normals[i].Length() == Catch::Approx(1.f));
+		}
+
+		// one influence per vertex: both palettes describe the same rigid bones
+		std::vector<SkinnedVertex> rigid;
+		for (std::size_t i = 0; i < mesh.size(); i++)
+			rigid.push_back(SkinnedVertex(mesh[i].ToVertex(), { std::uint16_t(i % dualPalette.size()), 0, 0, 0 },
+				{ 1.f, 0.f, 0.f, 0.f }));
+
+		std::vector<FVec3> matrixPositions(mesh.size());
+		std::vector<FVec3> matrixNormals(mesh.size());
+		SkinVertices(rigid.data(), rigid.size(), dualPalette.data(), dualPalette.size(), positions.data(), normals.data());
+		SkinVertices(rigid.data(), rigid.size(), matrixPalette.data(), matrixPalette.size(), matrixPositions.data(),
+			matrixNormals.data());
+
+		for (std::size_t i = 0; i < mesh.size(); i++)
+		{
+			CHECK_SKINNED_VEC3(positions[i], matrixPositions[i]);
+			CHECK_SKINNED_VEC3(normals[i], matrixNormals[i]);
+		}
+
+		// an unweighted slot naming a bone opposite to one of the twists does not pick the hemisphere
+		const FDualQuat twist[3] = { FDualQuat(FQuat::RotationAxis(3.f, FVec3(1.f, 0.f, 0.f)), FVec3()),
+			FDualQuat(FQuat::RotationAxis(1.5f, FVec3(1.f, 0.f, 0.f)), FVec3()),
+			FDualQuat(FQuat::RotationAxis(-1.5f, FVec3(1.f, 0.f, 0.f)), FVec3()) };
+		const SkinnedVertex padded(Vertex(FVec3(0.f, 1.f, 0.f), FVec3(0.f, 0.f, 1.f)), { 0, 1, 2, 0 }, { 0.f, .5f, .5f, 0.f });
+		SkinVertices(&padded, 1, twist, 3, positions.data(), normals.data());
+		CHECK_SKINNED_VEC3(positions[0], FVec3(0.f, 1.f, 0.f));
+		CHECK_SKINNED_VEC3(normals[0], FVec3(0.f, 0.f, 1.f));
+
+		// no weight at all skins to 0 with both palettes, not to a division by a zero length
+		const SkinnedVertex unweighted(Vertex(FVec3(1.f, 2.f, 3.f), FVec3(0.f, 0.f, 1.f)), { 1, 2, 0, 0 }, { 0.f, 0.f, 0.f, 0.f });
+		SkinVertices(&unweighted, 1, twist, 3, positions.data(), normals.data());
+		SkinVertices(&unweighted, 1, matrixPalette.data(), matrixPalette.size(), matrixPositions.data(), matrixNormals.data());
+		CHECK(positions[0] == FVec3(0.f));
+		CHECK(normals[0] == FVec3(0.f));
+		CHECK(matrixPositions[0] == FVec3(0.f));
+		CHECK(matrixNormals[0] == FVec3(0.f));
+	}
+
+	SECTION("Parallel ranges")
+	{
+		for (const std::size_t count : { std::size_t(0), std::size_t(1), std::size_t(5), std::size_t(9), std::size_t(1000) })
+		{
+			std::vector<std::atomic<int>> visits(count);
+			Parallel::ForRanges(count, 1, 4, [&visits](const std::size_t pBegin, const std::size_t pEnd)
+				{
+					for (std::size_t i = pBegin; i < pEnd; i++)
+						visits[i]++;
+				});
+
+			for (std::size_t i = 0; i < count; i++)
+				CHECK(visits[i] == 1);
+		}
+	}
+}
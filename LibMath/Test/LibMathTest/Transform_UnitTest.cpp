@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/Transform.h"
+
+using namespace lm;
+
+#define CHECK_TRANSFORM_VEC3(vector, expected)				  \
+CHECK((vector).X() == Catch::Approx((expected).X()).margin(1e-5)); \
+CHECK((vector).Y() == Catch::Approx((expected).Y()).margin(1e-5)); \
+CHECK((vector).Z() == Catch::Approx((expected).Z()).margin(1e-5))
+
+static FVec3 Transformed(const FMat4& pMatrix, const FVec3& pPoint, const float pW = 1.f)
+{
+	const FVec4 result = pMatrix * FVec4(pPoint, pW);
+	return FVec3(result.X(), result.Y(), result.Z());
+}
+
+TEST_CASE("Transform", "[.all][transform][Transform]")
+{
+	const FQuat rotation = FQuat::RotationAxis(.8f, FVec3(1.f, -2.f, .5f));
+	const FTransform transform(FVec3(3.f, -1.f, .5f), rotation, FVec3(2.f, .5f, 1.5f));
+	const FTransform uniform(FVec3(-2.f, 4.f, 1.f), FQuat::RotationAxis(-2.1f, FVec3(0.f, 1.f, 1.f)), FVec3(1.5f, 1.5f, 1.5f));
+	const FVec3 point(.5f, -2.f, 1.5f);
+
+	SECTION("Instantiation")
+	{
+		CHECK(FTransform() == FTransform::mIdentity);
+		CHECK(FTransform::mIdentity.TransformPoint(point) == point);
+		CHECK(FTransform(FVec3(1.f, 2.f, 3.f)).mScale == FVec3(1.f, 1.f, 1.f));
+
+		constexpr FTransform moved(FVec3(1.f, 2.f, 3.f), FQuat(0.f, 0.f, 0.f, 1.f), FVec3(2.f, 2.f, 2.f));
+		STATIC_REQUIRE(moved.TransformPoint(FVec3(1.f, 1.f, 1.f)).Z() == 5.f);
+		STATIC_REQUIRE(moved.TransformDirection(FVec3(1.f, 1.f, 1.f)).Z() == 2.f);
+	}
+
+	SECTION("Transform")
+	{
+		// scale, then rotate, then translate
+		FQuat rotate = rotation;
+		CHECK_TRANSFORM_VEC3(transform.TransformPoint(point), rotate * (point * transform.mScale) + transform.mTranslation);
+		CHECK_TRANSFORM_VEC3(transform.TransformDirection(point), rotate * (point * transform.mScale));
+		CHECK_TRANSFORM_VEC3(transform.InverseTransformPoint(transform.TransformPoint(point)), point);
+
+		const FMat4 scale(FVec4(2.f, 0.f, 0.f, 0.f), FVec4(0.f, .5f, 0.f, 0.f), FVec4(0.f, 0.f, 1.5f, 0.f),
+			FVec4(0.f, 0.f, 0.f, 1.f));
+		const FMat4 matrix = transform.ToMat4();
+		CHECK(matrix.ApproxEqual(scale * rotation.ToMat4() * FMat4::Translation(transform.mTranslation), 1e-6f));
+		CHECK_TRANSFORM_VEC3(Transformed(matrix, point), transform.TransformPoint(point));
+		CHECK_TRANSFORM_VEC3(Transformed(matrix, point, 0.f), transform.TransformDirection(point));
+	}
+
+	SECTION("Composition")
+	{
+		// a * b applies b first, the reverse of the row-vector matrix product
+		const FTransform product = uniform * transform;
+		CHECK_TRANSFORM_VEC3(product.TransformPoint(point), uniform.TransformPoint(transform.TransformPoint(point)));
+		CHECK(product.ToMat4().ApproxEqual(transform.ToMat4() * uniform.ToMat4(), 1e-5f));
+
+		FTransform self = uniform;
+		self *= transform;
+		CHECK(self.ApproxEqual(product, 1e-6f));
+
+		// a non-uniform parent scale only holds for an unrotated child
+		const FTransform child(FVec3(1.f, 0.f, -1.f), FQuat(0.f, 0.f, 0.f, 1.f), FVec3(1.f, 2.f, 1.f));
+		CHECK_TRANSFORM_VEC3((transform * child).TransformPoint(point), transform.TransformPoint(child.TransformPoint(point)));
+	}
+
+	SECTION("Inverse")
+	{
+		CHECK((uniform * uniform.Inverse()).ApproxEqual(FTransform::mIdentity, 1e-5f));
+		CHECK((uniform.Inverse() * uniform).ApproxEqual(FTransform::mIdentity, 1e-5f));
+		CHECK_TRANSFORM_VEC3(uniform.Inverse().TransformPoint(uniform.TransformPoint(point)), point);
+		CHECK(uniform.Inverse().ToMat4().ApproxEqual(uniform.ToMat4().Inverse(), 1e-5f));
+	}
+
+	SECTION("Interpolation")
+	{
+		CHECK(FTransform::Lerp(transform, uniform, 0.f).ApproxEqual(transform, 1e-6f));
+		CHECK(FTransform::Slerp(transform, uniform, 1.f).ApproxEqual(uniform, 1e-6f));
+
+		const FTransform half = FTransform::Slerp(transform, uniform, .5f);
+		CHECK_TRANSFORM_VEC3(half.mTranslation, (transform.mTranslation + uniform.mTranslation) * .5f);
+		CHECK_TRANSFORM_VEC3(half.mScale, (transform.mScale + uniform.mScale) * .5f);
+		CHECK(half.mRotation.ApproxEqual(FQuat::Slerp(transform.mRotation, uniform.mRotation, .5f), 1e-6f));
+		CHECK(FTransform::Lerp(transform, uniform, .5f).mRotation.Length() == Catch::Approx(1.f));
+	}
+}
@@ -3,6 +3,7 @@
 
 #include "../../LibMath/Vec2.h"
 #include <DirectXMath.h>
+#include <cstring>
 
 using namespace lm;
 using namespace DirectX;
@@ -12,12 +13,12 @@ using Dv2 = DirectX::XMFLOAT2;
 CHECK(vector.X() == Catch::Approx(vectorDir.x)); \
 CHECK(vector.Y() == Catch::Approx(vectorDir.y))
 
-XMVECTOR ToVector(const Dv2& pV2)
+static XMVECTOR ToVector(const Dv2& pV2)
 {
 	return XMLoadFloat2(&pV2);
 }
 
-Dv2 ToFloat(const XMVECTOR& pVector)
+static Dv2 ToFloat(const XMVECTOR& pVector)
 {
 	Dv2 v2F;
 	XMStoreFloat2(&v2F, pVector);
@@ -53,8 +54,8 @@ TEST_CASE("Vector2", "[.all][vector][Vector2]")
 		CHECK_VECTOR2(empty, emptyD);
 
 		// DirectX compatibility
-		//CHECK(sizeof FVec2 == sizeof XMVECTOR);
-		//CHECK(memcmp(&allParam, &allParamD, sizeof FVec2));
+		CHECK(sizeof(FVec2) == sizeof(Dv2));
+		CHECK(std::memcmp(&allParam, &allParamD, sizeof(FVec2)) == 0);
 	}
 
 	SECTION("Accessor")
@@ -67,6 +68,13 @@ TEST_CASE("Vector2", "[.all][vector][Vector2]")
 			FVec2 const& vectorConst = vector;
 			CHECK(vectorConst[0] == x);
 			CHECK(vectorConst[1] == y);
+			CHECK(vectorConst['x'] == x);
+			CHECK(vectorConst['y'] == y);
+		}
+
+		{
+			// an axis name is not the index of its character
+			CHECK(&vector['y'] == &vector[1]);
 		}
 
 		{
@@ -259,6 +267,8 @@ TEST_CASE("Vector2", "[.all][vector][Vector2]")
 
 				CHECK(magnitude == Catch::Approx(magnitudeD));
 			}
+
+			CHECK(base.DistanceFrom(other) == Catch::Approx((other - base).Length()));
 		}
 
 		SECTION("Normal")
@@ -3,6 +3,8 @@
 
 #include "../../LibMath/Vec3.h"
 #include <DirectXMath.h>
+#include <cmath>
+#include <cstring>
 
 using namespace lm;
 using namespace DirectX;
@@ -13,12 +15,12 @@ CHECK(vector.X() == Catch::Approx(vectorDir.x)); \
 CHECK(vector.Y() == Catch::Approx(vectorDir.y)); \
 CHECK(vector.Z() == Catch::Approx(vectorDir.z))
 
-XMVECTOR ToVector(const Dv3& pV3)
+static XMVECTOR ToVector(const Dv3& pV3)
 {
 	return XMLoadFloat3(&pV3);
 }
 
-Dv3 ToFloat(const XMVECTOR& pVector)
+static Dv3 ToFloat(const XMVECTOR& pVector)
 {
 	Dv3 v3F;
 	XMStoreFloat3(&v3F, pVector);
@@ -54,8 +56,8 @@ TEST_CASE("Vector3", "[.all][vector][Vector3]")
 		CHECK_VECTOR3(empty, emptyD);
 
 		// DirectX compatibility
-		//CHECK(sizeof FVec3 == sizeof XMVECTOR);
-		//CHECK(memcmp(&allParam, &allParamD, sizeof FVec3));
+		CHECK(sizeof(FVec3) == sizeof(Dv3));
+		CHECK(std::memcmp(&allParam, &allParamD, sizeof(FVec3)) == 0);
 	}
 
 	SECTION("Accessor")
@@ -70,6 +72,13 @@ TEST_CASE("Vector3", "[.all][vector][Vector3]")
 			CHECK(vectorConst[0] == x);
 			CHECK(vectorConst[1] == y);
 			CHECK(vectorConst[2] == z);
+			CHECK(vectorConst['x'] == x);
+			CHECK(vectorConst['z'] == z);
+		}
+
+		{
+			// an axis name is not the index of its character
+			CHECK(&vector['y'] == &vector[1]);
 		}
 
 		{
@@ -80,6 +89,31 @@ TEST_CASE("Vector3", "[.all][vector][Vector3]")
 			CHECK(vector[1] == y + 1.f);
 			CHECK(vector[2] == z + 1.f);
 		}
+
+		{
+			// compile time index
+			vector.get<1>() = y;
+			CHECK(vector.get<0>() == x + 1.f);
+			CHECK(vector.get<1>() == y);
+			CHECK(vector.get<2>() == z + 1.f);
+
+			auto [bx, by, bz] = vector;
+			CHECK(bx == vector.X());
+			CHECK(by == vector.Y());
+			CHECK(bz == vector.Z());
+
+			FVec3 reversed = vector.Swizzle<2, 1, 0>();
+			CHECK(reversed.X() == vector.Z());
+			CHECK(reversed.Y() == vector.Y());
+			CHECK(reversed.Z() == vector.X());
+
+			FVec2 xz = vector.Swizzle<0, 2>();
+			CHECK(xz.X() == vector.X());
+			CHECK(xz.Y() == vector.Z());
+
+			STATIC_REQUIRE(FVec3(1.f, 2.f, 3.f).Swizzle<1, 1, 0>() == FVec3(2.f, 2.f, 1.f));
+			STATIC_REQUIRE(FVec3(1.f, 2.f, 3.f).get<2>() == 3.f);
+		}
 	}
 
 	SECTION("Comparator")
@@ -120,6 +154,37 @@ TEST_CASE("Vector3", "[.all][vector][Vector3]")
 
 		CHECK_FALSE(self.IsUnit());
 		CHECK(FVec3{ 0.771516740f, 0.154303357f, 0.617213428f }.IsUnit());
+
+		// equality is component-wise, not by length
+		CHECK_FALSE(FVec3{ 1.f, 0.f, 0.f } == FVec3{ 0.f, 1.f, 0.f });
+		CHECK(FVec3{ 0.f, 0.f, 0.f } == FVec3{ -0.f, 0.f, 0.f });
+
+		// ordering is by magnitude
+		CHECK(small < big);
+		CHECK(small <= big);
+		CHECK(big > small);
+		CHECK(big >= small);
+		CHECK_FALSE(small > big);
+		CHECK_FALSE(small >= big);
+		CHECK(FVec3{ 1.f, 0.f, 0.f } <= FVec3{ 0.f, 1.f, 0.f });
+		CHECK(FVec3{ 1.f, 0.f, 0.f } >= FVec3{ 0.f, 1.f, 0.f });
+		CHECK_FALSE(FVec3{ 1.f, 0.f, 0.f } < FVec3{ 0.f, 1.f, 0.f });
+		CHECK_FALSE(FVec3{ 1.f, 0.f, 0.f } > FVec3{ 0.f, 1.f, 0.f });
+
+		// approximate comparisons
+		FVec3 third{ 1.f / 3.f, 2.f / 3.f, 1.f };
+		FVec3 nearThird{ std::nextafter(third.X(), 1.f), third.Y(), std::nextafter(third.Z(), 0.f) };
+		CHECK_FALSE(third == nearThird);
+		CHECK(third.ApproxEqual(nearThird));
+		CHECK(third.UlpEqual(nearThird, 1));
+		CHECK_FALSE(third.UlpEqual(FVec3{ 1.f / 3.f, 2.f / 3.f, 1.001f }));
+		CHECK_FALSE(third.ApproxEqual(FVec3{ 1.f / 3.f, 2.f / 3.f, 1.001f }));
+		CHECK(third.ApproxEqual(FVec3{ 1.f / 3.f, 2.f / 3.f, 1.001f }, 0.f, 1e-2f));
+		CHECK(FVec3{ 0.f, 1e-9f, 0.f }.ApproxEqual(FVec3::mZero, 1e-6f, 0.f));
+		CHECK_FALSE(FVec3{ 0.f, 1e-9f, 0.f }.ApproxEqual(FVec3::mZero, 0.f, 1e-2f));
+
+		STATIC_REQUIRE(FVec3{ 1.f, 2.f, 3.f } == FVec3{ 1.f, 2.f, 3.f });
+		STATIC_REQUIRE(FVec3{ 1.f, 2.f, 3.f } < FVec3{ 3.f, 2.f, 1.1f });
 	}
 
 	SECTION("Constant")
@@ -141,6 +206,20 @@ TEST_CASE("Vector3", "[.all][vector][Vector3]")
 		CHECK_VECTOR3(FVec3::mZero, Dv3(0.f, 0.f, 0.f));
 	}
 
+	SECTION("Compile time")
+	{
+		constexpr FVec3 right = FVec3::mUp.CrossProduct(FVec3::mForward);
+		STATIC_REQUIRE(right.X() == 1.f);
+		STATIC_REQUIRE(FVec3::mUp.DotProduct(FVec3::mDown) == -1.f);
+
+		constexpr FVec3 sum = (FVec3(1.f, 2.f, 3.f) + FVec3::mOne) * 2.f - FVec3(.5f);
+		STATIC_REQUIRE(sum.Y() == 5.5f);
+		STATIC_REQUIRE(sum.Length2() == 3.5f * 3.5f + 5.5f * 5.5f + 7.5f * 7.5f);
+
+		constexpr FVec3 half = FVec3::Lerp(FVec3::mZero, FVec3(2.f, 4.f, 6.f), .5f);
+		STATIC_REQUIRE(half[2] == 3.f);
+	}
+
 	SECTION("Arithmetic")
 	{
 		FVec3 const small{ 2.5f, .5f, 2.f };
@@ -270,6 +349,8 @@ TEST_CASE("Vector3", "[.all][vector][Vector3]")
 
 				CHECK(magnitude == Catch::Approx(magnitudeD));
 			}
+
+			CHECK(base.DistanceFrom(other) == Catch::Approx((other - base).Length()));
 		}
 
 		SECTION("Normal")
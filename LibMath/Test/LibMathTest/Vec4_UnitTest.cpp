@@ -3,6 +3,7 @@
 
 #include "../../LibMath/Vec4.h"
 #include <DirectXMath.h>
+#include <cstring>
 
 using namespace lm;
 using namespace DirectX;
@@ -14,12 +15,12 @@ CHECK(vector.Y() == Catch::Approx(vectorDir.y)); \
 CHECK(vector.Z() == Catch::Approx(vectorDir.z)); \
 CHECK(vector.W() == Catch::Approx(vectorDir.w))
 
-XMVECTOR ToVector(const Dv4& pV4)
+static XMVECTOR ToVector(const Dv4& pV4)
 {
 	return XMLoadFloat4(&pV4);
 }
 
-Dv4 ToFloat(const XMVECTOR& pVector)
+static Dv4 ToFloat(const XMVECTOR& pVector)
 {
 	Dv4 v4F;
 	XMStoreFloat4(&v4F, pVector);
@@ -55,8 +56,8 @@ TEST_CASE("Vector4", "[.all][vector][Vector4]")
 		CHECK_VECTOR4(empty, emptyD);
 
 		// DirectX compatibility
-		//CHECK(sizeof FVec4 == sizeof XMVECTOR);
-		//CHECK(memcmp(&allParam, &allParamD, sizeof FVec4));
+		CHECK(sizeof(FVec4) == sizeof(Dv4));
+		CHECK(std::memcmp(&allParam, &allParamD, sizeof(FVec4)) == 0);
 	}
 
 	SECTION("Accessor")
@@ -73,6 +74,13 @@ TEST_CASE("Vector4", "[.all][vector][Vector4]")
 			CHECK(vectorConst[1] == y);
 			CHECK(vectorConst[2] == z);
 			CHECK(vectorConst[3] == w);
+			CHECK(vectorConst['x'] == x);
+			CHECK(vectorConst['w'] == w);
+		}
+
+		{
+			// an axis name is not the index of its character
+			CHECK(&vector['y'] == &vector[1]);
 		}
 
 		{
@@ -85,6 +93,35 @@ TEST_CASE("Vector4", "[.all][vector][Vector4]")
 			CHECK(vector[2] == z + 1.f);
 			CHECK(vector[3] == w + 1.f);
 		}
+
+		{
+			// compile time index
+			vector.get<3>() = w;
+			CHECK(vector.get<0>() == x + 1.f);
+			CHECK(vector.get<3>() == w);
+
+			auto [bx, by, bz, bw] = vector;
+			CHECK(bx == vector.X());
+			CHECK(by == vector.Y());
+			CHECK(bz == vector.Z());
+			CHECK(bw == vector.W());
+
+			Dv4 vectorD{ vector.X(), vector.Y(), vector.Z(), vector.W() };
+			FVec4 wzyx = vector.Swizzle<3, 2, 1, 0>();
+			Dv4 wzyxD = ToFloat(XMVectorSwizzle(ToVector(vectorD), 3, 2, 1, 0));
+			CHECK_VECTOR4(wzyx, wzyxD);
+
+			FVec4 yyxz = vector.Swizzle<1, 1, 0, 2>();
+			Dv4 yyxzD = ToFloat(XMVectorSwizzle(ToVector(vectorD), 1, 1, 0, 2));
+			CHECK_VECTOR4(yyxz, yyxzD);
+
+			FVec3 xyz = vector.Swizzle<0, 1, 2>();
+			CHECK(xyz.X() == vector.X());
+			CHECK(xyz.Y() == vector.Y());
+			CHECK(xyz.Z() == vector.Z());
+
+			STATIC_REQUIRE(FVec4(1.f, 2.f, 3.f, 4.f).Swizzle<3, 3, 0, 1>() == FVec4(4.f, 4.f, 1.f, 2.f));
+		}
 	}
 
 	SECTION("Comparator")
@@ -146,6 +183,20 @@ TEST_CASE("Vector4", "[.all][vector][Vector4]")
 		CHECK_VECTOR4(FVec4::mZero, Dv4(0.f, 0.f, 0.f, 0.f));
 	}
 
+	SECTION("Compile time")
+	{
+		// FVec4 uses the SIMD kernels at runtime, constant evaluation takes the scalar path
+		constexpr FVec4 sum = FVec4(1.f, 2.f, 3.f, 4.f) + FVec4::mOne * 2.f - FVec4(.5f);
+		STATIC_REQUIRE(sum.W() == 5.5f);
+		STATIC_REQUIRE(sum.DotProduct(FVec4::mRight) == 2.5f);
+
+		constexpr FVec4 product = FVec4(2.f) * FVec4(1.f, 2.f, 3.f, 4.f);
+		STATIC_REQUIRE(product[3] == 8.f);
+		STATIC_REQUIRE(FVec4(2.f, 4.f, 6.f, 2.f).Homogenize().Z() == 3.f);
+
+		CHECK_VECTOR4(sum, Dv4(2.5f, 3.5f, 4.5f, 5.5f));
+	}
+
 	SECTION("Arithmetic")
 	{
 		FVec4 const small{ 2.5f, .5f, 2.f, 3.f };
@@ -275,6 +326,8 @@ TEST_CASE("Vector4", "[.all][vector][Vector4]")
 
 				CHECK(magnitude == Catch::Approx(magnitudeD));
 			}
+
+			CHECK(base.DistanceFrom(other) == Catch::Approx((other - base).Length()));
 		}
 
 		SECTION("Normal")
@@ -0,0 +1,188 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/Vec3SoA.h"
+#include "../../LibMath/Vec4SoA.h"
+
+using namespace lm;
+
+#define CHECK_SOA3(vector, expected)					   \
+CHECK((vector).X() == Catch::Approx((expected).X())); \
+CHECK((vector).Y() == Catch::Approx((expected).Y())); \
+CHECK((vector).Z() == Catch::Approx((expected).Z()))
+
+#define CHECK_SOA4(vector, expected)					   \
+CHECK_SOA3(vector, expected);							   \
+CHECK((vector).W() == Catch::Approx((expected).W()))
+
+// 11 elements so every kernel runs both the packed loop and the scalar remainder
+static const std::size_t gCount = 11;
+
+TEST_CASE("Vector3SoA", "[.all][vector][Vector3SoA]")
+{
+	std::vector<FVec3> first;
+	std::vector<FVec3> second;
+	for (std::size_t i = 0; i < gCount; i++)
+	{
+		first.push_back(FVec3(1.f + i, -2.f + .5f * i, .25f * i + 3.f));
+		second.push_back(FVec3(.5f * i - 4.f, 2.f, 1.f + i * i * .1f));
+	}
+
+	SECTION("Instantiation")
+	{
+		FVec3SoA empty;
+		CHECK(empty.Size() == 0);
+
+		FVec3SoA sized{ gCount };
+		CHECK(sized.Size() == gCount);
+		CHECK_SOA3(sized[gCount - 1], FVec3::mZero);
+
+		FVec3SoA copy{ first.data(), first.size() };
+		REQUIRE(copy.Size() == gCount);
+		for (std::size_t i = 0; i < gCount; i++)
+		{
+			CHECK_SOA3(copy[i], first[i]);
+		}
+
+		FVec3SoA pushed;
+		pushed.Reserve(2);
+		pushed.PushBack(first[0]);
+		pushed.PushBack(first[1]);
+		CHECK(pushed.Size() == 2);
+		CHECK_SOA3(pushed[1], first[1]);
+
+		pushed.Clear();
+		CHECK(pushed.Size() == 0);
+	}
+
+	SECTION("Accessor")
+	{
+		FVec3SoA soa{ first.data(), first.size() };
+
+		soa[3] = FVec3(7.f, 8.f, 9.f);
+		CHECK(soa.X()[3] == 7.f);
+		CHECK(soa.Y()[3] == 8.f);
+		CHECK(soa.Z()[3] == 9.f);
+
+		soa[4].Y() = 42.f;
+		CHECK(soa.Y()[4] == 42.f);
+
+		FVec3 element = soa[5];
+		CHECK_SOA3(element, first[5]);
+
+		const FVec3SoA& constSoa = soa;
+		CHECK_SOA3(constSoa[5], first[5]);
+
+		std::vector<FVec3> stored(gCount);
+		soa.Store(stored.data());
+		CHECK_SOA3(stored[3], FVec3(7.f, 8.f, 9.f));
+		CHECK_SOA3(stored[6], first[6]);
+	}
+
+	SECTION("Functionality")
+	{
+		FVec3SoA a{ first.data(), first.size() };
+		FVec3SoA b{ second.data(), second.size() };
+
+		// element proxy forwards to Vec3
+		CHECK(a[2].Length() == Catch::Approx(first[2].Length()));
+		CHECK(a[2].DotProduct(second[2]) == Catch::Approx(first[2].DotProduct(second[2])));
+		CHECK_SOA3(a[2].CrossProduct(second[2]), first[2].CrossProduct(second[2]));
+
+		std::vector<float> dot(gCount);
+		std::vector<float> length(gCount);
+		std::vector<float> length2(gCount);
+		a.DotProduct(b, dot.data());
+		a.Length(length.data());
+		a.Length2(length2.data());
+
+		FVec3SoA cross;
+		a.CrossProduct(b, cross);
+
+		FVec3SoA normalized;
+		a.Normalize(normalized);
+
+		FVec3SoA lerp;
+		FVec3SoA::Lerp(a, b, .3f, lerp);
+
+		for (std::size_t i = 0; i < gCount; i++)
+		{
+			CHECK(dot[i] == Catch::Approx(first[i].DotProduct(second[i])));
+			CHECK(length[i] == Catch::Approx(first[i].Length()));
+			CHECK(length2[i] == Catch::Approx(first[i].Length2()));
+			CHECK_SOA3(cross[i], first[i].CrossProduct(second[i]));
+			CHECK_SOA3(normalized[i], first[i].Normalize());
+			CHECK_SOA3(lerp[i], FVec3::Lerp(first[i], second[i], .3f));
+		}
+
+		a.NormalizeSelf();
+		for (std::size_t i = 0; i < gCount; i++)
+		{
+			CHECK_SOA3(a[i], first[i].Normalize());
+		}
+	}
+}
+
+TEST_CASE("Vector4SoA", "[.all][vector][Vector4SoA]")
+{
+	std::vector<FVec4> first;
+	std::vector<FVec4> second;
+	for (std::size_t i = 0; i < gCount; i++)
+	{
+		first.push_back(FVec4(1.f + i, -2.f + .5f * i, .25f * i + 3.f, 1.f));
+		second.push_back(FVec4(.5f * i - 4.f, 2.f, 1.f + i * i * .1f, -.5f * i));
+	}
+
+	SECTION("Instantiation")
+	{
+		FVec4SoA sized{ gCount };
+		CHECK(sized.Size() == gCount);
+
+		FVec4SoA copy{ first.data(), first.size() };
+		REQUIRE(copy.Size() == gCount);
+		for (std::size_t i = 0; i < gCount; i++)
+		{
+			CHECK_SOA4(copy[i], first[i]);
+		}
+	}
+
+	SECTION("Accessor")
+	{
+		FVec4SoA soa{ first.data(), first.size() };
+
+		soa[3] = FVec4(7.f, 8.f, 9.f, 10.f);
+		CHECK(soa.W()[3] == 10.f);
+
+		soa[4].W() = 42.f;
+		CHECK(soa.W()[4] == 42.f);
+
+		std::vector<FVec4> stored(gCount);
+		soa.Store(stored.data());
+		CHECK_SOA4(stored[3], FVec4(7.f, 8.f, 9.f, 10.f));
+	}
+
+	SECTION("Functionality")
+	{
+		FVec4SoA a{ first.data(), first.size() };
+		FVec4SoA b{ second.data(), second.size() };
+
+		std::vector<float> dot(gCount);
+		std::vector<float> length(gCount);
+		a.DotProduct(b, dot.data());
+		a.Length(length.data());
+
+		FVec4SoA normalized;
+		a.Normalize(normalized);
+
+		FVec4SoA lerp;
+		FVec4SoA::Lerp(a, b, .75f, lerp);
+
+		for (std::size_t i = 0; i < gCount; i++)
+		{
+			CHECK(dot[i] == Catch::Approx(first[i].DotProduct(second[i])));
+			CHECK(length[i] == Catch::Approx(first[i].Length()));
+			CHECK_SOA4(normalized[i], first[i].Normalize());
+			CHECK_SOA4(lerp[i], (first[i] * .25f) + (second[i] * .75f));
+		}
+	}
+}
@@ -0,0 +1,195 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include "../../LibMath/VertexBuffer.h"
+#include "MeshGrid.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace lm;
+
+static std::vector<Vertex> MakeVertices(const std::size_t pCount)
+{
+	std::vector<Vertex> vertices;
+	for (std::size_t i = 0; i < pCount; i++)
+	{
+		const float t = float(i);
+		vertices.emplace_back(FVec3(std::sin(t), .5f * t, std::cos(.3f * t)), FVec3(std::cos(t), 1.f, std::sin(2.f * t)).Normalize(),
+			FVec2(.1f * t, 1.f - .1f * t), FVec3(.5f, .01f * t, 1.f));
+	}
+	return vertices;
+}
+
+static FMat4 ScaleMatrix(const FVec3& pScale)
+{
+	FMat4 scale(1.f);
+	for (int axis = 0; axis < 3; axis++)
+		scale[axis][axis] = pScale[axis];
+	return scale;
+}
+
+TEST_CASE("VertexBuffer", "[.all][mesh][VertexBuffer]")
+{
+	const std::vector<Vertex> vertices = MakeVertices(37);
+
+	SECTION("Layout")
+	{
+		for (const VertexLayout layout : { VertexLayout::Interleaved, VertexLayout::Deinterleaved })
+		{
+			VertexBuffer buffer(vertices.data(), vertices.size(), layout);
+			CHECK(buffer.GetLayout() == layout);
+			REQUIRE(buffer.Size() == vertices.size());
+			CHECK((buffer.GetVertices() != nullptr) == (layout == VertexLayout::Interleaved));
+
+			for (std::size_t i = 0; i < vertices.size(); i++)
+			{
+				CHECK(buffer.GetVertex(i) == vertices[i]);
+				CHECK(buffer.GetVertex(i).GetNormal() == vertices[i].GetNormal());
+			}
+
+			// the views alias the storage
+			const VertexStream<FVec3> positions = buffer.GetPositions();
+			CHECK(positions.Size() == vertices.size());
+			CHECK(positions.Stride() == (layout == VertexLayout::Interleaved ? sizeof(Vertex) : sizeof(FVec3)));
+			CHECK(positions.IsPacked() == (layout == VertexLayout::Deinterleaved));
+			positions[5] = FVec3(9.f, 8.f, 7.f);
+			buffer.GetTextCoords()[6] = FVec2(3.f, 4.f);
+			CHECK(buffer.GetVertex(5).GetPosition() == FVec3(9.f, 8.f, 7.f));
+			CHECK(buffer.GetVertex(6).GetTextCoords() == FVec2(3.f, 4.f));
+
+			const VertexBuffer& constant = buffer;
+			const VertexStream<const FVec3> colors = constant.GetColors();
+			CHECK(colors[7] == vertices[7].GetColor());
+			CHECK(constant.GetNormals()[8] == vertices[8].GetNormal());
+
+			buffer.PushBack(vertices[0]);
+			CHECK(buffer.Size() == vertices.size() + 1);
+			CHECK(buffer.GetVertex(vertices.size()) == vertices[0]);
+
+			buffer.Clear();
+			CHECK(buffer.Size() == 0);
+			CHECK(buffer.GetPositions().Size() == 0);
+		}
+	}
+
+	SECTION("Conversion")
+	{
+		VertexBuffer buffer(vertices.data(), vertices.size());
+		buffer.SetLayout(VertexLayout::Deinterleaved);
+		CHECK(buffer.GetLayout() == VertexLayout::Deinterleaved);
+		CHECK(buffer.GetVertices() == nullptr);
+		for (std::size_t i = 0; i < vertices.size(); i++)
+			CHECK(buffer.GetVertex(i) == vertices[i]);
+
+		buffer.SetLayout(VertexLayout::Interleaved);
+		REQUIRE(buffer.GetVertices() != nullptr);
+		std::vector<Vertex> copy(vertices.size());
+		buffer.CopyTo(copy.data());
+		for (std::size_t i = 0; i < vertices.size(); i++)
+		{
+			CHECK(buffer.GetVertices()[i] == vertices[i]);
+			CHECK(copy[i] == vertices[i]);
+			CHECK(copy[i].GetNormal() == vertices[i].GetNormal());
+		}
+	}
+
+	SECTION("Transform")
+	{
+		// non-uniform scale: the normals go through the inverse transpose
+		const FMat4 matrix = ScaleMatrix(FVec3(2.f, .5f, 1.f)) * FMat4::yRotation(.8f) * FMat4::xRotation(-.3f) *
+			FMat4::Translation(FVec3(1.f, -2.f, 3.f));
+		const FMat4 normalMatrix = matrix.Inverse().Transpose();
+
+		for (const VertexLayout layout : { VertexLayout::Interleaved, VertexLayout::Deinterleaved })
+		{
+			VertexBuffer buffer(vertices.data(), vertices.size(), layout);
+			buffer.Transform(matrix);
+
+			for (std::size_t i = 0; i < vertices.size(); i++)
+			{
+				const FVec4 position = matrix * FVec4(vertices[i].GetPosition(), 1.f);
+				const FVec4 normal = normalMatrix * FVec4(vertices[i].GetNormal(), 0.f);
+				CHECK(buffer.GetVertex(i).GetPosition().ApproxEqual(FVec3(position.X(), position.Y(), position.Z()), 1e-4f, 1e-5f));
+				CHECK(buffer.GetVertex(i).GetNormal().ApproxEqual(FVec3(normal.X(), normal.Y(), normal.Z()).Normalize(), 1e-5f));
+				CHECK(buffer.GetVertex(i).GetTextCoords() == vertices[i].GetTextCoords());
+			}
+		}
+
+		// a tangent of the surface stays perpendicular to the transformed normal
+		VertexBuffer plane(VertexLayout::Deinterleaved);
+		plane.PushBack(Vertex(FVec3(0.f), FVec3(1.f, 1.f, 0.f).Normalize()));
+		plane.Transform(ScaleMatrix(FVec3(4.f, 1.f, 1.f)));
+		const FVec4 tangent = ScaleMatrix(FVec3(4.f, 1.f, 1.f)) * FVec4(1.f, -1.f, 0.f, 0.f);
+		CHECK(plane.GetNormals()[0].DotProduct(FVec3(tangent.X(), tangent.Y(), tangent.Z())) == Catch::Approx(0.f).margin(1e-6));
+
+		// threaded ranges give the same result, up to the packed kernels starting at another vertex
+		const std::vector<Vertex> many = MakeVertices(3 * Parallel::mMinElementsPerThread + 5);
+		for (const VertexLayout layout : { VertexLayout::Interleaved, VertexLayout::Deinterleaved })
+		{
+			VertexBuffer single(many.data(), many.size(), layout);
+			VertexBuffer threaded(many.data(), many.size(), layout);
+			single.Transform(matrix, 1);
+			threaded.Transform(matrix, 3);
+
+			bool same = true;
+			for (std::size_t i = 0; i < many.size(); i++)
+				same = same && single.GetPositions()[i].ApproxEqual(threaded.GetPositions()[i], 1e-4f, 1e-6f) &&
+					single.GetNormals()[i].ApproxEqual(threaded.GetNormals()[i], 1e-6f);
+			CHECK(same);
+		}
+	}
+
+	SECTION("Normals")
+	{
+		// a fold along x = 3 between two slopes
+		std::vector<Vertex> grid;
+		const std::vector<std::uint32_t> indices = AppendGrid(grid, 6, [](const float pX, float) { return std::abs(pX - 3.f); });
+		grid.emplace_back(100.f, 0.f, 0.f);
+
+		VertexBuffer interleaved(grid.data(), grid.size());
+		VertexBuffer deinterleaved(grid.data(), grid.size(), VertexLayout::Deinterleaved);
+		interleaved.RecomputeNormals(indices.data(), indices.size());
+		deinterleaved.RecomputeNormals(indices.data(), indices.size());
+
+		const float slope = std::sqrt(.5f);
+		for (std::size_t i = 0; i + 1 < grid.size(); i++)
+		{
+			CHECK(deinterleaved.GetNormals()[i].ApproxEqual(interleaved.GetNormals()[i], 1e-6f));
+
+			// on the fold the two slopes weigh the same away from the border
+			const FVec3& position = grid[i].GetPosition();
+			const bool border = position.Z() == 0.f || position.Z() == 6.f;
+			if (position.X() != 3.f)
+				CHECK(interleaved.GetNormals()[i].ApproxEqual(FVec3(position.X() < 3.f ? slope : -slope, slope, 0.f), 1e-5f));
+			else if (!border)
+				CHECK(interleaved.GetNormals()[i].ApproxEqual(FVec3(0.f, 1.f, 0.f), 1e-5f));
+		}
+
+		// unused vertex
+		CHECK(interleaved.GetNormals()[grid.size() - 1] == FVec3(0.f));
+
+		// ComputeNormals works on any pair of views
+		std::vector<FVec3> normals(grid.size());
+		ComputeNormals(VertexStream<const FVec3>(&grid[0].GetPosition(), grid.size(), sizeof(Vertex)), indices.data(), indices.size(),
+			VertexStream<FVec3>(normals.data(), normals.size()));
+		CHECK(normals[10].ApproxEqual(interleaved.GetNormals()[10], 1e-6f));
+	}
+
+	SECTION("Bounds")
+	{
+		for (const VertexLayout layout : { VertexLayout::Interleaved, VertexLayout::Deinterleaved })
+		{
+			const VertexBuffer buffer(vertices.data(), vertices.size(), layout);
+			const FAABB bounds = buffer.GetBounds();
+
+			FAABB expected;
+			for (const Vertex& vertex : vertices)
+				expected.MergeSelf(vertex.GetPosition());
+			CHECK(bounds == expected);
+		}
+
+		CHECK(VertexBuffer().GetBounds().IsEmpty());
+	}
+}
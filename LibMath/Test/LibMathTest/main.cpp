@@ -99,6 +99,25 @@ int main(int argc, char* argv[])
 	arguments.push_back("Matrix3,");
 	arguments.push_back("Matrix4,");
 	arguments.push_back("Quaternion,");
+	arguments.push_back("Vector3SoA,");
+	arguments.push_back("Vector4SoA,");
+	arguments.push_back("Vector3Packet*,");
+	arguments.push_back("QuaternionPacket*,");
+	arguments.push_back("QuaternionBatch,");
+	arguments.push_back("DualQuaternion,");
+	arguments.push_back("Transform,");
+	arguments.push_back("Hierarchy,");
+	arguments.push_back("AABB,");
+	arguments.push_back("BVH,");
+	arguments.push_back("Ray,");
+	arguments.push_back("Frustum,");
+	arguments.push_back("FastMath,");
+	arguments.push_back("FastMathPacket*,");
+	arguments.push_back("Skinning,");
+	arguments.push_back("VertexBuffer,");
+	arguments.push_back("MeshNormals,");
+	arguments.push_back("MeshWeld,");
+	arguments.push_back("MeshOptimize,");
 
 
 	/************************************\